@@ -55,6 +55,10 @@ typedef struct {
   gboolean is_server;
   gboolean is_blocking;
 
+  guint max_chunk_size; /* max bytes of tensor data in a message (0: no chunking) */
+  guint max_in_flight;  /* max number of queued buffers to be sent (0: unlimited) */
+  guint num_threads;    /* number of completion queue threads (server only) */
+
   grpc_cb cb;
   void *cb_data;
 
@@ -77,6 +81,9 @@ enum
   PROP_HOST,
   PROP_PORT,
   PROP_OUT,
+  PROP_MAX_CHUNK_SIZE,
+  PROP_MAX_IN_FLIGHT,
+  PROP_NUM_THREADS,
 };
 
 /**
@@ -25,6 +25,8 @@
 static constexpr const char *NNS_GRPC_PROTOBUF_NAME = "libnnstreamer_grpc_protobuf";
 static constexpr const char *NNS_GRPC_FLATBUF_NAME = "libnnstreamer_grpc_flatbuf";
 static constexpr const char *NNS_GRPC_CREATE_INSTANCE = "create_instance";
+/* max time to wait in stop () until the queued buffers are sent */
+static constexpr gint64 NNS_GRPC_DRAIN_TIMEOUT_USEC = G_USEC_PER_SEC;
 
 using namespace grpc;
 
@@ -81,12 +83,15 @@ NNStreamerRPC::createInstance (const grpc_config * config)
 NNStreamerRPC::NNStreamerRPC (const grpc_config * config):
   host_ (config->host), port_ (config->port),
   is_server_ (config->is_server), is_blocking_ (config->is_blocking),
-  direction_ (config->dir), cb_ (config->cb), cb_data_ (config->cb_data),
+  max_chunk_size_ (config->max_chunk_size),
+  max_in_flight_ (config->max_in_flight),
+  num_threads_ (MAX (config->num_threads, 1U)), direction_ (config->dir),
+  cb_ (config->cb), cb_data_ (config->cb_data),
   config_ (config->config), server_instance_ (nullptr), handle_ (nullptr),
   stop_ (false)
 {
   queue_ = gst_data_queue_new (_data_queue_check_full_cb,
-      NULL, NULL, NULL);
+      NULL, NULL, this);
 }
 
 /** @brief destructor of NNStreamerRPC */
@@ -116,10 +121,17 @@ NNStreamerRPC::stop () {
   stop_ = true;
 
   if (queue_) {
-    /* wait until the queue's flushed */
-    while (!gst_data_queue_is_empty (queue_))
+    gint64 timeout = g_get_monotonic_time () + NNS_GRPC_DRAIN_TIMEOUT_USEC;
+
+    /**
+     * wait until the queued buffers are sent, but not forever:
+     * no worker pops the queue if the peer is gone or not connected yet.
+     */
+    while (!gst_data_queue_is_empty (queue_) &&
+        g_get_monotonic_time () < timeout)
       g_usleep (G_USEC_PER_SEC / 100);
 
+    /* unblock the upstream waiting in send () */
     gst_data_queue_set_flushing (queue_, TRUE);
   }
 
@@ -127,12 +139,14 @@ NNStreamerRPC::stop () {
     if (server_instance_.get ())
       server_instance_->Shutdown ();
 
-    if (completion_queue_.get ())
-      completion_queue_->Shutdown ();
+    for (auto &cq : completion_queues_)
+      cq->Shutdown ();
   }
 
-  if (worker_.joinable ())
-    worker_.join ();
+  for (auto &worker : workers_) {
+    if (worker.joinable ())
+      worker.join ();
+  }
 }
 
 /** @brief send buffer holding tensors */
@@ -156,6 +170,145 @@ NNStreamerRPC::send (GstBuffer *buffer) {
   return TRUE;
 }
 
+/**
+ * @brief pop a buffer from the data queue if no frame is being sent,
+ *        and get the tensor chunks of the next message
+ * @param[in] chunker the chunker of the stream
+ * @param[out] chunks the chunks to be written in a message
+ * @param[out] more TRUE if the frame has remaining chunks
+ * @return FALSE if the queue is flushing
+ */
+gboolean
+NNStreamerRPC::pop_chunks (TensorsChunker &chunker,
+    std::vector<TensorChunk> &chunks, gboolean *more)
+{
+  while (chunker.isEmpty ()) {
+    GstDataQueueItem *item;
+    GstBuffer *buffer;
+
+    if (!gst_data_queue_pop (queue_, &item))
+      return FALSE;
+
+    buffer = GST_BUFFER (item->object);
+    item->object = NULL;
+
+    GDestroyNotify destroy = (item->destroy) ? item->destroy : g_free;
+    destroy (item);
+
+    if (!chunker.setBuffer (buffer, &config_->info)) {
+      ml_logw ("Dropping the frame not matched with the negotiated tensors");
+      chunker.reset ();
+    }
+  }
+
+  *more = chunker.next (max_chunk_size_, chunks);
+  return TRUE;
+}
+
+/**
+ * @brief client-to-server streaming with the generic stub.
+ *        The messages refer to the tensor data without copy until they are written.
+ * @param[in] channel the channel connected to the server
+ * @param[in] method the full name of the method to send tensors
+ */
+void
+NNStreamerRPC::write_tensors_zero_copy (std::shared_ptr<Channel> channel,
+    const std::string &method)
+{
+  GenericStub stub (channel);
+  CompletionQueue cq;
+  ClientContext context;
+  TensorsChunker chunker;
+  ByteBuffer reply;
+  Status status;
+
+  /* wait for the completion of the last operation */
+  auto wait_op = [&cq] () -> bool {
+    void *tag;
+    bool ok = false;
+
+    return cq.Next (&tag, &ok) && ok;
+  };
+
+  std::unique_ptr<GenericClientAsyncReaderWriter> call =
+      stub.PrepareCall (&context, method, &cq);
+
+  call->StartCall (this);
+  if (!wait_op ()) {
+    ml_loge ("Failed to start the RPC call %s\n", method.c_str ());
+    goto finish;
+  }
+
+  while (1) {
+    std::vector<TensorChunk> chunks;
+    ByteBuffer buffer;
+    gboolean more;
+
+    /* until flushing */
+    if (!pop_chunks (chunker, chunks, &more))
+      break;
+
+    if (!encode_chunks (chunks, more, &buffer)) {
+      ml_loge ("Failed to serialize the tensors, dropping the frame\n");
+      chunker.reset ();
+      continue;
+    }
+
+    /* the slices of the message hold the memories, release the buffer */
+    if (!more)
+      chunker.reset ();
+
+    call->Write (buffer, this);
+    if (!wait_op ()) {
+      ml_loge ("Failed to write the tensors, the stream is closed\n");
+      break;
+    }
+  }
+
+  call->WritesDone (this);
+  wait_op ();
+
+  call->Read (&reply, this);
+  wait_op ();
+
+finish:
+  call->Finish (&status, this);
+  wait_op ();
+
+  if (!status.ok ())
+    ml_logw ("The RPC call is finished with error: %s",
+        status.error_message ().c_str ());
+
+  /* nobody sends the queued buffers anymore, fail the upstream instead of blocking it */
+  gst_data_queue_set_flushing (queue_, TRUE);
+  gst_data_queue_flush (queue_);
+
+  cq.Shutdown ();
+  {
+    void *tag;
+    bool ok;
+
+    /* drain the completion queue before destroying it */
+    while (cq.Next (&tag, &ok))
+      ;
+  }
+}
+
+/** @brief deliver the reassembled frame via callback */
+void
+NNStreamerRPC::push_buffer (TensorsAssembler &assembler)
+{
+  GstBuffer *buffer = assembler.finish ();
+
+  if (buffer == NULL)
+    return;
+
+  if (cb_)
+    cb_ (cb_data_, buffer);
+  else
+    gst_buffer_unref (buffer);
+}
+
 /** @brief start server service */
 gboolean
 NNStreamerRPC::_start_server () {
@@ -183,7 +336,12 @@ gboolean
 NNStreamerRPC::_data_queue_check_full_cb (GstDataQueue * queue,
     guint visible, guint bytes, guint64 time, gpointer checkdata)
 {
-  /* no full */
+  NNStreamerRPC *self = static_cast<NNStreamerRPC *> (checkdata);
+
+  /* block the upstream until the buffers in flight are sent */
+  if (self->max_in_flight_ > 0 && visible >= self->max_in_flight_)
+    return TRUE;
+
   return FALSE;
 }
 
@@ -195,6 +353,353 @@ NNStreamerRPC::_data_queue_item_free (GstDataQueueItem * item) {
   g_free (item);
 }
 
+/** @brief constructor of TensorsChunker */
+TensorsChunker::TensorsChunker ():
+  buffer_ (nullptr), index_ (0), offset_ (0)
+{
+}
+
+/** @brief destructor of TensorsChunker */
+TensorsChunker::~TensorsChunker ()
+{
+  reset ();
+}
+
+/**
+ * @brief map the tensors of the buffer to be split. It takes the buffer.
+ * @return FALSE if the buffer does not hold the tensors of the info. The caller should reset the chunker.
+ */
+gboolean
+TensorsChunker::setBuffer (GstBuffer *buffer, const GstTensorsInfo *info)
+{
+  guint num_mems = gst_buffer_n_memory (buffer);
+  gboolean per_tensor = (num_mems == info->num_tensors);
+  gsize data_ptr = 0;
+
+  reset ();
+  buffer_ = buffer;
+
+  /* map each memory of the tensors not to merge (copy) the whole buffer */
+  if (per_tensor) {
+    for (guint i = 0; i < num_mems; i++)
+      memories_.push_back (gst_buffer_get_memory (buffer, i));
+  } else {
+    memories_.push_back (gst_buffer_get_all_memory (buffer));
+  }
+
+  for (GstMemory *mem : memories_) {
+    GstMapInfo map;
+
+    if (mem == NULL || !gst_memory_map (mem, &map, GST_MAP_READ)) {
+      ml_loge ("Unable to map the buffer\n");
+      return FALSE;
+    }
+
+    maps_.push_back (map);
+  }
+
+  for (guint i = 0; i < info->num_tensors; i++) {
+    gsize tsize = gst_tensor_info_get_size (&info->info[i]);
+    GstMapInfo *map = per_tensor ? &maps_[i] : &maps_[0];
+    gsize offset = per_tensor ? 0 : data_ptr;
+
+    if (tsize == 0 || offset + tsize > map->size) {
+      ml_logw ("Setting invalid tensor data");
+      return FALSE;
+    }
+
+    data_.push_back (map->data + offset);
+    sizes_.push_back (tsize);
+    mem_index_.push_back (per_tensor ? i : 0);
+    data_ptr += tsize;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief get the tensor chunks of the next message
+ * @param[in] max_size max bytes of tensor data in a message (0: no limit)
+ * @param[out] chunks the chunks pointing the mapped buffer
+ * @return TRUE if the frame has remaining chunks
+ */
+gboolean
+TensorsChunker::next (gsize max_size, std::vector<TensorChunk> &chunks)
+{
+  gsize budget = (max_size > 0) ? max_size : G_MAXSIZE;
+
+  while (index_ < data_.size () && budget > 0) {
+    TensorChunk chunk;
+
+    chunk.index = index_;
+    chunk.offset = offset_;
+    chunk.total = sizes_[index_];
+    chunk.size = MIN (chunk.total - offset_, budget);
+    chunk.data = data_[index_] + offset_;
+    chunk.memory = memories_[mem_index_[index_]];
+    chunk.mem_offset = chunk.data - maps_[mem_index_[index_]].data;
+    chunks.push_back (chunk);
+
+    budget -= chunk.size;
+    offset_ += chunk.size;
+
+    if (offset_ == chunk.total) {
+      index_++;
+      offset_ = 0;
+    }
+  }
+
+  return (index_ < data_.size ());
+}
+
+/** @brief unmap and release the buffer */
+void
+TensorsChunker::reset ()
+{
+  for (size_t i = 0; i < maps_.size (); i++)
+    gst_memory_unmap (memories_[i], &maps_[i]);
+
+  for (GstMemory *mem : memories_) {
+    if (mem)
+      gst_memory_unref (mem);
+  }
+
+  memories_.clear ();
+  maps_.clear ();
+  data_.clear ();
+  sizes_.clear ();
+  mem_index_.clear ();
+
+  if (buffer_)
+    gst_buffer_unref (buffer_);
+  buffer_ = nullptr;
+
+  index_ = 0;
+  offset_ = 0;
+}
+
+/**
+ * @brief mapped memory referred by a slice
+ */
+typedef struct {
+  GstMemory *memory;
+  GstMapInfo map;
+} TensorSliceData;
+
+/** @brief release the memory when the slice is written */
+static void
+_free_tensor_slice (void *data)
+{
+  TensorSliceData *slice_data = static_cast<TensorSliceData *> (data);
+
+  gst_memory_unmap (slice_data->memory, &slice_data->map);
+  gst_memory_unref (slice_data->memory);
+  g_free (slice_data);
+}
+
+/**
+ * @brief wrap the data of the tensor chunk in a slice without copy.
+ *        The slice holds the memory, so the chunker can release the buffer.
+ * @return the slice, empty one if failed to map the memory
+ */
+Slice
+grpc::tensor_chunk_to_slice (const TensorChunk &chunk)
+{
+  TensorSliceData *slice_data = g_new0 (TensorSliceData, 1);
+
+  slice_data->memory = gst_memory_ref (chunk.memory);
+  if (!gst_memory_map (slice_data->memory, &slice_data->map, GST_MAP_READ)) {
+    ml_loge ("Unable to map the tensor memory\n");
+    gst_memory_unref (slice_data->memory);
+    g_free (slice_data);
+    return Slice ();
+  }
+
+  return Slice (slice_data->map.data + chunk.mem_offset, chunk.size,
+      _free_tensor_slice, slice_data);
+}
+
+/** @brief constructor of TensorsAssembler */
+TensorsAssembler::TensorsAssembler (const GstTensorsInfo *info):
+  info_ (info), buffer_ (nullptr), memory_ (nullptr), filled_ (0), total_ (0),
+  invalid_ (FALSE)
+{
+}
+
+/** @brief destructor of TensorsAssembler */
+TensorsAssembler::~TensorsAssembler ()
+{
+  reset ();
+}
+
+/**
+ * @brief check the size of the next tensor does not exceed the negotiated one
+ * @param[in] total size of the whole tensor given by the peer
+ */
+gboolean
+TensorsAssembler::checkSize (gsize total)
+{
+  guint index = (buffer_ != nullptr) ? gst_buffer_n_memory (buffer_) : 0;
+
+  /* the tensors info is not negotiated or not fixed */
+  if (info_ == nullptr || info_->num_tensors == 0 ||
+      info_->format != _NNS_TENSOR_FORMAT_STATIC)
+    return TRUE;
+
+  if (index >= info_->num_tensors) {
+    ml_logw ("Too many tensors in a frame (max %u)", info_->num_tensors);
+    return FALSE;
+  }
+
+  if (total > gst_tensor_info_get_size (&info_->info[index])) {
+    ml_logw ("The size of tensor %u (%" G_GSIZE_FORMAT
+        ") exceeds the negotiated size", index, total);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief append a complete tensor. It takes the memory.
+ * @return FALSE if the tensor is invalid, the frame is dropped when finished.
+ */
+gboolean
+TensorsAssembler::append (GstMemory *memory)
+{
+  /* the previous tensor is not completed */
+  if (memory_ != nullptr)
+    invalid_ = TRUE;
+
+  if (!checkSize (gst_memory_get_sizes (memory, NULL, NULL))) {
+    gst_memory_unref (memory);
+    invalid_ = TRUE;
+    return FALSE;
+  }
+
+  if (buffer_ == nullptr)
+    buffer_ = gst_buffer_new ();
+
+  gst_buffer_append_memory (buffer_, memory);
+  return TRUE;
+}
+
+/**
+ * @brief append a chunk of the tensor
+ * @param[in] data data of the chunk
+ * @param[in] size size of the chunk
+ * @param[in] offset offset of the chunk in the tensor
+ * @param[in] total size of the whole tensor
+ */
+gboolean
+TensorsAssembler::append (const guint8 *data, gsize size, gsize offset,
+    gsize total)
+{
+  GstMapInfo map;
+
+  if (offset == 0) {
+    gpointer new_data;
+
+    if (memory_ != nullptr) {
+      invalid_ = TRUE;
+      gst_memory_unref (memory_);
+      memory_ = nullptr;
+    }
+
+    if (total == 0 || !checkSize (total)) {
+      invalid_ = TRUE;
+      return FALSE;
+    }
+
+    /* the size is given by the peer, do not abort on allocation failure */
+    new_data = g_try_malloc (total);
+    if (new_data == NULL) {
+      ml_loge ("Failed to allocate a tensor of %" G_GSIZE_FORMAT " bytes", total);
+      invalid_ = TRUE;
+      return FALSE;
+    }
+
+    memory_ = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, total,
+        0, total, new_data, g_free);
+    filled_ = 0;
+    total_ = total;
+  }
+
+  if (memory_ == nullptr || offset != filled_ || total != total_ ||
+      size > total_ - filled_) {
+    ml_logw ("Invalid tensor chunk (offset %" G_GSIZE_FORMAT ", size %"
+        G_GSIZE_FORMAT ", total %" G_GSIZE_FORMAT ")", offset, size, total);
+    invalid_ = TRUE;
+    return FALSE;
+  }
+
+  if (!gst_memory_map (memory_, &map, GST_MAP_WRITE)) {
+    ml_loge ("Unable to map the tensor memory\n");
+    invalid_ = TRUE;
+    return FALSE;
+  }
+
+  if (size > 0)
+    memcpy (map.data + offset, data, size);
+  gst_memory_unmap (memory_, &map);
+
+  filled_ += size;
+  if (filled_ == total_) {
+    if (buffer_ == nullptr)
+      buffer_ = gst_buffer_new ();
+
+    gst_buffer_append_memory (buffer_, memory_);
+    memory_ = nullptr;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief get the reassembled frame
+ * @return the buffer or NULL if there is no tensor or a tensor is not completed
+ */
+GstBuffer *
+TensorsAssembler::finish ()
+{
+  GstBuffer *buffer = buffer_;
+
+  if (invalid_ || memory_ != nullptr) {
+    ml_logw ("Dropping the incomplete frame");
+    reset ();
+    return NULL;
+  }
+
+  /* a tensor of the frame is missing */
+  if (buffer != nullptr && info_ != nullptr && info_->num_tensors > 0 &&
+      info_->format == _NNS_TENSOR_FORMAT_STATIC &&
+      gst_buffer_n_memory (buffer) != info_->num_tensors) {
+    ml_logw ("Dropping the frame without %u tensors", info_->num_tensors);
+    reset ();
+    return NULL;
+  }
+
+  buffer_ = nullptr;
+  return buffer;
+}
+
+/** @brief release the frame being reassembled */
+void
+TensorsAssembler::reset ()
+{
+  if (memory_)
+    gst_memory_unref (memory_);
+  memory_ = nullptr;
+
+  if (buffer_)
+    gst_buffer_unref (buffer_);
+  buffer_ = nullptr;
+
+  filled_ = 0;
+  total_ = 0;
+  invalid_ = FALSE;
+}
+
 /**
  * @brief get gRPC IDL enum from a given string
  */
@@ -367,6 +872,18 @@ grpc_common_set_property (GObject * self, gboolean * silent,
       grpc->config.port = g_value_get_int (value);
       silent_debug ("Set port = %d", grpc->config.port);
       break;
+    case PROP_MAX_CHUNK_SIZE:
+      grpc->config.max_chunk_size = g_value_get_uint (value);
+      silent_debug ("Set max-chunk-size = %u", grpc->config.max_chunk_size);
+      break;
+    case PROP_MAX_IN_FLIGHT:
+      grpc->config.max_in_flight = g_value_get_uint (value);
+      silent_debug ("Set max-in-flight = %u", grpc->config.max_in_flight);
+      break;
+    case PROP_NUM_THREADS:
+      grpc->config.num_threads = g_value_get_uint (value);
+      silent_debug ("Set num-threads = %u", grpc->config.num_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -411,6 +928,15 @@ grpc_common_get_property (GObject * self, gboolean silent, guint out,
     case PROP_OUT:
       g_value_set_uint (value, out);
       break;
+    case PROP_MAX_CHUNK_SIZE:
+      g_value_set_uint (value, grpc->config.max_chunk_size);
+      break;
+    case PROP_MAX_IN_FLIGHT:
+      g_value_set_uint (value, grpc->config.max_in_flight);
+      break;
+    case PROP_NUM_THREADS:
+      g_value_set_uint (value, grpc->config.num_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -19,13 +19,85 @@
 
 #include <gst/base/gstdataqueue.h>
 #include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/generic_stub.h>
 
 #include <cstring>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace grpc {
 
+/**
+ * @brief a piece of tensor data to be written in a message
+ */
+typedef struct {
+  guint index;        /**< index of the tensor in the frame */
+  const guint8 *data; /**< data of the piece */
+  gsize size;         /**< size of the piece */
+  gsize offset;       /**< offset of the piece in the tensor */
+  gsize total;        /**< size of the whole tensor */
+  GstMemory *memory;  /**< memory holding the piece, valid while the chunker holds the buffer */
+  gsize mem_offset;   /**< offset of the piece in the memory */
+} TensorChunk;
+
+Slice tensor_chunk_to_slice (const TensorChunk &chunk);
+
+/**
+ * @brief Splits a frame (buffer) into the tensor chunks of streamed messages.
+ * Each stream has its own instance so that the chunks are never interleaved.
+ */
+class TensorsChunker {
+  public:
+    TensorsChunker ();
+    ~TensorsChunker ();
+
+    gboolean setBuffer (GstBuffer *buffer, const GstTensorsInfo *info);
+    gboolean next (gsize max_size, std::vector<TensorChunk> &chunks);
+    void reset ();
+
+    /** @brief check whether all the chunks of the frame are consumed */
+    gboolean isEmpty () { return buffer_ == nullptr; }
+
+  private:
+    GstBuffer *buffer_;
+    std::vector<GstMemory *> memories_;
+    std::vector<GstMapInfo> maps_;
+    std::vector<const guint8 *> data_;
+    std::vector<gsize> sizes_;
+    std::vector<guint> mem_index_;
+
+    guint index_;
+    gsize offset_;
+};
+
+/**
+ * @brief Reassembles a frame (buffer) from the tensor chunks of streamed messages.
+ */
+class TensorsAssembler {
+  public:
+    TensorsAssembler (const GstTensorsInfo *info = nullptr);
+    ~TensorsAssembler ();
+
+    gboolean append (GstMemory *memory);
+    gboolean append (const guint8 *data, gsize size, gsize offset, gsize total);
+    GstBuffer * finish ();
+    void reset ();
+
+    /** @brief drop the frame being reassembled when it is finished */
+    void invalidate () { invalid_ = TRUE; }
+
+  private:
+    gboolean checkSize (gsize total);
+
+    const GstTensorsInfo *info_;
+    GstBuffer *buffer_;
+    GstMemory *memory_;
+    gsize filled_;
+    gsize total_;
+    gboolean invalid_;
+};
+
 /**
  * @brief NNStreamer RPC service
  */
@@ -64,13 +136,28 @@ class NNStreamerRPC {
       return direction_;
     }
 
+    /** @brief get the negotiated tensors info */
+    const GstTensorsInfo *getTensorsInfo () {
+      return config_ ? &config_->info : nullptr;
+    }
+
   protected:
+    gboolean pop_chunks (TensorsChunker &chunker,
+        std::vector<TensorChunk> &chunks, gboolean *more);
+    void push_buffer (TensorsAssembler &assembler);
+    void write_tensors_zero_copy (std::shared_ptr<Channel> channel,
+        const std::string &method);
+
     const gchar *host_;
     gint port_;
 
     gboolean is_server_;
     gboolean is_blocking_;
 
+    guint max_chunk_size_;
+    guint max_in_flight_;
+    guint num_threads_;
+
     grpc_direction direction_;
 
     grpc_cb cb_;
@@ -80,9 +167,9 @@ class NNStreamerRPC {
     GstDataQueue *queue_;
 
     std::unique_ptr<Server> server_instance_;
-    std::unique_ptr<ServerCompletionQueue> completion_queue_;
+    std::vector<std::unique_ptr<ServerCompletionQueue>> completion_queues_;
 
-    std::thread worker_;
+    std::vector<std::thread> workers_;
 
     void * handle_;
     gboolean stop_;
@@ -92,6 +179,9 @@ class NNStreamerRPC {
     virtual gboolean start_server (std::string address) { return FALSE; }
     /** @brief start gRPC client */
     virtual gboolean start_client (std::string address) { return FALSE; }
+    /** @brief serialize the tensor chunks into a message referring the tensor data */
+    virtual gboolean encode_chunks (std::vector<TensorChunk> &chunks,
+        gboolean more, ByteBuffer *buffer) { return FALSE; }
 
     gboolean _start_server ();
     gboolean _start_client ();
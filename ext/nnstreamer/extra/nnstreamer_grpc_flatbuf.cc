@@ -36,6 +36,13 @@ using flatbuffers::grpc::MessageBuilder;
 
 using namespace grpc;
 
+/** @brief get the full name of the method to send tensors */
+static std::string
+_send_tensors_method ()
+{
+  return std::string ("/") + TensorService::service_full_name () + "/SendTensors";
+}
+
 /** @brief Constructor of ServiceImplFlatbuf */
 ServiceImplFlatbuf::ServiceImplFlatbuf (const grpc_config * config)
   : NNStreamerRPC (config), client_stub_ (nullptr)
@@ -44,31 +51,45 @@ ServiceImplFlatbuf::ServiceImplFlatbuf (const grpc_config * config)
 
 /** @brief parse tensors and deliver the buffer via callback */
 void
-ServiceImplFlatbuf::parse_tensors (Message<Tensors> &tensors)
+ServiceImplFlatbuf::parse_tensors (Message<Tensors> &tensors,
+    TensorsAssembler &assembler)
 {
-  GstBuffer *buffer;
+  gboolean more;
 
-  _get_buffer_from_tensors (tensors, &buffer);
+  /* already consumed */
+  if (tensors.size () == 0)
+    return;
 
-  if (cb_)
-    cb_ (cb_data_, buffer);
-  else
-    gst_buffer_unref (buffer);
+  more = tensors.GetRoot ()->more_chunks ();
+
+  _get_buffer_from_tensors (tensors, assembler);
+
+  /* the tensors hold the references of the message slice */
+  tensors = Message<Tensors> ();
+
+  /* wait for the remaining chunks of the frame */
+  if (more)
+    return;
+
+  push_buffer (assembler);
 }
 
 /** @brief fill tensors from the buffer */
 gboolean
-ServiceImplFlatbuf::fill_tensors (Message<Tensors> &tensors)
+ServiceImplFlatbuf::fill_tensors (Message<Tensors> &tensors,
+    TensorsChunker &chunker)
 {
-  GstDataQueueItem *item;
+  std::vector<TensorChunk> chunks;
+  gboolean more;
 
-  if (!gst_data_queue_pop (queue_, &item))
+  if (!pop_chunks (chunker, chunks, &more))
     return FALSE;
 
-  _get_tensors_from_buffer (GST_BUFFER (item->object), tensors);
+  _get_tensors_from_chunks (chunks, more, tensors);
 
-  GDestroyNotify destroy = (item->destroy) ? item->destroy : g_free;
-  destroy (item);
+  /* release the buffer once its last chunk is copied */
+  if (!more)
+    chunker.reset ();
 
   return TRUE;
 }
@@ -77,13 +98,15 @@ ServiceImplFlatbuf::fill_tensors (Message<Tensors> &tensors)
 template <typename T>
 Status ServiceImplFlatbuf::_read_tensors (T reader)
 {
+  TensorsAssembler assembler (getTensorsInfo ());
+
   while (1) {
     Message<Tensors> tensors;
 
     if (!reader->Read (&tensors))
       break;
 
-    parse_tensors (tensors);
+    parse_tensors (tensors, assembler);
   }
 
   return Status::OK;
@@ -93,11 +116,13 @@ Status ServiceImplFlatbuf::_read_tensors (T reader)
 template <typename T>
 Status ServiceImplFlatbuf::_write_tensors (T writer)
 {
+  TensorsChunker chunker;
+
   while (1) {
     Message<Tensors> tensors;
 
     /* until flushing */
-    if (!fill_tensors (tensors))
+    if (!fill_tensors (tensors, chunker))
       break;
 
     writer->Write (tensors);
@@ -106,33 +131,53 @@ Status ServiceImplFlatbuf::_write_tensors (T writer)
   return Status::OK;
 }
 
+/** @brief release the message slice referred by a tensor */
+static void
+_free_message_slice (gpointer data)
+{
+  delete static_cast<grpc::Slice *> (data);
+}
+
 /** @brief convert tensors to buffer */
 void
 ServiceImplFlatbuf::_get_buffer_from_tensors (Message<Tensors> &msg,
-    GstBuffer **buffer)
+    TensorsAssembler &assembler)
 {
   const Tensors *tensors = msg.GetRoot ();
-  guint num_tensor = tensors->num_tensor ();
-  GstMemory *memory;
-
-  *buffer = gst_buffer_new ();
+  guint num_tensor = VectorLength (tensors->tensor ());
 
   for (guint i = 0; i < num_tensor; i++) {
     const Tensor * tensor = tensors->tensor ()->Get (i);
-    const void * data = tensor->data ()->data ();
+    const guint8 * data = tensor->data () ? tensor->data ()->data () : NULL;
     gsize size = VectorLength (tensor->data ());
-    gpointer new_data = _g_memdup (data, size);
-
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
-    gst_buffer_append_memory (*buffer, memory);
+    gsize total = tensor->total_size ();
+
+    if (data == NULL || size == 0) {
+      /* gst_memory_new_wrapped () does not accept null data */
+      ml_logw ("Received a tensor without data");
+      assembler.invalidate ();
+    } else if (tensor->offset () > 0 || total > size) {
+      assembler.append (data, size, tensor->offset (), total);
+    } else {
+      /* refer to the received message slice without copy */
+      grpc::Slice *slice = new grpc::Slice (msg.BorrowSlice ());
+      GstMemory *memory;
+
+      memory = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+          (gpointer) data, size, 0, size, slice, _free_message_slice);
+      assembler.append (memory);
+    }
   }
 }
 
-/** @brief convert buffer to tensors */
+/**
+ * @brief convert tensor chunks to tensors
+ * @param[out] data_offsets if given, the data vectors are not filled and their offsets are returned
+ */
 void
-ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
-    Message<Tensors> &msg)
+ServiceImplFlatbuf::_get_tensors_from_chunks (
+    std::vector<TensorChunk> &chunks, gboolean more, Message<Tensors> &msg,
+    std::vector<flatbuffers::uoffset_t> *data_offsets)
 {
   MessageBuilder builder;
 
@@ -147,40 +192,75 @@ ServiceImplFlatbuf::_get_tensors_from_buffer (GstBuffer *buffer,
   unsigned int num_tensors = config_->info.num_tensors;
   frame_rate fr = frame_rate (config_->rate_n, config_->rate_d);
 
-  GstMapInfo map;
-  gsize data_ptr = 0;
-
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
-    ml_loge ("Unable to map the buffer\n");
-    return;
-  }
-
-  for (guint i = 0; i < num_tensors; i++) {
-    const GstTensorInfo * info = &config_->info.info[i];
-    gsize tsize = gst_tensor_info_get_size (info);
-
-    if (data_ptr + tsize > map.size) {
-      ml_logw ("Setting invalid tensor data");
-      break;
-    }
+  for (const TensorChunk &chunk : chunks) {
+    const GstTensorInfo * info = &config_->info.info[chunk.index];
+    /* the receiver reassembles the split tensor */
+    gboolean split = (chunk.size < chunk.total);
 
     tensor_dim = builder.CreateVector (info->dimension, NNS_TENSOR_RANK_LIMIT);
     tensor_name = builder.CreateString ("Anonymous");
     tensor_type = (Tensor_type) info->type;
-    tensor_data = builder.CreateVector<unsigned char> (map.data + data_ptr, tsize);
+    if (data_offsets) {
+      unsigned char *unused;
 
-    data_ptr += tsize;
+      tensor_data = builder.CreateUninitializedVector<unsigned char> (chunk.size, &unused);
+      data_offsets->push_back (tensor_data.o);
+    } else {
+      tensor_data = builder.CreateVector<unsigned char> (chunk.data, chunk.size);
+    }
 
-    tensor = CreateTensor (builder, tensor_name, tensor_type, tensor_dim, tensor_data);
+    tensor = CreateTensor (builder, tensor_name, tensor_type, tensor_dim, tensor_data,
+        split ? chunk.offset : 0, split ? chunk.total : 0);
     tensor_vector.push_back (tensor);
   }
 
-  tensors = CreateTensors (builder, num_tensors, &fr, builder.CreateVector (tensor_vector), format);
+  tensors = CreateTensors (builder, num_tensors, &fr, builder.CreateVector (tensor_vector),
+      format, more);
 
   builder.Finish (tensors);
   msg = builder.ReleaseMessage<Tensors>();
+}
+
+/**
+ * @brief serialize the tensor chunks into a flatbuffer message.
+ *        The data vectors are left unfilled in the message, the slices referring the tensor memory are written in their place.
+ */
+gboolean
+ServiceImplFlatbuf::encode_chunks (std::vector<TensorChunk> &chunks,
+    gboolean more, ByteBuffer *buffer)
+{
+  std::vector<flatbuffers::uoffset_t> data_offsets;
+  std::vector<Slice> slices;
+  Message<Tensors> msg;
+  gsize msg_size, pos;
+
+  _get_tensors_from_chunks (chunks, more, msg, &data_offsets);
+
+  Slice msg_slice (msg.BorrowSlice (), Slice::ADD_REF);
+  msg_size = msg_slice.size ();
+  pos = 0;
+
+  /**
+   * The offset of an object is from the end of the buffer, and the vector data follows its length.
+   * The builder writes the buffer backwards, the last vector is placed first.
+   */
+  for (gsize i = chunks.size (); i > 0; i--) {
+    const TensorChunk &chunk = chunks[i - 1];
+    gsize start = msg_size - data_offsets[i - 1] + sizeof (flatbuffers::uoffset_t);
+
+    Slice data = tensor_chunk_to_slice (chunk);
+    if (data.size () != chunk.size || start < pos || start + chunk.size > msg_size)
+      return FALSE;
+
+    slices.push_back (msg_slice.sub (pos, start));
+    slices.push_back (data);
+    pos = start + chunk.size;
+  }
 
-  gst_buffer_unmap (buffer, &map);
+  slices.push_back (msg_slice.sub (pos, msg_size));
+
+  *buffer = ByteBuffer (slices.data (), slices.size ());
+  return TRUE;
 }
 
 /** @brief Constructor of SyncServiceImplFlatbuf */
@@ -216,6 +296,10 @@ SyncServiceImplFlatbuf::start_server (std::string address)
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
 
+  /* the number of completion queues to poll the sync requests */
+  builder.SetSyncServerOption (ServerBuilder::SyncServerOption::NUM_CQS,
+      num_threads_);
+
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
   if (server_instance_.get () == nullptr)
@@ -232,12 +316,20 @@ SyncServiceImplFlatbuf::start_client (std::string address)
   std::shared_ptr<Channel> channel = grpc::CreateChannel(
       address, grpc::InsecureChannelCredentials());
 
+  /* send the tensors with the generic stub not to copy the tensor data */
+  if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
+    workers_.emplace_back ([this, channel] {
+      this->write_tensors_zero_copy (channel, _send_tensors_method ());
+    });
+    return TRUE;
+  }
+
   /* connect the server */
   client_stub_ = TensorService::NewStub (channel);
   if (client_stub_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  workers_.emplace_back ([this] { this->_client_thread (); });
 
   return TRUE;
 }
@@ -248,24 +340,8 @@ SyncServiceImplFlatbuf::_client_thread ()
 {
   ClientContext context;
 
-  if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
-    Message<Empty> empty;
-
-    /* initiate the RPC call */
-    std::unique_ptr< ClientWriter<Message<Tensors>> > writer(
-        client_stub_->SendTensors (&context, &empty));
-
-    _write_tensors (writer.get ());
-
-    writer->WritesDone ();
-    /**
-     * TODO: The below incurs assertion failure but it seems like a bug.
-     * Let's check it later with the latest gRPC version.
-     *
-     * writer->Finish ();
-     */
-    g_usleep (G_USEC_PER_SEC / 100);
-  } else if (direction_ == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
+  /* the tensors are sent by write_tensors_zero_copy () */
+  if (direction_ == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
     MessageBuilder builder;
 
     auto empty_offset = nnstreamer::flatbuf::CreateEmpty (builder);
@@ -285,15 +361,17 @@ SyncServiceImplFlatbuf::_client_thread ()
 
 /** @brief Constructor of AsyncServiceImplFlatbuf */
 AsyncServiceImplFlatbuf::AsyncServiceImplFlatbuf (const grpc_config * config)
-  : ServiceImplFlatbuf (config), last_call_ (nullptr)
+  : ServiceImplFlatbuf (config)
 {
 }
 
 /** @brief Destructor of AsyncServiceImplFlatbuf */
 AsyncServiceImplFlatbuf::~AsyncServiceImplFlatbuf ()
 {
-  if (last_call_)
-    delete last_call_;
+  for (AsyncCallData *call : last_calls_) {
+    if (call)
+      delete call;
+  }
 }
 
 
@@ -306,15 +384,18 @@ AsyncServiceImplFlatbuf::start_server (std::string address)
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
 
-  /* need to manually handle the completion queue */
-  completion_queue_ = builder.AddCompletionQueue ();
+  /* need to manually handle the completion queues, one per thread */
+  for (guint i = 0; i < num_threads_; i++)
+    completion_queues_.push_back (builder.AddCompletionQueue ());
+  last_calls_.assign (num_threads_, nullptr);
 
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
   if (server_instance_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_server_thread (); });
+  for (guint i = 0; i < num_threads_; i++)
+    workers_.emplace_back ([this, i] { this->_server_thread (i); });
 
   return TRUE;
 }
@@ -327,12 +408,20 @@ AsyncServiceImplFlatbuf::start_client (std::string address)
   std::shared_ptr<Channel> channel = grpc::CreateChannel(
       address, grpc::InsecureChannelCredentials());
 
+  /* send the tensors with the generic stub not to copy the tensor data */
+  if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
+    workers_.emplace_back ([this, channel] {
+      this->write_tensors_zero_copy (channel, _send_tensors_method ());
+    });
+    return TRUE;
+  }
+
   /* connect the server */
   client_stub_ = TensorService::NewStub (channel);
   if (client_stub_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  workers_.emplace_back ([this] { this->_client_thread (); });
 
   return TRUE;
 }
@@ -341,8 +430,9 @@ AsyncServiceImplFlatbuf::start_client (std::string address)
 class AsyncCallDataServer : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataServer */
-    AsyncCallDataServer (AsyncServiceImplFlatbuf *service, ServerCompletionQueue *cq)
-      : AsyncCallData (service), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+    AsyncCallDataServer (AsyncServiceImplFlatbuf *service, ServerCompletionQueue *cq,
+        guint id)
+      : AsyncCallData (service), cq_ (cq), id_ (id), writer_ (nullptr), reader_ (nullptr)
     {
       RunState ();
     }
@@ -353,7 +443,7 @@ class AsyncCallDataServer : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, assembler_);
           state_ = FINISH;
         } else {
           return;
@@ -372,18 +462,18 @@ class AsyncCallDataServer : public AsyncCallData {
       } else if (state_ == PROCESS) {
         if (count_ == 0) {
           /* spawn a new instance to serve new clients */
-          service_->set_last_call (new AsyncCallDataServer (service_, cq_));
+          service_->set_last_call (id_, new AsyncCallDataServer (service_, cq_, id_));
         }
 
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, assembler_);
           reader_->Read (&rpc_tensors_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
         } else if (writer_.get () != nullptr) {
           Message<Tensors> tensors;
-          if (service_->fill_tensors (tensors)) {
+          if (service_->fill_tensors (tensors, chunker_)) {
             writer_->Write (tensors, this);
             count_++;
           } else {
@@ -413,6 +503,7 @@ class AsyncCallDataServer : public AsyncCallData {
 
   private:
     ServerCompletionQueue *cq_;
+    guint id_;
     ServerContext ctx_;
 
     std::unique_ptr<ServerAsyncWriter<Message<Tensors>>> writer_;
@@ -425,7 +516,7 @@ class AsyncCallDataClient : public AsyncCallData {
     /** @brief Constructor of AsyncCallDataClient */
     AsyncCallDataClient (AsyncServiceImplFlatbuf *service, TensorService::Stub * stub,
         CompletionQueue *cq)
-      : AsyncCallData (service), stub_ (stub), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+      : AsyncCallData (service), stub_ (stub), cq_ (cq), reader_ (nullptr)
     {
       RunState ();
     }
@@ -436,50 +527,33 @@ class AsyncCallDataClient : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, assembler_);
           state_ = FINISH;
         } else {
           return;
         }
       }
 
+      /* the tensors are sent by write_tensors_zero_copy () */
       if (state_ == CREATE) {
-        if (service_->getDirection () == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
-          MessageBuilder builder;
+        MessageBuilder builder;
 
-          auto empty_offset = nnstreamer::flatbuf::CreateEmpty (builder);
-          builder.Finish (empty_offset);
+        auto empty_offset = nnstreamer::flatbuf::CreateEmpty (builder);
+        builder.Finish (empty_offset);
 
-          reader_ = stub_->AsyncRecvTensors (&ctx_,
-              builder.ReleaseMessage <Empty> (), cq_, this);
-        } else {
-          writer_ = stub_->AsyncSendTensors (&ctx_, &rpc_empty_, cq_, this);
-        }
+        reader_ = stub_->AsyncRecvTensors (&ctx_,
+            builder.ReleaseMessage <Empty> (), cq_, this);
         state_ = PROCESS;
       } else if (state_ == PROCESS) {
-        if (reader_.get () != nullptr) {
-          if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
-          reader_->Read (&rpc_tensors_, this);
-          /* can't read tensors yet. use the next turn */
-          count_++;
-        } else if (writer_.get () != nullptr) {
-          Message<Tensors> tensors;
-          if (service_->fill_tensors (tensors)) {
-            writer_->Write (tensors, this);
-            count_++;
-          } else {
-            writer_->WritesDone (this);
-            state_ = FINISH;
-          }
-        }
+        if (count_ != 0)
+          service_->parse_tensors (rpc_tensors_, assembler_);
+        reader_->Read (&rpc_tensors_, this);
+        /* can't read tensors yet. use the next turn */
+        count_++;
       } else if (state_ == FINISH) {
         Status status;
 
-        if (reader_.get () != nullptr)
-          reader_->Finish (&status, this);
-        if (writer_.get () != nullptr)
-          writer_->Finish (&status, this);
+        reader_->Finish (&status, this);
 
         delete this;
       }
@@ -490,16 +564,17 @@ class AsyncCallDataClient : public AsyncCallData {
     CompletionQueue * cq_;
     ClientContext ctx_;
 
-    std::unique_ptr<ClientAsyncWriter<Message<Tensors>>> writer_;
     std::unique_ptr<ClientAsyncReader<Message<Tensors>>> reader_;
 };
 
-/** @brief gRPC client thread */
+/** @brief gRPC server thread polling the completion queue of the id */
 void
-AsyncServiceImplFlatbuf::_server_thread ()
+AsyncServiceImplFlatbuf::_server_thread (guint id)
 {
+  ServerCompletionQueue *completion_queue = completion_queues_[id].get ();
+
   /* spawn a new instance to server new clients */
-  set_last_call (new AsyncCallDataServer (this, completion_queue_.get ()));
+  set_last_call (id, new AsyncCallDataServer (this, completion_queue, id));
 
   while (1) {
     void *tag;
@@ -510,7 +585,7 @@ AsyncServiceImplFlatbuf::_server_thread ()
       gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
           gpr_time_from_millis(10, GPR_TIMESPAN));
 
-    switch (completion_queue_->AsyncNext (&tag, &ok, deadline)) {
+    switch (completion_queue->AsyncNext (&tag, &ok, deadline)) {
       case CompletionQueue::GOT_EVENT:
         static_cast<AsyncCallDataServer *>(tag)->RunState(ok);
         break;
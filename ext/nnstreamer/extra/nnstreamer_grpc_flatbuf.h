@@ -35,8 +35,8 @@ class ServiceImplFlatbuf : public NNStreamerRPC
   public:
     ServiceImplFlatbuf (const grpc_config * config);
 
-    void parse_tensors (Message<Tensors> &tensors);
-    gboolean fill_tensors (Message<Tensors> &tensors);
+    void parse_tensors (Message<Tensors> &tensors, TensorsAssembler &assembler);
+    gboolean fill_tensors (Message<Tensors> &tensors, TensorsChunker &chunker);
 
   protected:
     template <typename T>
@@ -45,10 +45,17 @@ class ServiceImplFlatbuf : public NNStreamerRPC
     template <typename T>
     grpc::Status _read_tensors (T reader);
 
-    void _get_tensors_from_buffer (GstBuffer *buffer, Message<Tensors> &tensors);
-    void _get_buffer_from_tensors (Message<Tensors> &tensors, GstBuffer **buffer);
+    void _get_tensors_from_chunks (std::vector<TensorChunk> &chunks,
+        gboolean more, Message<Tensors> &tensors,
+        std::vector<flatbuffers::uoffset_t> *data_offsets = nullptr);
+    void _get_buffer_from_tensors (Message<Tensors> &tensors,
+        TensorsAssembler &assembler);
 
     std::unique_ptr<nnstreamer::flatbuf::TensorService::Stub> client_stub_;
+
+  private:
+    gboolean encode_chunks (std::vector<TensorChunk> &chunks,
+        gboolean more, ByteBuffer *buffer) override;
 };
 
 /**
@@ -85,17 +92,17 @@ class AsyncServiceImplFlatbuf final
     AsyncServiceImplFlatbuf (const grpc_config * config);
     ~AsyncServiceImplFlatbuf ();
 
-    /** @brief set the last call data */
-    void set_last_call (AsyncCallData * call) { last_call_ = call; }
+    /** @brief set the last call data of the completion queue */
+    void set_last_call (guint id, AsyncCallData * call) { last_calls_[id] = call; }
 
   private:
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _server_thread ();
+    void _server_thread (guint id);
     void _client_thread ();
 
-    AsyncCallData * last_call_;
+    std::vector<AsyncCallData *> last_calls_;
 };
 
 /** @brief Internal base class to serve a request */
@@ -103,7 +110,8 @@ class AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallData */
     AsyncCallData (AsyncServiceImplFlatbuf *service)
-      : service_ (service), state_ (CREATE), count_ (0)
+      : service_ (service), state_ (CREATE), count_ (0),
+        assembler_ (service->getTensorsInfo ())
     {
     }
 
@@ -122,6 +130,9 @@ class AsyncCallData {
 
     Message<Tensors> rpc_tensors_;
     Message<Empty> rpc_empty_;
+
+    TensorsChunker chunker_;
+    TensorsAssembler assembler_;
 };
 
 }; // namespace grpc
@@ -28,8 +28,28 @@
 
 #include <gst/base/gstdataqueue.h>
 
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::io::StringOutputStream;
+
 using namespace grpc;
 
+/** @brief get the full name of the method to send tensors */
+static std::string
+_send_tensors_method ()
+{
+  return std::string ("/") + TensorService::service_full_name () + "/SendTensors";
+}
+
+/** @brief get the tag of length-delimited (wire type 2) field */
+static inline guint32
+_length_delimited_tag (int field_number)
+{
+  return (static_cast<guint32> (field_number) << 3) | 2U;
+}
+
 /** @brief constructor */
 ServiceImplProtobuf::ServiceImplProtobuf (const grpc_config * config):
   NNStreamerRPC (config), client_stub_ (nullptr)
@@ -38,31 +58,38 @@ ServiceImplProtobuf::ServiceImplProtobuf (const grpc_config * config):
 
 /** @brief parse tensors and deliver the buffer via callback */
 void
-ServiceImplProtobuf::parse_tensors (Tensors &tensors)
+ServiceImplProtobuf::parse_tensors (Tensors &tensors,
+    TensorsAssembler &assembler)
 {
-  GstBuffer *buffer;
+  gboolean more = tensors.more_chunks ();
 
-  _get_buffer_from_tensors (tensors, &buffer);
+  _get_buffer_from_tensors (tensors, assembler);
 
-  if (cb_)
-    cb_ (cb_data_, buffer);
-  else
-    gst_buffer_unref (buffer);
+  /* the data is taken by the assembler */
+  tensors.Clear ();
+
+  /* wait for the remaining chunks of the frame */
+  if (more)
+    return;
+
+  push_buffer (assembler);
 }
 
 /** @brief fill tensors from the buffer */
 gboolean
-ServiceImplProtobuf::fill_tensors (Tensors &tensors)
+ServiceImplProtobuf::fill_tensors (Tensors &tensors, TensorsChunker &chunker)
 {
-  GstDataQueueItem *item;
+  std::vector<TensorChunk> chunks;
+  gboolean more;
 
-  if (!gst_data_queue_pop (queue_, &item))
+  if (!pop_chunks (chunker, chunks, &more))
     return FALSE;
 
-  _get_tensors_from_buffer (GST_BUFFER (item->object), tensors);
+  _get_tensors_from_chunks (chunks, more, tensors);
 
-  GDestroyNotify destroy = (item->destroy) ? item->destroy : g_free;
-  destroy (item);
+  /* release the buffer once its last chunk is copied */
+  if (!more)
+    chunker.reset ();
 
   return TRUE;
 }
@@ -71,13 +98,15 @@ ServiceImplProtobuf::fill_tensors (Tensors &tensors)
 template <typename T>
 Status ServiceImplProtobuf::_read_tensors (T reader)
 {
+  TensorsAssembler assembler (getTensorsInfo ());
+
   while (1) {
     Tensors tensors;
 
     if (!reader->Read (&tensors))
       break;
 
-    parse_tensors (tensors);
+    parse_tensors (tensors, assembler);
   }
 
   return Status::OK;
@@ -87,11 +116,13 @@ Status ServiceImplProtobuf::_read_tensors (T reader)
 template <typename T>
 Status ServiceImplProtobuf::_write_tensors (T writer)
 {
+  TensorsChunker chunker;
+
   while (1) {
     Tensors tensors;
 
     /* until flushing */
-    if (!fill_tensors (tensors))
+    if (!fill_tensors (tensors, chunker))
       break;
 
     writer->Write (tensors);
@@ -100,36 +131,52 @@ Status ServiceImplProtobuf::_write_tensors (T writer)
   return Status::OK;
 }
 
+/** @brief free the data string of a tensor */
+static void
+_free_tensor_data (gpointer data)
+{
+  delete static_cast<std::string *> (data);
+}
+
 /** @brief convert tensors to buffer */
 void
 ServiceImplProtobuf::_get_buffer_from_tensors (Tensors &tensors,
-    GstBuffer **buffer)
+    TensorsAssembler &assembler)
 {
-  guint num_tensor = tensors.num_tensor ();
-  GstMemory *memory;
-
-  *buffer = gst_buffer_new ();
-
-  for (guint i = 0; i < num_tensor; i++) {
-    const Tensor * tensor = &tensors.tensor (i);
-    const void * data = tensor->data ().c_str ();
+  for (int i = 0; i < tensors.tensor_size (); i++) {
+    Tensor * tensor = tensors.mutable_tensor (i);
     gsize size = tensor->data ().length ();
-    gpointer new_data = _g_memdup (data, size);
-
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
-    gst_buffer_append_memory (*buffer, memory);
+    gsize total = tensor->total_size ();
+
+    if (size == 0) {
+      ml_logw ("Received a tensor without data");
+      assembler.invalidate ();
+    } else if (tensor->offset () > 0 || total > size) {
+      assembler.append ((const guint8 *) tensor->data ().data (), size,
+          tensor->offset (), total);
+    } else {
+      /* take the received data without copy */
+      std::string *data = new std::string ();
+      GstMemory *memory;
+
+      data->swap (*tensor->mutable_data ());
+      memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, &(*data)[0], size,
+          0, size, data, _free_tensor_data);
+      assembler.append (memory);
+    }
   }
 }
 
-/** @brief convert buffer to tensors */
+/**
+ * @brief convert tensor chunks to tensors
+ * @param[in] copy_data FALSE not to set the data of the tensors
+ */
 void
-ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
-    Tensors &tensors)
+ServiceImplProtobuf::_get_tensors_from_chunks (
+    std::vector<TensorChunk> &chunks, gboolean more, Tensors &tensors,
+    gboolean copy_data)
 {
   Tensors::frame_rate *fr;
-  GstMapInfo map;
-  gsize data_ptr = 0;
 
   tensors.set_num_tensor (config_->info.num_tensors);
 
@@ -137,20 +184,12 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
   fr->set_rate_n (config_->rate_n);
   fr->set_rate_d (config_->rate_d);
 
-  if (!gst_buffer_map (buffer, &map, GST_MAP_READ)) {
-    ml_loge ("Unable to map the buffer\n");
-    return;
-  }
+  if (more)
+    tensors.set_more_chunks (true);
 
-  for (guint i = 0; i < config_->info.num_tensors; i++) {
+  for (const TensorChunk &chunk : chunks) {
     nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
-    const GstTensorInfo * info = &config_->info.info[i];
-    gsize tsize = gst_tensor_info_get_size (info);
-
-    if (data_ptr + tsize > map.size) {
-      ml_logw ("Setting invalid tensor data");
-      break;
-    }
+    const GstTensorInfo * info = &config_->info.info[chunk.index];
 
     /* set tensor info */
     tensor->set_name ("Anonymous");
@@ -159,11 +198,68 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
     for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++)
       tensor->add_dimension (info->dimension[j]);
 
-    tensor->set_data (map.data + data_ptr, tsize);
-    data_ptr += tsize;
+    if (copy_data)
+      tensor->set_data (chunk.data, chunk.size);
+
+    /* the receiver reassembles the split tensor */
+    if (chunk.size < chunk.total) {
+      tensor->set_offset (chunk.offset);
+      tensor->set_total_size (chunk.total);
+    }
+  }
+}
+
+/**
+ * @brief serialize the tensor chunks into the protobuf wire format.
+ *        The bytes field of each tensor is appended as a slice referring the tensor memory.
+ */
+gboolean
+ServiceImplProtobuf::encode_chunks (std::vector<TensorChunk> &chunks,
+    gboolean more, ByteBuffer *buffer)
+{
+  std::vector<Slice> slices;
+  std::string frame;
+  Tensors tensors;
+
+  _get_tensors_from_chunks (chunks, more, tensors, FALSE);
+
+  for (int i = 0; i < tensors.tensor_size (); i++) {
+    const TensorChunk &chunk = chunks[i];
+    std::string tensor, prefix;
+    guint32 data_tag = _length_delimited_tag (Tensor::kDataFieldNumber);
+    gsize tensor_size;
+
+    Slice data = tensor_chunk_to_slice (chunk);
+    if (data.size () != chunk.size)
+      return FALSE;
+
+    /* the fields of the tensor except the data */
+    tensors.tensor (i).SerializeToString (&tensor);
+    tensor_size = tensor.size () + CodedOutputStream::VarintSize32 (data_tag) +
+        CodedOutputStream::VarintSize64 (chunk.size) + chunk.size;
+
+    {
+      StringOutputStream string_stream (&prefix);
+      CodedOutputStream coded_stream (&string_stream);
+
+      coded_stream.WriteTag (_length_delimited_tag (Tensors::kTensorFieldNumber));
+      coded_stream.WriteVarint64 (tensor_size);
+      coded_stream.WriteRaw (tensor.data (), tensor.size ());
+      coded_stream.WriteTag (data_tag);
+      coded_stream.WriteVarint64 (chunk.size);
+    }
+
+    slices.push_back (Slice (prefix));
+    slices.push_back (data);
   }
 
-  gst_buffer_unmap (buffer, &map);
+  /* the fields of the frame, the order of fields does not matter when parsing */
+  tensors.clear_tensor ();
+  tensors.SerializeToString (&frame);
+  slices.insert (slices.begin (), Slice (frame));
+
+  *buffer = ByteBuffer (slices.data (), slices.size ());
+  return TRUE;
 }
 
 /** @brief Constructor of SyncServiceImplProtobuf */
@@ -197,6 +293,10 @@ SyncServiceImplProtobuf::start_server (std::string address)
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
 
+  /* the number of completion queues to poll the sync requests */
+  builder.SetSyncServerOption (ServerBuilder::SyncServerOption::NUM_CQS,
+      num_threads_);
+
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
   if (server_instance_.get () == nullptr)
@@ -213,12 +313,20 @@ SyncServiceImplProtobuf::start_client (std::string address)
   std::shared_ptr<Channel> channel = grpc::CreateChannel(
       address, grpc::InsecureChannelCredentials());
 
+  /* send the tensors with the generic stub not to copy the tensor data */
+  if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
+    workers_.emplace_back ([this, channel] {
+      this->write_tensors_zero_copy (channel, _send_tensors_method ());
+    });
+    return TRUE;
+  }
+
   /* connect the server */
   client_stub_ = TensorService::NewStub (channel);
   if (client_stub_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  workers_.emplace_back ([this] { this->_client_thread (); });
 
   return TRUE;
 }
@@ -230,16 +338,8 @@ SyncServiceImplProtobuf::_client_thread ()
   ClientContext context;
   Empty empty;
 
-  if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
-    /* initiate the RPC call */
-    std::unique_ptr< ClientWriter<Tensors> > writer(
-        client_stub_->SendTensors (&context, &empty));
-
-    _write_tensors (writer.get ());
-
-    writer->WritesDone ();
-    writer->Finish ();
-  } else if (direction_ == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
+  /* the tensors are sent by write_tensors_zero_copy () */
+  if (direction_ == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
     Tensors tensors;
 
     /* initiate the RPC call */
@@ -256,15 +356,17 @@ SyncServiceImplProtobuf::_client_thread ()
 
 /** @brief Constructor of AsyncServiceImplProtobuf */
 AsyncServiceImplProtobuf::AsyncServiceImplProtobuf (const grpc_config * config)
-  : ServiceImplProtobuf (config), last_call_ (nullptr)
+  : ServiceImplProtobuf (config)
 {
 }
 
 /** @brief Destructor of AsyncServiceImplProtobuf */
 AsyncServiceImplProtobuf::~AsyncServiceImplProtobuf ()
 {
-  if (last_call_)
-    delete last_call_;
+  for (AsyncCallData *call : last_calls_) {
+    if (call)
+      delete call;
+  }
 }
 
 /** @brief start gRPC server handling protobuf */
@@ -276,15 +378,18 @@ AsyncServiceImplProtobuf::start_server (std::string address)
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
 
-  /* need to manually handle the completion queue */
-  completion_queue_ = builder.AddCompletionQueue ();
+  /* need to manually handle the completion queues, one per thread */
+  for (guint i = 0; i < num_threads_; i++)
+    completion_queues_.push_back (builder.AddCompletionQueue ());
+  last_calls_.assign (num_threads_, nullptr);
 
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
   if (server_instance_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_server_thread (); });
+  for (guint i = 0; i < num_threads_; i++)
+    workers_.emplace_back ([this, i] { this->_server_thread (i); });
 
   return TRUE;
 }
@@ -297,12 +402,20 @@ AsyncServiceImplProtobuf::start_client (std::string address)
   std::shared_ptr<Channel> channel = grpc::CreateChannel(
       address, grpc::InsecureChannelCredentials());
 
+  /* send the tensors with the generic stub not to copy the tensor data */
+  if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
+    workers_.emplace_back ([this, channel] {
+      this->write_tensors_zero_copy (channel, _send_tensors_method ());
+    });
+    return TRUE;
+  }
+
   /* connect the server */
   client_stub_ = TensorService::NewStub (channel);
   if (client_stub_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  workers_.emplace_back ([this] { this->_client_thread (); });
 
   return TRUE;
 }
@@ -311,8 +424,9 @@ AsyncServiceImplProtobuf::start_client (std::string address)
 class AsyncCallDataServer : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataServer */
-    AsyncCallDataServer (AsyncServiceImplProtobuf *service, ServerCompletionQueue *cq)
-      : AsyncCallData (service), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+    AsyncCallDataServer (AsyncServiceImplProtobuf *service, ServerCompletionQueue *cq,
+        guint id)
+      : AsyncCallData (service), cq_ (cq), id_ (id), writer_ (nullptr), reader_ (nullptr)
     {
       RunState ();
     }
@@ -323,7 +437,7 @@ class AsyncCallDataServer : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, assembler_);
           state_ = FINISH;
         } else {
           return;
@@ -342,18 +456,18 @@ class AsyncCallDataServer : public AsyncCallData {
       } else if (state_ == PROCESS) {
         if (count_ == 0) {
           /* spawn a new instance to serve new clients */
-          service_->set_last_call (new AsyncCallDataServer (service_, cq_));
+          service_->set_last_call (id_, new AsyncCallDataServer (service_, cq_, id_));
         }
 
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, assembler_);
           reader_->Read (&rpc_tensors_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
         } else if (writer_.get () != nullptr) {
           Tensors tensors;
-          if (service_->fill_tensors (tensors)) {
+          if (service_->fill_tensors (tensors, chunker_)) {
             writer_->Write (tensors, this);
             count_++;
           } else {
@@ -377,6 +491,7 @@ class AsyncCallDataServer : public AsyncCallData {
 
   private:
     ServerCompletionQueue *cq_;
+    guint id_;
     ServerContext ctx_;
 
     std::unique_ptr<ServerAsyncWriter<Tensors>> writer_;
@@ -389,7 +504,7 @@ class AsyncCallDataClient : public AsyncCallData {
     /** @brief Constructor of AsyncCallDataClient */
     AsyncCallDataClient (AsyncServiceImplProtobuf *service, TensorService::Stub * stub,
         CompletionQueue *cq)
-      : AsyncCallData (service), stub_ (stub), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+      : AsyncCallData (service), stub_ (stub), cq_ (cq), reader_ (nullptr)
     {
       RunState ();
     }
@@ -400,44 +515,27 @@ class AsyncCallDataClient : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_tensors (rpc_tensors_, assembler_);
           state_ = FINISH;
         } else {
           return;
         }
       }
 
+      /* the tensors are sent by write_tensors_zero_copy () */
       if (state_ == CREATE) {
-        if (service_->getDirection () == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
-          reader_ = stub_->AsyncRecvTensors (&ctx_, rpc_empty_, cq_, this);
-        } else {
-          writer_ = stub_->AsyncSendTensors (&ctx_, &rpc_empty_, cq_, this);
-        }
+        reader_ = stub_->AsyncRecvTensors (&ctx_, rpc_empty_, cq_, this);
         state_ = PROCESS;
       } else if (state_ == PROCESS) {
-        if (reader_.get () != nullptr) {
-          if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
-          reader_->Read (&rpc_tensors_, this);
-          /* can't read tensors yet. use the next turn */
-          count_++;
-        } else if (writer_.get () != nullptr) {
-          Tensors tensors;
-          if (service_->fill_tensors (tensors)) {
-            writer_->Write (tensors, this);
-            count_++;
-          } else {
-            writer_->WritesDone (this);
-            state_ = FINISH;
-          }
-        }
+        if (count_ != 0)
+          service_->parse_tensors (rpc_tensors_, assembler_);
+        reader_->Read (&rpc_tensors_, this);
+        /* can't read tensors yet. use the next turn */
+        count_++;
       } else if (state_ == FINISH) {
         Status status;
 
-        if (reader_.get () != nullptr)
-          reader_->Finish (&status, this);
-        if (writer_.get () != nullptr)
-          writer_->Finish (&status, this);
+        reader_->Finish (&status, this);
 
         delete this;
       }
@@ -448,16 +546,17 @@ class AsyncCallDataClient : public AsyncCallData {
     CompletionQueue * cq_;
     ClientContext ctx_;
 
-    std::unique_ptr<ClientAsyncWriter<Tensors>> writer_;
     std::unique_ptr<ClientAsyncReader<Tensors>> reader_;
 };
 
-/** @brief gRPC client thread */
+/** @brief gRPC server thread polling the completion queue of the id */
 void
-AsyncServiceImplProtobuf::_server_thread ()
+AsyncServiceImplProtobuf::_server_thread (guint id)
 {
+  ServerCompletionQueue *completion_queue = completion_queues_[id].get ();
+
   /* spawn a new instance to server new clients */
-  set_last_call (new AsyncCallDataServer (this, completion_queue_.get ()));
+  set_last_call (id, new AsyncCallDataServer (this, completion_queue, id));
 
   while (1) {
     void *tag;
@@ -468,7 +567,7 @@ AsyncServiceImplProtobuf::_server_thread ()
       gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
           gpr_time_from_millis(10, GPR_TIMESPAN));
 
-    switch (completion_queue_->AsyncNext (&tag, &ok, deadline)) {
+    switch (completion_queue->AsyncNext (&tag, &ok, deadline)) {
       case CompletionQueue::GOT_EVENT:
         static_cast<AsyncCallDataServer *>(tag)->RunState(ok);
         break;
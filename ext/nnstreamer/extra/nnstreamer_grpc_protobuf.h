@@ -34,8 +34,8 @@ class ServiceImplProtobuf : public NNStreamerRPC
   public:
     ServiceImplProtobuf (const grpc_config * config);
 
-    void parse_tensors (Tensors &tensors);
-    gboolean fill_tensors (Tensors &tensors);
+    void parse_tensors (Tensors &tensors, TensorsAssembler &assembler);
+    gboolean fill_tensors (Tensors &tensors, TensorsChunker &chunker);
 
   protected:
     template <typename T>
@@ -44,10 +44,16 @@ class ServiceImplProtobuf : public NNStreamerRPC
     template <typename T>
     grpc::Status _read_tensors (T reader);
 
-    void _get_tensors_from_buffer (GstBuffer *buffer, Tensors &tensors);
-    void _get_buffer_from_tensors (Tensors &tensors, GstBuffer **buffer);
+    void _get_tensors_from_chunks (std::vector<TensorChunk> &chunks,
+        gboolean more, Tensors &tensors, gboolean copy_data = TRUE);
+    void _get_buffer_from_tensors (Tensors &tensors,
+        TensorsAssembler &assembler);
 
     std::unique_ptr<nnstreamer::protobuf::TensorService::Stub> client_stub_;
+
+  private:
+    gboolean encode_chunks (std::vector<TensorChunk> &chunks,
+        gboolean more, ByteBuffer *buffer) override;
 };
 
 /**
@@ -84,17 +90,17 @@ class AsyncServiceImplProtobuf final
     AsyncServiceImplProtobuf (const grpc_config * config);
     ~AsyncServiceImplProtobuf ();
 
-    /** @brief set the last call data */
-    void set_last_call (AsyncCallData * call) { last_call_ = call; }
+    /** @brief set the last call data of the completion queue */
+    void set_last_call (guint id, AsyncCallData * call) { last_calls_[id] = call; }
 
   private:
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _server_thread ();
+    void _server_thread (guint id);
     void _client_thread ();
 
-    AsyncCallData * last_call_;
+    std::vector<AsyncCallData *> last_calls_;
 };
 
 /** @brief Internal base class to serve a request */
@@ -102,7 +108,8 @@ class AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallData */
     AsyncCallData (AsyncServiceImplProtobuf *service)
-      : service_ (service), state_ (CREATE), count_ (0)
+      : service_ (service), state_ (CREATE), count_ (0),
+        assembler_ (service->getTensorsInfo ())
     {
     }
 
@@ -121,6 +128,9 @@ class AsyncCallData {
 
     Tensors rpc_tensors_;
     Empty rpc_empty_;
+
+    TensorsChunker chunker_;
+    TensorsAssembler assembler_;
 };
 
 }; // namespace grpc
@@ -84,6 +84,10 @@
  * option5: Input Dimension (WIDTH:HEIGHT)
  *          This is independent from option1
  * option6: Box Style (NYI)
+ * option7: The number of threads to extract the box candidates, default is 1.
+ *          The anchors are partitioned evenly to the threads.
+ *          This is applied to the float32 tensors of mobilenet-ssd, yolov5
+ *          and mp-palm-detection.
  *
  * MAJOR TODO: Support other colorspaces natively from _decode for performance gain
  * (e.g., BGRA, ARGB, ...)
@@ -100,6 +104,7 @@
 #include <stdint.h>
 #include <glib.h>
 #include <gst/gst.h>
+#include <gst/video/video.h>
 #include <math.h>               /* expf */
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api.h>
@@ -129,6 +134,7 @@ extern uint8_t rasters[][13];
 #define MP_PALM_DETECTION_INFO_SIZE             (18)
 #define MP_PALM_DETECTION_MAX_TENSORS           (2U)
 #define MP_PALM_DETECTION_DETECTION_MAX         (2016)
+#define MAX_THREADS                             (16)
 
 /**
  * @todo Fill in the value at build time or hardcode this. It's const value
@@ -245,6 +251,18 @@ typedef struct
 
 } properties_MP_PALM_DETECTION;
 
+/**
+ * @brief Box candidates in structure-of-arrays, extracted from the anchors before computing the box positions.
+ * Each anchor gives one candidate at most, so a partition of the anchors fills the arrays from its first anchor index.
+ */
+typedef struct
+{
+  guint *index; /**< The anchor index of the candidate */
+  gint *class_id; /**< The class index of the candidate */
+  gfloat *score; /**< The score of the candidate (mode-dependent, raw or probability) */
+  guint size; /**< The allocated length of the arrays */
+} bb_candidates;
+
 /**
  * @brief Data structure for bounding box info.
  */
@@ -274,6 +292,17 @@ typedef struct
 
   guint max_detection;
   gboolean flag_use_label;
+
+  GstMemory *empty_frame; /**< Transparent frame to be shared with overlay composition */
+
+  /* From option7 */
+  guint num_threads; /**< The number of threads to extract the box candidates */
+  GThreadPool *pool; /**< Thread pool to extract the box candidates */
+  GMutex lock; /**< Lock to wait for the threads */
+  GCond cond; /**< Condition to wait for the threads */
+  guint pending; /**< The number of tasks not finished yet */
+
+  bb_candidates candidates; /**< Candidate buffer, reused for each frame */
 } bounding_boxes;
 
 /** @brief check the mode is mobilenet-ssd */
@@ -431,6 +460,11 @@ bb_init (void **pdata)
   bdata->i_width = 0;
   bdata->i_height = 0;
   bdata->flag_use_label = FALSE;
+  bdata->num_threads = 1;
+  bdata->pool = NULL;
+  bdata->pending = 0;
+  g_mutex_init (&bdata->lock);
+  g_cond_init (&bdata->cond);
 
   initSingleLineSprite (singleLineSprite, rasters, PIXEL_VALUE);
 
@@ -461,6 +495,19 @@ bb_exit (void **pdata)
     g_free (bdata->label_path);
   _exit_modes (bdata);
 
+  if (bdata->empty_frame)
+    gst_memory_unref (bdata->empty_frame);
+
+  if (bdata->pool)
+    g_thread_pool_free (bdata->pool, FALSE, TRUE);
+
+  g_free (bdata->candidates.index);
+  g_free (bdata->candidates.class_id);
+  g_free (bdata->candidates.score);
+
+  g_mutex_clear (&bdata->lock);
+  g_cond_clear (&bdata->cond);
+
   g_free (*pdata);
   *pdata = NULL;
 }
@@ -845,6 +892,23 @@ bb_setOption (void **pdata, int opNum, const char *param)
     bdata->i_width = dim[0];
     bdata->i_height = dim[1];
     return TRUE;
+  } else if (opNum == 6) {
+    /* option7 = the number of threads to extract the box candidates */
+    guint64 num_threads = g_ascii_strtoull (param, NULL, 10);
+
+    if (num_threads == 0 || num_threads > MAX_THREADS) {
+      GST_ERROR ("The number of threads at option7 should be 1 ~ %d",
+          MAX_THREADS);
+      return FALSE;
+    }
+
+    if (bdata->pool && bdata->num_threads != (guint) num_threads) {
+      g_thread_pool_free (bdata->pool, FALSE, TRUE);
+      bdata->pool = NULL;
+    }
+
+    bdata->num_threads = (guint) num_threads;
+    return TRUE;
   }
   /**
    * @todo Accept color / border-width / ... with option-2
@@ -1092,15 +1156,16 @@ static size_t
 bb_getTransformSize (void **pdata, const GstTensorsConfig * config,
     GstCaps * caps, size_t size, GstCaps * othercaps, GstPadDirection direction)
 {
-  UNUSED (pdata);
+  bounding_boxes *bdata = *pdata;
   UNUSED (config);
   UNUSED (caps);
   UNUSED (size);
   UNUSED (othercaps);
-  UNUSED (direction);
 
-  return 0;
-  /** @todo Use appropriate values */
+  if (direction == GST_PAD_SINK)
+    return (size_t) bdata->width * bdata->height * 4; /* RGBA */
+  else
+    return 0; /** @todo NYI */
 }
 
 /** @brief Represents a detect object */
@@ -1259,13 +1324,13 @@ nms (GArray * results, gfloat threshold)
   }
 
   i = 0;
-  do {
+  while (i < results->len) {
     detectedObject *a = &g_array_index (results, detectedObject, i);
     if (a->valid == FALSE)
       g_array_remove_index (results, i);
     else
       i++;
-  } while (i < results->len);
+  }
 
 }
 
@@ -1389,7 +1454,6 @@ nms (GArray * results, gfloat threshold)
     guint i_height_ = bb->i_height; \
     int num_ = bb->max_detection; \
     size_t boxbpi_ = config->info.info[0].dimension[0]; \
-    results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), num_); \
     for (d_ = 0; d_ < num_; d_++) { \
       gfloat y_center, x_center, h, w; \
       gfloat ymin, xmin; \
@@ -1429,6 +1493,455 @@ nms (GArray * results, gfloat threshold)
 #define _get_objects_mp_palm_detection_(type, typename) \
   _get_objects_mp_palm_detection (bdata, data, type, typename, (detections->data), (boxes->data), config, results)
 
+/**
+ * @brief A partition of the anchors to extract the box candidates.
+ */
+typedef struct
+{
+  bounding_boxes *bdata; /**< The bounding-box internal data */
+  const float *scores; /**< The float32 tensor with the scores of the anchors */
+  guint stride; /**< The number of elements per anchor in scores */
+  gfloat threshold; /**< The mode-dependent threshold of the scores */
+  guint start; /**< The first anchor index of the partition */
+  guint end; /**< The anchor index after the last one of the partition */
+  guint len; /**< The number of candidates found in the partition */
+} bb_extract_task;
+
+/** @brief Get the max value of the scores. Written as a plain reduction to be vectorized. */
+static inline float
+_get_max_score (const float *score, guint num)
+{
+  float max_score = -INFINITY;
+  guint i;
+
+  for (i = 0; i < num; i++)
+    max_score = (score[i] > max_score) ? score[i] : max_score;
+
+  return max_score;
+}
+
+/**
+ * @brief Extract the candidates of yolov5 (objectness at 4, class confidences from 5).
+ * Class confidences are not larger than 1, so the box is rejected with objectness before scanning the classes.
+ */
+static guint
+_yolov5_extract_candidates (const bb_extract_task * task, guint * index,
+    gint * class_id, gfloat * score)
+{
+  const guint num_classes = task->stride - YOLOV5_DETECTION_NUM_INFO;
+  const float *box = task->scores + (gsize) task->start * task->stride;
+  guint b, c, n = 0;
+
+  for (b = task->start; b < task->end; b++, box += task->stride) {
+    const float objectness = box[4];
+    const float *cls = box + YOLOV5_DETECTION_NUM_INFO;
+    float max_conf;
+
+    if (objectness <= YOLOV5_DETECTION_CONF_THRESHOLD)
+      continue;
+
+    max_conf = _get_max_score (cls, num_classes);
+    if (!(max_conf * objectness > YOLOV5_DETECTION_CONF_THRESHOLD))
+      continue;
+
+    for (c = 0; cls[c] != max_conf; c++);
+
+    index[n] = b;
+    class_id[n] = (gint) c;
+    score[n] = max_conf * objectness;
+    n++;
+  }
+
+  return n;
+}
+
+/**
+ * @brief Extract the candidates of mobilenet-ssd (class 0 is background).
+ * The first class over the threshold (in logit) is the candidate, same as _get_object_i_mobilenet_ssd.
+ */
+static guint
+_mobilenet_ssd_extract_candidates (const bb_extract_task * task,
+    guint * index, gint * class_id, gfloat * score)
+{
+  const float *det = task->scores + (gsize) task->start * task->stride;
+  guint d, c, n = 0;
+
+  if (task->stride < 2)
+    return 0;
+
+  for (d = task->start; d < task->end; d++, det += task->stride) {
+    if (_get_max_score (det + 1, task->stride - 1) < task->threshold)
+      continue;
+
+    for (c = 1; c < task->stride && !(det[c] >= task->threshold); c++);
+    if (c == task->stride)
+      continue;
+
+    index[n] = d;
+    class_id[n] = (gint) c;
+    score[n] = det[c];
+    n++;
+  }
+
+  return n;
+}
+
+/**
+ * @brief Extract the candidates of mp-palm-detection.
+ * The score is compared in logit, the sigmoid is applied to the candidates only.
+ */
+static guint
+_mp_palm_detection_extract_candidates (const bb_extract_task * task,
+    guint * index, gint * class_id, gfloat * score)
+{
+  guint d, n = 0;
+
+  for (d = task->start; d < task->end; d++) {
+    gfloat s = task->scores[(gsize) d * task->stride];
+
+    s = MAX (s, -100.0f);
+    s = MIN (s, 100.0f);
+    if (s < task->threshold)
+      continue;
+
+    index[n] = d;
+    class_id[n] = 0;
+    score[n] = s;
+    n++;
+  }
+
+  return n;
+}
+
+/** @brief Extract the candidates of the partitioned anchors */
+static void
+_extract_candidates_range (bb_extract_task * task)
+{
+  bounding_boxes *bdata = task->bdata;
+  guint *index = bdata->candidates.index + task->start;
+  gint *class_id = bdata->candidates.class_id + task->start;
+  gfloat *score = bdata->candidates.score + task->start;
+
+  if (bdata->mode == YOLOV5_BOUNDING_BOX)
+    task->len = _yolov5_extract_candidates (task, index, class_id, score);
+  else if (_check_mode_is_mobilenet_ssd (bdata->mode))
+    task->len = _mobilenet_ssd_extract_candidates (task, index, class_id,
+        score);
+  else if (_check_mode_is_mp_palm_detection (bdata->mode))
+    task->len = _mp_palm_detection_extract_candidates (task, index, class_id,
+        score);
+  else
+    task->len = 0;
+}
+
+/** @brief Thread pool function to extract the candidates of the partitioned anchors */
+static void
+_extract_candidates_thread (gpointer data, gpointer user_data)
+{
+  bb_extract_task *task = (bb_extract_task *) data;
+  bounding_boxes *bdata = (bounding_boxes *) user_data;
+
+  _extract_candidates_range (task);
+
+  g_mutex_lock (&bdata->lock);
+  if (--bdata->pending == 0)
+    g_cond_signal (&bdata->cond);
+  g_mutex_unlock (&bdata->lock);
+}
+
+/**
+ * @brief Extract the box candidates from the float32 scores.
+ * The anchors are partitioned to the threads if num_threads is larger than 1.
+ * The candidates of each task are stored in bdata->candidates from its start index, in anchor order.
+ * @param[in] bdata The bounding-box internal data.
+ * @param[in] scores The float32 tensor with the scores of the anchors.
+ * @param[in] stride The number of elements per anchor in scores.
+ * @param[in] threshold The mode-dependent threshold.
+ * @param[in] num_anchors The number of anchors.
+ * @param[out] tasks The partitions with the number of candidates.
+ * @return The number of tasks, 0 if failed.
+ */
+static guint
+_extract_candidates (bounding_boxes * bdata, const float *scores,
+    guint stride, gfloat threshold, guint num_anchors,
+    bb_extract_task tasks[MAX_THREADS])
+{
+  bb_candidates *cand = &bdata->candidates;
+  guint num_tasks, anchors, i;
+
+  num_tasks = MIN (bdata->num_threads, num_anchors);
+  if (num_tasks == 0)
+    return 0;
+
+  if (cand->size < num_anchors) {
+    cand->index = g_renew (guint, cand->index, num_anchors);
+    cand->class_id = g_renew (gint, cand->class_id, num_anchors);
+    cand->score = g_renew (gfloat, cand->score, num_anchors);
+    cand->size = num_anchors;
+  }
+
+  if (num_tasks > 1 && bdata->pool == NULL) {
+    bdata->pool = g_thread_pool_new (_extract_candidates_thread, bdata,
+        bdata->num_threads - 1, TRUE, NULL);
+    if (bdata->pool == NULL) {
+      GST_WARNING ("Failed to create thread pool, extract boxes in a thread.");
+      num_tasks = 1;
+    }
+  }
+
+  anchors = (num_anchors + num_tasks - 1) / num_tasks;
+
+  for (i = 0; i < num_tasks; i++) {
+    tasks[i].bdata = bdata;
+    tasks[i].scores = scores;
+    tasks[i].stride = stride;
+    tasks[i].threshold = threshold;
+    tasks[i].start = MIN (i * anchors, num_anchors);
+    tasks[i].end = MIN ((i + 1) * anchors, num_anchors);
+    tasks[i].len = 0;
+  }
+
+  if (num_tasks == 1) {
+    _extract_candidates_range (&tasks[0]);
+    return 1;
+  }
+
+  /* run the last partition in this thread */
+  bdata->pending = num_tasks - 1;
+  for (i = 0; i < num_tasks - 1; i++)
+    g_thread_pool_push (bdata->pool, &tasks[i], NULL);
+
+  _extract_candidates_range (&tasks[num_tasks - 1]);
+
+  g_mutex_lock (&bdata->lock);
+  while (bdata->pending > 0)
+    g_cond_wait (&bdata->cond, &bdata->lock);
+  g_mutex_unlock (&bdata->lock);
+
+  return num_tasks;
+}
+
+/**
+ * @brief Get the box of the mobilenet-ssd candidate.
+ * @param[in] bdata The bounding-box internal data.
+ * @param[in] d The anchor index.
+ * @param[in] boxinputptr The box of the anchor.
+ * @param[out] object The detected object.
+ */
+static void
+_mobilenet_ssd_get_object (bounding_boxes * bdata, guint d,
+    const float *boxinputptr, detectedObject * object)
+{
+  properties_MOBILENET_SSD *data = &bdata->mobilenet_ssd;
+  float y_scale = data->params[MOBILENET_SSD_PARAMS_Y_SCALE_IDX];
+  float x_scale = data->params[MOBILENET_SSD_PARAMS_X_SCALE_IDX];
+  float h_scale = data->params[MOBILENET_SSD_PARAMS_H_SCALE_IDX];
+  float w_scale = data->params[MOBILENET_SSD_PARAMS_W_SCALE_IDX];
+  float ycenter = boxinputptr[0] / y_scale * data->box_priors[2][d] +
+      data->box_priors[0][d];
+  float xcenter = boxinputptr[1] / x_scale * data->box_priors[3][d] +
+      data->box_priors[1][d];
+  float h = (float) expf (boxinputptr[2] / h_scale) * data->box_priors[2][d];
+  float w = (float) expf (boxinputptr[3] / w_scale) * data->box_priors[3][d];
+  float ymin = ycenter - h / 2.f;
+  float xmin = xcenter - w / 2.f;
+  int x = xmin * bdata->i_width;
+  int y = ymin * bdata->i_height;
+
+  object->x = MAX (0, x);
+  object->y = MAX (0, y);
+  object->width = w * bdata->i_width;
+  object->height = h * bdata->i_height;
+  object->prob = _expit (object->prob);
+}
+
+/**
+ * @brief Get the box of the yolov5 candidate.
+ * @param[in] bdata The bounding-box internal data.
+ * @param[in] box The box of the anchor (cx, cy, w, h).
+ * @param[out] object The detected object.
+ */
+static void
+_yolov5_get_object (bounding_boxes * bdata, const float *box,
+    detectedObject * object)
+{
+  float cx, cy, w, h;
+
+  cx = box[0] * (float) bdata->i_width;
+  cy = box[1] * (float) bdata->i_height;
+  w = box[2] * (float) bdata->i_width;
+  h = box[3] * (float) bdata->i_height;
+
+  object->x = (int) (MAX (0.f, (cx - w / 2.f)));
+  object->y = (int) (MAX (0.f, (cy - h / 2.f)));
+  object->width = (int) (MIN ((float) bdata->i_width, w));
+  object->height = (int) (MIN ((float) bdata->i_height, h));
+}
+
+/**
+ * @brief Get the box of the mp-palm-detection candidate.
+ * @param[in] bdata The bounding-box internal data.
+ * @param[in] d The anchor index.
+ * @param[in] box The box of the anchor.
+ * @param[out] object The detected object.
+ */
+static void
+_mp_palm_detection_get_object (bounding_boxes * bdata, guint d,
+    const float *box, detectedObject * object)
+{
+  properties_MP_PALM_DETECTION *data = &bdata->mp_palm_detection;
+  anchor *a = &g_array_index (data->anchors, anchor, d);
+  gfloat y_center, x_center, h, w;
+  int x, y;
+
+  y_center = box[0] / bdata->i_height * a->h + a->y_center;
+  x_center = box[1] / bdata->i_width * a->w + a->x_center;
+  h = box[2] / bdata->i_height * a->h;
+  w = box[3] / bdata->i_width * a->w;
+  y = (y_center - h / 2.f) * bdata->i_height;
+  x = (x_center - w / 2.f) * bdata->i_width;
+
+  object->x = MAX (0, x);
+  object->y = MAX (0, y);
+  object->width = w * bdata->i_width;
+  object->height = h * bdata->i_height;
+  object->prob = 1.0f / (1.0f + exp (-object->prob));
+}
+
+/**
+ * @brief Get the detected objects from the float32 tensors of the box candidates.
+ * @param[in] bdata The bounding-box internal data.
+ * @param[in] scores The float32 tensor with the scores of the anchors.
+ * @param[in] stride The number of elements per anchor in scores.
+ * @param[in] threshold The mode-dependent threshold.
+ * @param[in] num_anchors The number of anchors.
+ * @param[in] boxes The float32 tensor with the boxes of the anchors.
+ * @param[in] boxbpi The number of elements per anchor in boxes.
+ * @param[out] results The detected objects appended (GArray with detectedObject)
+ */
+static void
+_get_objects_from_candidates (bounding_boxes * bdata, const float *scores,
+    guint stride, gfloat threshold, guint num_anchors, const float *boxes,
+    guint boxbpi, GArray * results)
+{
+  bb_extract_task tasks[MAX_THREADS];
+  bb_candidates *cand = &bdata->candidates;
+  guint num_tasks, i, n;
+
+  num_tasks = _extract_candidates (bdata, scores, stride, threshold,
+      num_anchors, tasks);
+
+  for (i = 0; i < num_tasks; i++) {
+    for (n = tasks[i].start; n < tasks[i].start + tasks[i].len; n++) {
+      const guint d = cand->index[n];
+      const float *box = boxes + (gsize) d * boxbpi;
+      detectedObject object;
+
+      object.valid = TRUE;
+      object.class_id = cand->class_id[n];
+      object.prob = cand->score[n];
+
+      if (bdata->mode == YOLOV5_BOUNDING_BOX)
+        _yolov5_get_object (bdata, box, &object);
+      else if (_check_mode_is_mobilenet_ssd (bdata->mode))
+        _mobilenet_ssd_get_object (bdata, d, box, &object);
+      else
+        _mp_palm_detection_get_object (bdata, d, box, &object);
+
+      g_array_append_val (results, object);
+    }
+  }
+}
+
+/**
+ * @brief Get the label and the position of the box on the output surface.
+ * @return The label to be drawn, NULL if the object is not valid or the label is not used.
+ */
+static const char *
+_get_box_position (bounding_boxes * bdata, detectedObject * a, int *x1,
+    int *y1, int *x2, int *y2, gboolean * valid)
+{
+  *valid = FALSE;
+
+  if ((bdata->flag_use_label) &&
+      ((a->class_id < 0 ||
+              a->class_id >= (int) bdata->labeldata.total_labels))) {
+    /** @todo make it "logw_once" after we get logw_once API. */
+    ml_logw ("Invalid class found with tensordec-boundingbox.c.\n");
+    return NULL;
+  }
+
+  *x1 = (bdata->width * a->x) / bdata->i_width;
+  *x2 = MIN (bdata->width - 1,
+      (bdata->width * (a->x + a->width)) / bdata->i_width);
+  *y1 = (bdata->height * a->y) / bdata->i_height;
+  *y2 = MIN (bdata->height - 1,
+      (bdata->height * (a->y + a->height)) / bdata->i_height);
+  *valid = TRUE;
+
+  return (bdata->flag_use_label) ? bdata->labeldata.labels[a->class_id] : NULL;
+}
+
+/**
+ * @brief Draw a box and its label on the surface.
+ * @param[out] frame The surface to be drawn (RGBA plain)
+ * @param[in] width The width of the surface
+ * @param[in] x1,y1,x2,y2 The box position on the surface
+ * @param[in] label_y The vertical position of the label on the surface
+ * @param[in] label The label of the box (nullable)
+ */
+static void
+draw_object (uint32_t * frame, int width, int x1, int y1, int x2, int y2,
+    int label_y, const char *label)
+{
+  int j;
+  uint32_t *pos1, *pos2;
+
+  /* 1. Draw Boxes */
+  /* 1-1. Horizontal */
+  pos1 = &frame[y1 * width + x1];
+  pos2 = &frame[y2 * width + x1];
+  for (j = x1; j <= x2; j++) {
+    *pos1 = PIXEL_VALUE;
+    *pos2 = PIXEL_VALUE;
+    pos1++;
+    pos2++;
+  }
+
+  /* 1-2. Vertical */
+  pos1 = &frame[(y1 + 1) * width + x1];
+  pos2 = &frame[(y1 + 1) * width + x2];
+  for (j = y1 + 1; j < y2; j++) {
+    *pos1 = PIXEL_VALUE;
+    *pos2 = PIXEL_VALUE;
+    pos1 += width;
+    pos2 += width;
+  }
+
+  /* 2. Write Labels */
+  if (label) {
+    int label_len = strlen (label);
+
+    pos1 = &frame[label_y * width + x1];
+    for (j = 0; j < label_len; j++) {
+      unsigned int char_index = label[j];
+      if ((x1 + 8) > width)
+        break;                  /* Stop drawing if it may overfill */
+      pos2 = pos1;
+      for (y2 = 0; y2 < 13; y2++) {
+        /* 13 : character height */
+        for (x2 = 0; x2 < 8; x2++) {
+          /* 8: character width */
+          *(pos2 + x2) = singleLineSprite[char_index][y2][x2];
+        }
+        pos2 += width;
+      }
+      x1 += 9;
+      pos1 += 9;                /* charater width + 1px */
+    }
+  }
+}
+
 /**
  * @brief Draw with the given results (objects[MOBILENET_SSD_DETECTION_MAX]) to the output buffer
  * @param[out] out_info The output buffer (RGBA plain)
@@ -1443,113 +1956,105 @@ draw (GstMapInfo * out_info, bounding_boxes * bdata, GArray * results)
 
   for (i = 0; i < results->len; i++) {
     int x1, x2, y1, y2;         /* Box positions on the output surface */
-    int j;
-    uint32_t *pos1, *pos2;
     const char *label;
-    int label_len;
+    gboolean valid;
     detectedObject *a = &g_array_index (results, detectedObject, i);
 
+    label = _get_box_position (bdata, a, &x1, &y1, &x2, &y2, &valid);
+    if (!valid)
+      continue;
+
+    draw_object (frame, bdata->width, x1, y1, x2, y2, MAX (0, (y1 - 14)),
+        label);
+  }
+}
+
+/**
+ * @brief Make the overlay rectangles with the given results instead of drawing the whole frame.
+ * Each box and its label is drawn on a small surface (ARGB in native endian) to be blended by downstream.
+ * @param[in] bdata The bounding-box internal data.
+ * @param[in] results The final results to be drawn.
+ * @return The overlay composition, NULL if there is no box. Caller should unref the returned value.
+ */
+static GstVideoOverlayComposition *
+draw_overlay (bounding_boxes * bdata, GArray * results)
+{
+  GstVideoOverlayComposition *comp = NULL;
+  unsigned int i;
+
+  for (i = 0; i < results->len; i++) {
+    int x1, x2, y1, y2, label_y, w, h;
+    const char *label;
+    gboolean valid;
+    GstBuffer *surface;
+    GstMapInfo map;
+    GstVideoOverlayRectangle *rect;
+    uint32_t *pixel, *end;
+    detectedObject *a = &g_array_index (results, detectedObject, i);
 
-    if ((bdata->flag_use_label) &&
-        ((a->class_id < 0 ||
-                a->class_id >= (int) bdata->labeldata.total_labels))) {
-      /** @todo make it "logw_once" after we get logw_once API. */
-      ml_logw ("Invalid class found with tensordec-boundingbox.c.\n");
+    label = _get_box_position (bdata, a, &x1, &y1, &x2, &y2, &valid);
+    if (!valid || x2 < x1 || y2 < y1)
       continue;
+
+    /* The surface covers the box and the label above it. */
+    label_y = (label) ? MAX (0, (y1 - 14)) : y1;
+    w = x2 - x1 + 1;
+    h = y2 - label_y + 1;
+    if (label) {
+      w = MIN (MAX (w, (int) strlen (label) * 9), (int) bdata->width - x1);
+      h = MAX (h, 13);
     }
 
-    /* 1. Draw Boxes */
-    x1 = (bdata->width * a->x) / bdata->i_width;
-    x2 = MIN (bdata->width - 1,
-        (bdata->width * (a->x + a->width)) / bdata->i_width);
-    y1 = (bdata->height * a->y) / bdata->i_height;
-    y2 = MIN (bdata->height - 1,
-        (bdata->height * (a->y + a->height)) / bdata->i_height);
-
-    /* 1-1. Horizontal */
-    pos1 = &frame[y1 * bdata->width + x1];
-    pos2 = &frame[y2 * bdata->width + x1];
-    for (j = x1; j <= x2; j++) {
-      *pos1 = PIXEL_VALUE;
-      *pos2 = PIXEL_VALUE;
-      pos1++;
-      pos2++;
+    surface = gst_buffer_new_allocate (NULL, (gsize) w * h * 4, NULL);
+    if (!surface || !gst_buffer_map (surface, &map, GST_MAP_WRITE)) {
+      ml_loge ("Cannot map the overlay surface / tensordec-bounding_boxes.\n");
+      if (surface)
+        gst_buffer_unref (surface);
+      continue;
     }
 
-    /* 1-2. Vertical */
-    pos1 = &frame[(y1 + 1) * bdata->width + x1];
-    pos2 = &frame[(y1 + 1) * bdata->width + x2];
-    for (j = y1 + 1; j < y2; j++) {
-      *pos1 = PIXEL_VALUE;
-      *pos2 = PIXEL_VALUE;
-      pos1 += bdata->width;
-      pos2 += bdata->width;
+    memset (map.data, 0, map.size);
+    draw_object ((uint32_t *) map.data, w, 0, y1 - label_y, x2 - x1,
+        y2 - label_y, 0, label);
+
+    /* RGBA (byte order) to the overlay format (native-endian ARGB) */
+    end = (uint32_t *) (map.data + map.size);
+    for (pixel = (uint32_t *) map.data; pixel < end; pixel++) {
+      guint8 *c = (guint8 *) pixel;
+      *pixel = GST_READ_UINT32_BE (c) >> 8 | ((uint32_t) c[3] << 24);
     }
+    gst_buffer_unmap (surface, &map);
 
-    /* 2. Write Labels */
-    if (bdata->flag_use_label) {
-      label = bdata->labeldata.labels[a->class_id];
-      label_len = strlen (label);
-      /* x1 is the same: x1 = MAX (0, (bdata->width * a->x) / bdata->i_width); */
-      y1 = MAX (0, (y1 - 14));
-      pos1 = &frame[y1 * bdata->width + x1];
-      for (j = 0; j < label_len; j++) {
-        unsigned int char_index = label[j];
-        if ((x1 + 8) > (int) bdata->width)
-          break;                /* Stop drawing if it may overfill */
-        pos2 = pos1;
-        for (y2 = 0; y2 < 13; y2++) {
-          /* 13 : character height */
-          for (x2 = 0; x2 < 8; x2++) {
-            /* 8: character width */
-            *(pos2 + x2) = singleLineSprite[char_index][y2][x2];
-          }
-          pos2 += bdata->width;
-        }
-        x1 += 9;
-        pos1 += 9;              /* charater width + 1px */
-      }
+    gst_buffer_add_video_meta (surface, GST_VIDEO_FRAME_FLAG_NONE,
+        GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, w, h);
+    rect = gst_video_overlay_rectangle_new_raw (surface, x1, label_y, w, h,
+        GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+    gst_buffer_unref (surface);
+
+    if (comp == NULL) {
+      comp = gst_video_overlay_composition_new (rect);
+    } else {
+      gst_video_overlay_composition_add_rectangle (comp, rect);
     }
+    gst_video_overlay_rectangle_unref (rect);
   }
+
+  return comp;
 }
 
-/** @brief tensordec-plugin's GstTensorDecoderDef callback */
-static GstFlowReturn
-bb_decode (void **pdata, const GstTensorsConfig * config,
-    const GstTensorMemory * input, GstBuffer * outbuf)
+/**
+ * @brief Get the detected objects from the input tensors.
+ * @param[in] bdata The bounding-box internal data.
+ * @param[in] config The structure of input tensor info.
+ * @param[in] input The array of input tensor data.
+ * @return The detected objects (GArray with detectedObject), NULL if failed. Caller should free the array.
+ */
+static GArray *
+_get_results (bounding_boxes * bdata, const GstTensorsConfig * config,
+    const GstTensorMemory * input)
 {
-  bounding_boxes *bdata = *pdata;
-  const size_t size = (size_t) bdata->width * bdata->height * 4; /* RGBA */
-  GstMapInfo out_info;
-  GstMemory *out_mem;
   GArray *results = NULL;
   const guint num_tensors = config->info.num_tensors;
-  gboolean need_output_alloc;
-
-  g_assert (outbuf);
-  need_output_alloc = gst_buffer_get_size (outbuf) == 0;
-
-  if (_check_label_props (bdata))
-    bdata->flag_use_label = TRUE;
-  else
-    bdata->flag_use_label = FALSE;
-
-  /* Ensure we have outbuf properly allocated */
-  if (need_output_alloc) {
-    out_mem = gst_allocator_alloc (NULL, size, NULL);
-  } else {
-    if (gst_buffer_get_size (outbuf) < size) {
-      gst_buffer_set_size (outbuf, size);
-    }
-    out_mem = gst_buffer_get_all_memory (outbuf);
-  }
-  if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
-    ml_loge ("Cannot map output memory / tensordec-bounding_boxes.\n");
-    goto error_free;
-  }
-
-  /** reset the buffer with alpha 0 / black */
-  memset (out_info.data, 0, size);
 
   if (_check_mode_is_mobilenet_ssd (bdata->mode)) {
     const GstTensorMemory *boxes, *detections = NULL;
@@ -1568,6 +2073,17 @@ bb_decode (void **pdata, const GstTensorsConfig * config,
     if (num_tensors >= MOBILENET_SSD_MAX_TENSORS) /* lgtm[cpp/constant-comparison] */
       detections = &input[1];
 
+    if (config->info.info[0].type == _NNS_FLOAT32) {
+      guint num = MIN (MOBILENET_SSD_DETECTION_MAX, bdata->max_detection);
+
+      _get_objects_from_candidates (bdata, (const float *) detections->data,
+          config->info.info[1].dimension[0], data->sigmoid_threshold, num,
+          (const float *) boxes->data, config->info.info[0].dimension[0],
+          results);
+      nms (results, data->params[MOBILENET_SSD_PARAMS_IOU_THRESHOLD_IDX]);
+      return results;
+    }
+
     switch (config->info.info[0].type) {
         _get_objects_mobilenet_ssd_ (uint8_t, _NNS_UINT8);
         _get_objects_mobilenet_ssd_ (int8_t, _NNS_INT8);
@@ -1643,51 +2159,21 @@ bb_decode (void **pdata, const GstTensorsConfig * config,
         g_assert (0);
     }
   } else if (bdata->mode == YOLOV5_BOUNDING_BOX) {
-    int bIdx, numTotalBox;
-    int cIdx, numTotalClass, cStartIdx, cIdxMax;
-    float *boxinput;
+    guint numTotalBox, cIdxMax;
+    const float *boxinput;
 
     numTotalBox = bdata->max_detection;
-    numTotalClass = bdata->labeldata.total_labels;
-    cStartIdx = YOLOV5_DETECTION_NUM_INFO;
-    cIdxMax = numTotalClass + cStartIdx;
+    cIdxMax = bdata->labeldata.total_labels + YOLOV5_DETECTION_NUM_INFO;
 
-    boxinput = (float *) input[0].data; // boxinput[1][1][numTotalBox][cIdxMax]
+    boxinput = (const float *) input[0].data; // boxinput[1][1][numTotalBox][cIdxMax]
 
     /** Only support for float type model */
     g_assert (config->info.info[0].type == _NNS_FLOAT32);
 
-    results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), numTotalBox);
-    for (bIdx = 0; bIdx < numTotalBox; ++bIdx) {
-      float maxClassConfVal = -INFINITY;
-      int maxClassIdx = -1;
-      for (cIdx = cStartIdx; cIdx < cIdxMax; ++cIdx) {
-        if (boxinput[bIdx * cIdxMax + cIdx] > maxClassConfVal) {
-          maxClassConfVal = boxinput[bIdx * cIdxMax + cIdx];
-          maxClassIdx = cIdx;
-        }
-      }
-
-      if (maxClassConfVal * boxinput[bIdx * cIdxMax + 4] >
-          YOLOV5_DETECTION_CONF_THRESHOLD) {
-        detectedObject object;
-        float cx, cy, w, h;
-        cx = boxinput[bIdx * cIdxMax + 0] * (float) bdata->i_width;
-        cy = boxinput[bIdx * cIdxMax + 1] * (float) bdata->i_height;
-        w = boxinput[bIdx * cIdxMax + 2] * (float) bdata->i_width;
-        h = boxinput[bIdx * cIdxMax + 3] * (float) bdata->i_height;
-
-        object.x = (int) (MAX (0.f, (cx - w / 2.f)));
-        object.y = (int) (MAX (0.f, (cy - h / 2.f)));
-        object.width = (int) (MIN ((float) bdata->i_width, w));
-        object.height = (int) (MIN ((float) bdata->i_height, h));
-
-        object.prob = maxClassConfVal * boxinput[bIdx * cIdxMax + 4];
-        object.class_id = maxClassIdx - YOLOV5_DETECTION_NUM_INFO;
-        object.valid = TRUE;
-        g_array_append_val (results, object);
-      }
-    }
+    results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), 100);
+    _get_objects_from_candidates (bdata, boxinput, cIdxMax,
+        YOLOV5_DETECTION_CONF_THRESHOLD, numTotalBox, boxinput, cIdxMax,
+        results);
 
     nms (results, YOLOV5_DETECTION_IOU_THRESHOLD);
   } else if (bdata->mode == MP_PALM_DETECTION_BOUNDING_BOX) {
@@ -1702,6 +2188,15 @@ bb_decode (void **pdata, const GstTensorsConfig * config,
     boxes = &input[0];
     detections = &input[1];
 
+    if (config->info.info[0].type == _NNS_FLOAT32) {
+      _get_objects_from_candidates (bdata, (const float *) detections->data, 1,
+          logit (data->min_score_threshold), bdata->max_detection,
+          (const float *) boxes->data, config->info.info[0].dimension[0],
+          results);
+      nms (results, 0.05f);
+      return results;
+    }
+
     switch (config->info.info[0].type) {
       _get_objects_mp_palm_detection_ (uint8_t, _NNS_UINT8);
       _get_objects_mp_palm_detection_ (int8_t, _NNS_INT8);
@@ -1720,9 +2215,53 @@ bb_decode (void **pdata, const GstTensorsConfig * config,
     nms (results, 0.05f);
   } else {
     GST_ERROR ("Failed to get output buffer, unknown mode %d.", bdata->mode);
-    goto error_unmap;
   }
 
+
+  return results;
+}
+
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstFlowReturn
+bb_decode (void **pdata, const GstTensorsConfig * config,
+    const GstTensorMemory * input, GstBuffer * outbuf)
+{
+  bounding_boxes *bdata = *pdata;
+  const size_t size = (size_t) bdata->width * bdata->height * 4; /* RGBA */
+  GstMapInfo out_info;
+  GstMemory *out_mem;
+  GArray *results = NULL;
+  gboolean need_output_alloc;
+
+  g_assert (outbuf);
+  need_output_alloc = gst_buffer_get_size (outbuf) == 0;
+
+  if (_check_label_props (bdata))
+    bdata->flag_use_label = TRUE;
+  else
+    bdata->flag_use_label = FALSE;
+
+  /* Ensure we have outbuf properly allocated */
+  if (need_output_alloc) {
+    out_mem = gst_allocator_alloc (NULL, size, NULL);
+  } else {
+    if (gst_buffer_get_size (outbuf) < size) {
+      gst_buffer_set_size (outbuf, size);
+    }
+    out_mem = gst_buffer_get_all_memory (outbuf);
+  }
+  if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
+    ml_loge ("Cannot map output memory / tensordec-bounding_boxes.\n");
+    goto error_free;
+  }
+
+  /** reset the buffer with alpha 0 / black */
+  memset (out_info.data, 0, size);
+
+  results = _get_results (bdata, config, input);
+  if (results == NULL)
+    goto error_unmap;
+
   draw (&out_info, bdata, results);
   g_array_free (results, TRUE);
 
@@ -1743,6 +2282,69 @@ error_free:
   return GST_FLOW_ERROR;
 }
 
+/**
+ * @brief tensordec-plugin's GstTensorDecoderDef callback
+ *
+ * If downstream blends the overlay composition, emit the boxes as overlay rectangles
+ * on a shared transparent frame instead of clearing and drawing the whole frame.
+ */
+static GstFlowReturn
+bb_decodeBuffer (void **pdata, const GstTensorsConfig * config,
+    const GstTensorMemory * input, const GstTensorDecoderContext * context,
+    GstBuffer * outbuf)
+{
+  bounding_boxes *bdata = *pdata;
+  const size_t size = (size_t) bdata->width * bdata->height * 4; /* RGBA */
+  GstVideoOverlayComposition *comp;
+  GArray *results;
+
+  g_assert (outbuf);
+
+  /* Render the frame into the buffer from the pool. */
+  if (!context->overlay_composition || gst_buffer_get_size (outbuf) > 0)
+    return bb_decode (pdata, config, input, outbuf);
+
+  bdata->flag_use_label = _check_label_props (bdata);
+
+  if (bdata->empty_frame &&
+      gst_memory_get_sizes (bdata->empty_frame, NULL, NULL) != size) {
+    gst_memory_unref (bdata->empty_frame);
+    bdata->empty_frame = NULL;
+  }
+
+  if (bdata->empty_frame == NULL) {
+    GstMapInfo map;
+
+    bdata->empty_frame = gst_allocator_alloc (NULL, size, NULL);
+    if (!gst_memory_map (bdata->empty_frame, &map, GST_MAP_WRITE)) {
+      ml_loge ("Cannot map output memory / tensordec-bounding_boxes.\n");
+      gst_memory_unref (bdata->empty_frame);
+      bdata->empty_frame = NULL;
+      return GST_FLOW_ERROR;
+    }
+
+    /** reset the buffer with alpha 0 / black */
+    memset (map.data, 0, size);
+    gst_memory_unmap (bdata->empty_frame, &map);
+    GST_MINI_OBJECT_FLAG_SET (bdata->empty_frame, GST_MEMORY_FLAG_READONLY);
+  }
+
+  results = _get_results (bdata, config, input);
+  if (results == NULL)
+    return GST_FLOW_ERROR;
+
+  gst_buffer_append_memory (outbuf, gst_memory_ref (bdata->empty_frame));
+
+  comp = draw_overlay (bdata, results);
+  if (comp) {
+    gst_buffer_add_video_overlay_composition_meta (outbuf, comp);
+    gst_video_overlay_composition_unref (comp);
+  }
+
+  g_array_free (results, TRUE);
+  return GST_FLOW_OK;
+}
+
 static gchar decoder_subplugin_bounding_box[] = "bounding_boxes";
 
 /** @brief Bounding box tensordec-plugin GstTensorDecoderDef instance */
@@ -1753,14 +2355,15 @@ static GstTensorDecoderDef boundingBox = {
   .setOption = bb_setOption,
   .getOutCaps = bb_getOutCaps,
   .getTransformSize = bb_getTransformSize,
-  .decode = bb_decode
+  .decode = bb_decode,
+  .decodeBuffer = bb_decodeBuffer
 };
 
 /** @brief Initialize this object for tensordec-plugin */
 void
 init_bb (void)
 {
-  nnstreamer_decoder_probe (&boundingBox);
+  nnstreamer_decoder_probe_v2 (&boundingBox, sizeof (GstTensorDecoderDef));
 }
 
 /** @brief Destruct this object for tensordec-plugin */
@@ -28,7 +28,7 @@
 
 #include <string.h>
 #include <glib.h>
-#include <gst/video/video-format.h>
+#include <gst/video/video.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_log.h>
@@ -158,34 +158,23 @@ dv_setOption (void **pdata, int opNum, const char *param)
   return TRUE;
 }
 
-/** @brief tensordec-plugin's GstTensorDecoderDef callback */
-static GstCaps *
-dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
+/** @brief Get the video format from the channel of tensor and option1. Returns the default format if option1 is not given. */
+static GstVideoFormat
+_dv_get_video_format (const direct_video_ops * ddata, const uint32_t channel)
 {
-  direct_video_ops *ddata = *pdata;
-  /* Old gst_tensordec_video_caps_from_config () had this */
   GstVideoFormat format;
-  gint width, height, channel;
-  GstCaps *caps;
 
-  g_return_val_if_fail (config != NULL, NULL);
-  GST_INFO ("Num Tensors = %d", config->info.num_tensors);
-  g_return_val_if_fail (config->info.num_tensors >= 1, NULL);
-
-  /* Direct video uses the first tensor only even if it's multi-tensor */
-  channel = config->info.info[0].dimension[0];
   if (channel == 1) {
     switch (ddata->format) {
       case DIRECT_VIDEO_FORMAT_GRAY8:
         format = GST_VIDEO_FORMAT_GRAY8;
         break;
       case DIRECT_VIDEO_FORMAT_UNKNOWN:
-        GST_WARNING ("Default format has been applied: GRAY8");
         format = GST_VIDEO_FORMAT_GRAY8;
         break;
       default:
         GST_ERROR ("Invalid format. Please check the video format");
-        return NULL;
+        return GST_VIDEO_FORMAT_UNKNOWN;
     }
   } else if (channel == 3) {
     switch (ddata->format) {
@@ -196,12 +185,11 @@ dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
         format = GST_VIDEO_FORMAT_BGR;
         break;
       case DIRECT_VIDEO_FORMAT_UNKNOWN:
-        GST_WARNING ("Default format has been applied: RGB");
         format = GST_VIDEO_FORMAT_RGB;
         break;
       default:
         GST_ERROR ("Invalid format. Please check the video format");
-        return NULL;
+        return GST_VIDEO_FORMAT_UNKNOWN;
     }
   } else if (channel == 4) {
     switch (ddata->format) {
@@ -230,16 +218,42 @@ dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
         format = GST_VIDEO_FORMAT_ABGR;
         break;
       case DIRECT_VIDEO_FORMAT_UNKNOWN:
-        GST_WARNING ("Default format has been applied: BGRx");
         format = GST_VIDEO_FORMAT_BGRx;
         break;
       default:
         GST_ERROR ("Invalid format. Please check the video format");
-        return NULL;
+        return GST_VIDEO_FORMAT_UNKNOWN;
     }
   } else {
-    GST_ERROR ("%d channel is not supported", channel);
+    GST_ERROR ("%u channel is not supported", channel);
+    return GST_VIDEO_FORMAT_UNKNOWN;
+  }
+
+  return format;
+}
+
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstCaps *
+dv_getOutCaps (void **pdata, const GstTensorsConfig * config)
+{
+  direct_video_ops *ddata = *pdata;
+  /* Old gst_tensordec_video_caps_from_config () had this */
+  GstVideoFormat format;
+  gint width, height;
+  GstCaps *caps;
+
+  g_return_val_if_fail (config != NULL, NULL);
+  GST_INFO ("Num Tensors = %d", config->info.num_tensors);
+  g_return_val_if_fail (config->info.num_tensors >= 1, NULL);
+
+  /* Direct video uses the first tensor only even if it's multi-tensor */
+  format = _dv_get_video_format (ddata, config->info.info[0].dimension[0]);
+  if (format == GST_VIDEO_FORMAT_UNKNOWN)
     return NULL;
+
+  if (ddata->format == DIRECT_VIDEO_FORMAT_UNKNOWN) {
+    GST_WARNING ("Default format has been applied: %s",
+        gst_video_format_to_string (format));
   }
 
   width = config->info.info[0].dimension[1];
@@ -273,24 +287,6 @@ _get_video_xraw_bufsize (const tensor_dim dim)
   return (size_t)((dim[0] * dim[1] - 1) / 4 + 1) * 4 * dim[2];
 }
 
-/** @brief tensordec-plugin's GstTensorDecoderDef callback */
-static size_t
-dv_getTransformSize (void **pdata, const GstTensorsConfig * config,
-    GstCaps * caps, size_t size, GstCaps * othercaps, GstPadDirection direction)
-{
-  /* Direct video uses the first tensor only even if it's multi-tensor */
-  const uint32_t *dim = &(config->info.info[0].dimension[0]);
-  UNUSED (pdata);
-  UNUSED (caps);
-  UNUSED (size);
-  UNUSED (othercaps);
-
-  if (direction == GST_PAD_SINK)
-    return _get_video_xraw_bufsize (dim);
-  else
-    return 0; /** @todo NYI */
-}
-
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
 dv_decode (void **pdata, const GstTensorsConfig * config,
@@ -349,6 +345,67 @@ dv_decode (void **pdata, const GstTensorsConfig * config,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief tensordec-plugin's GstTensorDecoderDef callback
+ *
+ * Appends the memory of input tensor to the output buffer without copy.
+ * If each row of the frame needs padding, the stride is described with GstVideoMeta.
+ * The frame is copied if downstream does not support GstVideoMeta or the memory of input tensor cannot be shared.
+ */
+static GstFlowReturn
+dv_decodeBuffer (void **pdata, const GstTensorsConfig * config,
+    const GstTensorMemory * input, const GstTensorDecoderContext * context,
+    GstBuffer * outbuf)
+{
+  direct_video_ops *ddata = *pdata;
+  /* Direct video uses the first tensor only even if it's multi-tensor */
+  const uint32_t *dim = &(config->info.info[0].dimension[0]);
+  size_t row_size, stride, size;
+  GstMemory *in_mem, *out_mem;
+
+  g_assert (outbuf);
+  g_assert (config->info.info[0].type == _NNS_UINT8);
+
+  row_size = (size_t) dim[0] * dim[1];
+  stride = ((row_size - 1) / 4 + 1) * 4;
+  size = row_size * dim[2];
+
+  /* Flexible tensor has the header in the memory, copy the frame. */
+  if (!gst_tensors_config_is_static (config) || input[0].size != size)
+    return dv_decode (pdata, config, input, outbuf);
+
+  if (stride != row_size && !context->video_meta)
+    return dv_decode (pdata, config, input, outbuf);
+
+  in_mem = gst_buffer_peek_memory (context->inbuf, 0);
+
+  /* The memory cannot be shared with other buffers, copy the frame. */
+  if (in_mem == NULL || GST_MEMORY_IS_NO_SHARE (in_mem))
+    return dv_decode (pdata, config, input, outbuf);
+
+  if (gst_memory_get_sizes (in_mem, NULL, NULL) == size)
+    out_mem = gst_memory_ref (in_mem);
+  else
+    out_mem = gst_memory_share (in_mem, 0, size);
+
+  if (out_mem == NULL)
+    return dv_decode (pdata, config, input, outbuf);
+
+  gst_buffer_append_memory (outbuf, out_mem);
+
+  if (stride != row_size) {
+    gsize offset[GST_VIDEO_MAX_PLANES] = { 0, };
+    gint strides[GST_VIDEO_MAX_PLANES] = { 0, };
+
+    strides[0] = (gint) row_size;
+    gst_buffer_add_video_meta_full (outbuf, GST_VIDEO_FRAME_FLAG_NONE,
+        _dv_get_video_format (ddata, dim[0]), dim[1], dim[2], 1, offset,
+        strides);
+  }
+
+  return GST_FLOW_OK;
+}
+
 static gchar decoder_subplugin_direct_video[] = "direct_video";
 
 /** @brief Direct-Video tensordec-plugin GstTensorDecoderDef instance */
@@ -358,15 +415,16 @@ static GstTensorDecoderDef directVideo = {
   .exit = dv_exit,
   .setOption = dv_setOption,
   .getOutCaps = dv_getOutCaps,
-  .getTransformSize = dv_getTransformSize,
-  .decode = dv_decode
+  .getTransformSize = NULL, /* appends the memory of input tensor in decodeBuffer */
+  .decode = dv_decode,
+  .decodeBuffer = dv_decodeBuffer
 };
 
 /** @brief Initialize this object for tensordec-plugin */
 void
 init_dv (void)
 {
-  nnstreamer_decoder_probe (&directVideo);
+  nnstreamer_decoder_probe_v2 (&directVideo, sizeof (GstTensorDecoderDef));
 }
 
 /** @brief Destruct this object for tensordec-plugin */
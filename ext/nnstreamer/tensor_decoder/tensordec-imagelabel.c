@@ -20,6 +20,12 @@
  * @brief       NNStreamer tensor-decoder subplugin, "image labeling",
  *              which converts image label tensors to text stream.
  *
+ * option1: Location of the label file
+ * option2: The number of labels to be printed (top-k), default is 1.
+ *          The labels are printed in descending order of score, separated with a new line.
+ * option3: Score threshold. If given, the labels with lower score are not printed,
+ *          and the buffer is dropped if there is no label over the threshold.
+ *
  * @see         https://github.com/nnstreamer/nnstreamer
  * @author      MyungJoo Ham <myungjoo.ham@samsung.com>
  * @bug         No known bugs except for NYI items
@@ -31,6 +37,7 @@
 #include <string.h>
 #include <glib.h>
 #include <gst/gstinfo.h>
+#include <gst/base/gstbasetransform.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_log.h>
@@ -48,6 +55,9 @@ typedef struct
 {
   imglabel_t labels;
   char *label_path;
+  guint top_k; /**< The number of labels to be printed */
+  gboolean use_threshold; /**< TRUE to print the labels over the threshold only */
+  double threshold; /**< Score threshold */
 } ImageLabelData;
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -55,12 +65,18 @@ static int
 il_init (void **pdata)
 {
   /** @todo check if we need to ensure plugin_data is not yet allocated */
-  *pdata = g_new0 (ImageLabelData, 1);
-  if (*pdata == NULL) {
+  ImageLabelData *data;
+
+  data = *pdata = g_new0 (ImageLabelData, 1);
+  if (data == NULL) {
     GST_ERROR ("Failed to allocate memory for decoder subplugin.");
     return FALSE;
   }
 
+  data->top_k = 1;
+  data->use_threshold = FALSE;
+  data->threshold = 0.0;
+
   return TRUE;
 }
 
@@ -98,6 +114,29 @@ il_setOption (void **pdata, int opNum, const char *param)
       return TRUE;
     else
       return FALSE;
+  } else if (opNum == 1) {
+    guint64 top_k;
+
+    /* empty option, use default top-k */
+    if (param == NULL || *param == '\0') {
+      data->top_k = 1;
+      return TRUE;
+    }
+
+    top_k = g_ascii_strtoull (param, NULL, 10);
+
+    if (top_k == 0 || top_k > G_MAXUINT) {
+      GST_ERROR ("Invalid option2 (top-k) %s, it should be a positive number.",
+          param);
+      return FALSE;
+    }
+
+    data->top_k = (guint) top_k;
+    return TRUE;
+  } else if (opNum == 2) {
+    data->use_threshold = (param != NULL && *param != '\0');
+    data->threshold = data->use_threshold ? g_ascii_strtod (param, NULL) : 0.0;
+    return TRUE;
   }
 
   GST_INFO ("Property mode-option-%d is ignored", opNum + 1);
@@ -166,6 +205,93 @@ case typename:\
   break;
 
 
+/**
+ * @brief Search for top-k in a single pass. Macro for tensor_element union
+ * The scores are kept in descending order, and the former index wins on a tie.
+ */
+#define search_topk(type, data, num_data, k, topk_idx, topk_val, found) \
+do {\
+  gsize i;\
+  guint j;\
+  type *cursor = (type *) (data);\
+  found = 0;\
+  for (i = 0; i < (num_data); i++) {\
+    double v = (double) cursor[i];\
+    if (found == (k) && v <= topk_val[(k) - 1])\
+      continue;\
+    j = (found < (k)) ? found++ : (k) - 1;\
+    while (j > 0 && topk_val[j - 1] < v) {\
+      topk_val[j] = topk_val[j - 1];\
+      topk_idx[j] = topk_idx[j - 1];\
+      j--;\
+    }\
+    topk_val[j] = v;\
+    topk_idx[j] = (guint) i;\
+  }\
+} while (0);
+
+/** @brief Shorter case statement for search_topk */
+#define search_topk_case(type, typename) \
+case typename:\
+  search_topk(type, input_data, num_data, k, topk_idx, topk_val, found);\
+  break;
+
+/**
+ * @brief Get the string of top-k labels over the threshold.
+ * @return Newly allocated string. NULL if there is no label to be printed.
+ */
+static gchar *
+il_get_topk_labels (ImageLabelData * data, const GstTensorsConfig * config,
+    void *input_data, gsize num_data)
+{
+  GString *result;
+  guint *topk_idx;
+  double *topk_val;
+  guint i, k, found = 0;
+
+  k = (guint) MIN ((gsize) data->top_k, num_data);
+  topk_idx = g_new0 (guint, k);
+  topk_val = g_new0 (double, k);
+
+  switch (config->info.info[0].type) {
+      search_topk_case (int32_t, _NNS_INT32);
+      search_topk_case (uint32_t, _NNS_UINT32);
+      search_topk_case (int16_t, _NNS_INT16);
+      search_topk_case (uint16_t, _NNS_UINT16);
+      search_topk_case (int8_t, _NNS_INT8);
+      search_topk_case (uint8_t, _NNS_UINT8);
+      search_topk_case (double, _NNS_FLOAT64);
+      search_topk_case (float, _NNS_FLOAT32);
+      search_topk_case (int64_t, _NNS_INT64);
+      search_topk_case (uint64_t, _NNS_UINT64);
+    default:
+      break;
+  }
+
+  result = g_string_new (NULL);
+
+  for (i = 0; i < found; i++) {
+    if (data->use_threshold && topk_val[i] < data->threshold)
+      break;
+
+    g_assert (topk_idx[i] < data->labels.total_labels);
+
+    if (result->len > 0)
+      g_string_append_c (result, '\n');
+    g_string_append (result, data->labels.labels[topk_idx[i]]);
+  }
+
+  g_free (topk_idx);
+  g_free (topk_val);
+
+  if (result->len == 0) {
+    g_string_free (result, TRUE);
+    return NULL;
+  }
+
+  return g_string_free (result, FALSE);
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
 il_decode (void **pdata, const GstTensorsConfig * config,
@@ -183,6 +309,7 @@ il_decode (void **pdata, const GstTensorsConfig * config,
 
   gsize size;
   char *str;
+  gchar *topk_str = NULL;
 
   g_assert (bpe > 0);
   g_assert (outbuf);
@@ -190,6 +317,25 @@ il_decode (void **pdata, const GstTensorsConfig * config,
   input_data = input->data;
   num_data = gst_tensor_info_get_size (&config->info.info[0]) / bpe;
 
+  if (data->top_k > 1 || data->use_threshold) {
+    switch (config->info.info[0].type) {
+      case _NNS_FLOAT16:
+      case _NNS_END:
+        return GST_FLOW_NOT_SUPPORTED;
+      default:
+        break;
+    }
+
+    topk_str = il_get_topk_labels (data, config, input_data, num_data);
+    if (topk_str == NULL) {
+      /* no label over the threshold */
+      return GST_BASE_TRANSFORM_FLOW_DROPPED;
+    }
+
+    str = topk_str;
+    goto write_output;
+  }
+
   switch (config->info.info[0].type) {
       search_max_case (int32_t, _NNS_INT32);
       search_max_case (uint32_t, _NNS_UINT32);
@@ -207,11 +353,12 @@ il_decode (void **pdata, const GstTensorsConfig * config,
 
   g_assert (max_index < data->labels.total_labels);
 
-  /** @todo With option-2, allow to change output format */
   str = data->labels.labels[max_index];
 
+write_output:
   if (!str || (size = strlen (str)) == 0) {
     ml_loge ("Invalid labels. Please check the label data.");
+    g_free (topk_str);
     return GST_FLOW_ERROR;
   }
 
@@ -228,10 +375,12 @@ il_decode (void **pdata, const GstTensorsConfig * config,
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     ml_loge ("Cannot map output memory / tensordec-imagelabel.\n");
     gst_memory_unref (out_mem);
+    g_free (topk_str);
     return GST_FLOW_ERROR;
   }
 
   memcpy (out_info.data, str, size);
+  g_free (topk_str);
 
   gst_memory_unmap (out_mem, &out_info);
 
@@ -34,6 +34,15 @@
  *
  * option2: Maximum number of class labels (except background), default is 20 (Pascal)
  *
+ * option3: Output format, default is rgba
+ *          Available : rgba (video/x-raw, RGBA colored segments)
+ *          Available : label-map (other/tensor, uint8 label index of each pixel)
+ *          label-map is available for tflite-deeplab and snpe-deeplab,
+ *          and the maximum number of labels should be less than 256.
+ *
+ * option4: The number of threads to find the labels of tflite-deeplab, default is 1.
+ *          The rows of the image are partitioned evenly to the threads.
+ *
  * expected models
  * - tflite-deeplab : deeplabv3_257_mv_gpu.tflite (designed for embedded devices)
  * - snpe-deeplab   : deeplabv3_mnv2_pascal_train_aug.dlc (converted from a TF model)
@@ -93,6 +102,7 @@
 #endif
 
 #define DEFAULT_LABELS  (20)
+#define MAX_THREADS     (16)
 #define RGBA_CHANNEL    (4)
 #define MAX_RGB         (255)
 
@@ -138,8 +148,28 @@ typedef struct
 
   GRand *rand;              /**< random value generator */
   guint rgb_modifier;       /**< rgb modifier according to # labels */
+
+  gboolean label_map;       /**< TRUE to output label map instead of RGBA frame */
+  guint num_threads;        /**< The number of threads to find labels */
+  GThreadPool *pool;        /**< Thread pool to find labels */
+  GMutex lock;              /**< Lock to wait for the threads */
+  GCond cond;               /**< Condition to wait for the threads */
+  guint pending;            /**< The number of running tasks */
 } image_segments;
 
+/**
+ * @brief Data structure for the task to find labels of partitioned rows
+ */
+typedef struct
+{
+  image_segments *idata;    /**< The image segmentation info */
+  const float *prob_map;    /**< Label probabilities of the whole image */
+  guint row_start;          /**< The first row of the partition */
+  guint row_end;            /**< The row after the last row of the partition */
+  float *segment_map;       /**< Output, float label index (NULL if not used) */
+  guint8 *label_map;        /**< Output, uint8 label index (NULL if not used) */
+} image_segment_task;
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static int
 is_init (void **pdata)
@@ -160,6 +190,12 @@ is_init (void **pdata)
   idata->segment_map = NULL;
   idata->color_map = NULL;
   idata->rgb_modifier = 0;
+  idata->label_map = FALSE;
+  idata->num_threads = 1;
+  idata->pool = NULL;
+  idata->pending = 0;
+  g_mutex_init (&idata->lock);
+  g_cond_init (&idata->cond);
 
   return TRUE;
 }
@@ -168,6 +204,11 @@ is_init (void **pdata)
 static void
 _free_resources (image_segments * idata)
 {
+  if (idata->pool) {
+    g_thread_pool_free (idata->pool, FALSE, TRUE);
+    idata->pool = NULL;
+  }
+
   g_free (idata->segment_map);
   g_free (idata->color_map);
   g_rand_free (idata->rand);
@@ -184,6 +225,8 @@ is_exit (void **pdata)
   image_segments *idata = *pdata;
 
   _free_resources (idata);
+  g_mutex_clear (&idata->lock);
+  g_cond_clear (&idata->cond);
 
   g_free (*pdata);
   *pdata = NULL;
@@ -237,6 +280,33 @@ is_setOption (void **pdata, int op_num, const char *param)
     guint64 max_labels_64 = g_ascii_strtoll (param, NULL, 10);
     if (max_labels_64 != 0 && max_labels_64 <= UINT_MAX)
       idata->max_labels = (guint) max_labels_64;
+  } else if (op_num == 2) {
+    if (NULL == param || *param == '\0' || g_ascii_strcasecmp (param,
+            "rgba") == 0) {
+      idata->label_map = FALSE;
+    } else if (g_ascii_strcasecmp (param, "label-map") == 0) {
+      idata->label_map = TRUE;
+    } else {
+      GST_ERROR ("Unknown output format %s at option3", param);
+      return FALSE;
+    }
+    return TRUE;
+  } else if (op_num == 3) {
+    guint64 num_threads = g_ascii_strtoull (param, NULL, 10);
+
+    if (num_threads == 0 || num_threads > MAX_THREADS) {
+      GST_ERROR ("The number of threads at option4 should be 1 ~ %d",
+          MAX_THREADS);
+      return FALSE;
+    }
+
+    if (idata->pool && idata->num_threads != (guint) num_threads) {
+      g_thread_pool_free (idata->pool, FALSE, TRUE);
+      idata->pool = NULL;
+    }
+
+    idata->num_threads = (guint) num_threads;
+    return TRUE;
   }
 
   GST_WARNING ("mode-option-\"%d\" is not definded.", op_num);
@@ -298,6 +368,27 @@ is_getOutCaps (void **pdata, const GstTensorsConfig * config)
     idata->height = config->info.info[0].dimension[2];
   }
 
+  if (idata->label_map) {
+    GstTensorsConfig out_config;
+
+    if (idata->mode == MODE_SNPE_DEPTH || idata->max_labels > G_MAXUINT8) {
+      GST_ERROR ("Label map is not available with this mode or labels.");
+      return NULL;
+    }
+
+    gst_tensors_config_init (&out_config);
+    out_config.info.num_tensors = 1;
+    out_config.info.info[0].type = _NNS_UINT8;
+    out_config.info.info[0].dimension[0] = idata->width;
+    out_config.info.info[0].dimension[1] = idata->height;
+    out_config.info.info[0].dimension[2] = 1;
+    out_config.info.info[0].dimension[3] = 1;
+    out_config.rate_n = config->rate_n;
+    out_config.rate_d = config->rate_d;
+
+    return gst_tensor_caps_from_config (&out_config);
+  }
+
   str = g_strdup_printf ("video/x-raw, format = RGBA, "
       "width = %u, height = %u", idata->width, idata->height);
   caps = gst_caps_from_string (str);
@@ -312,15 +403,18 @@ static size_t
 is_getTransformSize (void **pdata, const GstTensorsConfig * config,
     GstCaps * caps, size_t size, GstCaps * othercaps, GstPadDirection direction)
 {
-  UNUSED (pdata);
+  image_segments *idata = *pdata;
   UNUSED (config);
   UNUSED (caps);
   UNUSED (size);
   UNUSED (othercaps);
-  UNUSED (direction);
+
+  if (direction == GST_PAD_SINK)
+    return (size_t) idata->width * idata->height *
+        (idata->label_map ? 1 : RGBA_CHANNEL);
 
   return 0;
-  /** @todo Use appropriate values */
+  /** @todo NYI */
 }
 
 /** @brief Set color according to each pixel's label (RGBA) */
@@ -507,45 +601,150 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
   }
 }
 
-/** @brief Set label index according to each pixel's label probabilities */
+/**
+ * @brief Set label index of the partitioned rows according to each pixel's label probabilities
+ */
 static void
-set_label_index (image_segments * idata, void *data)
+set_label_index_rows (const image_segment_task * task)
 {
-  float *prob_map = (float *) data;
-  guint idx, i, j;
-  int max_idx;
+  const image_segments *idata = task->idata;
+  const guint total_labels = idata->max_labels + 1;
+  const float *prob;
+  gsize pixel, pixel_end;
+  guint idx, max_idx;
   float max_prob;
-  guint total_labels = idata->max_labels + 1;
 
-  memset (idata->segment_map, '\x00',
-      (size_t) idata->width * idata->height * sizeof (float));
+  pixel = (gsize) task->row_start * idata->width;
+  pixel_end = (gsize) task->row_end * idata->width;
+  prob = task->prob_map + pixel * total_labels;
+
+  for (; pixel < pixel_end; pixel++, prob += total_labels) {
+    max_idx = 0;
+    max_prob = prob[0];
+    for (idx = 1; idx < total_labels; idx++) {
+      if (prob[idx] > max_prob) {
+        max_prob = prob[idx];
+        max_idx = idx;
+      }
+    }
 
-  for (i = 0; i < idata->height; i++) {
-    for (j = 0; j < idata->width; j++) {
+    /* otherwise, regarded as background */
+    if (max_prob <= DETECTION_THRESHOLD)
       max_idx = 0;
-      max_prob = prob_map[i * idata->width * total_labels + j * total_labels];
-      for (idx = 1; idx < total_labels; idx++) {
-        float prob = prob_map[i * idata->width * total_labels
-            + j * total_labels + idx];
-        if (prob > max_prob) {
-          max_prob = prob;
-          max_idx = idx;
-        }
-      }
-      if (max_prob > DETECTION_THRESHOLD) {
-        idata->segment_map[i * idata->width + j] = (float) max_idx;
-      }                         /* otherwise, regarded as background */
+
+    if (task->label_map)
+      task->label_map[pixel] = (guint8) max_idx;
+    else
+      task->segment_map[pixel] = (float) max_idx;
+  }
+}
+
+/** @brief Thread pool function to set label index of the partitioned rows */
+static void
+set_label_index_thread (gpointer data, gpointer user_data)
+{
+  image_segment_task *task = (image_segment_task *) data;
+  image_segments *idata = (image_segments *) user_data;
+
+  set_label_index_rows (task);
+
+  g_mutex_lock (&idata->lock);
+  if (--idata->pending == 0)
+    g_cond_signal (&idata->cond);
+  g_mutex_unlock (&idata->lock);
+}
+
+/**
+ * @brief Set label index according to each pixel's label probabilities
+ * The rows are partitioned to the threads if num_threads is larger than 1.
+ * @param[in] idata The image segmentation info
+ * @param[in] data Label probabilities
+ * @param[out] segment_map Float label index (NULL if label_map is used)
+ * @param[out] label_map uint8 label index (NULL if segment_map is used)
+ */
+static void
+set_label_index (image_segments * idata, void *data, float *segment_map,
+    guint8 * label_map)
+{
+  image_segment_task tasks[MAX_THREADS];
+  guint num_tasks, rows, i;
+
+  num_tasks = MIN (idata->num_threads, idata->height);
+  if (num_tasks == 0)
+    return;
+
+  if (num_tasks > 1 && idata->pool == NULL) {
+    idata->pool = g_thread_pool_new (set_label_index_thread, idata,
+        idata->num_threads - 1, TRUE, NULL);
+    if (idata->pool == NULL) {
+      GST_WARNING ("Failed to create thread pool, find labels in a thread.");
+      num_tasks = 1;
     }
   }
+
+  rows = (idata->height + num_tasks - 1) / num_tasks;
+
+  for (i = 0; i < num_tasks; i++) {
+    tasks[i].idata = idata;
+    tasks[i].prob_map = (const float *) data;
+    tasks[i].row_start = MIN (i * rows, idata->height);
+    tasks[i].row_end = MIN ((i + 1) * rows, idata->height);
+    tasks[i].segment_map = segment_map;
+    tasks[i].label_map = label_map;
+  }
+
+  if (num_tasks == 1) {
+    set_label_index_rows (&tasks[0]);
+    return;
+  }
+
+  /* run the last partition in this thread */
+  idata->pending = num_tasks - 1;
+  for (i = 0; i < num_tasks - 1; i++)
+    g_thread_pool_push (idata->pool, &tasks[i], NULL);
+
+  set_label_index_rows (&tasks[num_tasks - 1]);
+
+  g_mutex_lock (&idata->lock);
+  while (idata->pending > 0)
+    g_cond_wait (&idata->cond, &idata->lock);
+  g_mutex_unlock (&idata->lock);
+}
+
+/** @brief Set label index from the labeled data (snpe-deeplab) */
+static void
+set_label_map_from_index (image_segments * idata, const float *input,
+    guint8 * label_map)
+{
+  gsize num_pixels = (gsize) idata->height * idata->width;
+  gsize idx;
+  guint label_idx;
+
+  for (idx = 0; idx < num_pixels; idx++) {
+    label_idx = (guint) input[idx];
+
+    /* If out-of-range, regarded as background */
+    label_map[idx] =
+        G_UNLIKELY (label_idx > idata->max_labels) ? 0 : (guint8) label_idx;
+  }
 }
 
 /** @brief set color to output buffer depending on each mode */
 static void
 set_color (image_segments * idata, void *data, GstMapInfo * out_info)
 {
+  /* output the label index without coloring */
+  if (idata->label_map) {
+    if (idata->mode == MODE_TFLITE_DEEPLAB)
+      set_label_index (idata, data, NULL, out_info->data);
+    else if (idata->mode == MODE_SNPE_DEEPLAB)
+      set_label_map_from_index (idata, data, out_info->data);
+    return;
+  }
+
   /* tflite-deeplab needs to perform extra post-processing to set labels */
   if (idata->mode == MODE_TFLITE_DEEPLAB) {
-    set_label_index (idata, data);
+    set_label_index (idata, data, idata->segment_map, NULL);
     set_color_according_to_label (idata, out_info);
     return;
   }
@@ -584,7 +783,8 @@ is_decode (void **pdata, const GstTensorsConfig * config,
     const GstTensorMemory * input, GstBuffer * outbuf)
 {
   image_segments *idata = *pdata;
-  const size_t size = (size_t) idata->width * idata->height * RGBA_CHANNEL;
+  const size_t size = (size_t) idata->width * idata->height *
+      (idata->label_map ? 1 : RGBA_CHANNEL);
   gboolean need_output_alloc;
   GstMapInfo out_info;
   GstMemory *out_mem;
@@ -632,6 +832,20 @@ error_free:
   return GST_FLOW_ERROR;
 }
 
+/**
+ * @brief tensordec-plugin's GstTensorDecoderDef callback
+ *
+ * The frame is rendered into the buffer from the pool (or newly allocated if outbuf is empty).
+ */
+static GstFlowReturn
+is_decodeBuffer (void **pdata, const GstTensorsConfig * config,
+    const GstTensorMemory * input, const GstTensorDecoderContext * context,
+    GstBuffer * outbuf)
+{
+  UNUSED (context);
+  return is_decode (pdata, config, input, outbuf);
+}
+
 static gchar decoder_subplugin_image_segment[] = "image_segment";
 
 /** @brief Image Segmentation tensordec-plugin GstTensorDecoderDef instance */
@@ -642,14 +856,15 @@ static GstTensorDecoderDef imageSegment = {
   .setOption = is_setOption,
   .getOutCaps = is_getOutCaps,
   .getTransformSize = is_getTransformSize,
-  .decode = is_decode
+  .decode = is_decode,
+  .decodeBuffer = is_decodeBuffer
 };
 
 /** @brief Initialize this object for tensordec-plugin */
 void
 init_is (void)
 {
-  nnstreamer_decoder_probe (&imageSegment);
+  nnstreamer_decoder_probe_v2 (&imageSegment, sizeof (GstTensorDecoderDef));
 }
 
 /** @brief Destruct this object for tensordec-plugin */
@@ -72,6 +72,21 @@
  *   			Tensor[1]: #labels x 2: width : height (float32, Offset position within heatmap grid)
  *	                    	(e.g., 34 x 9 x 9 )
  *
+ * option5: Multi-pose decoding (optional), MAX_POSES[:THRESHOLD[:NMS_RADIUS]]
+ *      MAX_POSES is the maximum number of poses to decode (default 1, single pose).
+ *      THRESHOLD is the minimum score of keypoint (default 0.5).
+ *      NMS_RADIUS is the radius (pixels of input dimension) to suppress the peaks of
+ *      the same keypoint (default 20).
+ *      With multi-pose decoding, the local maxima of the heatmap are found for each keypoint,
+ *      and the peaks are grouped to the poses in the order of score.
+ *      A peak is attached to the pose which has the nearest keypoint, if the distance
+ *      is less than 5 times of NMS_RADIUS.
+ *
+ * option6: Output format (optional)
+ *      Available: rgba (default, video/x-raw, the poses drawn on transparent background)
+ *                 keypoints (other/tensor, float32 3 x #labels x MAX_POSES, x:y:score of each
+ *                 keypoint in the output video dimension, the score is 0 if not found)
+ *
  * Pipeline:
  * 	v4l2src
  * 	   |
@@ -120,6 +135,11 @@ extern uint8_t rasters[][13];
 #define POSE_MD_MAX_LABEL_SZ 16
 #define POSE_MD_MAX_CONNECTIONS_SZ 8
 
+#define POSE_MAX_POSES 64
+#define POSE_THRESHOLD_DEFAULT (0.5f)
+#define POSE_NMS_RADIUS_DEFAULT (20.f)
+#define POSE_GROUP_RADIUS_SCALE (5.f)
+
 /**
  * @brief Macro for calculating sigmoid
  */
@@ -215,6 +235,14 @@ typedef struct
 
   /* From option4 */
   pose_modes mode; /**< The pose estimation decoding mode */
+
+  /* From option5 */
+  guint max_poses; /**< The maximum number of poses to decode */
+  gfloat threshold; /**< The minimum score of keypoint */
+  gfloat nms_radius; /**< The radius to suppress the peaks of same keypoint */
+
+  /* From option6 */
+  gboolean keypoint_output; /**< TRUE to output keypoint list instead of RGBA frame */
 } pose_data;
 
 /**
@@ -337,6 +365,11 @@ pose_init (void **pdata)
 
   data->mode = HEATMAP_ONLY;
 
+  data->max_poses = 1;
+  data->threshold = POSE_THRESHOLD_DEFAULT;
+  data->nms_radius = POSE_NMS_RADIUS_DEFAULT;
+  data->keypoint_output = FALSE;
+
   initSingleLineSprite (singleLineSprite, rasters, PIXEL_VALUE);
 
   return TRUE;
@@ -419,6 +452,66 @@ pose_setOption (void **pdata, int opNum, const char *param)
     }
     data->mode = mode;
 
+    return TRUE;
+  } else if (opNum == 4) {
+    /* option5 = multi-pose decoding (max-poses:threshold:nms-radius) */
+    gchar **tokens;
+    guint num;
+    guint64 max_poses;
+    gdouble value;
+
+    data->max_poses = 1;
+    data->threshold = POSE_THRESHOLD_DEFAULT;
+    data->nms_radius = POSE_NMS_RADIUS_DEFAULT;
+    if (param == NULL || *param == '\0')
+      return TRUE;
+
+    tokens = g_strsplit (param, ":", -1);
+    num = g_strv_length (tokens);
+
+    max_poses = g_ascii_strtoull (tokens[0], NULL, 10);
+    if (max_poses == 0 || max_poses > POSE_MAX_POSES) {
+      GST_ERROR ("The maximum number of poses at option5 should be 1 ~ %d",
+          POSE_MAX_POSES);
+      g_strfreev (tokens);
+      return FALSE;
+    }
+    data->max_poses = (guint) max_poses;
+
+    if (num > 1) {
+      value = g_ascii_strtod (tokens[1], NULL);
+      if (value <= 0.0 || value >= 1.0) {
+        GST_ERROR ("The threshold at option5 should be in range (0, 1).");
+        g_strfreev (tokens);
+        return FALSE;
+      }
+      data->threshold = (gfloat) value;
+    }
+
+    if (num > 2) {
+      value = g_ascii_strtod (tokens[2], NULL);
+      if (value <= 0.0) {
+        GST_ERROR ("The NMS radius at option5 should be positive.");
+        g_strfreev (tokens);
+        return FALSE;
+      }
+      data->nms_radius = (gfloat) value;
+    }
+
+    g_strfreev (tokens);
+    return TRUE;
+  } else if (opNum == 5) {
+    /* option6 = output format */
+    if (param == NULL || *param == '\0' ||
+        g_ascii_strcasecmp (param, "rgba") == 0) {
+      data->keypoint_output = FALSE;
+    } else if (g_ascii_strcasecmp (param, "keypoints") == 0) {
+      data->keypoint_output = TRUE;
+    } else {
+      GST_ERROR ("Unknown output format %s at option6", param);
+      return FALSE;
+    }
+
     return TRUE;
   }
 
@@ -481,6 +574,22 @@ pose_getOutCaps (void **pdata, const GstTensorsConfig * config)
       g_return_val_if_fail (dim[i] == 1, NULL);
   }
 
+  if (data->keypoint_output) {
+    GstTensorsConfig out_config;
+
+    gst_tensors_config_init (&out_config);
+    out_config.info.num_tensors = 1;
+    out_config.info.info[0].type = _NNS_FLOAT32;
+    out_config.info.info[0].dimension[0] = 3;
+    out_config.info.info[0].dimension[1] = pose_size;
+    out_config.info.info[0].dimension[2] = data->max_poses;
+    out_config.info.info[0].dimension[3] = 1;
+    out_config.rate_n = config->rate_n;
+    out_config.rate_d = config->rate_d;
+
+    return gst_tensor_caps_from_config (&out_config);
+  }
+
   str = g_strdup_printf ("video/x-raw, format = RGBA, " /* Use alpha channel to make the background transparent */
       "width = %u, height = %u", data->width, data->height);
   caps = gst_caps_from_string (str);
@@ -495,12 +604,17 @@ static size_t
 pose_getTransformSize (void **pdata, const GstTensorsConfig * config,
     GstCaps * caps, size_t size, GstCaps * othercaps, GstPadDirection direction)
 {
-  UNUSED (pdata);
+  pose_data *data = *pdata;
   UNUSED (config);
   UNUSED (caps);
   UNUSED (size);
   UNUSED (othercaps);
-  UNUSED (direction);
+
+  if (direction == GST_PAD_SINK) {
+    if (data->keypoint_output)
+      return (size_t) 3 * data->total_labels * data->max_poses * sizeof (gfloat);
+    return (size_t) data->width * data->height * 4; /* RGBA */
+  }
   return 0;
 }
 
@@ -673,32 +787,25 @@ draw_label (uint32_t * frame, pose_data * data, pose * xydata)
  * @brief Draw with the given results (pose) to the output buffer
  * @param[out] out_info The output buffer (RGBA plain)
  * @param[in] bdata The bouding-box internal data.
- * @param[in] results The final results to be drawn.
+ * @param[in] xydata The keypoints of a pose to be drawn.
  */
 static void
-draw (GstMapInfo * out_info, pose_data * data, GArray * results)
+draw (GstMapInfo * out_info, pose_data * data, pose * xydata)
 {
   guint i;
   gint j;
   uint32_t *frame = (uint32_t *) out_info->data;        /* Let's draw per pixel (4bytes) */
   guint pose_size = data->total_labels;
 
-  pose **XYdata = g_new0 (pose *, pose_size);
-  if (!XYdata) {
-    ml_loge ("The memory allocation is failed.");
-    return;
-  }
-
   for (i = 0; i < pose_size; i++) {
-    XYdata[i] = &g_array_index (results, pose, i);
-    if (XYdata[i]->prob < 0.5) {
-      XYdata[i]->valid = FALSE;
+    if (xydata[i].prob < data->threshold) {
+      xydata[i].valid = FALSE;
     }
   }
 
   for (i = 0; i < pose_size; i++) {
     pose_metadata_t *smd;
-    if (XYdata[i]->valid == FALSE)
+    if (xydata[i].valid == FALSE)
       continue;
     smd = pose_get_metadata_by_id (data, i);
     if (smd == NULL)
@@ -706,19 +813,288 @@ draw (GstMapInfo * out_info, pose_data * data, GArray * results)
     for (j = 0; j < smd->num_connections; j++) {
       guint k = smd->connections[j];
       /* Have we already drawn the connection ? */
-      if ((k > data->total_labels) || (k < i))
+      if ((k >= data->total_labels) || (k < i))
         continue;
       /* Is the body point valid ? */
-      if (XYdata[k]->valid == FALSE)
+      if (xydata[k].valid == FALSE)
         continue;
       draw_line_with_dot (frame, data,
-          XYdata[i]->x, XYdata[i]->y, XYdata[k]->x, XYdata[k]->y);
+          xydata[i].x, xydata[i].y, xydata[k].x, xydata[k].y);
     }
   }
 
-  draw_label (frame, data, *XYdata);
+  draw_label (frame, data, xydata);
+}
+
+/**
+ * @brief Find the cell of max value for all keypoints in a single pass over the heatmap.
+ * The heatmap is laid out as [height][width][#labels], the values of all keypoints in a cell are contiguous.
+ * The inner loop is branchless, so that the compiler can vectorize it.
+ * @param[in] arr The heatmap
+ * @param[in] pose_size The number of keypoints
+ * @param[in] num_cells The number of cells (width x height) of the heatmap
+ * @param[out] max The max value of each keypoint
+ * @param[out] max_cell The index of the cell with max value of each keypoint
+ */
+static void
+pose_find_max_cells (const gfloat * arr, guint pose_size, guint num_cells,
+    gfloat * max, guint * max_cell)
+{
+  guint c, k;
+
+  for (k = 0; k < pose_size; k++) {
+    max[k] = arr[k];
+    max_cell[k] = 0;
+  }
+
+  for (c = 1; c < num_cells; c++) {
+    const gfloat *cell = arr + (gsize) c * pose_size;
+
+    for (k = 0; k < pose_size; k++) {
+      gboolean greater = (cell[k] > max[k]);
+
+      max[k] = greater ? cell[k] : max[k];
+      max_cell[k] = greater ? c : max_cell[k];
+    }
+  }
+}
+
+/**
+ * @brief Get the keypoint from the cell of heatmap.
+ * @param[in] data The pose data object
+ * @param[in] config The tensors config
+ * @param[in] input The input tensors
+ * @param[in] index The index of keypoint
+ * @param[in] cell The index of the cell in heatmap
+ * @param[in] prob The score of keypoint
+ * @param[out] p The keypoint in output video dimension
+ */
+static void
+pose_get_keypoint (pose_data * data, const GstTensorsConfig * config,
+    const GstTensorMemory * input, guint index, guint cell, gfloat prob,
+    pose * p)
+{
+  guint pose_size = data->total_labels;
+  int grid_xsize, grid_ysize;
+  int maxX, maxY;
+
+  grid_xsize = config->info.info[0].dimension[1];
+  grid_ysize = config->info.info[0].dimension[2];
+  maxX = cell % grid_xsize;
+  maxY = cell / grid_xsize;
+
+  p->valid = TRUE;
+  p->prob = prob;
+  if (data->mode == HEATMAP_OFFSET) {
+    const gfloat *offset = ((const GstTensorMemory *) &input[1])->data;
+    gfloat offsetX, offsetY, posX, posY;
+    int offsetIdx;
+    offsetIdx = (maxY * grid_xsize + maxX) * pose_size * 2 + index;
+    offsetY = offset[offsetIdx];
+    offsetX = offset[offsetIdx + pose_size];
+    posX = (((gfloat) maxX) / (grid_xsize - 1)) * data->i_width + offsetX;
+    posY = (((gfloat) maxY) / (grid_ysize - 1)) * data->i_height + offsetY;
+    p->x = posX * data->width / data->i_width;
+    p->y = posY * data->height / data->i_height;
+
+  } else {
+    p->x = (maxX * data->width) / data->i_width;
+    p->y = (maxY * data->height) / data->i_height;;
+  }
+  /* Some keypoints can be estimated slightly out of image range */
+  p->x = MIN (data->width, (guint) (MAX (0, p->x)));
+  p->y = MIN (data->height, (guint) (MAX (0, p->y)));
+}
+
+/**
+ * @brief Decode a pose with the max value of each keypoint.
+ */
+static void
+pose_decode_single (pose_data * data, const GstTensorsConfig * config,
+    const GstTensorMemory * input, pose * poses)
+{
+  guint pose_size = data->total_labels;
+  guint num_cells, index;
+  gfloat *max;
+  guint *max_cell;
+
+  num_cells = config->info.info[0].dimension[1] *
+      config->info.info[0].dimension[2];
+
+  max = g_new (gfloat, pose_size);
+  max_cell = g_new (guint, pose_size);
+
+  pose_find_max_cells ((const gfloat *) input[0].data, pose_size, num_cells,
+      max, max_cell);
+
+  for (index = 0; index < pose_size; index++) {
+    /* sigmoid is monotonic, apply it to the max value only. */
+    gfloat prob = (data->mode == HEATMAP_OFFSET) ?
+        _sigmoid (max[index]) : max[index];
+
+    pose_get_keypoint (data, config, input, index, max_cell[index], prob,
+        &poses[index]);
+  }
 
-  g_free (XYdata);
+  g_free (max);
+  g_free (max_cell);
+}
+
+/** @brief Represents a peak (local maximum) of the heatmap */
+typedef struct
+{
+  guint index; /**< The index of keypoint */
+  guint cell; /**< The index of the cell in heatmap */
+  gfloat score; /**< The score of keypoint */
+} pose_peak;
+
+/**
+ * @brief Compare the score of peaks, for sorting in descending order.
+ */
+static gint
+pose_compare_peak (gconstpointer a, gconstpointer b)
+{
+  const pose_peak *p1 = (const pose_peak *) a;
+  const pose_peak *p2 = (const pose_peak *) b;
+
+  if (p1->score > p2->score)
+    return -1;
+  return (p1->score < p2->score) ? 1 : 0;
+}
+
+/**
+ * @brief Get the squared distance of two keypoints.
+ */
+static inline gfloat
+pose_get_distance2 (const pose * p1, const pose * p2)
+{
+  gfloat dx = (gfloat) (p1->x - p2->x);
+  gfloat dy = (gfloat) (p1->y - p2->y);
+
+  return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Decode multiple poses with the local maxima of the heatmap.
+ * @return The number of decoded poses.
+ */
+static guint
+pose_decode_multi (pose_data * data, const GstTensorsConfig * config,
+    const GstTensorMemory * input, pose * poses)
+{
+  const gfloat *arr = (const gfloat *) input[0].data;
+  guint pose_size = data->total_labels;
+  guint grid_xsize, grid_ysize;
+  guint x, y, k, i, n, num_poses = 0;
+  gfloat threshold, scale, nms2, group2;
+  GArray *peaks;
+
+  grid_xsize = config->info.info[0].dimension[1];
+  grid_ysize = config->info.info[0].dimension[2];
+
+  /* compare the raw value with the threshold, sigmoid is monotonic. */
+  threshold = data->threshold;
+  if (data->mode == HEATMAP_OFFSET)
+    threshold = logf (threshold / (1.f - threshold));
+
+  /* the radius in output video dimension */
+  scale = (data->i_width > 0) ? ((gfloat) data->width / data->i_width) : 1.f;
+  nms2 = data->nms_radius * scale;
+  group2 = nms2 * POSE_GROUP_RADIUS_SCALE;
+  nms2 *= nms2;
+  group2 *= group2;
+
+  /* 1. find the local maxima (3x3) of all keypoints in a single pass. */
+  peaks = g_array_new (FALSE, FALSE, sizeof (pose_peak));
+
+  for (y = 0; y < grid_ysize; y++) {
+    for (x = 0; x < grid_xsize; x++) {
+      const gfloat *cell = arr + ((gsize) y * grid_xsize + x) * pose_size;
+
+      for (k = 0; k < pose_size; k++) {
+        gfloat v = cell[k];
+        gboolean is_peak = (v >= threshold);
+        gint dx, dy;
+
+        for (dy = -1; dy <= 1 && is_peak; dy++) {
+          for (dx = -1; dx <= 1 && is_peak; dx++) {
+            gint nx = (gint) x + dx;
+            gint ny = (gint) y + dy;
+
+            if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 ||
+                nx >= (gint) grid_xsize || ny >= (gint) grid_ysize)
+              continue;
+
+            if (arr[((gsize) ny * grid_xsize + nx) * pose_size + k] > v)
+              is_peak = FALSE;
+          }
+        }
+
+        if (is_peak) {
+          pose_peak peak;
+
+          peak.index = k;
+          peak.cell = y * grid_xsize + x;
+          peak.score = (data->mode == HEATMAP_OFFSET) ? _sigmoid (v) : v;
+          g_array_append_val (peaks, peak);
+        }
+      }
+    }
+  }
+
+  g_array_sort (peaks, pose_compare_peak);
+
+  /* 2. group the peaks to the poses in the order of score. */
+  for (n = 0; n < peaks->len; n++) {
+    pose_peak *peak = &g_array_index (peaks, pose_peak, n);
+    pose p;
+    gboolean suppressed = FALSE;
+    gint nearest = -1;
+    gfloat nearest_dist = group2;
+
+    pose_get_keypoint (data, config, input, peak->index, peak->cell,
+        peak->score, &p);
+
+    for (i = 0; i < num_poses; i++) {
+      pose *kpts = &poses[i * pose_size];
+
+      /* NMS: the same keypoint of other pose is close to this peak. */
+      if (kpts[peak->index].valid &&
+          pose_get_distance2 (&kpts[peak->index], &p) <= nms2) {
+        suppressed = TRUE;
+        break;
+      }
+
+      if (kpts[peak->index].valid)
+        continue;
+
+      for (k = 0; k < pose_size; k++) {
+        gfloat dist;
+
+        if (!kpts[k].valid)
+          continue;
+
+        dist = pose_get_distance2 (&kpts[k], &p);
+        if (dist < nearest_dist) {
+          nearest_dist = dist;
+          nearest = (gint) i;
+        }
+      }
+    }
+
+    if (suppressed)
+      continue;
+
+    if (nearest >= 0) {
+      poses[nearest * pose_size + peak->index] = p;
+    } else if (num_poses < data->max_poses) {
+      poses[num_poses * pose_size + peak->index] = p;
+      num_poses++;
+    }
+  }
+
+  g_array_free (peaks, TRUE);
+  return num_poses;
 }
 
 /** @brief tensordec-plugin's TensorDecDef callback */
@@ -727,15 +1103,18 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
     const GstTensorMemory * input, GstBuffer * outbuf)
 {
   pose_data *data = *pdata;
-  const size_t size = (size_t) data->width * data->height * 4;   /* RGBA */
+  size_t size;
   GstMapInfo out_info;
   GstMemory *out_mem;
-  GArray *results = NULL;
-  const GstTensorMemory *detections = NULL;
-  float *arr;
-  int i, j;
-  int grid_xsize, grid_ysize;
-  guint pose_size, index;
+  pose *poses;
+  guint pose_size, num_poses, i;
+
+  pose_size = data->total_labels;
+
+  if (data->keypoint_output)
+    size = (size_t) 3 * pose_size * data->max_poses * sizeof (gfloat);
+  else
+    size = (size_t) data->width * data->height * 4;     /* RGBA */
 
   g_assert (outbuf); /** GST Internal Bug */
   /* Ensure we have outbuf properly allocated */
@@ -752,63 +1131,35 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
     ml_loge ("Cannot map output memory / tensordec-pose.\n");
     return GST_FLOW_ERROR;
   }
-  /** reset the buffer with alpha 0 / black */
+  /** reset the buffer with alpha 0 / black (or zero score) */
   memset (out_info.data, 0, size);
 
-  pose_size = data->total_labels;
+  poses = g_new0 (pose, pose_size * data->max_poses);
 
-  grid_xsize = config->info.info[0].dimension[1];
-  grid_ysize = config->info.info[0].dimension[2];
+  if (data->max_poses > 1) {
+    num_poses = pose_decode_multi (data, config, input, poses);
+  } else {
+    pose_decode_single (data, config, input, poses);
+    num_poses = 1;
+  }
 
-  results = g_array_sized_new (FALSE, TRUE, sizeof (pose), pose_size);
-  detections = &input[0];
-  arr = detections->data;
-  for (index = 0; index < pose_size; index++) {
-    int maxX = 0;
-    int maxY = 0;
-    float max = G_MINFLOAT;
-    pose p;
-    for (j = 0; j < grid_ysize; j++) {
-      for (i = 0; i < grid_xsize; i++) {
-        float cen = arr[i * pose_size + j * grid_xsize * pose_size + index];
-        if (data->mode == HEATMAP_OFFSET) {
-          cen = _sigmoid (cen);
-        }
-        if (cen > max) {
-          max = cen;
-          maxX = i;
-          maxY = j;
-        }
-      }
-    }
+  if (data->keypoint_output) {
+    gfloat *kpts = (gfloat *) out_info.data;
 
-    p.valid = TRUE;
-    p.prob = max;
-    if (data->mode == HEATMAP_OFFSET) {
-      const gfloat *offset = ((const GstTensorMemory *) &input[1])->data;
-      gfloat offsetX, offsetY, posX, posY;
-      int offsetIdx;
-      offsetIdx = (maxY * grid_xsize + maxX) * pose_size * 2 + index;
-      offsetY = offset[offsetIdx];
-      offsetX = offset[offsetIdx + pose_size];
-      posX = (((gfloat) maxX) / (grid_xsize - 1)) * data->i_width + offsetX;
-      posY = (((gfloat) maxY) / (grid_ysize - 1)) * data->i_height + offsetY;
-      p.x = posX * data->width / data->i_width;
-      p.y = posY * data->height / data->i_height;
+    for (i = 0; i < num_poses * pose_size; i++) {
+      if (!poses[i].valid)
+        continue;
 
-    } else {
-      p.x = (maxX * data->width) / data->i_width;
-      p.y = (maxY * data->height) / data->i_height;;
+      kpts[i * 3] = (gfloat) poses[i].x;
+      kpts[i * 3 + 1] = (gfloat) poses[i].y;
+      kpts[i * 3 + 2] = poses[i].prob;
     }
-    /* Some keypoints can be estimated slightly out of image range */
-    p.x = MIN (data->width, (guint) (MAX (0, p.x)));
-    p.y = MIN (data->height, (guint) (MAX (0, p.y)));
-
-    g_array_append_val (results, p);
+  } else {
+    for (i = 0; i < num_poses; i++)
+      draw (&out_info, data, &poses[i * pose_size]);
   }
 
-  draw (&out_info, data, results);
-  g_array_free (results, TRUE);
+  g_free (poses);
   gst_memory_unmap (out_mem, &out_info);
   if (gst_buffer_get_size (outbuf) == 0)
     gst_buffer_append_memory (outbuf, out_mem);
@@ -818,6 +1169,20 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief tensordec-plugin's TensorDecDef callback
+ *
+ * The frame is rendered into the buffer from the pool (or newly allocated if outbuf is empty).
+ */
+static GstFlowReturn
+pose_decodeBuffer (void **pdata, const GstTensorsConfig * config,
+    const GstTensorMemory * input, const GstTensorDecoderContext * context,
+    GstBuffer * outbuf)
+{
+  UNUSED (context);
+  return pose_decode (pdata, config, input, outbuf);
+}
+
 static gchar decoder_subplugin_pose_estimation[] = "pose_estimation";
 /** @brief Pose Estimation tensordec-plugin TensorDecDef instance */
 static GstTensorDecoderDef poseEstimation = {
@@ -827,14 +1192,15 @@ static GstTensorDecoderDef poseEstimation = {
   .setOption = pose_setOption,
   .getOutCaps = pose_getOutCaps,
   .getTransformSize = pose_getTransformSize,
-  .decode = pose_decode
+  .decode = pose_decode,
+  .decodeBuffer = pose_decodeBuffer
 };
 
 /** @brief Initialize this object for tensordec-plugin */
 void
 init_pose (void)
 {
-  nnstreamer_decoder_probe (&poseEstimation);
+  nnstreamer_decoder_probe_v2 (&poseEstimation, sizeof (GstTensorDecoderDef));
 }
 
 /** @brief Destruct this object for tensordec-plugin */
@@ -65,6 +65,37 @@
  *   end
  * end
  *
+ *   Accessing the elements one by one with the index is slow, because
+ * each access is a C call. The following functions process the whole
+ * tensor in C. The tensors may have different types, then the values
+ * are converted.
+ *  - tensor_copy (dst, src): dst[i] = src[i]
+ *  - tensor_scale (dst, src, mul, add): dst[i] = src[i] * mul + add
+ *  - tensor_map (dst, src, op[, min, max]): dst[i] = op (src[i]),
+ *      op is one of 'abs', 'exp', 'relu', 'sigmoid', 'tanh' and 'clamp'.
+ *  - tensor_argmax (tensor): returns the index (from 1) and the max value.
+ *  - #tensor: returns the number of elements.
+ *
+ *   An Example:
+ * function nnstreamer_invoke()
+ *   tensor_scale (output_tensor(1), input_tensor(1), 1.0 / 255.0, 0.0)
+ * end
+ *
+ *   If the sub-plugin is built with LuaJIT (luajit-support), the scripts
+ * may get the typed FFI pointer of the tensor with "input_tensor_ffi(idx)"
+ * and "output_tensor_ffi(idx)", which also return the number of elements.
+ * The pointer is indexed from 0 and valid only in "nnstreamer_invoke()".
+ * Do not write the input tensors.
+ *
+ *   An Example:
+ * function nnstreamer_invoke()
+ *   input, num = input_tensor_ffi(1)
+ *   output = output_tensor_ffi(1)
+ *   for i=0,num-1 do
+ *     output[i] = input[i]
+ *   end
+ * end
+ *
  *   In "script mode", not "file mode", the script should NOT have
  * double quote ("), and double dashes ( -- COMMENT ) for comment.
  * Use single quote and --[[ COMMENT --]] format instead.
@@ -78,8 +109,12 @@ extern "C" {
 }
 
 #include <glib.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <memory>
+#include <type_traits>
 #include <nnstreamer_cppplugin_api_filter.hh>
 #include <nnstreamer_log.h>
 #include <nnstreamer_util.h>
@@ -242,6 +277,372 @@ tensor_newindex (lua_State* L)
   return 0;
 }
 
+/**
+ * @brief Call the function with the typed pointer of the tensor data.
+ */
+template <typename F>
+static void
+with_typed_data (const lua_tensor *lt, F &&func)
+{
+  switch (lt->type) {
+    case _NNS_INT32:
+      func ((int32_t *) lt->data);
+      break;
+    case _NNS_UINT32:
+      func ((uint32_t *) lt->data);
+      break;
+    case _NNS_INT16:
+      func ((int16_t *) lt->data);
+      break;
+    case _NNS_UINT16:
+      func ((uint16_t *) lt->data);
+      break;
+    case _NNS_INT8:
+      func ((int8_t *) lt->data);
+      break;
+    case _NNS_UINT8:
+      func ((uint8_t *) lt->data);
+      break;
+    case _NNS_FLOAT64:
+      func ((double *) lt->data);
+      break;
+    case _NNS_FLOAT32:
+      func ((float *) lt->data);
+      break;
+    case _NNS_FLOAT16:
+#ifdef FLOAT16_SUPPORT
+      func ((float16 *) lt->data);
+#else
+      nns_loge
+          ("NNStreamer requires -DFLOAT16_SUPPORT as a build option to enable float16 type. This binary does not have float16 feature enabled; thus, float16 type is not supported in this instance.\n");
+      throw std::runtime_error ("Float16 not supported. Recompile with -DFLOAT16_SUPPORT.");
+#endif
+      break;
+    case _NNS_INT64:
+      func ((int64_t *) lt->data);
+      break;
+    case _NNS_UINT64:
+      func ((uint64_t *) lt->data);
+      break;
+    default:
+      throw std::runtime_error ("Invalid tensor type");
+      break;
+  }
+}
+
+/** @brief Get the max value of the floating point type */
+template <typename T>
+static inline double
+float_type_max (void)
+{
+  return (double) std::numeric_limits<T>::max ();
+}
+
+#ifdef FLOAT16_SUPPORT
+/** @brief Get the max value of float16, std::numeric_limits is not specialized for it */
+template <>
+inline double
+float_type_max<float16> (void)
+{
+  return 65504.0;
+}
+#endif
+
+/** @brief Convert the value to the integral type, NaN is 0 and the value is clamped */
+template <typename T>
+static inline T
+saturate_cast (double v, std::true_type)
+{
+  if (std::isnan (v))
+    return (T) 0;
+  if (v <= (double) std::numeric_limits<T>::lowest ())
+    return std::numeric_limits<T>::lowest ();
+  if (v >= (double) std::numeric_limits<T>::max ())
+    return std::numeric_limits<T>::max ();
+  return (T) v;
+}
+
+/** @brief Convert the value to the floating point type, a finite value is clamped */
+template <typename T>
+static inline T
+saturate_cast (double v, std::false_type)
+{
+  const double max = float_type_max<T> ();
+
+  if (std::isfinite (v))
+    v = (v < -max) ? -max : ((v > max) ? max : v);
+  return (T) v;
+}
+
+/**
+ * @brief Convert the value to the tensor type.
+ * Converting an out-of-range floating point value is undefined, the value is clamped to the range of the type.
+ */
+template <typename T>
+static inline T
+saturate_cast (double v)
+{
+  return saturate_cast<T> (v, std::is_integral<T> ());
+}
+
+/** @brief Convert the element, integers are converted directly to keep the precision of 64-bit values */
+template <typename D, typename S>
+static inline D
+convert_element (S v, std::true_type)
+{
+  return (D) v;
+}
+
+/** @brief Convert the element, with a floating point type on either side */
+template <typename D, typename S>
+static inline D
+convert_element (S v, std::false_type)
+{
+  return saturate_cast<D> ((double) v);
+}
+
+/** @brief Convert the element of the source tensor to the type of destination */
+template <typename D, typename S>
+static inline D
+convert_element (S v)
+{
+  return convert_element<D> (v, std::integral_constant<bool,
+      std::is_integral<D>::value && std::is_integral<S>::value> ());
+}
+
+/** @brief Get the number of elements in the tensor */
+static size_t
+tensor_num_elements (const lua_tensor *lt)
+{
+  uint element_size = gst_tensor_get_element_size (lt->type);
+
+  if (element_size == 0)
+    throw std::runtime_error ("Invalid tensor type");
+
+  return lt->size / element_size;
+}
+
+/** @brief Get two tensors (dst, src) having same number of elements for bulk operations */
+static size_t
+check_bulk_tensors (lua_State *L, lua_tensor **dst, lua_tensor **src)
+{
+  *dst = *((lua_tensor **) luaL_checkudata (L, 1, "lua_tensor"));
+  *src = *((lua_tensor **) luaL_checkudata (L, 2, "lua_tensor"));
+
+  size_t num = tensor_num_elements (*dst);
+  if (num != tensor_num_elements (*src))
+    throw std::runtime_error ("The number of elements in the tensors is different");
+
+  return num;
+}
+
+/** @brief For getting the number of elements in Lua (#tensor) */
+static int
+tensor_len (lua_State *L)
+{
+  lua_tensor *lt = *((lua_tensor **) luaL_checkudata (L, 1, "lua_tensor"));
+
+  lua_pushinteger (L, (lua_Integer) tensor_num_elements (lt));
+  return 1;
+}
+
+/** @brief Bulk operation in Lua: tensor_copy (dst, src) */
+static int
+tensor_copy (lua_State *L)
+{
+  lua_tensor *dst, *src;
+  size_t num = check_bulk_tensors (L, &dst, &src);
+
+  if (dst->type == src->type) {
+    if (dst->data != src->data)
+      memmove (dst->data, src->data, num * gst_tensor_get_element_size (dst->type));
+    return 0;
+  }
+
+  with_typed_data (dst, [&] (auto *d) {
+    with_typed_data (src, [&] (auto *s) {
+      using dtype = typename std::remove_pointer<decltype (d)>::type;
+      for (size_t i = 0; i < num; i++)
+        d[i] = convert_element<dtype> (s[i]);
+    });
+  });
+
+  return 0;
+}
+
+/** @brief Bulk operation in Lua: tensor_scale (dst, src, mul, add) */
+static int
+tensor_scale (lua_State *L)
+{
+  lua_tensor *dst, *src;
+  size_t num = check_bulk_tensors (L, &dst, &src);
+  double mul = luaL_checknumber (L, 3);
+  double add = luaL_optnumber (L, 4, 0.0);
+
+  if (dst->type == _NNS_FLOAT32 && src->type == _NNS_FLOAT32) {
+    /* single precision, to be vectorized */
+    float *d = (float *) dst->data;
+    const float *s = (const float *) src->data;
+    const float m = saturate_cast<float> (mul), a = saturate_cast<float> (add);
+
+    for (size_t i = 0; i < num; i++)
+      d[i] = s[i] * m + a;
+    return 0;
+  }
+
+  with_typed_data (dst, [&] (auto *d) {
+    with_typed_data (src, [&] (auto *s) {
+      using dtype = typename std::remove_pointer<decltype (d)>::type;
+      for (size_t i = 0; i < num; i++)
+        d[i] = saturate_cast<dtype> ((double) s[i] * mul + add);
+    });
+  });
+
+  return 0;
+}
+
+/** @brief Bulk operation in Lua: tensor_map (dst, src, op[, min, max]) */
+static int
+tensor_map (lua_State *L)
+{
+  lua_tensor *dst, *src;
+  size_t num = check_bulk_tensors (L, &dst, &src);
+  const char *op = luaL_checkstring (L, 3);
+  double (*func) (double) = nullptr;
+  double lower = -INFINITY, upper = INFINITY;
+
+  if (g_ascii_strcasecmp (op, "abs") == 0) {
+    func = [] (double x) { return std::fabs (x); };
+  } else if (g_ascii_strcasecmp (op, "exp") == 0) {
+    func = [] (double x) { return std::exp (x); };
+  } else if (g_ascii_strcasecmp (op, "relu") == 0) {
+    lower = 0.0;
+  } else if (g_ascii_strcasecmp (op, "sigmoid") == 0) {
+    func = [] (double x) { return 1.0 / (1.0 + std::exp (-x)); };
+  } else if (g_ascii_strcasecmp (op, "tanh") == 0) {
+    func = [] (double x) { return std::tanh (x); };
+  } else if (g_ascii_strcasecmp (op, "clamp") == 0) {
+    lower = luaL_checknumber (L, 4);
+    upper = luaL_checknumber (L, 5);
+  } else {
+    throw std::runtime_error (std::string ("Invalid operation for tensor_map: ") + op);
+  }
+
+  with_typed_data (dst, [&] (auto *d) {
+    with_typed_data (src, [&] (auto *s) {
+      using dtype = typename std::remove_pointer<decltype (d)>::type;
+      if (func) {
+        for (size_t i = 0; i < num; i++)
+          d[i] = saturate_cast<dtype> (func ((double) s[i]));
+      } else {
+        for (size_t i = 0; i < num; i++) {
+          double v = (double) s[i];
+          d[i] = saturate_cast<dtype> ((v < lower) ? lower : ((v > upper) ? upper : v));
+        }
+      }
+    });
+  });
+
+  return 0;
+}
+
+/** @brief Bulk operation in Lua: idx, value = tensor_argmax (tensor) */
+static int
+tensor_argmax (lua_State *L)
+{
+  lua_tensor *lt = *((lua_tensor **) luaL_checkudata (L, 1, "lua_tensor"));
+  size_t num = tensor_num_elements (lt);
+  size_t max_idx = 0;
+  double max_val = 0.0;
+
+  if (num == 0)
+    throw std::runtime_error ("Empty tensor for tensor_argmax");
+
+  with_typed_data (lt, [&] (auto *t) {
+    auto m = t[0];
+    for (size_t i = 1; i < num; i++) {
+      if (t[i] > m) {
+        m = t[i];
+        max_idx = i;
+      }
+    }
+    max_val = (double) m;
+  });
+
+  lua_pushinteger (L, (lua_Integer) (max_idx + 1));
+  lua_pushnumber (L, max_val);
+  return 2;
+}
+
+#ifdef LUA_JITLIBNAME
+/** @brief Get the raw pointer, FFI C type and the number of elements of the tensor for LuaJIT */
+static int
+tensor_ffi_info (lua_State *L)
+{
+  lua_tensor *lt = *((lua_tensor **) luaL_checkudata (L, 1, "lua_tensor"));
+  const char *ctype;
+
+  switch (lt->type) {
+    case _NNS_INT32:
+      ctype = "int32_t";
+      break;
+    case _NNS_UINT32:
+      ctype = "uint32_t";
+      break;
+    case _NNS_INT16:
+      ctype = "int16_t";
+      break;
+    case _NNS_UINT16:
+      ctype = "uint16_t";
+      break;
+    case _NNS_INT8:
+      ctype = "int8_t";
+      break;
+    case _NNS_UINT8:
+      ctype = "uint8_t";
+      break;
+    case _NNS_FLOAT64:
+      ctype = "double";
+      break;
+    case _NNS_FLOAT32:
+      ctype = "float";
+      break;
+    case _NNS_INT64:
+      ctype = "int64_t";
+      break;
+    case _NNS_UINT64:
+      ctype = "uint64_t";
+      break;
+    default:
+      throw std::runtime_error ("The tensor type is not supported with FFI");
+  }
+
+  lua_pushlightuserdata (L, lt->data);
+  lua_pushstring (L, ctype);
+  lua_pushinteger (L, (lua_Integer) tensor_num_elements (lt));
+  return 3;
+}
+
+/**
+ * @brief Lua functions to get the typed FFI pointer of the tensor.
+ */
+static const char *tensor_ffi_script = R""""(
+local ffi = require('ffi')
+local info = _nns_tensor_ffi_info
+_nns_tensor_ffi_info = nil
+local function typed (t)
+  local ptr, ctype, num = info(t)
+  return ffi.cast(ctype .. '*', ptr), num
+end
+function input_tensor_ffi (idx)
+  return typed(input_tensor(idx))
+end
+function output_tensor_ffi (idx)
+  return typed(output_tensor(idx))
+end
+)"""";
+#endif /* LUA_JITLIBNAME */
+
 /** @brief Expose C array to Lua */
 static int
 expose_tensor (lua_State* L, lua_tensor *tensor)
@@ -293,6 +694,7 @@ create_tensor_type (lua_State *L)
   static const struct luaL_reg tensor[] = {
     {"__index", tensor_index},
     {"__newindex", tensor_newindex},
+    {"__len", tensor_len},
     {NULL, NULL}
   };
 
@@ -300,6 +702,20 @@ create_tensor_type (lua_State *L)
   luaL_openlib (L, NULL, tensor, 0);
   lua_register (L, "input_tensor", getInputTensor);
   lua_register (L, "output_tensor", getOutputTensor);
+
+  /* bulk operations */
+  lua_register (L, "tensor_copy", tensor_copy);
+  lua_register (L, "tensor_scale", tensor_scale);
+  lua_register (L, "tensor_map", tensor_map);
+  lua_register (L, "tensor_argmax", tensor_argmax);
+
+#ifdef LUA_JITLIBNAME
+  lua_register (L, "_nns_tensor_ffi_info", tensor_ffi_info);
+  if (luaL_dostring (L, tensor_ffi_script) != 0) {
+    throw std::runtime_error (std::string ("Failed to load FFI functions. Error message: ") +
+        lua_tostring (L, -1));
+  }
+#endif
 }
 
 /** @brief lua subplugin class */
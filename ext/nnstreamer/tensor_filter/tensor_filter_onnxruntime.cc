@@ -0,0 +1,714 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * @file    tensor_filter_onnxruntime.cc
+ * @date    19 Oct 2026
+ * @brief   NNStreamer tensor-filter sub-plugin for ONNX Runtime
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs
+ *
+ * This is the per-NN-framework plugin (ONNX Runtime) for tensor_filter.
+ * The input and output tensors are bound to the session with Ort::IoBinding, without memory copy.
+ *
+ * @note Supported custom properties (e.g., custom=intra_op_threads:4,graph_optimization:extended)
+ *       intra_op_threads: the number of threads to run an operator
+ *       inter_op_threads: the number of threads to run the independent operators in parallel
+ *       graph_optimization: graph optimization level (disable, basic, extended, all)
+ *       optimized_model: the file path to save the optimized model. If the file is newer than the model, it is loaded without optimization.
+ *                        The optimized model is written to a temporary file and renamed, so that a partially written file is never loaded.
+ */
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <nnstreamer_cppplugin_api_filter.hh>
+#include <nnstreamer_log.h>
+#include <nnstreamer_plugin_api.h>
+#include <nnstreamer_util.h>
+#include <tensor_common.h>
+
+#include <onnxruntime_cxx_api.h>
+
+namespace nnstreamer
+{
+namespace tensorfilter_onnxruntime
+{
+
+G_BEGIN_DECLS
+
+void init_filter_onnxruntime (void) __attribute__ ((constructor));
+void fini_filter_onnxruntime (void) __attribute__ ((destructor));
+
+G_END_DECLS
+
+/**
+ * @brief Options to create the session of ONNX Runtime.
+ */
+typedef struct {
+  int intra_op_threads; /**< the number of intra-op threads, 0 for default */
+  int inter_op_threads; /**< the number of inter-op threads, 0 for default */
+  GraphOptimizationLevel opt_level; /**< graph optimization level */
+  std::string optimized_model; /**< the file path to save (or load) the optimized model */
+} ort_options;
+
+/**
+ * @brief Get the ONNX Runtime environment, which should be created once for the process.
+ */
+static Ort::Env &
+get_ort_env (void)
+{
+  static Ort::Env env (ORT_LOGGING_LEVEL_WARNING, "nnstreamer");
+  return env;
+}
+
+/**
+ * @brief Model representation of ONNX Runtime, which can be shared among the filter instances with the same shared key.
+ */
+class ort_model
+{
+  public:
+  ort_model (const char *path, const ort_options &options);
+  ~ort_model ();
+
+  Ort::Session session{ nullptr };
+  gchar *model_path;
+
+  GstTensorsInfo inputInfo;
+  GstTensorsInfo outputInfo;
+  std::vector<std::string> inputNames;
+  std::vector<std::string> outputNames;
+  std::vector<std::vector<int64_t>> inputShapes;
+  std::vector<std::vector<int64_t>> outputShapes;
+  std::vector<ONNXTensorElementDataType> inputTypes;
+  std::vector<ONNXTensorElementDataType> outputTypes;
+
+  private:
+  void create_session (const char *path, const Ort::SessionOptions &session_options);
+  void clear_tensors_info (void);
+  void load_tensors_info (bool is_input);
+};
+
+/**
+ * @brief Convert the element type of ONNX Runtime to tensor type.
+ */
+static tensor_type
+convert_tensor_type (ONNXTensorElementDataType type)
+{
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      return _NNS_FLOAT32;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      return _NNS_FLOAT64;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+      return _NNS_FLOAT16;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+      return _NNS_INT8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return _NNS_UINT8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+      return _NNS_INT16;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+      return _NNS_UINT16;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      return _NNS_INT32;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return _NNS_UINT32;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+      return _NNS_INT64;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+      return _NNS_UINT64;
+    default:
+      break;
+  }
+
+  return _NNS_END;
+}
+
+/**
+ * @brief Check the optimized model can be loaded instead of the original model.
+ * @return TRUE if the optimized model exists and is newer than the original model.
+ */
+static gboolean
+is_optimized_model_valid (const char *model_path, const std::string &optimized)
+{
+  GStatBuf model_stat, opt_stat;
+
+  if (optimized.empty ())
+    return FALSE;
+
+  if (g_stat (model_path, &model_stat) != 0 || g_stat (optimized.c_str (), &opt_stat) != 0)
+    return FALSE;
+
+  return (opt_stat.st_mtime >= model_stat.st_mtime && opt_stat.st_size > 0);
+}
+
+/**
+ * @brief Construct a new ONNX Runtime model representation.
+ */
+ort_model::ort_model (const char *path, const ort_options &options)
+    : model_path (g_strdup (path))
+{
+  Ort::SessionOptions session_options;
+  gchar *tmp_path = NULL;
+
+  gst_tensors_info_init (std::addressof (inputInfo));
+  gst_tensors_info_init (std::addressof (outputInfo));
+
+  if (options.intra_op_threads > 0)
+    session_options.SetIntraOpNumThreads (options.intra_op_threads);
+  if (options.inter_op_threads > 0) {
+    session_options.SetInterOpNumThreads (options.inter_op_threads);
+    if (options.inter_op_threads > 1)
+      session_options.SetExecutionMode (ExecutionMode::ORT_PARALLEL);
+  }
+
+  if (is_optimized_model_valid (path, options.optimized_model)) {
+    /* the graph is already optimized, skip the optimization for fast restart. */
+    Ort::SessionOptions opt_session_options = session_options.Clone ();
+
+    opt_session_options.SetGraphOptimizationLevel (GraphOptimizationLevel::ORT_DISABLE_ALL);
+    try {
+      create_session (options.optimized_model.c_str (), opt_session_options);
+      nns_logi ("Load the optimized model %s (original model %s).",
+          options.optimized_model.c_str (), path);
+      return;
+    } catch (const std::exception &e) {
+      nns_logw ("Failed to load the optimized model %s, optimize the model %s again: %s",
+          options.optimized_model.c_str (), path, e.what ());
+    }
+  }
+
+  session_options.SetGraphOptimizationLevel (options.opt_level);
+
+  /* save the optimized model to a temporary file, then rename it after the session is created. */
+  if (!options.optimized_model.empty ()) {
+    gint fd;
+
+    tmp_path = g_strdup_printf ("%s.XXXXXX", options.optimized_model.c_str ());
+    fd = g_mkstemp (tmp_path);
+    if (fd < 0) {
+      nns_logw ("Cannot create a temporary file to save the optimized model %s.",
+          options.optimized_model.c_str ());
+      g_free (tmp_path);
+      tmp_path = NULL;
+    } else {
+      g_close (fd, NULL);
+      session_options.SetOptimizedModelFilePath (tmp_path);
+    }
+  }
+
+  try {
+    create_session (path, session_options);
+  } catch (const std::exception &e) {
+    if (tmp_path) {
+      g_remove (tmp_path);
+      g_free (tmp_path);
+    }
+    g_free (model_path);
+    throw std::invalid_argument (
+        std::string ("Failed to load the model with ONNX Runtime: ") + e.what ());
+  }
+
+  if (tmp_path) {
+    if (g_rename (tmp_path, options.optimized_model.c_str ()) != 0) {
+      nns_logw ("Failed to save the optimized model %s.", options.optimized_model.c_str ());
+      g_remove (tmp_path);
+    }
+    g_free (tmp_path);
+  }
+}
+
+/**
+ * @brief Internal method to create the session and get the tensors info. The tensors info is cleared if failed.
+ */
+void
+ort_model::create_session (const char *path, const Ort::SessionOptions &session_options)
+{
+  try {
+    session = Ort::Session (get_ort_env (), path, session_options);
+    load_tensors_info (true);
+    load_tensors_info (false);
+  } catch (const std::exception &e) {
+    session = Ort::Session (nullptr);
+    clear_tensors_info ();
+    throw;
+  }
+}
+
+/**
+ * @brief Internal method to clear the tensors info.
+ */
+void
+ort_model::clear_tensors_info (void)
+{
+  gst_tensors_info_free (std::addressof (inputInfo));
+  gst_tensors_info_free (std::addressof (outputInfo));
+  gst_tensors_info_init (std::addressof (inputInfo));
+  gst_tensors_info_init (std::addressof (outputInfo));
+
+  inputNames.clear ();
+  outputNames.clear ();
+  inputShapes.clear ();
+  outputShapes.clear ();
+  inputTypes.clear ();
+  outputTypes.clear ();
+}
+
+/**
+ * @brief Destroy the ONNX Runtime model representation.
+ */
+ort_model::~ort_model ()
+{
+  gst_tensors_info_free (std::addressof (inputInfo));
+  gst_tensors_info_free (std::addressof (outputInfo));
+  g_free (model_path);
+}
+
+/**
+ * @brief Internal method to get the names, shapes and types of the tensors from the session.
+ */
+void
+ort_model::load_tensors_info (bool is_input)
+{
+  Ort::AllocatorWithDefaultOptions allocator;
+  GstTensorsInfo *info = is_input ? &inputInfo : &outputInfo;
+  std::vector<std::string> &names = is_input ? inputNames : outputNames;
+  std::vector<std::vector<int64_t>> &shapes = is_input ? inputShapes : outputShapes;
+  std::vector<ONNXTensorElementDataType> &types = is_input ? inputTypes : outputTypes;
+  size_t i, num;
+  int rank, j;
+
+  num = is_input ? session.GetInputCount () : session.GetOutputCount ();
+  if (num == 0 || num > NNS_TENSOR_SIZE_LIMIT)
+    throw std::invalid_argument ("The number of tensors is invalid: " + std::to_string (num));
+
+  info->num_tensors = (unsigned int) num;
+
+  for (i = 0; i < num; i++) {
+    Ort::TypeInfo type_info
+        = is_input ? session.GetInputTypeInfo (i) : session.GetOutputTypeInfo (i);
+
+    if (type_info.GetONNXType () != ONNX_TYPE_TENSOR)
+      throw std::invalid_argument ("Non-tensor type is not supported.");
+
+    auto tensor_info = type_info.GetTensorTypeAndShapeInfo ();
+    std::vector<int64_t> shape = tensor_info.GetShape ();
+    ONNXTensorElementDataType type = tensor_info.GetElementType ();
+
+#if ORT_API_VERSION >= 13
+    Ort::AllocatedStringPtr name = is_input ?
+        session.GetInputNameAllocated (i, allocator) :
+        session.GetOutputNameAllocated (i, allocator);
+    names.emplace_back (name.get ());
+#else
+    char *name = is_input ? session.GetInputName (i, allocator) :
+                            session.GetOutputName (i, allocator);
+    names.emplace_back (name);
+    allocator.Free (name);
+#endif
+
+    info->info[i].type = convert_tensor_type (type);
+    if (info->info[i].type == _NNS_END)
+      throw std::invalid_argument ("Unsupported element type of tensor " + names.back ());
+
+    rank = (int) shape.size ();
+    if (rank > NNS_TENSOR_RANK_LIMIT)
+      throw std::invalid_argument ("The rank of tensor " + names.back () + " exceeds the limit.");
+
+    /* dynamic dimension is fixed to 1 (e.g., batch) */
+    for (j = 0; j < rank; j++) {
+      if (shape[j] <= 0)
+        shape[j] = 1;
+    }
+
+    /* the dimension of nnstreamer is in reverse order */
+    for (j = 0; j < rank; j++)
+      info->info[i].dimension[j] = (uint32_t) shape[rank - j - 1];
+    for (; j < NNS_TENSOR_RANK_LIMIT; j++)
+      info->info[i].dimension[j] = 1;
+
+    info->info[i].name = g_strdup (names.back ().c_str ());
+    shapes.push_back (shape);
+    types.push_back (type);
+  }
+}
+
+/**
+ * @brief Callback to destroy the shared model representation.
+ */
+static void
+free_ort_model (void *model)
+{
+  delete static_cast<ort_model *> (model);
+}
+
+G_LOCK_DEFINE_STATIC (slock);
+
+/**
+ * @brief Class for ONNX Runtime subplugin.
+ */
+class onnxruntime_subplugin final : public tensor_filter_subplugin
+{
+  private:
+  ort_model *model;
+  gchar *shared_key; /**< the key of shared model representation, NULL if not shared */
+  ort_options options;
+  Ort::MemoryInfo memory_info{ nullptr };
+  std::unique_ptr<Ort::IoBinding> binding;
+
+  static const char *name;
+  static const accl_hw hw_list[];
+  static const int num_hw = 1;
+  static onnxruntime_subplugin *registeredRepresentation;
+
+  bool parse_custom_prop (const char *custom_prop);
+  void load_model (const GstTensorFilterProperties *prop);
+  void cleanup () noexcept;
+
+  public:
+  static void init_filter_onnxruntime ();
+  static void fini_filter_onnxruntime ();
+
+  onnxruntime_subplugin ();
+  ~onnxruntime_subplugin ();
+
+  tensor_filter_subplugin &getEmptyInstance ();
+  void configure_instance (const GstTensorFilterProperties *prop);
+  void invoke (const GstTensorMemory *input, GstTensorMemory *output);
+  void getFrameworkInfo (GstTensorFilterFrameworkInfo &info);
+  int getModelInfo (model_info_ops ops, GstTensorsInfo &in_info, GstTensorsInfo &out_info);
+  int eventHandler (event_ops ops, GstTensorFilterFrameworkEventData &data);
+};
+
+const char *onnxruntime_subplugin::name = "onnxruntime";
+const accl_hw onnxruntime_subplugin::hw_list[] = { ACCL_CPU };
+
+/**
+ * @brief Construct a new onnxruntime subplugin object
+ */
+onnxruntime_subplugin::onnxruntime_subplugin ()
+    : tensor_filter_subplugin (), model (nullptr), shared_key (nullptr)
+{
+  options.intra_op_threads = 0;
+  options.inter_op_threads = 0;
+  options.opt_level = GraphOptimizationLevel::ORT_ENABLE_ALL;
+}
+
+/**
+ * @brief Cleanup method for onnxruntime subplugin
+ */
+void
+onnxruntime_subplugin::cleanup () noexcept
+{
+  binding.reset ();
+
+  if (model) {
+    if (shared_key) {
+      G_LOCK (slock);
+      if (!nnstreamer_filter_shared_model_remove (this, shared_key, free_ort_model))
+        nns_loge ("Failed to remove the shared model (key %s).", shared_key);
+      G_UNLOCK (slock);
+    } else {
+      delete model;
+    }
+  }
+
+  g_free (shared_key);
+  shared_key = nullptr;
+  model = nullptr;
+}
+
+/**
+ * @brief Destroy the onnxruntime subplugin object
+ */
+onnxruntime_subplugin::~onnxruntime_subplugin ()
+{
+  cleanup ();
+}
+
+/**
+ * @brief Method to get an empty object
+ */
+tensor_filter_subplugin &
+onnxruntime_subplugin::getEmptyInstance ()
+{
+  return *(new onnxruntime_subplugin ());
+}
+
+/**
+ * @brief Internal method to parse custom properties
+ * @param custom_prop Given c_str value of 'custom' property
+ */
+bool
+onnxruntime_subplugin::parse_custom_prop (const char *custom_prop)
+{
+  gchar **options_str = NULL;
+  guint len_opt = 0;
+  bool invalid_option = false;
+
+  if (custom_prop != nullptr) {
+    options_str = g_strsplit (custom_prop, ",", -1);
+    len_opt = g_strv_length (options_str);
+  }
+
+  for (guint op = 0; op < len_opt && !invalid_option; ++op) {
+    gchar **option = g_strsplit (options_str[op], ":", 2);
+
+    if (g_strv_length (option) > 1) {
+      g_strstrip (option[0]);
+      g_strstrip (option[1]);
+
+      if (g_ascii_strcasecmp (option[0], "intra_op_threads") == 0
+          || g_ascii_strcasecmp (option[0], "inter_op_threads") == 0) {
+        gchar *endptr = NULL;
+        gint64 val = g_ascii_strtoll (option[1], &endptr, 10);
+
+        if (endptr == option[1] || *endptr != '\0' || val < 0 || val > G_MAXINT) {
+          nns_loge ("Invalid number of threads (%s).", options_str[op]);
+          invalid_option = true;
+        } else if (g_ascii_strcasecmp (option[0], "intra_op_threads") == 0) {
+          options.intra_op_threads = (int) val;
+        } else {
+          options.inter_op_threads = (int) val;
+        }
+      } else if (g_ascii_strcasecmp (option[0], "graph_optimization") == 0) {
+        if (g_ascii_strcasecmp (option[1], "disable") == 0) {
+          options.opt_level = GraphOptimizationLevel::ORT_DISABLE_ALL;
+        } else if (g_ascii_strcasecmp (option[1], "basic") == 0) {
+          options.opt_level = GraphOptimizationLevel::ORT_ENABLE_BASIC;
+        } else if (g_ascii_strcasecmp (option[1], "extended") == 0) {
+          options.opt_level = GraphOptimizationLevel::ORT_ENABLE_EXTENDED;
+        } else if (g_ascii_strcasecmp (option[1], "all") == 0) {
+          options.opt_level = GraphOptimizationLevel::ORT_ENABLE_ALL;
+        } else {
+          nns_loge ("Unknown graph optimization level (%s).", option[1]);
+          invalid_option = true;
+        }
+      } else if (g_ascii_strcasecmp (option[0], "optimized_model") == 0) {
+        options.optimized_model = option[1];
+      } else {
+        nns_logw ("Unknown option (%s).", options_str[op]);
+      }
+    }
+
+    g_strfreev (option);
+  }
+
+  if (options_str)
+    g_strfreev (options_str);
+
+  return !invalid_option;
+}
+
+/**
+ * @brief Internal method to load the model, or get the shared model representation with the same key.
+ */
+void
+onnxruntime_subplugin::load_model (const GstTensorFilterProperties *prop)
+{
+  const char *path = prop->model_files[0];
+
+  if (!prop->shared_tensor_filter_key) {
+    model = new ort_model (path, options);
+    return;
+  }
+
+  G_LOCK (slock);
+  model = static_cast<ort_model *> (
+      nnstreamer_filter_shared_model_get (this, prop->shared_tensor_filter_key));
+
+  if (model) {
+    if (g_strcmp0 (path, model->model_path) != 0) {
+      nns_logw ("The model paths are not equal, models are not shared.");
+      nnstreamer_filter_shared_model_remove (this, prop->shared_tensor_filter_key, free_ort_model);
+      G_UNLOCK (slock);
+      model = new ort_model (path, options);
+      return;
+    }
+
+    nns_logd ("The model representation is shared: key=[%s]", prop->shared_tensor_filter_key);
+  } else {
+    ort_model *new_model;
+
+    try {
+      new_model = new ort_model (path, options);
+    } catch (...) {
+      G_UNLOCK (slock);
+      throw;
+    }
+
+    shared_key = g_strdup (prop->shared_tensor_filter_key);
+    model = static_cast<ort_model *> (
+        nnstreamer_filter_shared_model_insert_and_get (this, shared_key, new_model));
+    if (!model) {
+      nns_loge ("Failed to insert the model representation (key %s).", shared_key);
+      g_free (shared_key);
+      shared_key = nullptr;
+      model = new_model;
+    }
+    G_UNLOCK (slock);
+    return;
+  }
+
+  shared_key = g_strdup (prop->shared_tensor_filter_key);
+  G_UNLOCK (slock);
+}
+
+/**
+ * @brief Configure onnxruntime instance
+ */
+void
+onnxruntime_subplugin::configure_instance (const GstTensorFilterProperties *prop)
+{
+  if (!parse_custom_prop (prop->custom_properties)) {
+    nns_loge ("Failed to parse custom property.");
+    throw std::invalid_argument ("Failed to parse custom property.");
+  }
+
+  if (prop->num_models != 1 || !prop->model_files[0] || prop->model_files[0][0] == '\0') {
+    nns_loge ("Model path is not given.");
+    throw std::invalid_argument ("Model path is not given.");
+  }
+
+  if (!g_file_test (prop->model_files[0], G_FILE_TEST_IS_REGULAR)) {
+    const std::string err_msg
+        = "Given file " + (std::string) prop->model_files[0] + " is not valid";
+    nns_loge ("%s", err_msg.c_str ());
+    throw std::invalid_argument (err_msg);
+  }
+
+  cleanup ();
+  load_model (prop);
+
+  memory_info = Ort::MemoryInfo::CreateCpu (OrtArenaAllocator, OrtMemTypeDefault);
+  binding.reset (new Ort::IoBinding (model->session));
+}
+
+/**
+ * @brief Invoke onnxruntime instance
+ */
+void
+onnxruntime_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
+{
+  std::vector<Ort::Value> values;
+  unsigned int i;
+
+  if (!model || !binding)
+    throw std::runtime_error ("The model is not configured.");
+
+  values.reserve (model->inputInfo.num_tensors + model->outputInfo.num_tensors);
+  binding->ClearBoundInputs ();
+  binding->ClearBoundOutputs ();
+
+  /* bind the tensor memory directly, ONNX Runtime reads and writes the buffers without copy. */
+  for (i = 0; i < model->inputInfo.num_tensors; i++) {
+    values.emplace_back (Ort::Value::CreateTensor (memory_info, input[i].data,
+        input[i].size, model->inputShapes[i].data (), model->inputShapes[i].size (),
+        model->inputTypes[i]));
+    binding->BindInput (model->inputNames[i].c_str (), values.back ());
+  }
+
+  for (i = 0; i < model->outputInfo.num_tensors; i++) {
+    values.emplace_back (Ort::Value::CreateTensor (memory_info, output[i].data,
+        output[i].size, model->outputShapes[i].data (),
+        model->outputShapes[i].size (), model->outputTypes[i]));
+    binding->BindOutput (model->outputNames[i].c_str (), values.back ());
+  }
+
+  model->session.Run (Ort::RunOptions{ nullptr }, *binding);
+}
+
+/**
+ * @brief Get onnxruntime frameworks info
+ */
+void
+onnxruntime_subplugin::getFrameworkInfo (GstTensorFilterFrameworkInfo &info)
+{
+  info.name = name;
+  info.allow_in_place = 0;
+  info.allocate_in_invoke = 0;
+  info.run_without_model = 0;
+  info.verify_model_path = 1;
+  info.hw_list = hw_list;
+  info.num_hw = num_hw;
+}
+
+/**
+ * @brief Get onnxruntime model information
+ */
+int
+onnxruntime_subplugin::getModelInfo (
+    model_info_ops ops, GstTensorsInfo &in_info, GstTensorsInfo &out_info)
+{
+  if (ops == GET_IN_OUT_INFO && model) {
+    gst_tensors_info_copy (std::addressof (in_info), std::addressof (model->inputInfo));
+    gst_tensors_info_copy (std::addressof (out_info), std::addressof (model->outputInfo));
+    return 0;
+  }
+
+  return -ENOENT;
+}
+
+/**
+ * @brief Method to handle the event
+ */
+int
+onnxruntime_subplugin::eventHandler (event_ops ops, GstTensorFilterFrameworkEventData &data)
+{
+  UNUSED (ops);
+  UNUSED (data);
+  return -ENOENT;
+}
+
+onnxruntime_subplugin *onnxruntime_subplugin::registeredRepresentation = nullptr;
+
+/**
+ * @brief Initialize the object for runtime register
+ */
+void
+onnxruntime_subplugin::init_filter_onnxruntime (void)
+{
+  registeredRepresentation
+      = tensor_filter_subplugin::register_subplugin<onnxruntime_subplugin> ();
+  nnstreamer_filter_set_custom_property_desc (name, "intra_op_threads",
+      "The number of threads to run an operator (0 for default)", "inter_op_threads",
+      "The number of threads to run the independent operators in parallel (0 for default)",
+      "graph_optimization", "Graph optimization level (disable, basic, extended, all)",
+      "optimized_model", "File path to save the optimized model, which is loaded without optimization next time",
+      NULL);
+}
+
+/**
+ * @brief Destruct the subplugin
+ */
+void
+onnxruntime_subplugin::fini_filter_onnxruntime (void)
+{
+  assert (registeredRepresentation != nullptr);
+  tensor_filter_subplugin::unregister_subplugin (registeredRepresentation);
+}
+
+/**
+ * @brief initializer
+ */
+void
+init_filter_onnxruntime ()
+{
+  onnxruntime_subplugin::init_filter_onnxruntime ();
+}
+
+/**
+ * @brief finalizer
+ */
+void
+fini_filter_onnxruntime ()
+{
+  onnxruntime_subplugin::fini_filter_onnxruntime ();
+}
+
+} /* namespace tensorfilter_onnxruntime */
+} /* namespace nnstreamer */
@@ -59,6 +59,7 @@ std::map<accl_hw, std::string> TensorFilterOpenvino::_nnsAcclHwToOVDevMap = {
 
 const std::string TensorFilterOpenvino::extBin = ".bin";
 const std::string TensorFilterOpenvino::extXml = ".xml";
+const guint TensorFilterOpenvino::maxNumRequests = 16;
 
 /**
  * @brief Convert the string representing the tensor data type to _nns_tensor_type
@@ -181,6 +182,9 @@ TensorFilterOpenvino::TensorFilterOpenvino (std::string pathModelXml, std::strin
   this->_outputsDataMap = (this->_networkCNN).getOutputsInfo ();
   this->_isLoaded = false;
   this->_hw = ACCL_NONE;
+  this->_idleRequests = g_async_queue_new ();
+  this->_numRequests = 0;
+  this->_numThreads = 0;
 }
 
 /**
@@ -189,7 +193,108 @@ TensorFilterOpenvino::TensorFilterOpenvino (std::string pathModelXml, std::strin
  */
 TensorFilterOpenvino::~TensorFilterOpenvino ()
 {
-  ;
+  g_async_queue_unref (this->_idleRequests);
+}
+
+/**
+ * @brief Parse the unsigned integer value of the custom property
+ * @return TRUE if the whole string is a number in the range [min, max]
+ */
+static gboolean
+ov_parse_uint (const gchar *str, guint64 min, guint64 max, guint64 *val)
+{
+  gchar *endptr = NULL;
+
+  if (str == NULL || !g_ascii_isdigit (str[0]))
+    return FALSE;
+
+  *val = g_ascii_strtoull (str, &endptr, 10);
+  if (endptr == NULL || *endptr != '\0')
+    return FALSE;
+
+  return (*val >= min && *val <= max);
+}
+
+/**
+ * @brief Parse the custom properties to configure the infer requests and the CPU plugin
+ * @param custom_props the custom properties of tensor_filter, e.g., "num_requests:4,num_streams:auto,num_threads:8"
+ * @return 0 (TensorFilterOpenvino::RetSuccess) if OK, negative values if error
+ * @note This should be called before loading the model.
+ *       num_requests: the number of infer requests to run concurrently (0 or 'auto' to use the optimal number of the device, default 'auto')
+ *       num_streams: the number of CPU throughput streams ('auto' to let the plugin decide)
+ *       num_threads: the number of CPU threads for inference
+ */
+int
+TensorFilterOpenvino::parseCustomProperties (const char *custom_props)
+{
+  gchar **options;
+  guint i, len;
+  guint64 val;
+  int ret = RetSuccess;
+
+  if (custom_props == NULL)
+    return RetSuccess;
+
+  if (this->_isLoaded) {
+    ml_loge ("Cannot configure the OpenVino plugin after the model is loaded.");
+    return RetEBusy;
+  }
+
+  options = g_strsplit (custom_props, ",", -1);
+  len = g_strv_length (options);
+
+  for (i = 0; i < len && ret == RetSuccess; ++i) {
+    gchar **option = g_strsplit (options[i], ":", -1);
+
+    if (g_strv_length (option) != 2) {
+      if (g_strv_length (option) > 0 && g_strstrip (option[0])[0] != '\0') {
+        ml_loge ("Invalid custom property of the OpenVino plugin: %s", options[i]);
+        ret = RetEInval;
+      }
+      g_strfreev (option);
+      continue;
+    }
+
+    g_strstrip (option[0]);
+    g_strstrip (option[1]);
+
+    if (g_ascii_strcasecmp (option[0], "num_requests") == 0) {
+      if (g_ascii_strcasecmp (option[1], "auto") == 0) {
+        this->_numRequests = 0;
+      } else if (ov_parse_uint (option[1], 0,
+                     TensorFilterOpenvino::maxNumRequests, &val)) {
+        this->_numRequests = (guint) val;
+      } else {
+        ml_loge ("Invalid number of infer requests: %s (should be 'auto' or 0 to %u)",
+            option[1], TensorFilterOpenvino::maxNumRequests);
+        ret = RetEInval;
+      }
+    } else if (g_ascii_strcasecmp (option[0], "num_streams") == 0) {
+      if (g_ascii_strcasecmp (option[1], "auto") == 0) {
+        this->_numStreams = CONFIG_VALUE (CPU_THROUGHPUT_AUTO);
+      } else if (ov_parse_uint (option[1], 1, G_MAXINT, &val)) {
+        this->_numStreams = std::to_string (val);
+      } else {
+        ml_loge ("Invalid number of streams: %s (should be 'auto' or a positive number)",
+            option[1]);
+        ret = RetEInval;
+      }
+    } else if (g_ascii_strcasecmp (option[0], "num_threads") == 0) {
+      if (ov_parse_uint (option[1], 1, G_MAXINT, &val)) {
+        this->_numThreads = (guint) val;
+      } else {
+        ml_loge ("Invalid number of threads: %s (should be a positive number)", option[1]);
+        ret = RetEInval;
+      }
+    } else {
+      ml_logw ("Unknown custom property of the OpenVino plugin: %s", option[0]);
+    }
+
+    g_strfreev (option);
+  }
+
+  g_strfreev (options);
+  return ret;
 }
 
 /**
@@ -203,6 +308,8 @@ TensorFilterOpenvino::loadModel (accl_hw hw)
   std::string targetDevice;
   std::vector<std::string> strVector;
   std::vector<std::string>::iterator strVectorIter;
+  std::map<std::string, std::string> config;
+  guint numRequests, i;
 
   if (this->_isLoaded) {
     /** @todo Can OpenVino support to replace the loaded model with a new one? */
@@ -230,12 +337,40 @@ TensorFilterOpenvino::loadModel (accl_hw hw)
         _nnsAcclHwToOVDevMap[hw]);
   }
 #endif
+  if (hw == ACCL_CPU) {
+    if (!this->_numStreams.empty ())
+      config[CONFIG_KEY (CPU_THROUGHPUT_STREAMS)] = this->_numStreams;
+    if (this->_numThreads > 0)
+      config[CONFIG_KEY (CPU_THREADS_NUM)] = std::to_string (this->_numThreads);
+  }
+
   /** @todo Catch the IE exception */
-  this->_executableNet
-      = this->_ieCore.LoadNetwork (this->_networkCNN, _nnsAcclHwToOVDevMap[hw]);
+  this->_executableNet = this->_ieCore.LoadNetwork (
+      this->_networkCNN, _nnsAcclHwToOVDevMap[hw], config);
   this->_hw = hw;
   this->_isLoaded = true;
-  this->_inferRequest = this->_executableNet.CreateInferRequest ();
+
+  numRequests = this->_numRequests;
+  if (numRequests == 0) {
+    try {
+      numRequests = this->_executableNet
+                        .GetMetric (METRIC_KEY (OPTIMAL_NUMBER_OF_INFER_REQUESTS))
+                        .as<unsigned int> ();
+    } catch (const std::exception &e) {
+      ml_logw ("Failed to get the optimal number of infer requests: %s", e.what ());
+      numRequests = 1;
+    }
+    numRequests = CLAMP (numRequests, 1U, TensorFilterOpenvino::maxNumRequests);
+  }
+
+  /**
+   * The optimal number of the device follows the number of throughput streams (num_streams of CPU).
+   * The infer requests are started asynchronously, so that concurrent invokes do not wait for each other.
+   */
+  for (i = 0; i < numRequests; ++i) {
+    this->_inferRequests.push_back (this->_executableNet.CreateInferRequest ());
+    g_async_queue_push (this->_idleRequests, GUINT_TO_POINTER (i + 1));
+  }
 
   return RetSuccess;
 }
@@ -394,6 +529,9 @@ failed:
  * @param[in] input the array of input tensors
  * @param[out] output the array of output tensors
  * @return RetSuccess if OK. non-zero if error
+ * @note This takes an idle infer request from the pool (waits if all requests are running) and runs it asynchronously.
+ *       Thus, the invokes from multiple threads (e.g., tensor_filter instances sharing the model) run on the device streams at the same time.
+ *       The invoke returns the output of the given input, so the buffers of a single stream are not pipelined.
  */
 int
 TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
@@ -401,8 +539,10 @@ TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
 {
   InferenceEngine::BlobMap inBlobMap;
   InferenceEngine::BlobMap outBlobMap;
+  InferenceEngine::StatusCode status;
   guint num_tensors;
-  guint i;
+  guint i, idx;
+  int ret = RetSuccess;
 
   num_tensors = (prop->input_meta).num_tensors;
   for (i = 0; i < num_tensors; ++i) {
@@ -415,24 +555,44 @@ TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
     }
     inBlobMap.insert (make_pair (std::string (info->name), blob));
   }
-  this->_inferRequest.SetInput (inBlobMap);
 
   num_tensors = (prop->output_meta).num_tensors;
   for (i = 0; i < num_tensors; ++i) {
     const GstTensorInfo *info = &((prop->output_meta).info[i]);
     InferenceEngine::Blob::Ptr blob = convertGstTensorMemoryToBlobPtr (
         this->_outputTensorDescs[i], &(output[i]), prop->output_meta.info[i].type);
-    outBlobMap.insert (make_pair (std::string (info->name), blob));
     if (blob == nullptr) {
       ml_loge ("Failed to create a blob for the output tensor: %u", i);
       return RetEInval;
     }
+    outBlobMap.insert (make_pair (std::string (info->name), blob));
+  }
+
+  if (this->_inferRequests.empty ()) {
+    ml_loge ("The model is not loaded, there is no infer request to run.");
+    return RetEInval;
   }
-  this->_inferRequest.SetOutput (outBlobMap);
 
-  this->_inferRequest.Infer ();
+  idx = GPOINTER_TO_UINT (g_async_queue_pop (this->_idleRequests)) - 1;
+  InferenceEngine::InferRequest &request = this->_inferRequests[idx];
 
-  return RetSuccess;
+  try {
+    request.SetInput (inBlobMap);
+    request.SetOutput (outBlobMap);
+    request.StartAsync ();
+    status = request.Wait (InferenceEngine::IInferRequest::WaitMode::RESULT_READY);
+    if (status != InferenceEngine::StatusCode::OK) {
+      ml_loge ("Failed to run the infer request (status %d)", (int) status);
+      ret = RetEInval;
+    }
+  } catch (const std::exception &e) {
+    ml_loge ("Failed to run the infer request: %s", e.what ());
+    ret = RetEInval;
+  }
+
+  g_async_queue_push (this->_idleRequests, GUINT_TO_POINTER (idx + 1));
+
+  return ret;
 }
 
 /**
@@ -594,6 +754,9 @@ ov_open (const GstTensorFilterProperties *prop, void **private_data)
   tfOv = new TensorFilterOpenvino (model_path_xml, model_path_bin);
   *private_data = tfOv;
 
+  if (tfOv->parseCustomProperties (prop->custom_properties) != TensorFilterOpenvino::RetSuccess)
+    return TensorFilterOpenvino::RetEInval;
+
   return tfOv->loadModel (accelerator);
 }
 
@@ -641,6 +804,11 @@ void
 init_filter_openvino (void)
 {
   nnstreamer_filter_probe (&NNS_support_openvino);
+
+  nnstreamer_filter_set_custom_property_desc (filter_subplugin_openvino,
+      "num_requests", "The number of infer requests to run concurrently (0 or 'auto' for the optimal number of the device, default 'auto')",
+      "num_streams", "The number of CPU throughput streams ('auto' to let the CPU plugin decide)",
+      "num_threads", "The number of CPU threads for inference", NULL);
 }
 
 /**
@@ -66,8 +66,12 @@ public:
   TensorFilterOpenvino (std::string path_model_xml, std::string path_model_bin);
   ~TensorFilterOpenvino ();
 
+  int parseCustomProperties (const char *custom_props);
   /** @todo Need to support other acceleration devices */
   int loadModel (accl_hw hw);
+  guint getNumRequests () {
+    return (guint) _inferRequests.size ();
+  }
   bool isModelLoaded () {
     return _isLoaded;
   }
@@ -83,6 +87,7 @@ public:
 
   static const std::string extBin;
   static const std::string extXml;
+  static const guint maxNumRequests;
 
 protected:
   InferenceEngine::InputsDataMap _inputsDataMap;
@@ -97,13 +102,17 @@ private:
   InferenceEngine::TensorDesc _inputTensorDescs[NNS_TENSOR_SIZE_LIMIT];
   InferenceEngine::TensorDesc _outputTensorDescs[NNS_TENSOR_SIZE_LIMIT];
   InferenceEngine::ExecutableNetwork _executableNet;
-  InferenceEngine::InferRequest _inferRequest;
+  std::vector<InferenceEngine::InferRequest> _inferRequests;
+  GAsyncQueue *_idleRequests; /**< indices (starting from 1) of the infer requests not in use */
   static std::map<accl_hw, std::string> _nnsAcclHwToOVDevMap;
 
   std::string _pathModelXml;
   std::string _pathModelBin;
   bool _isLoaded;
   accl_hw _hw;
+  guint _numRequests; /**< the number of infer requests, 0 to use the optimal number of the device */
+  std::string _numStreams; /**< the number of CPU throughput streams (empty to use the default of the plugin) */
+  guint _numThreads; /**< the number of CPU threads (0 to use the default of the plugin) */
 };
 
 #endif /* __TENSOR_FILTER_OPENVINO_H__ */
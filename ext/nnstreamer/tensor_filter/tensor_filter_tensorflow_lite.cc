@@ -30,6 +30,10 @@
 #include <limits.h>
 #include <thread>
 #include <unistd.h>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api_util.h>
@@ -127,6 +131,11 @@ typedef struct {
   gint num_threads; /**< the number of threads */
   const gchar *ext_delegate_path; /**< path to external delegate lib */
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
+  const gchar *cache_path; /**< directory to persist the compiled model of delegate */
+  const unsigned int *cpu_affinity; /**< CPUs to run the invoke and the worker threads */
+  unsigned int num_cpu_affinity; /**< the number of CPUs in cpu_affinity */
+  int map_flags; /**< hints to map the model file (nns_model_map_flags) */
+  gboolean async_reload; /**< TRUE to reload the model in background */
 } tflite_option_s;
 
 /**
@@ -148,6 +157,22 @@ static GstTensorFilterFrameworkStatistics tflite_internal_stats = {
   .total_overhead_latency = 0,
 };
 
+/**
+ * @brief Pin the calling thread to given CPUs while the object exists, so that the worker threads created by tensorflow-lite (e.g., thread pool of XNNPACK delegate) inherit the CPU affinity.
+ */
+class TFLiteThreadPinning
+{
+  public:
+  TFLiteThreadPinning (const std::vector<unsigned int> &cpus);
+  ~TFLiteThreadPinning ();
+
+  private:
+#if defined(__linux__)
+  cpu_set_t saved; /**< CPU affinity of the thread before pinning */
+  bool pinned; /**< true if the thread is pinned and should be restored */
+#endif
+};
+
 /**
  * @brief Wrapper class for TFLite Interpreter to support model switching
  */
@@ -159,6 +184,7 @@ class TFLiteInterpreter
 
   int invoke (const GstTensorMemory *input, GstTensorMemory *output);
   int loadModel (int num_threads, tflite_delegate_e delegate);
+  int warmup ();
 
   int setInputTensorProp ();
   int setOutputTensorProp ();
@@ -167,6 +193,17 @@ class TFLiteInterpreter
   void setModelPath (const char *model_path);
   void setExtDelegate (const char *lib_path, GHashTable *key_val);
   void getExtDelegate (const char **lib_path, GHashTable **key_val);
+  void setCachePath (const char *path);
+  /** @brief set the hints to map the model file */
+  void setModelMapFlags (int flags)
+  {
+    map_flags = flags;
+  }
+  /** @brief get the hints to map the model file */
+  int getModelMapFlags ()
+  {
+    return map_flags;
+  }
   /** @brief get current model path */
   const char *getModelPath ()
   {
@@ -216,6 +253,9 @@ class TFLiteInterpreter
   bool is_xnnpack_delegated; /**< To check if XNNPACK delegate is used */
   char *ext_delegate_path; /**< path to external delegate lib */
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
+  char *cache_path; /**< directory to persist the compiled model of delegate */
+  GstTensorFilterModelMap *model_map; /**< the mapped model file, shared in the page cache */
+  int map_flags; /**< hints to map the model file */
 
   std::unique_ptr<tflite::Interpreter> interpreter;
   std::unique_ptr<tflite::FlatBufferModel> model;
@@ -249,6 +289,7 @@ class TFLiteCore
   int getOutputTensorDim (GstTensorsInfo *info);
   int setInputTensorDim (const GstTensorsInfo *info);
   int reloadModel (const char *model_path);
+  int reloadModelSync (const char *model_path);
   int invoke (const GstTensorMemory *input, GstTensorMemory *output);
   /** @brief cache input and output tensor ptr before invoke */
   int cacheInOutTensorPtr ();
@@ -259,15 +300,19 @@ class TFLiteCore
 
   private:
   int num_threads;
+  std::vector<unsigned int> cpu_affinity;
   accl_hw accelerator;
   tflite_delegate_e delegate;
 
   TFLiteInterpreter *interpreter;
-  TFLiteInterpreter *interpreter_sub;
+  GMutex swap_lock; /**< lock to get or swap the interpreter */
+  gboolean async_reload; /**< TRUE to reload the model in background */
+  GThreadPool *reload_pool; /**< the thread to reload the model in background */
 
   gchar *shared_tensor_filter_key;
   gboolean checkSharedInterpreter (const GstTensorFilterProperties *prop);
   int reloadInterpreter (TFLiteInterpreter * new_interpreter);
+  TFLiteInterpreter *buildInterpreter (const char *model_path);
   void setAccelerator (const char *accelerators, tflite_delegate_e d);
 };
 
@@ -278,6 +323,42 @@ void fini_filter_tflite (void) __attribute__ ((destructor));
 
 G_LOCK_DEFINE_STATIC (slock);
 
+/**
+ * @brief TFLiteThreadPinning constructor
+ */
+TFLiteThreadPinning::TFLiteThreadPinning (const std::vector<unsigned int> &cpus)
+{
+#if defined(__linux__)
+  pinned = false;
+
+  if (!cpus.empty ()
+      && pthread_getaffinity_np (pthread_self (), sizeof (saved), &saved) == 0) {
+    cpu_set_t cpuset;
+
+    CPU_ZERO (&cpuset);
+    for (unsigned int cpu : cpus) {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET (cpu, &cpuset);
+    }
+
+    pinned = (pthread_setaffinity_np (pthread_self (), sizeof (cpuset), &cpuset) == 0);
+  }
+#else
+  UNUSED (cpus);
+#endif
+}
+
+/**
+ * @brief TFLiteThreadPinning destructor, restores the CPU affinity of the thread.
+ */
+TFLiteThreadPinning::~TFLiteThreadPinning ()
+{
+#if defined(__linux__)
+  if (pinned)
+    pthread_setaffinity_np (pthread_self (), sizeof (saved), &saved);
+#endif
+}
+
 /**
  * @brief TFLiteInterpreter constructor
  */
@@ -289,6 +370,9 @@ TFLiteInterpreter::TFLiteInterpreter ()
   model_path = nullptr;
   ext_delegate_path = nullptr;
   ext_delegate_kv_table = nullptr;
+  cache_path = nullptr;
+  model_map = nullptr;
+  map_flags = NNS_MODEL_MAP_DEFAULT;
 
   g_mutex_init (&mutex);
 
@@ -304,9 +388,15 @@ TFLiteInterpreter::TFLiteInterpreter ()
  */
 TFLiteInterpreter::~TFLiteInterpreter ()
 {
+  /* the model refers to the mapped data, release it first */
+  interpreter = nullptr;
+  model = nullptr;
+  nnstreamer_filter_model_unmap (model_map);
+
   g_mutex_clear (&mutex);
   g_free (model_path);
   g_free (ext_delegate_path);
+  g_free (cache_path);
   if (ext_delegate_kv_table)
     g_hash_table_unref(ext_delegate_kv_table);
 
@@ -395,6 +485,34 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
   return 0;
 }
 
+/**
+ * @brief Invoke the model once with zero-filled input, to run the first (slow) invoke before the stream uses this interpreter.
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteInterpreter::warmup ()
+{
+  TfLiteTensor *tensor_ptr;
+
+  for (unsigned int i = 0; i < inputTensorMeta.num_tensors; ++i) {
+    tensor_ptr = inputTensorPtr[i];
+    if (tensor_ptr->data.raw)
+      memset (tensor_ptr->data.raw, 0, tensor_ptr->bytes);
+  }
+
+  if (interpreter->Invoke () != kTfLiteOk) {
+    ml_loge ("Failed to invoke");
+    return -1;
+  }
+
+  /* the delegate may reallocate the tensors in the first invoke */
+  if (cacheInOutTensorPtr () != 0)
+    return -1;
+
+  is_cached_after_first_invoke = true;
+  return 0;
+}
+
 /**
  * @brief Internal implementation of TFLiteCore's loadModel()
  * @return 0 if OK. non-zero if error.
@@ -403,14 +521,33 @@ int
 TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
 {
   TfLiteDelegate *delegate;
+  GstTensorFilterModelMap *new_map;
+  const void *model_data;
+  size_t model_size = 0;
 #if (DBG)
   gint64 start_time, stop_time;
   start_time = g_get_monotonic_time ();
 #endif
 
-  model = tflite::FlatBufferModel::BuildFromFile (model_path);
-  if (!model) {
+  /**
+   * Build the model from the read-only mapping of the file, which is shared
+   * through the page cache among the processes loading the same model.
+   */
+  new_map = nnstreamer_filter_model_map (model_path, map_flags);
+  model_data = nnstreamer_filter_model_map_get_data (new_map, &model_size);
+  if (!model_data) {
     ml_loge ("Failed to mmap model\n");
+    nnstreamer_filter_model_unmap (new_map);
+    return -1;
+  }
+
+  interpreter = nullptr;
+  model = tflite::FlatBufferModel::BuildFromBuffer (
+      static_cast<const char *> (model_data), model_size);
+  nnstreamer_filter_model_unmap (model_map);
+  model_map = new_map;
+  if (!model) {
+    ml_loge ("Failed to build model from the mapped file %s\n", model_path);
     return -1;
   }
 
@@ -419,8 +556,6 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
    * model->error_reporter ();
    */
 
-  interpreter = nullptr;
-
 #ifdef TFLITE_RESOLVER_WITHOUT_DEFAULT_DELEGATES
   tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
 #else
@@ -484,6 +619,14 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
       options.inference_priority2 = TFLITE_GPU_INFERENCE_PRIORITY_MIN_MEMORY_USAGE;
       options.inference_priority3 = TFLITE_GPU_INFERENCE_PRIORITY_MAX_PRECISION;
 
+#if (TFLITE_VERSION_MAJOR > 2 || (TFLITE_VERSION_MAJOR == 2 && TFLITE_VERSION_MINOR >= 7))
+      /* reuse the serialized GPU programs to reduce the initialization time */
+      if (cache_path) {
+        options.serialization_dir = cache_path;
+        options.model_token = "nnstreamer";
+      }
+#endif
+
       delegate = TfLiteGpuDelegateV2Create (&options);
       void (* deleter) (TfLiteDelegate *) =
               [] (TfLiteDelegate *delegate_) {
@@ -794,6 +937,16 @@ TFLiteInterpreter::getExtDelegate (const char **lib_path, GHashTable **key_val)
   *key_val = ext_delegate_kv_table;
 }
 
+/**
+ * @brief update the directory to persist the compiled model of delegate
+ */
+void
+TFLiteInterpreter::setCachePath (const char *path)
+{
+  g_free (cache_path);
+  cache_path = g_strdup (path);
+}
+
 /**
  * @brief cache input and output tensor ptr before invoke
  * @return 0 on success. -errno on failure.
@@ -844,7 +997,9 @@ TFLiteCore::TFLiteCore (const GstTensorFilterProperties *prop)
   num_threads = -1;
   accelerator = ACCL_NONE;
   delegate = TFLITE_DELEGATE_NONE;
-  interpreter_sub = nullptr;
+  async_reload = FALSE;
+  reload_pool = nullptr;
+  g_mutex_init (&swap_lock);
   shared_tensor_filter_key = NULL;
 
   if (prop->shared_tensor_filter_key) {
@@ -871,6 +1026,10 @@ void free_interpreter (void * interpreter) {
  */
 TFLiteCore::~TFLiteCore ()
 {
+  /* run the pending reloads (the worker frees the model paths) and wait for them */
+  if (reload_pool)
+    g_thread_pool_free (reload_pool, FALSE, TRUE);
+
   if (shared_tensor_filter_key) {
     G_LOCK (slock);
     if (!nnstreamer_filter_shared_model_remove (this, shared_tensor_filter_key, free_interpreter)) {
@@ -882,6 +1041,8 @@ TFLiteCore::~TFLiteCore ()
   else {
     delete interpreter;
   }
+
+  g_mutex_clear (&swap_lock);
 }
 
 /**
@@ -965,9 +1126,21 @@ TFLiteCore::init (tflite_option_s *option)
 {
   interpreter->setModelPath (option->model_file);
   interpreter->setExtDelegate (option->ext_delegate_path, option->ext_delegate_kv_table);
+  interpreter->setCachePath (option->cache_path);
+  interpreter->setModelMapFlags (option->map_flags);
+  async_reload = option->async_reload;
   num_threads = option->num_threads;
   int err;
 
+  if (option->num_cpu_affinity > 0) {
+    cpu_affinity.assign (option->cpu_affinity,
+        option->cpu_affinity + option->num_cpu_affinity);
+
+    /* avoid oversubscription of the pinned CPUs */
+    if (num_threads <= 0 || num_threads > (int) option->num_cpu_affinity)
+      num_threads = (int) option->num_cpu_affinity;
+  }
+
   setAccelerator (option->accelerators, option->delegate);
   g_message ("accl = %s", get_accl_hw_str (accelerator));
 
@@ -1015,6 +1188,7 @@ int
 TFLiteCore::loadModel ()
 {
   int err;
+  TFLiteThreadPinning pinning (cpu_affinity);
 
   interpreter->lock ();
   err = interpreter->loadModel (num_threads, delegate);
@@ -1064,9 +1238,11 @@ TFLiteCore::setOutputTensorProp ()
 int
 TFLiteCore::getInputTensorDim (GstTensorsInfo *info)
 {
+  g_mutex_lock (&swap_lock);
   interpreter->lock ();
   gst_tensors_info_copy (info, interpreter->getInputTensorsInfo ());
   interpreter->unlock ();
+  g_mutex_unlock (&swap_lock);
 
   return 0;
 }
@@ -1080,9 +1256,11 @@ TFLiteCore::getInputTensorDim (GstTensorsInfo *info)
 int
 TFLiteCore::getOutputTensorDim (GstTensorsInfo *info)
 {
+  g_mutex_lock (&swap_lock);
   interpreter->lock ();
   gst_tensors_info_copy (info, interpreter->getOutputTensorsInfo ());
   interpreter->unlock ();
+  g_mutex_unlock (&swap_lock);
 
   return 0;
 }
@@ -1098,9 +1276,11 @@ TFLiteCore::setInputTensorDim (const GstTensorsInfo *info)
 {
   int err;
 
+  g_mutex_lock (&swap_lock);
   interpreter->lock ();
   err = interpreter->setInputTensorsInfo (info);
   interpreter->unlock ();
+  g_mutex_unlock (&swap_lock);
 
   return err;
 }
@@ -1114,10 +1294,19 @@ TFLiteCore::setInputTensorDim (const GstTensorsInfo *info)
 int
 TFLiteCore::reloadInterpreter (TFLiteInterpreter * new_interpreter)
 {
-  TFLiteInterpreter *old_interpreter = interpreter;
+  TFLiteInterpreter *old_interpreter;
   gboolean in_matched, out_matched;
+  int64_t start_time;
   int ret = 0;
 
+  start_time = g_get_monotonic_time ();
+
+  /**
+   * Block new invokes and wait for the in-flight invoke of old interpreter.
+   * After swapping the pointer, no invoke refers to old interpreter.
+   */
+  g_mutex_lock (&swap_lock);
+  old_interpreter = interpreter;
   old_interpreter->lock ();
   new_interpreter->lock ();
 
@@ -1135,6 +1324,10 @@ TFLiteCore::reloadInterpreter (TFLiteInterpreter * new_interpreter)
 
   new_interpreter->unlock ();
   old_interpreter->unlock ();
+  g_mutex_unlock (&swap_lock);
+
+  ml_logd ("The invokes were blocked for %" G_GINT64_FORMAT
+      " usec to swap the interpreter.", (gint64) (g_get_monotonic_time () - start_time));
 
   return ret;
 }
@@ -1150,66 +1343,193 @@ void replace_interpreter (void * instance, void * interperter) {
 }
 
 /**
- * @brief	reload a model
- * @param	tflite	: the class object
- * @param[in] model_path : the path of model file
- * @return 0 if OK. non-zero if error.
- * @note reloadModel() is asynchronously called with other callbacks. But, it requires
- *       extra memory size enough to temporarily hold both models during this function.
+ * @brief	build and warm up a new interpreter with the model to reload
+ * @param[in] _model_path : the path of model file
+ * @return the new interpreter, nullptr if error.
+ * @note The config of the current interpreter is copied under the swap lock, then the invokes are running while the new model is loaded.
  */
-int
-TFLiteCore::reloadModel (const char *_model_path)
+TFLiteInterpreter *
+TFLiteCore::buildInterpreter (const char *_model_path)
 {
-  TFLiteInterpreter * interpreter_temp = interpreter;
+  TFLiteInterpreter *new_interpreter;
   const char *_ext_delegate_path;
   GHashTable *_ext_delegate_kv;
+  GstTensorsInfo in_info, out_info;
+  gboolean in_matched, out_matched;
 
-  if (!g_file_test (_model_path, G_FILE_TEST_IS_REGULAR)) {
-    ml_loge ("The path of model file(s), %s, to reload is invalid.", _model_path);
-    return -EINVAL;
-  }
-  interpreter_sub = new TFLiteInterpreter ();
-  interpreter_sub->setModelPath (_model_path);
-  interpreter->getExtDelegate(&_ext_delegate_path, &_ext_delegate_kv);
-  interpreter_sub->setExtDelegate(_ext_delegate_path, _ext_delegate_kv);
+  new_interpreter = new TFLiteInterpreter ();
+  new_interpreter->setModelPath (_model_path);
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  /**
+   * The current interpreter may be swapped (and deleted) by another reload
+   * or by the other cores sharing the model, snapshot its config under the lock.
+   */
+  g_mutex_lock (&swap_lock);
+  interpreter->lock ();
+  interpreter->getExtDelegate (&_ext_delegate_path, &_ext_delegate_kv);
+  new_interpreter->setExtDelegate (_ext_delegate_path, _ext_delegate_kv);
+  new_interpreter->setModelMapFlags (interpreter->getModelMapFlags ());
+  gst_tensors_info_copy (&in_info, interpreter->getInputTensorsInfo ());
+  gst_tensors_info_copy (&out_info, interpreter->getOutputTensorsInfo ());
+  interpreter->unlock ();
+  g_mutex_unlock (&swap_lock);
 
   /**
    * load a model into sub interpreter. This loading overhead is independent
    * with main one's activities.
    */
-  if (interpreter_sub->loadModel (num_threads, delegate) != 0) {
-    ml_loge ("Failed to load model %s\n", _model_path);
-    return -EINVAL;
+  {
+    TFLiteThreadPinning pinning (cpu_affinity);
+
+    if (new_interpreter->loadModel (num_threads, delegate) != 0) {
+      ml_loge ("Failed to load model %s\n", _model_path);
+      goto error;
+    }
   }
-  if (interpreter_sub->setInputTensorProp () != 0) {
+  if (new_interpreter->setInputTensorProp () != 0) {
     ml_loge ("Failed to initialize input tensor\n");
-    return -EINVAL;
+    goto error;
   }
-  if (interpreter_sub->setOutputTensorProp () != 0) {
+  if (new_interpreter->setOutputTensorProp () != 0) {
     ml_loge ("Failed to initialize output tensor\n");
-    return -EINVAL;
+    goto error;
   }
-  if (interpreter_sub->cacheInOutTensorPtr () != 0) {
+  if (new_interpreter->cacheInOutTensorPtr () != 0) {
     ml_loge ("Failed to cache input and output tensors storage\n");
-    return -EINVAL;
+    goto error;
   }
 
+  in_matched = gst_tensors_info_is_equal (&in_info,
+      new_interpreter->getInputTensorsInfo ());
+  out_matched = gst_tensors_info_is_equal (&out_info,
+      new_interpreter->getOutputTensorsInfo ());
+  if (!in_matched || !out_matched) {
+    ml_loge ("The model has unmatched tensors info\n");
+    goto error;
+  }
+
+  /* run the first (slow) invoke before the swap, not in the stream */
+  {
+    TFLiteThreadPinning pinning (cpu_affinity);
+
+    if (new_interpreter->warmup () != 0) {
+      ml_loge ("Failed to warm up the model %s\n", _model_path);
+      goto error;
+    }
+  }
+
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  return new_interpreter;
+
+error:
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  delete new_interpreter;
+  return nullptr;
+}
+
+/**
+ * @brief	reload a model and swap the interpreter
+ * @param[in] _model_path : the path of model file
+ * @return 0 if OK. non-zero if error.
+ * @note It requires extra memory size enough to temporarily hold both models during this function.
+ */
+int
+TFLiteCore::reloadModelSync (const char *_model_path)
+{
+  TFLiteInterpreter *new_interpreter;
+  TFLiteInterpreter *old_interpreter;
+  int64_t start_time;
+
+  start_time = g_get_monotonic_time ();
+
+  new_interpreter = buildInterpreter (_model_path);
+  if (!new_interpreter)
+    return -EINVAL;
+
+  ml_logi ("The model %s is loaded and warmed up in %" G_GINT64_FORMAT " usec.",
+      _model_path, (gint64) (g_get_monotonic_time () - start_time));
+
   if (shared_tensor_filter_key) {
     /* update cores with new interpreter that has shared key */
     nnstreamer_filter_shared_model_replace (this, shared_tensor_filter_key,
-        interpreter_sub, replace_interpreter, free_interpreter);
-  }
-  else {
-    if (reloadInterpreter (interpreter_sub) != 0) {
+        new_interpreter, replace_interpreter, free_interpreter);
+  } else {
+    /* the interpreter is swapped only by this core, but read it under the lock as invoke does */
+    g_mutex_lock (&swap_lock);
+    old_interpreter = interpreter;
+    g_mutex_unlock (&swap_lock);
+
+    if (reloadInterpreter (new_interpreter) != 0) {
       ml_loge ("Failed replace interpreter\n");
+      delete new_interpreter;
       return -EINVAL;
     }
-    delete interpreter_temp;
+    /* the in-flight invoke of old interpreter is finished in reloadInterpreter () */
+    delete old_interpreter;
   }
 
   return 0;
 }
 
+/**
+ * @brief The worker to reload the model in background.
+ * @param[in] data the path of model file
+ * @param[in] user_data TFLiteCore instance
+ */
+static void
+tflite_reload_worker (gpointer data, gpointer user_data)
+{
+  TFLiteCore *core = static_cast<TFLiteCore *> (user_data);
+  gchar *model_path = static_cast<gchar *> (data);
+
+  if (core->reloadModelSync (model_path) != 0)
+    ml_loge ("Failed to reload the model %s in background, the current model is kept.", model_path);
+
+  g_free (model_path);
+}
+
+/**
+ * @brief	reload a model
+ * @param	tflite	: the class object
+ * @param[in] model_path : the path of model file
+ * @return 0 if OK. non-zero if error.
+ * @note reloadModel() is asynchronously called with other callbacks.
+ *       If async reload is enabled, the model is loaded in background and this returns immediately.
+ */
+int
+TFLiteCore::reloadModel (const char *_model_path)
+{
+  if (!g_file_test (_model_path, G_FILE_TEST_IS_REGULAR)) {
+    ml_loge ("The path of model file(s), %s, to reload is invalid.", _model_path);
+    return -EINVAL;
+  }
+
+  if (async_reload) {
+    if (!reload_pool) {
+      GError *err = NULL;
+
+      /* exclusive single thread to reload the models in order */
+      reload_pool = g_thread_pool_new (tflite_reload_worker, this, 1, TRUE, &err);
+      if (!reload_pool) {
+        ml_loge ("Failed to create the thread to reload model: %s",
+            err ? err->message : "unknown reason");
+        g_clear_error (&err);
+        return -EINVAL;
+      }
+    }
+
+    g_thread_pool_push (reload_pool, g_strdup (_model_path), NULL);
+    return 0;
+  }
+
+  return reloadModelSync (_model_path);
+}
+
 /**
  * @brief	run the model with the input.
  * @param[in] input : The array of input tensors
@@ -1219,11 +1539,17 @@ TFLiteCore::reloadModel (const char *_model_path)
 int
 TFLiteCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 {
+  TFLiteInterpreter *current;
   int err;
 
-  interpreter->lock ();
-  err = interpreter->invoke (input, output);
-  interpreter->unlock ();
+  /* hold the current interpreter, reload swaps it after this invoke */
+  g_mutex_lock (&swap_lock);
+  current = interpreter;
+  current->lock ();
+  g_mutex_unlock (&swap_lock);
+
+  err = current->invoke (input, output);
+  current->unlock ();
 
   return err;
 }
@@ -1236,9 +1562,11 @@ TFLiteCore::cacheInOutTensorPtr ()
 {
   int err;
 
+  g_mutex_lock (&swap_lock);
   interpreter->lock ();
   err = interpreter->cacheInOutTensorPtr ();
   interpreter->unlock ();
+  g_mutex_unlock (&swap_lock);
 
   return err;
 }
@@ -1258,6 +1586,11 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
   option->num_threads = -1;
   option->ext_delegate_path = nullptr;
   option->ext_delegate_kv_table = nullptr;
+  option->cache_path = prop->cache_path;
+  option->cpu_affinity = prop->cpu_affinity;
+  option->num_cpu_affinity = prop->num_cpu_affinity;
+  option->map_flags = NNS_MODEL_MAP_DEFAULT;
+  option->async_reload = FALSE;
 
   if (prop->custom_properties) {
     gchar **strv;
@@ -1286,6 +1619,17 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
             option->delegate = TFLITE_DELEGATE_EXTERNAL;
           else
             ml_logw ("Unknown option to set tensorflow-lite delegate (%s).", pair[1]);
+        } else if (g_ascii_strcasecmp (pair[0], "ModelMap") == 0) {
+          if (g_ascii_strcasecmp (pair[1], "Default") == 0)
+            option->map_flags = NNS_MODEL_MAP_DEFAULT;
+          else if (g_ascii_strcasecmp (pair[1], "WillNeed") == 0)
+            option->map_flags = NNS_MODEL_MAP_WILLNEED;
+          else if (g_ascii_strcasecmp (pair[1], "Populate") == 0)
+            option->map_flags = NNS_MODEL_MAP_POPULATE;
+          else
+            ml_logw ("Unknown option to map the model file (%s).", pair[1]);
+        } else if (g_ascii_strcasecmp (pair[0], "AsyncReload") == 0) {
+          option->async_reload = (g_ascii_strcasecmp (pair[1], "true") == 0);
         } else if (g_ascii_strcasecmp (pair[0], "ExtDelegateLib") == 0) {
           option->ext_delegate_path = g_strdup (pair[1]);
         } else if (g_ascii_strcasecmp (pair[0], "ExtDelegateKeyVal") == 0) {
@@ -1637,6 +1981,10 @@ init_filter_tflite (void)
       "NumThreads", "Number of threads. Set 0 for default behaviors.",
       "Delegate", "TF-Lite delegation options: {'NNAPI', 'GPU', 'XNNPACK', 'External'}."
       " Do not specify to disable delegation.",
+      "ModelMap", "Hint to load the mapped model file: {'Default', 'WillNeed', 'Populate'}."
+      " 'WillNeed' reads ahead in background and 'Populate' loads all pages at open.",
+      "AsyncReload", "Set 'true' to load the model to reload (is-updatable) in background"
+      " without blocking the caller.",
       "ExtDelegateLib", "Path to external delegate shared library",
       "ExtDelegateKeyVal", "key/values pairs optional parameters for delegate."
       " Format ExtDelegateKeyVal=key1#value1;key2#value2...",
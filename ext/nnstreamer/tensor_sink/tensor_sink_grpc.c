@@ -90,6 +90,21 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_sink_grpc_debug);
 #define DEFAULT_PROP_HOST  "localhost"
 #define DEFAULT_PROP_PORT  55115
 
+/**
+ * @brief Default max bytes of tensor data in a message (0: no chunking)
+ */
+#define DEFAULT_PROP_MAX_CHUNK_SIZE 0
+
+/**
+ * @brief Default max number of buffers in queue to be sent (0: unlimited)
+ */
+#define DEFAULT_PROP_MAX_IN_FLIGHT 0
+
+/**
+ * @brief Default number of completion queue threads for gRPC server
+ */
+#define DEFAULT_PROP_NUM_THREADS 1
+
 #define CAPS_STRING GST_TENSOR_CAP_DEFAULT "; " GST_TENSORS_CAP_DEFAULT
 
 static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
@@ -175,6 +190,26 @@ gst_tensor_sink_grpc_class_init (GstTensorSinkGRPCClass * klass)
           "The number of output messages generated",
           0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_MAX_CHUNK_SIZE,
+      g_param_spec_uint ("max-chunk-size", "Max chunk size",
+          "The max bytes of tensor data in a message. A larger tensor is split "
+          "into several messages (0: no chunking)",
+          0, G_MAXUINT, DEFAULT_PROP_MAX_CHUNK_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_IN_FLIGHT,
+      g_param_spec_uint ("max-in-flight", "Max in flight",
+          "The max number of buffers queued to be sent. Upstream is blocked "
+          "until the buffers are sent (0: unlimited)",
+          0, G_MAXUINT, DEFAULT_PROP_MAX_IN_FLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "The number of completion queue threads of gRPC server",
+          1, G_MAXUINT16, DEFAULT_PROP_NUM_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (gstelement_class, &sinktemplate);
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -208,6 +243,9 @@ grpc_config_init (GstTensorSinkGRPC * self)
   grpc->config.dir = GRPC_DIRECTION_TENSORS_TO_BUFFER;
   grpc->config.port = DEFAULT_PROP_PORT;
   grpc->config.host = g_strdup (DEFAULT_PROP_HOST);
+  grpc->config.max_chunk_size = DEFAULT_PROP_MAX_CHUNK_SIZE;
+  grpc->config.max_in_flight = DEFAULT_PROP_MAX_IN_FLIGHT;
+  grpc->config.num_threads = DEFAULT_PROP_NUM_THREADS;
   grpc->config.config = &self->config;
 }
 
@@ -88,6 +88,16 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_src_grpc_debug);
 #define DEFAULT_PROP_HOST  "localhost"
 #define DEFAULT_PROP_PORT  55115
 
+/**
+ * @brief Default max number of received buffers in queue (0: unlimited)
+ */
+#define DEFAULT_PROP_MAX_IN_FLIGHT 0
+
+/**
+ * @brief Default number of completion queue threads for gRPC server
+ */
+#define DEFAULT_PROP_NUM_THREADS 1
+
 #define GST_TENSOR_SRC_GRPC_SCALED_TIME(self, count)\
   gst_util_uint64_scale (count, \
       self->config.rate_d * GST_SECOND, self->config.rate_n)
@@ -175,6 +185,19 @@ gst_tensor_src_grpc_class_init (GstTensorSrcGRPCClass * klass)
           "The number of output buffers generated",
           0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_MAX_IN_FLIGHT,
+      g_param_spec_uint ("max-in-flight", "Max in flight",
+          "The max number of received buffers queued. gRPC stops receiving "
+          "until the buffers are pushed downstream (0: unlimited)",
+          0, G_MAXUINT, DEFAULT_PROP_MAX_IN_FLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_THREADS,
+      g_param_spec_uint ("num-threads", "Number of threads",
+          "The number of completion queue threads of gRPC server",
+          1, G_MAXUINT16, DEFAULT_PROP_NUM_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (gstelement_class, &srctemplate);
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -204,7 +227,13 @@ static gboolean
 _data_queue_check_full_cb (GstDataQueue * queue, guint visible,
     guint bytes, guint64 time, gpointer checkdata)
 {
-  /** it's dummy */
+  GstTensorSrcGRPC *self = GST_TENSOR_SRC_GRPC_CAST (checkdata);
+  grpc_private *grpc = GET_GRPC_PRIVATE (self);
+
+  /* block the gRPC receiver until the buffers are pushed downstream */
+  if (grpc->config.max_in_flight > 0 && visible >= grpc->config.max_in_flight)
+    return TRUE;
+
   return FALSE;
 }
 
@@ -270,6 +299,8 @@ _grpc_callback (void *obj, void *data)
   GST_BUFFER_DURATION (buffer) = duration;
   GST_BUFFER_PTS (buffer) = timestamp;
 
+  GST_OBJECT_UNLOCK (self);
+
   item = g_new0 (GstDataQueueItem, 1);
   item->object = GST_MINI_OBJECT (buffer);
   item->size = gst_buffer_get_size (buffer);
@@ -284,8 +315,6 @@ _grpc_callback (void *obj, void *data)
         GST_TIME_FORMAT, GST_TIME_ARGS (timestamp), GST_TIME_ARGS (duration));
   }
 
-  GST_OBJECT_UNLOCK (self);
-
   /* special case: framerate == (fraction)0/1 */
   if (duration == 0)
     _send_eos_event (self);
@@ -305,6 +334,8 @@ grpc_config_init (GstTensorSrcGRPC * self)
   grpc->config.dir = GRPC_DIRECTION_BUFFER_TO_TENSORS;
   grpc->config.port = DEFAULT_PROP_PORT;
   grpc->config.host = g_strdup (DEFAULT_PROP_HOST);
+  grpc->config.max_in_flight = DEFAULT_PROP_MAX_IN_FLIGHT;
+  grpc->config.num_threads = DEFAULT_PROP_NUM_THREADS;
   grpc->config.cb = _grpc_callback;
   grpc->config.cb_data = (void *) self;
   grpc->config.config = &self->config;
@@ -319,7 +350,7 @@ gst_tensor_src_grpc_init (GstTensorSrcGRPC * self)
   gst_tensors_config_init (&self->config);
 
   self->queue = gst_data_queue_new (_data_queue_check_full_cb,
-      NULL, NULL, NULL);
+      NULL, NULL, self);
   self->silent = DEFAULT_PROP_SILENT;
   self->out = 0;
 
@@ -409,13 +440,13 @@ gst_tensor_src_grpc_unlock (GstBaseSrc * src)
   GstTensorSrcGRPC *self = GST_TENSOR_SRC_GRPC (src);
   grpc_private *grpc = GET_GRPC_PRIVATE (self);
 
-  /* notify to gRPC */
-  if (grpc->instance)
-    grpc_stop (grpc->instance);
-
   silent_debug ("Unlocking create");
   gst_data_queue_set_flushing (self->queue, TRUE);
 
+  /* notify to gRPC, after unblocking the receiver waiting for the queue */
+  if (grpc->instance)
+    grpc_stop (grpc->instance);
+
   return TRUE;
 }
 
@@ -31,6 +31,8 @@ gst_edge_get_connect_type (void)
           "Connect with MQTT brokers and directly sending stream frames via TCP connections."},
       {NNS_EDGE_CONNECT_TYPE_AITT, "AITT",
           "Sending stream frames via AITT connections."},
+      {GST_EDGE_CONNECT_TYPE_LOCAL, "LOCAL",
+          "Passing stream frames via shared memory to the elements on the same host."},
       {0, NULL, NULL},
     };
     protocol = g_enum_register_static ("edge_protocol", protocols);
@@ -25,6 +25,11 @@
 #define DEFAULT_HOST "localhost"
 #define DEFAULT_PORT 3000
 #define DEFAULT_CONNECT_TYPE (NNS_EDGE_CONNECT_TYPE_TCP)
+/**
+ * @brief Connect type to pass stream frames via shared memory on the same host.
+ * This is handled by edge elements and not passed to nnstreamer-edge.
+ */
+#define GST_EDGE_CONNECT_TYPE_LOCAL (0x100)
 #define GST_TYPE_EDGE_CONNECT_TYPE (gst_edge_get_connect_type ())
 
 G_BEGIN_DECLS
@@ -0,0 +1,712 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    edge_local.c
+ * @date    19 Oct 2026
+ * @brief   Shared-memory transport for edge sink and src on the same host
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs
+ *
+ * The publisher listens on an abstract unix socket. Both ends check the credentials of
+ * the peer (SO_PEERCRED), only the processes of the same user are connected.
+ * For each buffer, the memories are
+ * written to sealed memfd (or the fd of GstFdMemory is used as it is if it is already
+ * a write-sealed memfd) and the file descriptors are passed to the subscribers with
+ * SCM_RIGHTS. The subscriber wraps the received fd with GstFdAllocator, thus the tensor
+ * data is not copied on receiving.
+ * The sockets of the subscribers are non-blocking. If a subscriber does not read the
+ * messages and its socket is full, the buffer is dropped for that subscriber only.
+ */
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include "edge_local.h"
+#include "nnstreamer_util.h"
+#include "tensor_typedef.h"
+#include "../nnstreamer/nnstreamer_log.h"
+
+#if defined(__linux__) && defined(HAVE_MEMFD_CREATE)
+#include <fcntl.h>
+#include <poll.h>
+#include <stddef.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <glib-unix.h>
+#include <gst/allocators/gstfdmemory.h>
+
+#define EDGE_LOCAL_MAGIC (0x4e4e534cU)
+#define EDGE_LOCAL_BACKLOG (8)
+
+/**
+ * @brief Message header sent with the file descriptors of the memories.
+ */
+typedef struct
+{
+  guint32 magic;
+  guint32 num_mems;
+  guint64 offset[NNS_TENSOR_SIZE_LIMIT];
+  guint64 size[NNS_TENSOR_SIZE_LIMIT];
+} GstEdgeLocalHeader;
+
+/**
+ * @brief Data structure for local transport.
+ */
+struct _GstEdgeLocal
+{
+  gboolean is_publisher;
+  gchar *name; /**< the name of abstract unix socket */
+  gint sock; /**< listening socket of publisher, or connected socket of subscriber */
+  GSList *clients; /**< publisher: sockets of connected subscribers */
+  gint wakeup[2]; /**< subscriber: pipe to unblock the receiving thread */
+  GstAllocator *allocator; /**< subscriber: allocator to wrap received fd */
+};
+
+/**
+ * @brief Internal function to fill the socket address with topic or port.
+ */
+static socklen_t
+_edge_local_get_address (GstEdgeLocal * local, struct sockaddr_un *addr)
+{
+  gsize len;
+
+  memset (addr, 0, sizeof (struct sockaddr_un));
+  addr->sun_family = AF_UNIX;
+
+  /* Abstract namespace, the first byte of sun_path is null. */
+  len = MIN (strlen (local->name), sizeof (addr->sun_path) - 1);
+  memcpy (addr->sun_path + 1, local->name, len);
+
+  return (socklen_t) (offsetof (struct sockaddr_un, sun_path) + 1 + len);
+}
+
+/**
+ * @brief Internal function to check the peer of the socket is a process of the same user.
+ * The abstract socket is not protected by file permission, any local user can bind or connect it.
+ */
+static gboolean
+_edge_local_check_peer (gint sock)
+{
+  struct ucred cred;
+  socklen_t len = sizeof (cred);
+
+  if (getsockopt (sock, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+    nns_loge ("Failed to get the credentials of local edge peer (%d).", errno);
+    return FALSE;
+  }
+
+  if (cred.uid != getuid ()) {
+    nns_loge ("The peer of local edge (pid %d, uid %u) is not allowed.",
+        (gint) cred.pid, (guint) cred.uid);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to create the handle.
+ */
+static GstEdgeLocal *
+_edge_local_new (gboolean is_publisher, const gchar * topic, guint16 port)
+{
+  GstEdgeLocal *local;
+
+  if (topic && topic[0] != '\0') {
+    local = g_new0 (GstEdgeLocal, 1);
+    local->name = g_strdup_printf ("nnstreamer-edge-%u/%s", getuid (), topic);
+  } else if (port > 0) {
+    local = g_new0 (GstEdgeLocal, 1);
+    local->name = g_strdup_printf ("nnstreamer-edge-%u/%u", getuid (), port);
+  } else {
+    nns_loge ("Failed to create local edge handle, topic or port is required.");
+    return NULL;
+  }
+
+  local->is_publisher = is_publisher;
+  local->sock = -1;
+  local->wakeup[0] = local->wakeup[1] = -1;
+
+  return local;
+}
+
+/**
+ * @brief Create the publisher of local transport.
+ */
+GstEdgeLocal *
+gst_edge_local_new_publisher (const gchar * topic, guint16 port)
+{
+  GstEdgeLocal *local;
+  struct sockaddr_un addr;
+  socklen_t addr_len;
+
+  local = _edge_local_new (TRUE, topic, port);
+  if (!local)
+    return NULL;
+
+  local->sock = socket (AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK,
+      0);
+  if (local->sock < 0) {
+    nns_loge ("Failed to create unix socket (%d).", errno);
+    goto error;
+  }
+
+  addr_len = _edge_local_get_address (local, &addr);
+  if (bind (local->sock, (struct sockaddr *) &addr, addr_len) != 0) {
+    nns_loge ("Failed to bind local edge '%s' (%d), it may be already in use.",
+        local->name, errno);
+    goto error;
+  }
+
+  if (listen (local->sock, EDGE_LOCAL_BACKLOG) != 0) {
+    nns_loge ("Failed to listen local edge '%s' (%d).", local->name, errno);
+    goto error;
+  }
+
+  return local;
+
+error:
+  gst_edge_local_free (local);
+  return NULL;
+}
+
+/**
+ * @brief Internal function to connect the subscriber to the publisher.
+ */
+static gboolean
+_edge_local_connect (GstEdgeLocal * local)
+{
+  struct sockaddr_un addr;
+  socklen_t addr_len;
+
+  if (local->sock >= 0)
+    close (local->sock);
+
+  local->sock = socket (AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (local->sock < 0) {
+    nns_loge ("Failed to create unix socket (%d).", errno);
+    return FALSE;
+  }
+
+  addr_len = _edge_local_get_address (local, &addr);
+  if (connect (local->sock, (struct sockaddr *) &addr, addr_len) != 0) {
+    nns_loge ("Failed to connect to local edge '%s' (%d).", local->name, errno);
+    goto error;
+  }
+
+  /* The name may be taken by the other user to feed forged data. */
+  if (!_edge_local_check_peer (local->sock)) {
+    nns_loge ("The publisher of local edge '%s' is not trusted.", local->name);
+    goto error;
+  }
+
+  return TRUE;
+
+error:
+  close (local->sock);
+  local->sock = -1;
+  return FALSE;
+}
+
+/**
+ * @brief Create the subscriber of local transport.
+ */
+GstEdgeLocal *
+gst_edge_local_new_subscriber (const gchar * topic, guint16 port)
+{
+  GstEdgeLocal *local;
+
+  local = _edge_local_new (FALSE, topic, port);
+  if (!local)
+    return NULL;
+
+  if (!g_unix_open_pipe (local->wakeup, FD_CLOEXEC, NULL)) {
+    nns_loge ("Failed to create wakeup pipe of local edge.");
+    goto error;
+  }
+
+  if (!g_unix_set_fd_nonblocking (local->wakeup[0], TRUE, NULL)) {
+    nns_loge ("Failed to set wakeup pipe of local edge non-blocking.");
+    goto error;
+  }
+
+  if (!_edge_local_connect (local))
+    goto error;
+
+  local->allocator = gst_fd_allocator_new ();
+  return local;
+
+error:
+  gst_edge_local_free (local);
+  return NULL;
+}
+
+/**
+ * @brief Internal function to accept pending subscribers.
+ */
+static void
+_edge_local_accept (GstEdgeLocal * local)
+{
+  gint fd;
+
+  while ((fd = accept4 (local->sock, NULL, NULL,
+              SOCK_CLOEXEC | SOCK_NONBLOCK)) >= 0) {
+    /* Do not publish the tensors to the other users. */
+    if (!_edge_local_check_peer (fd)) {
+      close (fd);
+      continue;
+    }
+
+    local->clients = g_slist_append (local->clients, GINT_TO_POINTER (fd));
+  }
+
+  if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+    nns_logw ("Failed to accept the subscriber of local edge (%d).", errno);
+}
+
+/**
+ * @brief Internal function to copy the memory into new sealed memfd.
+ */
+static gint
+_edge_local_create_memfd (GstMemory * mem)
+{
+  GstMapInfo map;
+  gsize written = 0;
+  gssize n;
+  gint fd;
+
+  fd = memfd_create ("nnstreamer-edge", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0) {
+    nns_loge ("Failed to create memfd (%d).", errno);
+    return -1;
+  }
+
+  if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+    nns_loge ("Failed to map the memory to be published.");
+    close (fd);
+    return -1;
+  }
+
+  while (written < map.size) {
+    n = write (fd, map.data + written, map.size - written);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+    written += n;
+  }
+
+  gst_memory_unmap (mem, &map);
+
+  if (written != map.size) {
+    nns_loge ("Failed to write the memory to memfd (%d).", errno);
+    close (fd);
+    return -1;
+  }
+
+  /* Receivers only read the data, seal it so that it cannot be changed. */
+  if (fcntl (fd, F_ADD_SEALS,
+          F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0)
+    nns_logw ("Failed to seal memfd (%d).", errno);
+
+  return fd;
+}
+
+/**
+ * @brief Internal function to check the fd of the memory can be shared as it is.
+ * Only write-sealed memfd is shared, because upstream may write the other fd (e.g., buffer
+ * pool) after the buffer is released while the subscribers are still reading it.
+ */
+static gboolean
+_edge_local_is_sealed (gint fd)
+{
+  gint seals = fcntl (fd, F_GET_SEALS);
+
+  return (seals >= 0 && (seals & F_SEAL_WRITE));
+}
+
+/**
+ * @brief Send the memories of given buffer to all connected subscribers.
+ */
+gboolean
+gst_edge_local_publish (GstEdgeLocal * local, GstBuffer * buffer)
+{
+  GstEdgeLocalHeader header;
+  gint fds[NNS_TENSOR_SIZE_LIMIT];
+  gboolean owned[NNS_TENSOR_SIZE_LIMIT];
+  union
+  {
+    struct cmsghdr hdr;
+    gchar buf[CMSG_SPACE (sizeof (fds))];
+  } cmsg_buf;
+  struct msghdr msg;
+  struct cmsghdr *cmsg;
+  struct iovec iov;
+  GSList *l, *next;
+  guint i, num_mems;
+  gboolean ret = FALSE;
+
+  g_return_val_if_fail (local != NULL && local->is_publisher, FALSE);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), FALSE);
+
+  _edge_local_accept (local);
+  if (!local->clients)
+    return TRUE;
+
+  num_mems = gst_buffer_n_memory (buffer);
+  if (num_mems == 0 || num_mems > NNS_TENSOR_SIZE_LIMIT) {
+    nns_loge ("Invalid number of memories (%u) to be published.", num_mems);
+    return FALSE;
+  }
+
+  memset (&header, 0, sizeof (header));
+  header.magic = EDGE_LOCAL_MAGIC;
+  header.num_mems = num_mems;
+
+  for (i = 0; i < num_mems; i++) {
+    GstMemory *mem = gst_buffer_peek_memory (buffer, i);
+
+    if (gst_is_fd_memory (mem) &&
+        _edge_local_is_sealed (gst_fd_memory_get_fd (mem))) {
+      /* Upstream memory cannot be changed anymore, pass it as it is. */
+      fds[i] = gst_fd_memory_get_fd (mem);
+      owned[i] = FALSE;
+      header.offset[i] = mem->offset;
+    } else {
+      fds[i] = _edge_local_create_memfd (mem);
+      owned[i] = TRUE;
+      header.offset[i] = 0;
+    }
+
+    if (fds[i] < 0) {
+      num_mems = i;
+      goto done;
+    }
+
+    header.size[i] = gst_memory_get_sizes (mem, NULL, NULL);
+  }
+
+  iov.iov_base = &header;
+  iov.iov_len = sizeof (header);
+
+  memset (&msg, 0, sizeof (msg));
+  memset (&cmsg_buf, 0, sizeof (cmsg_buf));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = cmsg_buf.buf;
+  msg.msg_controllen = CMSG_SPACE (sizeof (gint) * num_mems);
+
+  cmsg = CMSG_FIRSTHDR (&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN (sizeof (gint) * num_mems);
+  memcpy (CMSG_DATA (cmsg), fds, sizeof (gint) * num_mems);
+
+  for (l = local->clients; l; l = next) {
+    gint fd = GPOINTER_TO_INT (l->data);
+    gssize sent;
+
+    next = l->next;
+
+    do {
+      sent = sendmsg (fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+    } while (sent < 0 && errno == EINTR);
+
+    if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      /* The subscriber is too slow, drop this buffer for it only. */
+      nns_logd ("The socket of local edge subscriber is full, drop the buffer.");
+      continue;
+    }
+
+    if (sent != (gssize) sizeof (header)) {
+      /* The subscriber is closed, remove it from the list. */
+      close (fd);
+      local->clients = g_slist_delete_link (local->clients, l);
+    }
+  }
+
+  ret = TRUE;
+
+done:
+  for (i = 0; i < num_mems; i++) {
+    if (owned[i])
+      close (fds[i]);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Internal function to wait for the socket to be readable.
+ * @return TRUE if the socket is readable, FALSE if unlocked.
+ */
+static gboolean
+_edge_local_wait (GstEdgeLocal * local)
+{
+  struct pollfd pfd[2];
+  gint ret;
+
+  pfd[0].fd = local->sock;
+  pfd[0].events = POLLIN;
+  pfd[1].fd = local->wakeup[0];
+  pfd[1].events = POLLIN;
+
+  do {
+    pfd[0].revents = pfd[1].revents = 0;
+    ret = poll (pfd, 2, -1);
+  } while (ret < 0 && errno == EINTR);
+
+  if (ret < 0 || (pfd[1].revents & POLLIN))
+    return FALSE;
+
+  return TRUE;
+}
+
+/**
+ * @brief Wait and receive new buffer from the publisher.
+ */
+GstFlowReturn
+gst_edge_local_receive (GstEdgeLocal * local, GstBuffer ** buffer)
+{
+  GstEdgeLocalHeader header;
+  gint fds[NNS_TENSOR_SIZE_LIMIT];
+  union
+  {
+    struct cmsghdr hdr;
+    gchar buf[CMSG_SPACE (sizeof (fds))];
+  } cmsg_buf;
+  struct msghdr msg;
+  struct cmsghdr *cmsg;
+  struct iovec iov;
+  GstBuffer *buf;
+  guint i, num_fds = 0;
+  gssize n;
+
+  g_return_val_if_fail (local != NULL && !local->is_publisher, GST_FLOW_ERROR);
+  g_return_val_if_fail (buffer != NULL, GST_FLOW_ERROR);
+
+  *buffer = NULL;
+
+  if (!_edge_local_wait (local))
+    return GST_FLOW_FLUSHING;
+
+  iov.iov_base = &header;
+  iov.iov_len = sizeof (header);
+
+  memset (&msg, 0, sizeof (msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = cmsg_buf.buf;
+  msg.msg_controllen = sizeof (cmsg_buf.buf);
+
+  do {
+    n = recvmsg (local->sock, &msg, MSG_CMSG_CLOEXEC);
+  } while (n < 0 && errno == EINTR);
+
+  if (n == 0) {
+    /* The publisher is closed, try to connect again. */
+    if (_edge_local_connect (local))
+      return gst_edge_local_receive (local, buffer);
+
+    nns_loge ("The connection of local edge '%s' is closed.", local->name);
+    return GST_FLOW_ERROR;
+  }
+
+  for (cmsg = CMSG_FIRSTHDR (&msg); cmsg; cmsg = CMSG_NXTHDR (&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+      num_fds = (cmsg->cmsg_len - CMSG_LEN (0)) / sizeof (gint);
+      num_fds = MIN (num_fds, NNS_TENSOR_SIZE_LIMIT);
+      memcpy (fds, CMSG_DATA (cmsg), sizeof (gint) * num_fds);
+      break;
+    }
+  }
+
+  if (n != (gssize) sizeof (header) || header.magic != EDGE_LOCAL_MAGIC ||
+      (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) ||
+      header.num_mems == 0 || header.num_mems != num_fds) {
+    nns_loge ("Received invalid message from local edge '%s'.", local->name);
+    goto error;
+  }
+
+  /* The size given by the peer should be in the file, or reading the memory raises SIGBUS. */
+  for (i = 0; i < num_fds; i++) {
+    struct stat st;
+
+    if (fstat (fds[i], &st) != 0 || st.st_size < 0 ||
+        header.size[i] > (guint64) st.st_size ||
+        header.offset[i] > (guint64) st.st_size - header.size[i]) {
+      nns_loge ("Received invalid memory (offset %" G_GUINT64_FORMAT
+          ", size %" G_GUINT64_FORMAT ") from local edge '%s'.",
+          header.offset[i], header.size[i], local->name);
+      goto error;
+    }
+  }
+
+  buf = gst_buffer_new ();
+  for (i = 0; i < num_fds; i++) {
+    GstMemory *mem;
+
+    mem = gst_fd_allocator_alloc (local->allocator, fds[i],
+        header.offset[i] + header.size[i], GST_FD_MEMORY_FLAG_KEEP_MAPPED);
+    if (header.offset[i] > 0)
+      gst_memory_resize (mem, header.offset[i], header.size[i]);
+
+    /* The memory is shared with the publisher, downstream should not write it. */
+    GST_MINI_OBJECT_FLAG_SET (mem, GST_MEMORY_FLAG_READONLY);
+    gst_buffer_append_memory (buf, mem);
+  }
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+
+error:
+  for (i = 0; i < num_fds; i++)
+    close (fds[i]);
+
+  return GST_FLOW_ERROR;
+}
+
+/**
+ * @brief Unblock the subscriber waiting for new buffer.
+ */
+void
+gst_edge_local_unlock (GstEdgeLocal * local)
+{
+  const gchar c = 0;
+
+  g_return_if_fail (local != NULL);
+
+  if (local->wakeup[1] >= 0 && write (local->wakeup[1], &c, 1) < 0)
+    nns_logw ("Failed to unlock local edge (%d).", errno);
+}
+
+/**
+ * @brief Clear the unlock request of the subscriber.
+ */
+void
+gst_edge_local_unlock_stop (GstEdgeLocal * local)
+{
+  gchar c;
+
+  g_return_if_fail (local != NULL);
+
+  if (local->wakeup[0] >= 0) {
+    while (read (local->wakeup[0], &c, 1) > 0);
+  }
+}
+
+/**
+ * @brief Close the connections and release the handle.
+ */
+void
+gst_edge_local_free (GstEdgeLocal * local)
+{
+  GSList *l;
+
+  if (!local)
+    return;
+
+  for (l = local->clients; l; l = l->next)
+    close (GPOINTER_TO_INT (l->data));
+  g_slist_free (local->clients);
+
+  if (local->sock >= 0)
+    close (local->sock);
+  if (local->wakeup[0] >= 0)
+    close (local->wakeup[0]);
+  if (local->wakeup[1] >= 0)
+    close (local->wakeup[1]);
+
+  if (local->allocator)
+    gst_object_unref (local->allocator);
+
+  g_free (local->name);
+  g_free (local);
+}
+
+#else /* __linux__ && HAVE_MEMFD_CREATE */
+
+/**
+ * @brief Create the publisher of local transport. (Not supported)
+ */
+GstEdgeLocal *
+gst_edge_local_new_publisher (const gchar * topic, guint16 port)
+{
+  UNUSED (topic);
+  UNUSED (port);
+  nns_loge ("Local edge transport is not supported on this platform.");
+  return NULL;
+}
+
+/**
+ * @brief Create the subscriber of local transport. (Not supported)
+ */
+GstEdgeLocal *
+gst_edge_local_new_subscriber (const gchar * topic, guint16 port)
+{
+  UNUSED (topic);
+  UNUSED (port);
+  nns_loge ("Local edge transport is not supported on this platform.");
+  return NULL;
+}
+
+/**
+ * @brief Send the memories of given buffer to all connected subscribers. (Not supported)
+ */
+gboolean
+gst_edge_local_publish (GstEdgeLocal * local, GstBuffer * buffer)
+{
+  UNUSED (local);
+  UNUSED (buffer);
+  return FALSE;
+}
+
+/**
+ * @brief Wait and receive new buffer from the publisher. (Not supported)
+ */
+GstFlowReturn
+gst_edge_local_receive (GstEdgeLocal * local, GstBuffer ** buffer)
+{
+  UNUSED (local);
+  UNUSED (buffer);
+  return GST_FLOW_NOT_SUPPORTED;
+}
+
+/**
+ * @brief Unblock the subscriber waiting for new buffer. (Not supported)
+ */
+void
+gst_edge_local_unlock (GstEdgeLocal * local)
+{
+  UNUSED (local);
+}
+
+/**
+ * @brief Clear the unlock request of the subscriber. (Not supported)
+ */
+void
+gst_edge_local_unlock_stop (GstEdgeLocal * local)
+{
+  UNUSED (local);
+}
+
+/**
+ * @brief Close the connections and release the handle. (Not supported)
+ */
+void
+gst_edge_local_free (GstEdgeLocal * local)
+{
+  UNUSED (local);
+}
+
+#endif /* __linux__ && HAVE_MEMFD_CREATE */
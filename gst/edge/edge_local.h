@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2022 Samsung Electronics Co., Ltd.
+ *
+ * @file    edge_local.h
+ * @date    19 Oct 2026
+ * @brief   Shared-memory transport for edge sink and src on the same host
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs
+ *
+ */
+#ifndef __GST_EDGE_LOCAL_H__
+#define __GST_EDGE_LOCAL_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+typedef struct _GstEdgeLocal GstEdgeLocal;
+
+/**
+ * @brief Create the publisher of local transport. It listens for the subscribers with given topic (or port if topic is not set).
+ * @return Newly created handle, NULL on error. Caller should release it with gst_edge_local_free().
+ */
+GstEdgeLocal *gst_edge_local_new_publisher (const gchar * topic, guint16 port);
+
+/**
+ * @brief Create the subscriber of local transport and connect to the publisher with given topic (or port if topic is not set).
+ * @return Newly created handle, NULL on error. Caller should release it with gst_edge_local_free().
+ */
+GstEdgeLocal *gst_edge_local_new_subscriber (const gchar * topic, guint16 port);
+
+/**
+ * @brief Send the memories of given buffer to all connected subscribers.
+ * @return TRUE if the buffer is published (or there is no subscriber), FALSE on error.
+ */
+gboolean gst_edge_local_publish (GstEdgeLocal * local, GstBuffer * buffer);
+
+/**
+ * @brief Wait and receive new buffer from the publisher. The memories of the buffer are mapped from shared memory without copy.
+ * @return GST_FLOW_OK if new buffer is received, GST_FLOW_FLUSHING if unlocked.
+ */
+GstFlowReturn gst_edge_local_receive (GstEdgeLocal * local, GstBuffer ** buffer);
+
+/**
+ * @brief Unblock the subscriber waiting for new buffer.
+ */
+void gst_edge_local_unlock (GstEdgeLocal * local);
+
+/**
+ * @brief Clear the unlock request of the subscriber.
+ */
+void gst_edge_local_unlock_stop (GstEdgeLocal * local);
+
+/**
+ * @brief Close the connections and release the handle.
+ */
+void gst_edge_local_free (GstEdgeLocal * local);
+
+G_END_DECLS
+#endif /* __GST_EDGE_LOCAL_H__ */
@@ -14,6 +14,7 @@
 #include <config.h>
 #endif
 
+#include <string.h>
 #include "edge_sink.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_edgesink_debug);
@@ -40,11 +41,13 @@ enum
   PROP_DEST_PORT,
   PROP_CONNECT_TYPE,
   PROP_TOPIC,
+  PROP_COMPRESSION,
 
   PROP_LAST
 };
 #define DEFAULT_MQTT_HOST "127.0.0.1"
 #define DEFAULT_MQTT_PORT 1883
+#define DEFAULT_COMPRESSION TENSOR_CODEC_NONE
 
 #define gst_edgesink_parent_class parent_class
 G_DEFINE_TYPE (GstEdgeSink, gst_edgesink, GST_TYPE_BASE_SINK);
@@ -58,6 +61,7 @@ static void gst_edgesink_get_property (GObject * object,
 static void gst_edgesink_finalize (GObject * object);
 
 static gboolean gst_edgesink_start (GstBaseSink * basesink);
+static gboolean gst_edgesink_stop (GstBaseSink * basesink);
 static GstFlowReturn gst_edgesink_render (GstBaseSink * basesink,
     GstBuffer * buffer);
 static gboolean gst_edgesink_set_caps (GstBaseSink * basesink, GstCaps * caps);
@@ -118,6 +122,14 @@ gst_edgesink_class_init (GstEdgeSinkClass * klass)
           "The main topic of the host and option if necessary. "
           "(topic)/(optional topic for main topic).", "",
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_COMPRESSION,
+      g_param_spec_enum ("compression", "Compression",
+          "Compression of the tensors sent to edgesrc. "
+          "Lossless encoding is skipped for a while if the tensor is not compressible. "
+          "Lossy methods are applied to float32 tensors only. "
+          "This is ignored with LOCAL connect-type.",
+          GST_TYPE_TENSOR_CODEC, DEFAULT_COMPRESSION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&sinktemplate));
@@ -127,6 +139,7 @@ gst_edgesink_class_init (GstEdgeSinkClass * klass)
       "Publish incoming streams", "Samsung Electronics Co., Ltd.");
 
   gstbasesink_class->start = gst_edgesink_start;
+  gstbasesink_class->stop = gst_edgesink_stop;
   gstbasesink_class->render = gst_edgesink_render;
   gstbasesink_class->set_caps = gst_edgesink_set_caps;
 
@@ -140,12 +153,19 @@ gst_edgesink_class_init (GstEdgeSinkClass * klass)
 static void
 gst_edgesink_init (GstEdgeSink * self)
 {
+  guint i;
+
   self->host = g_strdup (DEFAULT_HOST);
   self->port = DEFAULT_PORT;
   self->dest_host = g_strdup (DEFAULT_HOST);
   self->dest_port = DEFAULT_PORT;
   self->topic = NULL;
   self->connect_type = DEFAULT_CONNECT_TYPE;
+  self->local = NULL;
+  self->compression = DEFAULT_COMPRESSION;
+  memset (self->codec_states, 0, sizeof (self->codec_states));
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++)
+    self->codec_types[i] = _NNS_END;
 }
 
 /**
@@ -186,6 +206,9 @@ gst_edgesink_set_property (GObject * object, guint prop_id,
       g_free (self->topic);
       self->topic = g_value_dup_string (value);
       break;
+    case PROP_COMPRESSION:
+      self->compression = g_value_get_enum (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -220,6 +243,9 @@ gst_edgesink_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_TOPIC:
       g_value_set_string (value, self->topic);
       break;
+    case PROP_COMPRESSION:
+      g_value_set_enum (value, self->compression);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -243,6 +269,11 @@ gst_edgesink_finalize (GObject * object)
     self->edge_h = NULL;
   }
 
+  if (self->local) {
+    gst_edge_local_free (self->local);
+    self->local = NULL;
+  }
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -257,6 +288,16 @@ gst_edgesink_start (GstBaseSink * basesink)
   int ret;
   char *port = NULL;
 
+  if (self->connect_type == GST_EDGE_CONNECT_TYPE_LOCAL) {
+    self->local = gst_edge_local_new_publisher (self->topic, self->port);
+    if (!self->local) {
+      nns_loge ("Failed to start local edge. Please check topic and port.");
+      return FALSE;
+    }
+
+    return TRUE;
+  }
+
   ret =
       nns_edge_create_handle (NULL, self->connect_type,
       NNS_EDGE_NODE_TYPE_PUB, &self->edge_h);
@@ -298,6 +339,22 @@ gst_edgesink_start (GstBaseSink * basesink)
   return TRUE;
 }
 
+/**
+ * @brief stop processing of edgesink
+ */
+static gboolean
+gst_edgesink_stop (GstBaseSink * basesink)
+{
+  GstEdgeSink *self = GST_EDGESINK (basesink);
+
+  if (self->local) {
+    gst_edge_local_free (self->local);
+    self->local = NULL;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief render buffer, send buffer
  */
@@ -311,6 +368,15 @@ gst_edgesink_render (GstBaseSink * basesink, GstBuffer * buffer)
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
 
+  if (self->local) {
+    if (!gst_edge_local_publish (self->local, buffer)) {
+      nns_loge ("Failed to publish the buffer via local edge.");
+      return GST_FLOW_ERROR;
+    }
+
+    return GST_FLOW_OK;
+  }
+
   ret = nns_edge_data_create (&data_h);
   if (ret != NNS_EDGE_ERROR_NONE) {
     nns_loge ("Failed to create data handle in edgesink");
@@ -325,9 +391,11 @@ gst_edgesink_render (GstBaseSink * basesink, GstBuffer * buffer)
       num_mems = i;
       goto done;
     }
-    nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
   }
 
+  gst_tensor_query_add_encoded_data (data_h, map, num_mems, self->compression,
+      self->codec_types, self->codec_states);
+
   nns_edge_send (self->edge_h, data_h);
   goto done;
 
@@ -342,6 +410,32 @@ done:
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Update the element type of each tensor to be compressed.
+ */
+static void
+_edgesink_update_codec_types (GstEdgeSink * self, GstCaps * caps)
+{
+  GstStructure *structure;
+  GstTensorsConfig config;
+  guint i;
+
+  memset (self->codec_states, 0, sizeof (self->codec_states));
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++)
+    self->codec_types[i] = _NNS_END;
+
+  structure = gst_caps_get_structure (caps, 0);
+  if (!gst_structure_is_tensor_stream (structure))
+    return;
+
+  gst_tensors_config_from_structure (&config, structure);
+  if (config.info.format == _NNS_TENSOR_FORMAT_STATIC) {
+    for (i = 0; i < config.info.num_tensors; i++)
+      self->codec_types[i] = config.info.info[i].type;
+  }
+  gst_tensors_config_free (&config);
+}
+
 /**
  * @brief An implementation of the set_caps vmethod in GstBaseSinkClass
  */
@@ -352,6 +446,12 @@ gst_edgesink_set_caps (GstBaseSink * basesink, GstCaps * caps)
   gchar *caps_str, *prev_caps_str, *new_caps_str;
   int set_rst;
 
+  _edgesink_update_codec_types (sink, caps);
+
+  /* Local edge does not deliver caps, edgesrc should set caps filter. */
+  if (sink->local)
+    return TRUE;
+
   caps_str = gst_caps_to_string (caps);
 
   nns_edge_get_info (sink->edge_h, "CAPS", &prev_caps_str);
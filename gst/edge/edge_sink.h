@@ -16,6 +16,8 @@
 #include <gst/gst.h>
 #include <gst/base/gstbasesink.h>
 #include "edge_common.h"
+#include "edge_local.h"
+#include "tensor_query/tensor_query_common.h"
 #include "nnstreamer-edge.h"
 #include "../nnstreamer/nnstreamer_log.h"
 #include "tensor_typedef.h"
@@ -50,6 +52,11 @@ struct _GstEdgeSink
 
   nns_edge_connect_type_e connect_type;
   nns_edge_h edge_h;
+  GstEdgeLocal *local; /**< shared-memory transport if connect-type is LOCAL */
+
+  tensor_codec_e compression; /**< compression of the tensors to be sent */
+  tensor_type codec_types[NNS_TENSOR_SIZE_LIMIT]; /**< element type of each tensor to be compressed */
+  GstTensorCodecState codec_states[NNS_TENSOR_SIZE_LIMIT]; /**< encoder state of each tensor */
 };
 
 /**
@@ -14,6 +14,7 @@
 #include <config.h>
 #endif
 
+#include <string.h>
 #include "edge_src.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_edgesrc_debug);
@@ -51,6 +52,9 @@ static void gst_edgesrc_get_property (GObject * object, guint prop_id,
 static void gst_edgesrc_class_finalize (GObject * object);
 
 static gboolean gst_edgesrc_start (GstBaseSrc * basesrc);
+static gboolean gst_edgesrc_stop (GstBaseSrc * basesrc);
+static gboolean gst_edgesrc_unlock (GstBaseSrc * basesrc);
+static gboolean gst_edgesrc_unlock_stop (GstBaseSrc * basesrc);
 static GstFlowReturn gst_edgesrc_create (GstBaseSrc * basesrc, guint64 offset,
     guint size, GstBuffer ** out_buf);
 
@@ -115,6 +119,9 @@ gst_edgesrc_class_init (GstEdgeSrcClass * klass)
       "Subscribe and push incoming streams", "Samsung Electronics Co., Ltd.");
 
   gstbasesrc_class->start = gst_edgesrc_start;
+  gstbasesrc_class->stop = gst_edgesrc_stop;
+  gstbasesrc_class->unlock = gst_edgesrc_unlock;
+  gstbasesrc_class->unlock_stop = gst_edgesrc_unlock_stop;
   gstbasesrc_class->create = gst_edgesrc_create;
 
   GST_DEBUG_CATEGORY_INIT (GST_CAT_DEFAULT,
@@ -139,6 +146,7 @@ gst_edgesrc_init (GstEdgeSrc * self)
   self->topic = NULL;
   self->msg_queue = g_async_queue_new ();
   self->connect_type = DEFAULT_CONNECT_TYPE;
+  self->local = NULL;
 }
 
 /**
@@ -245,6 +253,11 @@ gst_edgesrc_class_finalize (GObject * object)
     nns_edge_release_handle (self->edge_h);
     self->edge_h = NULL;
   }
+
+  if (self->local) {
+    gst_edge_local_free (self->local);
+    self->local = NULL;
+  }
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -301,6 +314,16 @@ gst_edgesrc_start (GstBaseSrc * basesrc)
   int ret;
   char *port = NULL;
 
+  if (self->connect_type == GST_EDGE_CONNECT_TYPE_LOCAL) {
+    self->local = gst_edge_local_new_subscriber (self->topic, self->dest_port);
+    if (!self->local) {
+      nns_loge ("Failed to connect to local edge. Please check topic and port.");
+      return FALSE;
+    }
+
+    return TRUE;
+  }
+
   ret =
       nns_edge_create_handle (NULL, self->connect_type,
       NNS_EDGE_NODE_TYPE_SUB, &self->edge_h);
@@ -349,6 +372,50 @@ gst_edgesrc_start (GstBaseSrc * basesrc)
   return TRUE;
 }
 
+/**
+ * @brief stop edgesrc, called when state changed ready to null
+ */
+static gboolean
+gst_edgesrc_stop (GstBaseSrc * basesrc)
+{
+  GstEdgeSrc *self = GST_EDGESRC (basesrc);
+
+  if (self->local) {
+    gst_edge_local_free (self->local);
+    self->local = NULL;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief unblock the create function of edgesrc
+ */
+static gboolean
+gst_edgesrc_unlock (GstBaseSrc * basesrc)
+{
+  GstEdgeSrc *self = GST_EDGESRC (basesrc);
+
+  if (self->local)
+    gst_edge_local_unlock (self->local);
+
+  return TRUE;
+}
+
+/**
+ * @brief clear the unlock request of edgesrc
+ */
+static gboolean
+gst_edgesrc_unlock_stop (GstBaseSrc * basesrc)
+{
+  GstEdgeSrc *self = GST_EDGESRC (basesrc);
+
+  if (self->local)
+    gst_edge_local_unlock_stop (self->local);
+
+  return TRUE;
+}
+
 /**
  * @brief Create a buffer containing the subscribed data
  */
@@ -361,11 +428,19 @@ gst_edgesrc_create (GstBaseSrc * basesrc, guint64 offset, guint size,
   nns_edge_data_h data_h;
   GstBuffer *buffer = NULL;
   guint i, num_data;
+  char *codec = NULL;
+  gsize max_sizes[NNS_TENSOR_SIZE_LIMIT];
+  GstCaps *caps;
   int ret;
 
   UNUSED (offset);
   UNUSED (size);
 
+  if (self->local) {
+    /* The memories are mapped from shared memory of edgesink, no copy here. */
+    return gst_edge_local_receive (self->local, out_buf);
+  }
+
   data_h = g_async_queue_pop (self->msg_queue);
 
   if (!data_h) {
@@ -379,21 +454,51 @@ gst_edgesrc_create (GstBaseSrc * basesrc, guint64 offset, guint size,
     goto done;
   }
 
+  /* The flag of each memory, '1' if the memory is encoded by edgesink. */
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h,
+          TENSOR_CODEC_INFO_KEY, &codec) || (codec && strlen (codec) != num_data)) {
+    g_free (codec);
+    codec = NULL;
+  }
+
+  if (codec) {
+    /* The decoded tensor cannot be larger than the negotiated tensor. */
+    caps = gst_pad_get_current_caps (GST_BASE_SRC_PAD (self));
+    gst_tensor_codec_get_max_sizes (caps, max_sizes);
+    if (caps)
+      gst_caps_unref (caps);
+  }
+
   buffer = gst_buffer_new ();
   for (i = 0; i < num_data; i++) {
     void *data = NULL;
     nns_size_t data_len = 0;
     gpointer new_data;
+    gsize new_size;
 
     nns_edge_data_get (data_h, i, &data, &data_len);
-    new_data = _g_memdup (data, data_len);
+
+    if (codec && codec[i] == '1') {
+      new_data = gst_tensor_codec_decode (data, data_len,
+          (i < NNS_TENSOR_SIZE_LIMIT) ? max_sizes[i] : 0, &new_size);
+      if (!new_data) {
+        nns_loge ("Failed to decode the %uth memory of the edge data.", i);
+        gst_buffer_unref (buffer);
+        buffer = NULL;
+        goto done;
+      }
+    } else {
+      new_data = _g_memdup (data, data_len);
+      new_size = data_len;
+    }
 
     gst_buffer_append_memory (buffer,
-        gst_memory_new_wrapped (0, new_data, data_len, 0, data_len, new_data,
+        gst_memory_new_wrapped (0, new_data, new_size, 0, new_size, new_data,
             g_free));
   }
 
 done:
+  g_free (codec);
   if (data_h)
     nns_edge_data_destroy (data_h);
 
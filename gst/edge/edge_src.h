@@ -16,6 +16,8 @@
 #include <gst/gst.h>
 #include <gst/base/gstbasesrc.h>
 #include "edge_common.h"
+#include "edge_local.h"
+#include "tensor_codec.h"
 #include "nnstreamer-edge.h"
 #include "nnstreamer_util.h"
 #include "../nnstreamer/nnstreamer_log.h"
@@ -51,6 +53,7 @@ struct _GstEdgeSrc
   nns_edge_connect_type_e connect_type;
   nns_edge_h edge_h;
   GAsyncQueue *msg_queue;
+  GstEdgeLocal *local; /**< shared-memory transport if connect-type is LOCAL */
 };
 
 /**
@@ -44,7 +44,9 @@
 #include <config.h>
 #endif
 
+#include <stddef.h>
 #include <string.h>
+#include <gst/video/video.h>
 #include "gsttensor_decoder.h"
 
 /**
@@ -125,6 +127,10 @@ static gboolean gst_tensordec_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensordec_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensordec_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query);
+static GstFlowReturn gst_tensordec_prepare_output_buffer (GstBaseTransform *
+    trans, GstBuffer * inbuf, GstBuffer ** outbuf);
 
 /**
  * @brief Validate decoder sub-plugin's data.
@@ -145,6 +151,12 @@ nnstreamer_decoder_validate (const GstTensorDecoderDef * decoder)
   return TRUE;
 }
 
+/**
+ * @brief The table of decoder definitions copied from the sub-plugins registered with decoder API v1.
+ */
+static GHashTable *decoder_v1_table = NULL;
+G_LOCK_DEFINE_STATIC (decoder_v1_table);
+
 /**
  * @brief Decoder's sub-plugin should call this function to register itself.
  * @param[in] decoder Decoder sub-plugin to be registered.
@@ -152,8 +164,53 @@ nnstreamer_decoder_validate (const GstTensorDecoderDef * decoder)
  */
 int
 nnstreamer_decoder_probe (GstTensorDecoderDef * decoder)
+{
+  GstTensorDecoderDef *def;
+  int ret;
+
+  g_return_val_if_fail (nnstreamer_decoder_validate (decoder), FALSE);
+
+  /**
+   * The sub-plugin may be built with the definition of decoder API v1,
+   * which ends with getTransformSize. Copy the fields of v1 only.
+   */
+  def = g_new0 (GstTensorDecoderDef, 1);
+  memcpy (def, decoder, offsetof (GstTensorDecoderDef, decodeBuffer));
+
+  ret = register_subplugin (NNS_SUBPLUGIN_DECODER, def->modename, def);
+  if (!ret) {
+    g_free (def);
+    return FALSE;
+  }
+
+  G_LOCK (decoder_v1_table);
+  if (!decoder_v1_table)
+    decoder_v1_table = g_hash_table_new_full (g_str_hash, g_str_equal,
+        NULL, g_free);
+  g_hash_table_insert (decoder_v1_table, def->modename, def);
+  G_UNLOCK (decoder_v1_table);
+
+  return ret;
+}
+
+/**
+ * @brief Decoder's sub-plugin with decoder API v2 (decodeBuffer) should call this function to register itself.
+ * @param[in] decoder Decoder sub-plugin to be registered.
+ * @param[in] size The size of decoder definition the sub-plugin is built with. It should be sizeof (GstTensorDecoderDef).
+ * @return TRUE if registered. FALSE is failed, duplicated, or the size is smaller than the definition of decoder API v2.
+ */
+int
+nnstreamer_decoder_probe_v2 (GstTensorDecoderDef * decoder, size_t size)
 {
   g_return_val_if_fail (nnstreamer_decoder_validate (decoder), FALSE);
+
+  if (size < sizeof (GstTensorDecoderDef)) {
+    nns_loge ("The decoder sub-plugin %s is built with the different version "
+        "of decoder API (size %zu, expected %zu).", decoder->modename, size,
+        sizeof (GstTensorDecoderDef));
+    return FALSE;
+  }
+
   return register_subplugin (NNS_SUBPLUGIN_DECODER, decoder->modename, decoder);
 }
 
@@ -165,6 +222,12 @@ void
 nnstreamer_decoder_exit (const char *name)
 {
   unregister_subplugin (NNS_SUBPLUGIN_DECODER, name);
+
+  /* free the definition copied in nnstreamer_decoder_probe () */
+  G_LOCK (decoder_v1_table);
+  if (decoder_v1_table && name)
+    g_hash_table_remove (decoder_v1_table, name);
+  G_UNLOCK (decoder_v1_table);
 }
 
 /**
@@ -386,6 +449,10 @@ gst_tensordec_class_init (GstTensorDecoderClass * klass)
   /** Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensordec_transform_size);
+  trans_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_tensordec_decide_allocation);
+  trans_class->prepare_output_buffer =
+      GST_DEBUG_FUNCPTR (gst_tensordec_prepare_output_buffer);
 }
 
 /**
@@ -407,6 +474,9 @@ gst_tensordec_init (GstTensorDecoder * self)
   self->is_custom = FALSE;
   self->custom.func = NULL;
   self->custom.data = NULL;
+  self->video_meta = FALSE;
+  self->overlay_composition = FALSE;
+  self->out_size = 0;
   for (i = 0; i < TensorDecMaxOpNum; i++)
     self->option[i] = NULL;
 
@@ -703,7 +773,16 @@ gst_tensordec_transform (GstBaseTransform * trans,
       input[i].data = in_info[i].data;
       input[i].size = in_info[i].size;
     }
-    if (!self->is_custom) {
+    if (!self->is_custom && self->decoder->decodeBuffer) {
+      GstTensorDecoderContext context;
+
+      context.inbuf = inbuf;
+      context.video_meta = self->video_meta;
+      context.overlay_composition = self->overlay_composition;
+
+      res = self->decoder->decodeBuffer (&self->plugin_data,
+          &self->tensor_config, input, &context, outbuf);
+    } else if (!self->is_custom) {
       res = self->decoder->decode (&self->plugin_data, &self->tensor_config,
           input, outbuf);
     } else if (self->custom.func != NULL) {
@@ -928,6 +1007,71 @@ gst_tensordec_transform_size (GstBaseTransform * trans,
   return TRUE;
 }
 
+/**
+ * @brief Decide allocation query for output buffers. optional vmethod of BaseTransform
+ */
+static gboolean
+gst_tensordec_decide_allocation (GstBaseTransform * trans, GstQuery * query)
+{
+  GstTensorDecoder *self = GST_TENSOR_DECODER_CAST (trans);
+
+  /* Check whether downstream can handle the stride of video frame and overlays. */
+  self->video_meta =
+      gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
+  self->overlay_composition = gst_query_find_allocation_meta (query,
+      GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE, NULL);
+  self->out_size = 0;
+
+  /**
+   * If the sub-plugin renders the frame, get the output buffer from the pool.
+   * Add the pool with the frame size if downstream does not propose it.
+   * The sub-plugin appends the memory by itself if it emits the overlays.
+   */
+  if (!self->is_custom && self->decoder && self->decoder->decodeBuffer &&
+      self->decoder->getTransformSize && !self->overlay_composition) {
+    GstCaps *caps, *outcaps;
+
+    gst_query_parse_allocation (query, &outcaps, NULL);
+    caps = gst_pad_get_current_caps (GST_BASE_TRANSFORM_SINK_PAD (trans));
+
+    self->out_size = self->decoder->getTransformSize (&self->plugin_data,
+        &self->tensor_config, caps, 0, outcaps, GST_PAD_SINK);
+
+    if (self->out_size > 0 && gst_query_get_n_allocation_pools (query) == 0)
+      gst_query_add_allocation_pool (query, NULL, self->out_size, 0, 0);
+
+    if (caps)
+      gst_caps_unref (caps);
+  }
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->decide_allocation (trans,
+      query);
+}
+
+/**
+ * @brief Prepare output buffer. optional vmethod of BaseTransform
+ *
+ * If the sub-plugin appends the memory by itself, pass empty buffer instead of the buffer from the pool.
+ */
+static GstFlowReturn
+gst_tensordec_prepare_output_buffer (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer ** outbuf)
+{
+  GstTensorDecoder *self = GST_TENSOR_DECODER_CAST (trans);
+
+  if (self->is_custom || self->decoder == NULL ||
+      self->decoder->decodeBuffer == NULL || self->out_size > 0) {
+    return GST_BASE_TRANSFORM_CLASS (parent_class)->prepare_output_buffer
+        (trans, inbuf, outbuf);
+  }
+
+  *outbuf = gst_buffer_new ();
+  gst_buffer_copy_into (*outbuf, inbuf,
+      GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief Registers a callback for tensor_decoder custom condition
  * @return 0 if success. -ERRNO if error.
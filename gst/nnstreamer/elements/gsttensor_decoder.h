@@ -81,6 +81,10 @@ struct _GstTensorDecoder
   gboolean is_custom;
   decoder_custom_cb_s custom;
 
+  gboolean video_meta; /**< TRUE if downstream supports GstVideoMeta */
+  gboolean overlay_composition; /**< TRUE if downstream supports GstVideoOverlayCompositionMeta */
+  gsize out_size; /**< The size of output buffer from the pool, 0 if the sub-plugin appends the memory */
+
   const GstTensorDecoderDef *decoder; /**< Plugin object */
   void *plugin_data;
 };
@@ -131,10 +131,219 @@ static void gst_tensor_merge_set_property (GObject * object, guint prop_id,
 static void gst_tensor_merge_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_tensor_merge_finalize (GObject * object);
+static gboolean gst_tensor_merge_sink_query (GstCollectPads * pads,
+    GstCollectData * data, GstQuery * query, GstTensorMerge * tensor_merge);
+static GstMemory *gst_tensor_merge_slice_alloc (GstTensorMerge * tensor_merge,
+    GstAllocator * allocator, guint index, gsize size,
+    GstAllocationParams * params);
 
 #define gst_tensor_merge_parent_class parent_class
 G_DEFINE_TYPE (GstTensorMerge, gst_tensor_merge, GST_TYPE_ELEMENT);
 
+/**
+ * @brief Max number of merged tensors whose slices are being allocated by upstream.
+ */
+#define TENSOR_MERGE_SLICE_FRAMES_LIMIT (8)
+
+/**
+ * @brief Memory type of the slice in the merged tensor.
+ */
+#define TENSOR_MERGE_SLICE_MEMORY_TYPE "TensorMergeSlice"
+
+/**
+ * @brief Merged tensor whose slices are allocated by upstream elements.
+ */
+typedef struct
+{
+  GstMemory *parent; /**< memory of the merged tensor */
+  guint8 *data; /**< data pointer of the merged tensor */
+  gboolean taken[NNS_TENSOR_SIZE_LIMIT]; /**< TRUE if the slice is allocated */
+  guint num_taken; /**< number of the allocated slices */
+} GstTensorMergeFrame;
+
+/**
+ * @brief Slice of the merged tensor.
+ */
+typedef struct
+{
+  GstMemory mem; /**< parent class, the parent memory is the merged tensor */
+  guint8 *data; /**< data pointer of the merged tensor */
+} GstTensorMergeMemory;
+
+/**
+ * @brief Allocator proposed to each sink pad, to allocate the slice of the merged tensor.
+ */
+typedef struct
+{
+  GstAllocator parent; /**< parent class */
+  GWeakRef merge; /**< tensor_merge element */
+  guint index; /**< index of the sink pad */
+} GstTensorMergeAllocator;
+
+/**
+ * @brief Class data of the slice allocator.
+ */
+typedef struct
+{
+  GstAllocatorClass parent_class; /**< parent class */
+} GstTensorMergeAllocatorClass;
+
+GType gst_tensor_merge_allocator_get_type (void);
+G_DEFINE_TYPE (GstTensorMergeAllocator, gst_tensor_merge_allocator,
+    GST_TYPE_ALLOCATOR);
+
+/**
+ * @brief Allocate the slice of the merged tensor, or system memory if the slice is not available.
+ */
+static GstMemory *
+gst_tensor_merge_allocator_alloc (GstAllocator * allocator, gsize size,
+    GstAllocationParams * params)
+{
+  GstTensorMergeAllocator *self = (GstTensorMergeAllocator *) allocator;
+  GstTensorMerge *tensor_merge;
+  GstMemory *mem = NULL;
+
+  tensor_merge = (GstTensorMerge *) g_weak_ref_get (&self->merge);
+  if (tensor_merge) {
+    mem = gst_tensor_merge_slice_alloc (tensor_merge, allocator, self->index,
+        size, params);
+    gst_object_unref (tensor_merge);
+  }
+
+  if (mem == NULL)
+    mem = gst_allocator_alloc (NULL, size, params);
+
+  return mem;
+}
+
+/**
+ * @brief Free the slice of the merged tensor.
+ */
+static void
+gst_tensor_merge_allocator_free (GstAllocator * allocator, GstMemory * mem)
+{
+  UNUSED (allocator);
+
+  /* the parent memory is released in gst-core */
+  g_free (mem);
+}
+
+/**
+ * @brief Map the slice. gst-core adds the offset of the slice.
+ */
+static gpointer
+gst_tensor_merge_memory_map (GstMemory * mem, gsize maxsize, GstMapFlags flags)
+{
+  UNUSED (maxsize);
+  UNUSED (flags);
+
+  return ((GstTensorMergeMemory *) mem)->data;
+}
+
+/**
+ * @brief Unmap the slice.
+ */
+static void
+gst_tensor_merge_memory_unmap (GstMemory * mem)
+{
+  UNUSED (mem);
+}
+
+/**
+ * @brief Share the region of the slice.
+ */
+static GstMemory *
+gst_tensor_merge_memory_share (GstMemory * mem, gssize offset, gssize size)
+{
+  GstTensorMergeMemory *sub;
+
+  if (size == -1)
+    size = mem->size - offset;
+
+  sub = g_new0 (GstTensorMergeMemory, 1);
+  gst_memory_init (GST_MEMORY_CAST (sub),
+      GST_MINI_OBJECT_FLAGS (mem->parent) | GST_MINI_OBJECT_FLAG_LOCK_READONLY,
+      mem->allocator, mem->parent, mem->maxsize, mem->align,
+      mem->offset + offset, size);
+  sub->data = ((GstTensorMergeMemory *) mem)->data;
+
+  return GST_MEMORY_CAST (sub);
+}
+
+/**
+ * @brief Check the slices are contiguous in the merged tensor.
+ */
+static gboolean
+gst_tensor_merge_memory_is_span (GstMemory * mem1, GstMemory * mem2,
+    gsize * offset)
+{
+  if (offset)
+    *offset = mem1->offset;
+
+  return (mem1->offset + mem1->size == mem2->offset);
+}
+
+/**
+ * @brief Finalize the slice allocator.
+ */
+static void
+gst_tensor_merge_allocator_finalize (GObject * object)
+{
+  GstTensorMergeAllocator *self = (GstTensorMergeAllocator *) object;
+
+  g_weak_ref_clear (&self->merge);
+
+  G_OBJECT_CLASS (gst_tensor_merge_allocator_parent_class)->finalize (object);
+}
+
+/**
+ * @brief Initialize the class of the slice allocator.
+ */
+static void
+gst_tensor_merge_allocator_class_init (GstTensorMergeAllocatorClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstAllocatorClass *allocator_class = (GstAllocatorClass *) klass;
+
+  gobject_class->finalize = gst_tensor_merge_allocator_finalize;
+  allocator_class->alloc = gst_tensor_merge_allocator_alloc;
+  allocator_class->free = gst_tensor_merge_allocator_free;
+}
+
+/**
+ * @brief Initialize the slice allocator.
+ */
+static void
+gst_tensor_merge_allocator_init (GstTensorMergeAllocator * self)
+{
+  GstAllocator *allocator = GST_ALLOCATOR_CAST (self);
+
+  allocator->mem_type = TENSOR_MERGE_SLICE_MEMORY_TYPE;
+  allocator->mem_map = gst_tensor_merge_memory_map;
+  allocator->mem_unmap = gst_tensor_merge_memory_unmap;
+  allocator->mem_share = gst_tensor_merge_memory_share;
+  allocator->mem_is_span = gst_tensor_merge_memory_is_span;
+
+  g_weak_ref_init (&self->merge, NULL);
+}
+
+/**
+ * @brief Create the slice allocator for the sink pad.
+ */
+static GstAllocator *
+gst_tensor_merge_allocator_new (GstTensorMerge * tensor_merge, guint index)
+{
+  GstTensorMergeAllocator *self;
+
+  self = g_object_new (gst_tensor_merge_allocator_get_type (), NULL);
+  gst_object_ref_sink (self);
+
+  g_weak_ref_set (&self->merge, tensor_merge);
+  self->index = index;
+
+  return GST_ALLOCATOR_CAST (self);
+}
+
 /**
  * @brief initialize the tensor_merge's class
  */
@@ -224,6 +433,9 @@ gst_tensor_merge_init (GstTensorMerge * tensor_merge)
   gst_collect_pads_set_function (tensor_merge->collect,
       (GstCollectPadsFunction) GST_DEBUG_FUNCPTR (gst_tensor_merge_collected),
       tensor_merge);
+  gst_collect_pads_set_query_function (tensor_merge->collect,
+      (GstCollectPadsQueryFunction)
+      GST_DEBUG_FUNCPTR (gst_tensor_merge_sink_query), tensor_merge);
 
   tensor_merge->silent = TRUE;
   tensor_merge->sync.mode = SYNC_NOSYNC;
@@ -233,6 +445,13 @@ gst_tensor_merge_init (GstTensorMerge * tensor_merge)
   tensor_merge->loaded = FALSE;
   tensor_merge->current_time = 0;
   tensor_merge->need_set_time = TRUE;
+
+  g_mutex_init (&tensor_merge->slice_lock);
+  tensor_merge->slice_num = 0;
+  tensor_merge->slice_pending = FALSE;
+  memset (tensor_merge->slice_allocator, 0,
+      sizeof (tensor_merge->slice_allocator));
+  g_queue_init (&tensor_merge->slice_frames);
 }
 
 /**
@@ -251,6 +470,20 @@ gst_tensor_merge_get_mode (const gchar * str)
   return GTT_END;
 }
 
+/**
+ * @brief Release the merged tensors whose slices are being allocated by upstream. (with slice_lock held)
+ */
+static void
+gst_tensor_merge_clear_slice_frames (GstTensorMerge * tensor_merge)
+{
+  GstTensorMergeFrame *frame;
+
+  while ((frame = g_queue_pop_head (&tensor_merge->slice_frames)) != NULL) {
+    gst_memory_unref (frame->parent);
+    g_free (frame);
+  }
+}
+
 /**
  * @brief finalize vmethod
  */
@@ -258,6 +491,7 @@ static void
 gst_tensor_merge_finalize (GObject * object)
 {
   GstTensorMerge *tensor_merge;
+  guint i;
 
   tensor_merge = GST_TENSOR_MERGE (object);
 
@@ -277,6 +511,17 @@ gst_tensor_merge_finalize (GObject * object)
     tensor_merge->sync.option = NULL;
   }
 
+  g_mutex_lock (&tensor_merge->slice_lock);
+  gst_tensor_merge_clear_slice_frames (tensor_merge);
+  g_mutex_unlock (&tensor_merge->slice_lock);
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    if (tensor_merge->slice_allocator[i]) {
+      gst_object_unref (tensor_merge->slice_allocator[i]);
+      tensor_merge->slice_allocator[i] = NULL;
+    }
+  }
+  g_mutex_clear (&tensor_merge->slice_lock);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -317,10 +562,19 @@ gst_tensor_merge_request_new_pad (GstElement * element, GstPadTemplate * templ,
 
     tensormergepad = (GstTensorCollectPadData *)
         gst_collect_pads_add_pad (tensor_merge->collect, newpad,
-        sizeof (GstTensorCollectPadData), NULL, TRUE);
+        sizeof (GstTensorCollectPadData),
+        (GstCollectDataDestroyNotify) gst_tensor_time_sync_pad_data_free,
+        TRUE);
 
     tensormergepad->pad = newpad;
     gst_pad_set_element_private (newpad, tensormergepad);
+
+    g_mutex_lock (&tensor_merge->slice_lock);
+    if (tensor_merge->slice_allocator[length] == NULL)
+      tensor_merge->slice_allocator[length] =
+          gst_tensor_merge_allocator_new (tensor_merge, length);
+    g_mutex_unlock (&tensor_merge->slice_lock);
+
     gst_element_add_pad (element, newpad);
   } else {
     GST_WARNING_OBJECT (tensor_merge, "failed to create request pad");
@@ -369,6 +623,237 @@ gst_tensor_merge_sink_event (GstCollectPads * pads, GstCollectData * data,
   return gst_collect_pads_event_default (pads, data, event, FALSE);
 }
 
+/**
+ * @brief Update the slices of the merged tensor from the current caps of the sink pads.
+ * @param tensor_merge tensor merger
+ * @param pad the sink pad to get the index of the slice
+ * @param index index of the slice for the sink pad
+ * @return TRUE if upstream elements can write the tensors into the slices
+ */
+static gboolean
+gst_tensor_merge_update_slices (GstTensorMerge * tensor_merge, GstPad * pad,
+    guint * index)
+{
+  GstTensorsConfig config;
+  GstTensorInfo *info;
+  GstCaps *caps;
+  GList *pads, *walk;
+  gsize size[NNS_TENSOR_SIZE_LIMIT];
+  gsize offset[NNS_TENSOR_SIZE_LIMIT];
+  tensor_dim dim = { 0 };
+  tensor_type type = _NNS_END;
+  guint num = 0;
+  gint j, direction;
+  gboolean ready;
+
+  GST_OBJECT_LOCK (tensor_merge);
+  pads = g_list_copy_deep (GST_ELEMENT (tensor_merge)->sinkpads,
+      (GCopyFunc) gst_object_ref, NULL);
+  GST_OBJECT_UNLOCK (tensor_merge);
+
+  direction = tensor_merge->data_linear.direction;
+  ready = (tensor_merge->mode == GTT_LINEAR && g_list_length (pads) > 1);
+
+  /**
+   * The merged tensor is the concatenation of input tensors only if the
+   * dimensions after the merging direction are 1.
+   */
+  for (walk = pads; walk && ready; walk = walk->next) {
+    gst_tensors_config_init (&config);
+
+    caps = gst_pad_get_current_caps (GST_PAD (walk->data));
+    if (caps) {
+      ready = gst_tensors_config_from_structure (&config,
+          gst_caps_get_structure (caps, 0));
+      gst_caps_unref (caps);
+    } else {
+      ready = FALSE;
+    }
+
+    ready = ready && gst_tensors_config_is_static (&config) &&
+        config.info.num_tensors == 1;
+
+    if (ready) {
+      info = &config.info.info[0];
+
+      if (num == 0) {
+        type = info->type;
+        memcpy (&dim, &info->dimension, sizeof (tensor_dim));
+      }
+
+      ready = (type == info->type);
+      for (j = 0; j < NNS_TENSOR_RANK_LIMIT && ready; j++) {
+        if (j > direction)
+          ready = (info->dimension[j] == 1);
+        else if (j < direction)
+          ready = (info->dimension[j] == dim[j]);
+      }
+
+      if (walk->data == pad)
+        *index = num;
+
+      size[num] = gst_tensor_info_get_size (info);
+      offset[num] = (num > 0) ? offset[num - 1] + size[num - 1] : 0;
+      num++;
+    }
+
+    gst_tensors_config_free (&config);
+  }
+
+  g_list_free_full (pads, gst_object_unref);
+
+  if (!ready)
+    num = 0;
+
+  g_mutex_lock (&tensor_merge->slice_lock);
+  if (num != tensor_merge->slice_num ||
+      memcmp (size, tensor_merge->slice_size, sizeof (gsize) * num) != 0) {
+    gst_tensor_merge_clear_slice_frames (tensor_merge);
+    tensor_merge->slice_num = num;
+    memcpy (tensor_merge->slice_size, size, sizeof (gsize) * num);
+    memcpy (tensor_merge->slice_offset, offset, sizeof (gsize) * num);
+  }
+  g_mutex_unlock (&tensor_merge->slice_lock);
+
+  return (num > 0);
+}
+
+/**
+ * @brief Allocate the slice of the merged tensor for the sink pad.
+ * @param tensor_merge tensor merger
+ * @param allocator the slice allocator of the sink pad
+ * @param index index of the slice
+ * @param size size to be allocated
+ * @param params allocation parameters
+ * @return The slice of the merged tensor. NULL if the slice is not available.
+ */
+static GstMemory *
+gst_tensor_merge_slice_alloc (GstTensorMerge * tensor_merge,
+    GstAllocator * allocator, guint index, gsize size,
+    GstAllocationParams * params)
+{
+  GstTensorMergeFrame *frame = NULL;
+  GstTensorMergeMemory *slice = NULL;
+  GList *walk;
+  gsize total, offset;
+
+  if (params && (params->prefix > 0 || params->padding > 0))
+    return NULL;
+
+  g_mutex_lock (&tensor_merge->slice_lock);
+
+  if (index >= tensor_merge->slice_num ||
+      tensor_merge->slice_allocator[index] != allocator ||
+      tensor_merge->slice_size[index] != size)
+    goto done;
+
+  offset = tensor_merge->slice_offset[index];
+  total = tensor_merge->slice_offset[tensor_merge->slice_num - 1] +
+      tensor_merge->slice_size[tensor_merge->slice_num - 1];
+
+  /* the oldest merged tensor of which the slice is not allocated yet */
+  for (walk = tensor_merge->slice_frames.head; walk; walk = walk->next) {
+    GstTensorMergeFrame *f = (GstTensorMergeFrame *) walk->data;
+
+    if (!f->taken[index]) {
+      frame = f;
+      break;
+    }
+  }
+
+  if (frame == NULL) {
+    if (g_queue_get_length (&tensor_merge->slice_frames) >=
+        TENSOR_MERGE_SLICE_FRAMES_LIMIT) {
+      /* other pads do not allocate the slices, drop the oldest one */
+      frame = g_queue_pop_head (&tensor_merge->slice_frames);
+      gst_memory_unref (frame->parent);
+      g_free (frame);
+    }
+
+    frame = g_new0 (GstTensorMergeFrame, 1);
+    frame->data = (guint8 *) g_malloc (total);
+    frame->parent = gst_memory_new_wrapped (0, frame->data, total, 0, total,
+        frame->data, g_free);
+    g_queue_push_tail (&tensor_merge->slice_frames, frame);
+  }
+
+  if (params && ((guintptr) (frame->data + offset) & params->align) != 0)
+    goto done;
+
+  slice = g_new0 (GstTensorMergeMemory, 1);
+  gst_memory_init (GST_MEMORY_CAST (slice), 0, allocator, frame->parent,
+      total, 0, offset, size);
+  slice->data = frame->data;
+
+  frame->taken[index] = TRUE;
+  frame->num_taken++;
+
+  if (frame->num_taken == tensor_merge->slice_num) {
+    /* all slices are allocated, the slices keep the parent memory */
+    g_queue_remove (&tensor_merge->slice_frames, frame);
+    gst_memory_unref (frame->parent);
+    g_free (frame);
+  }
+
+done:
+  g_mutex_unlock (&tensor_merge->slice_lock);
+  return GST_MEMORY_CAST (slice);
+}
+
+/**
+ * @brief sink query vmethod
+ */
+static gboolean
+gst_tensor_merge_sink_query (GstCollectPads * pads, GstCollectData * data,
+    GstQuery * query, GstTensorMerge * tensor_merge)
+{
+  GstAllocator *allocator;
+  GList *sinkpads, *walk;
+  gboolean reconfigure;
+  guint index = 0;
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_ALLOCATION:
+      if (!gst_tensor_merge_update_slices (tensor_merge, data->pad, &index)) {
+        /* other pads are not negotiated yet, reconfigure upstream later */
+        g_mutex_lock (&tensor_merge->slice_lock);
+        tensor_merge->slice_pending = TRUE;
+        g_mutex_unlock (&tensor_merge->slice_lock);
+        return FALSE;
+      }
+
+      g_mutex_lock (&tensor_merge->slice_lock);
+      allocator = gst_object_ref (tensor_merge->slice_allocator[index]);
+      reconfigure = tensor_merge->slice_pending;
+      tensor_merge->slice_pending = FALSE;
+      g_mutex_unlock (&tensor_merge->slice_lock);
+
+      /* propose the slice of the merged tensor so that upstream writes the tensor in place */
+      gst_query_add_allocation_param (query, allocator, NULL);
+      gst_object_unref (allocator);
+
+      if (reconfigure) {
+        GST_OBJECT_LOCK (tensor_merge);
+        sinkpads = g_list_copy_deep (GST_ELEMENT (tensor_merge)->sinkpads,
+            (GCopyFunc) gst_object_ref, NULL);
+        GST_OBJECT_UNLOCK (tensor_merge);
+
+        for (walk = sinkpads; walk; walk = walk->next) {
+          if (walk->data != data->pad)
+            gst_pad_push_event (GST_PAD (walk->data),
+                gst_event_new_reconfigure ());
+        }
+
+        g_list_free_full (sinkpads, gst_object_unref);
+      }
+      return TRUE;
+    default:
+      break;
+  }
+
+  return gst_collect_pads_query_default (pads, data, query, FALSE);
+}
+
 /**
  * @brief Generate out TensorsConfig with in TensorsConfig
  * @param tensor_merge tensor merger
@@ -453,6 +938,99 @@ gst_tensor_merge_collect_buffer (GstTensorMerge * tensor_merge,
       &tensor_merge->tensors_config, is_eos);
 }
 
+/**
+ * @brief Data to keep the input memories while the merged memory refers to them.
+ */
+typedef struct
+{
+  guint num_mem; /**< number of the mapped input memories */
+  GstMemory *mem[NNS_TENSOR_SIZE_LIMIT]; /**< input memories */
+  GstMapInfo info[NNS_TENSOR_SIZE_LIMIT]; /**< map info of input memories */
+} GstTensorMergeSpan;
+
+/**
+ * @brief Release the input memories of the merged memory.
+ */
+static void
+gst_tensor_merge_span_free (GstTensorMergeSpan * span)
+{
+  guint i;
+
+  for (i = 0; i < span->num_mem; i++) {
+    gst_memory_unmap (span->mem[i], &span->info[i]);
+    gst_memory_unref (span->mem[i]);
+  }
+
+  g_free (span);
+}
+
+/**
+ * @brief Get the merged memory without copying the data if upstream elements wrote the tensors into the contiguous slices of the same parent memory.
+ * @param tensor_merge tensor merger
+ * @param tensors_buf collected tensors buffer
+ * @return The read-only memory which refers to the input memories. NULL if the tensors cannot be merged without copy.
+ */
+static GstMemory *
+gst_tensor_merge_get_spanned_mem (GstTensorMerge * tensor_merge,
+    GstBuffer * tensors_buf)
+{
+  guint num_mem = tensor_merge->tensors_config.info.num_tensors;
+  GstTensorMergeSpan *span;
+  GstMemory *first, *mem;
+  gsize size = 0;
+  guint i;
+  gint j;
+  tensor_dim dim;
+
+  if (tensor_merge->mode != GTT_LINEAR || num_mem < 2)
+    return NULL;
+
+  /**
+   * The merged tensor is the concatenation of input tensors only if the
+   * dimensions after the merging direction are 1.
+   */
+  memcpy (&dim, &tensor_merge->tensors_config.info.info[0].dimension,
+      sizeof (tensor_dim));
+  for (j = tensor_merge->data_linear.direction + 1;
+      j < NNS_TENSOR_RANK_LIMIT; j++) {
+    if (dim[j] != 1)
+      return NULL;
+  }
+
+  first = gst_buffer_peek_memory (tensors_buf, 0);
+  if (first->parent == NULL)
+    return NULL;
+
+  /**
+   * Each sink pad has its own slice allocator, so the memories cannot be
+   * checked with gst_memory_is_span(). Check the mapped data instead.
+   */
+  span = g_new0 (GstTensorMergeSpan, 1);
+  for (i = 0; i < num_mem; i++) {
+    mem = gst_buffer_peek_memory (tensors_buf, i);
+
+    if (mem->parent != first->parent ||
+        !gst_memory_map (mem, &span->info[i], GST_MAP_READ))
+      goto not_spanned;
+
+    span->mem[span->num_mem++] = gst_memory_ref (mem);
+
+    if (i > 0 &&
+        span->info[i].data != span->info[i - 1].data + span->info[i - 1].size)
+      goto not_spanned;
+
+    size += span->info[i].size;
+  }
+
+  /* the input memories are not writable until the merged memory is released */
+  return gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, span->info[0].data,
+      size, 0, size, span, (GDestroyNotify) gst_tensor_merge_span_free);
+
+not_spanned:
+  gst_tensor_merge_span_free (span);
+  return NULL;
+}
+
 /**
  * @brief Generate Output GstMemory
  * @param tensor_merge tensor merger
@@ -483,6 +1061,15 @@ gst_tensor_merge_generate_mem (GstTensorMerge * tensor_merge,
   type = tensor_merge->tensors_config.info.info[0].type;
   element_size = gst_tensor_get_element_size (type);
 
+  /* zero-copy if the tensors are already placed in the merged order */
+  outMem = gst_tensor_merge_get_spanned_mem (tensor_merge, tensors_buf);
+  if (outMem) {
+    gst_buffer_append_memory (tensor_buf, outMem);
+    gst_buffer_copy_into (tensor_buf, tensors_buf, GST_BUFFER_COPY_TIMESTAMPS,
+        0, -1);
+    return GST_FLOW_OK;
+  }
+
   for (i = 0; i < num_mem; i++) {
     mem[i] = gst_buffer_peek_memory (tensors_buf, i);
     if (!gst_memory_map (mem[i], &mInfo[i], GST_MAP_READ)) {
@@ -761,6 +1348,9 @@ gst_tensor_merge_change_state (GstElement * element, GstStateChange transition)
     return ret;
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      g_mutex_lock (&tensor_merge->slice_lock);
+      gst_tensor_merge_clear_slice_frames (tensor_merge);
+      g_mutex_unlock (&tensor_merge->slice_lock);
       break;
     default:
       break;
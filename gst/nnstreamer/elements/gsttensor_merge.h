@@ -91,6 +91,14 @@ struct _GstTensorMerge
   GstClockTime current_time;
   gboolean need_set_time;
   GstTensorsConfig tensors_config; /**< output tensors info */
+
+  GMutex slice_lock; /**< lock for the slices of the merged tensor proposed to upstream */
+  guint slice_num; /**< number of slices (one for each sink pad), 0 if the slices cannot be proposed */
+  gsize slice_size[NNS_TENSOR_SIZE_LIMIT]; /**< size of the slice for each sink pad */
+  gsize slice_offset[NNS_TENSOR_SIZE_LIMIT]; /**< offset of the slice in the merged tensor */
+  gboolean slice_pending; /**< TRUE if a sink pad queried the allocation before the slices are ready */
+  GstAllocator *slice_allocator[NNS_TENSOR_SIZE_LIMIT]; /**< allocator proposed to each sink pad */
+  GQueue slice_frames; /**< merged tensors whose slices are being allocated by upstream */
 };
 
 /**
@@ -34,6 +34,12 @@
 
 #include "gsttensor_sink.h"
 
+#ifdef G_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <glib-unix.h>
+#endif
+
 /**
  * @brief Macro for debug mode.
  */
@@ -60,6 +66,12 @@ enum
   SIGNAL_NEW_DATA,
   SIGNAL_STREAM_START,
   SIGNAL_EOS,
+  SIGNAL_NEW_DATA_BATCH,
+
+  /* actions */
+  SIGNAL_PULL_BUFFER,
+  SIGNAL_TRY_PULL_BUFFER,
+
   LAST_SIGNAL
 };
 
@@ -71,7 +83,11 @@ enum
   PROP_0,
   PROP_SIGNAL_RATE,
   PROP_EMIT_SIGNAL,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_MAX_BUFFERS,
+  PROP_DROP,
+  PROP_BATCH_SIZE,
+  PROP_WAKEUP_FD
 };
 
 /**
@@ -89,6 +105,21 @@ enum
  */
 #define DEFAULT_SILENT TRUE
 
+/**
+ * @brief Max number of buffers in the queue for pull mode (Default 0 to disable pull mode).
+ */
+#define DEFAULT_MAX_BUFFERS 0
+
+/**
+ * @brief Flag to drop the oldest buffer when the queue is full (Default FALSE to block streaming thread).
+ */
+#define DEFAULT_DROP FALSE
+
+/**
+ * @brief The number of buffers delivered with one new-data-batch signal (Default 1 to emit new-data signal for each buffer).
+ */
+#define DEFAULT_BATCH_SIZE 1
+
 /**
  * @brief Flag for qos event.
  *
@@ -118,14 +149,31 @@ static void gst_tensor_sink_finalize (GObject * object);
 /** GstBaseSink method implementation */
 static gboolean gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event);
 static gboolean gst_tensor_sink_query (GstBaseSink * sink, GstQuery * query);
+static gboolean gst_tensor_sink_start (GstBaseSink * sink);
+static gboolean gst_tensor_sink_stop (GstBaseSink * sink);
+static gboolean gst_tensor_sink_unlock (GstBaseSink * sink);
+static gboolean gst_tensor_sink_unlock_stop (GstBaseSink * sink);
 static GstFlowReturn gst_tensor_sink_render (GstBaseSink * sink,
     GstBuffer * buffer);
 static GstFlowReturn gst_tensor_sink_render_list (GstBaseSink * sink,
     GstBufferList * buffer_list);
 
+/** actions */
+static GstBuffer *gst_tensor_sink_pull_buffer (GstTensorSink * self);
+static GstBuffer *gst_tensor_sink_try_pull_buffer (GstTensorSink * self,
+    GstClockTime timeout);
+
 /** internal functions */
-static void gst_tensor_sink_render_buffer (GstTensorSink * self,
+static GstFlowReturn gst_tensor_sink_render_buffer (GstTensorSink * self,
+    GstBuffer * buffer);
+static GstFlowReturn gst_tensor_sink_queue_buffer (GstTensorSink * self,
     GstBuffer * buffer);
+static void gst_tensor_sink_batch_buffer (GstTensorSink * self,
+    GstBuffer * buffer);
+static void gst_tensor_sink_flush_batch (GstTensorSink * self, gboolean emit);
+static void gst_tensor_sink_clear_queue (GstTensorSink * self);
+static void gst_tensor_sink_wakeup_set (GstTensorSink * self);
+static void gst_tensor_sink_wakeup_clear (GstTensorSink * self);
 static void gst_tensor_sink_set_last_render_time (GstTensorSink * self,
     GstClockTime now);
 static GstClockTime gst_tensor_sink_get_last_render_time (GstTensorSink * self);
@@ -136,6 +184,13 @@ static void gst_tensor_sink_set_emit_signal (GstTensorSink * self,
 static gboolean gst_tensor_sink_get_emit_signal (GstTensorSink * self);
 static void gst_tensor_sink_set_silent (GstTensorSink * self, gboolean silent);
 static gboolean gst_tensor_sink_get_silent (GstTensorSink * self);
+static void gst_tensor_sink_set_max_buffers (GstTensorSink * self, guint max);
+static guint gst_tensor_sink_get_max_buffers (GstTensorSink * self);
+static void gst_tensor_sink_set_drop (GstTensorSink * self, gboolean drop);
+static gboolean gst_tensor_sink_get_drop (GstTensorSink * self);
+static void gst_tensor_sink_set_batch_size (GstTensorSink * self, guint size);
+static guint gst_tensor_sink_get_batch_size (GstTensorSink * self);
+static gint gst_tensor_sink_get_wakeup_fd (GstTensorSink * self);
 
 #define gst_tensor_sink_parent_class parent_class
 G_DEFINE_TYPE (GstTensorSink, gst_tensor_sink, GST_TYPE_BASE_SINK);
@@ -198,6 +253,57 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorSink::max-buffers:
+   *
+   * The max number of buffers in the queue for pull mode (Default 0 to disable pull mode).
+   * If max-buffers is larger than 0, GstTensorSink keeps the received buffers in the queue,
+   * and an application can get the buffer with the action signals pull-buffer and try-pull-buffer.
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_BUFFERS,
+      g_param_spec_uint ("max-buffers", "Max buffers",
+          "The max number of buffers in the queue for pull mode (0 to disable pull mode)",
+          0, G_MAXUINT, DEFAULT_MAX_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::drop:
+   *
+   * The policy when the queue for pull mode is full.
+   * If TRUE, GstTensorSink drops the oldest buffer in the queue.
+   * If FALSE (default value), GstTensorSink blocks the streaming thread until an application pulls the buffer.
+   */
+  g_object_class_install_property (gobject_class, PROP_DROP,
+      g_param_spec_boolean ("drop", "Drop",
+          "Drop the oldest buffer when the queue is full, otherwise block",
+          DEFAULT_DROP, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::batch-size:
+   *
+   * The number of buffers delivered with one new-data-batch signal (Default 1).
+   * If batch-size is larger than 1, GstTensorSink emits the signal new-data-batch with the list of buffers, instead of the signal new-data for each buffer.
+   * Remaining buffers are delivered when EOS is reached.
+   */
+  g_object_class_install_property (gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint ("batch-size", "Batch size",
+          "The number of buffers delivered with one new-data-batch signal",
+          1, G_MAXUINT, DEFAULT_BATCH_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::wakeup-fd:
+   *
+   * The file descriptor which becomes readable when the queue for pull mode has a buffer or EOS is reached.
+   * An application can poll this in its own event loop, then get the buffer with the action signal try-pull-buffer.
+   * Do not read or close this descriptor. GstTensorSink drains it when the queue becomes empty.
+   * Returns -1 if the platform does not support it.
+   */
+  g_object_class_install_property (gobject_class, PROP_WAKEUP_FD,
+      g_param_spec_int ("wakeup-fd", "Wakeup fd",
+          "The file descriptor readable when a buffer is queued or EOS is reached (read-only)",
+          -1, G_MAXINT, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstTensorSink::new-data:
    *
@@ -230,6 +336,43 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
       G_STRUCT_OFFSET (GstTensorSinkClass, eos), NULL, NULL, NULL,
       G_TYPE_NONE, 0, G_TYPE_NONE);
 
+  /**
+   * GstTensorSink::new-data-batch:
+   *
+   * Signal to get the list of buffers from GstTensorSink, when batch-size is larger than 1.
+   */
+  _tensor_sink_signals[SIGNAL_NEW_DATA_BATCH] =
+      g_signal_new ("new-data-batch", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST, G_STRUCT_OFFSET (GstTensorSinkClass, new_data_batch),
+      NULL, NULL, NULL, G_TYPE_NONE, 1,
+      GST_TYPE_BUFFER_LIST | G_SIGNAL_TYPE_STATIC_SCOPE);
+
+  /**
+   * GstTensorSink::pull-buffer:
+   *
+   * Action signal to get the buffer from the queue for pull mode.
+   * This blocks until a buffer is available, or returns NULL when EOS is reached or the element is stopped.
+   * The caller should unref the returned buffer.
+   */
+  _tensor_sink_signals[SIGNAL_PULL_BUFFER] =
+      g_signal_new ("pull-buffer", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstTensorSinkClass, pull_buffer), NULL, NULL, NULL,
+      GST_TYPE_BUFFER, 0, G_TYPE_NONE);
+
+  /**
+   * GstTensorSink::try-pull-buffer:
+   *
+   * Action signal to get the buffer from the queue for pull mode, waiting at most the given timeout (in nanoseconds).
+   * Returns NULL if no buffer is available within the timeout, EOS is reached, or the element is stopped.
+   * The caller should unref the returned buffer.
+   */
+  _tensor_sink_signals[SIGNAL_TRY_PULL_BUFFER] =
+      g_signal_new ("try-pull-buffer", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstTensorSinkClass, try_pull_buffer), NULL, NULL, NULL,
+      GST_TYPE_BUFFER, 1, GST_TYPE_CLOCK_TIME);
+
   gst_element_class_set_static_metadata (element_class,
       "TensorSink",
       "Sink/Tensor",
@@ -248,6 +391,14 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
   bsink_class->query = GST_DEBUG_FUNCPTR (gst_tensor_sink_query);
   bsink_class->render = GST_DEBUG_FUNCPTR (gst_tensor_sink_render);
   bsink_class->render_list = GST_DEBUG_FUNCPTR (gst_tensor_sink_render_list);
+  bsink_class->start = GST_DEBUG_FUNCPTR (gst_tensor_sink_start);
+  bsink_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_sink_stop);
+  bsink_class->unlock = GST_DEBUG_FUNCPTR (gst_tensor_sink_unlock);
+  bsink_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_tensor_sink_unlock_stop);
+
+  /** actions */
+  klass->pull_buffer = gst_tensor_sink_pull_buffer;
+  klass->try_pull_buffer = gst_tensor_sink_try_pull_buffer;
 }
 
 /**
@@ -261,12 +412,22 @@ gst_tensor_sink_init (GstTensorSink * self)
   bsink = GST_BASE_SINK (self);
 
   g_mutex_init (&self->mutex);
+  g_cond_init (&self->cond);
+  g_queue_init (&self->queue);
 
   /** init properties */
   self->silent = DEFAULT_SILENT;
   self->emit_signal = DEFAULT_EMIT_SIGNAL;
   self->signal_rate = DEFAULT_SIGNAL_RATE;
   self->last_render_time = GST_CLOCK_TIME_NONE;
+  self->max_buffers = DEFAULT_MAX_BUFFERS;
+  self->drop = DEFAULT_DROP;
+  self->batch_size = DEFAULT_BATCH_SIZE;
+  self->batch = NULL;
+  self->flushing = TRUE;
+  self->is_eos = FALSE;
+  self->wakeup_fd[0] = self->wakeup_fd[1] = -1;
+  self->wakeup_signaled = FALSE;
 
   /** enable qos */
   gst_base_sink_set_qos_enabled (bsink, DEFAULT_QOS);
@@ -301,6 +462,18 @@ gst_tensor_sink_set_property (GObject * object, guint prop_id,
       gst_tensor_sink_set_silent (self, g_value_get_boolean (value));
       break;
 
+    case PROP_MAX_BUFFERS:
+      gst_tensor_sink_set_max_buffers (self, g_value_get_uint (value));
+      break;
+
+    case PROP_DROP:
+      gst_tensor_sink_set_drop (self, g_value_get_boolean (value));
+      break;
+
+    case PROP_BATCH_SIZE:
+      gst_tensor_sink_set_batch_size (self, g_value_get_uint (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -333,6 +506,22 @@ gst_tensor_sink_get_property (GObject * object, guint prop_id,
       g_value_set_boolean (value, gst_tensor_sink_get_silent (self));
       break;
 
+    case PROP_MAX_BUFFERS:
+      g_value_set_uint (value, gst_tensor_sink_get_max_buffers (self));
+      break;
+
+    case PROP_DROP:
+      g_value_set_boolean (value, gst_tensor_sink_get_drop (self));
+      break;
+
+    case PROP_BATCH_SIZE:
+      g_value_set_uint (value, gst_tensor_sink_get_batch_size (self));
+      break;
+
+    case PROP_WAKEUP_FD:
+      g_value_set_int (value, gst_tensor_sink_get_wakeup_fd (self));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -351,6 +540,18 @@ gst_tensor_sink_finalize (GObject * object)
 
   self = GST_TENSOR_SINK (object);
 
+  gst_tensor_sink_clear_queue (self);
+  gst_tensor_sink_flush_batch (self, FALSE);
+
+#ifdef G_OS_UNIX
+  if (self->wakeup_fd[0] >= 0) {
+    close (self->wakeup_fd[0]);
+    close (self->wakeup_fd[1]);
+    self->wakeup_fd[0] = self->wakeup_fd[1] = -1;
+  }
+#endif
+
+  g_cond_clear (&self->cond);
   g_mutex_clear (&self->mutex);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -383,6 +584,15 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
       break;
 
     case GST_EVENT_EOS:
+      /** deliver remaining buffers before eos signal */
+      gst_tensor_sink_flush_batch (self, TRUE);
+
+      g_mutex_lock (&self->mutex);
+      self->is_eos = TRUE;
+      gst_tensor_sink_wakeup_set (self);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->mutex);
+
       if (gst_tensor_sink_get_emit_signal (self)) {
         silent_debug (self, "Emit signal for eos");
 
@@ -390,6 +600,11 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
       }
       break;
 
+    case GST_EVENT_FLUSH_STOP:
+      gst_tensor_sink_clear_queue (self);
+      gst_tensor_sink_flush_batch (self, FALSE);
+      break;
+
     default:
       break;
   }
@@ -429,6 +644,88 @@ gst_tensor_sink_query (GstBaseSink * sink, GstQuery * query)
   return GST_BASE_SINK_CLASS (parent_class)->query (sink, query);
 }
 
+/**
+ * @brief Start processing, the queue for pull mode is ready.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_start (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = FALSE;
+  self->is_eos = FALSE;
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop processing, release the buffers in the queue.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_stop (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = TRUE;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+
+  gst_tensor_sink_clear_queue (self);
+  gst_tensor_sink_flush_batch (self, FALSE);
+
+  return TRUE;
+}
+
+/**
+ * @brief Unblock the streaming thread waiting for the space in the queue, and the application waiting for the buffer.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_unlock (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = TRUE;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
+/**
+ * @brief Clear the flushing state.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_unlock_stop (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = FALSE;
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
 /**
  * @brief Handle buffer.
  *
@@ -440,9 +737,8 @@ gst_tensor_sink_render (GstBaseSink * sink, GstBuffer * buffer)
   GstTensorSink *self;
 
   self = GST_TENSOR_SINK (sink);
-  gst_tensor_sink_render_buffer (self, buffer);
 
-  return GST_FLOW_OK;
+  return gst_tensor_sink_render_buffer (self, buffer);
 }
 
 /**
@@ -455,34 +751,36 @@ gst_tensor_sink_render_list (GstBaseSink * sink, GstBufferList * buffer_list)
 {
   GstTensorSink *self;
   GstBuffer *buffer;
+  GstFlowReturn ret = GST_FLOW_OK;
   guint i;
   guint num_buffers;
 
   self = GST_TENSOR_SINK (sink);
   num_buffers = gst_buffer_list_length (buffer_list);
 
-  for (i = 0; i < num_buffers; i++) {
+  for (i = 0; i < num_buffers && ret == GST_FLOW_OK; i++) {
     buffer = gst_buffer_list_get (buffer_list, i);
-    gst_tensor_sink_render_buffer (self, buffer);
+    ret = gst_tensor_sink_render_buffer (self, buffer);
   }
 
-  return GST_FLOW_OK;
+  return ret;
 }
 
 /**
  * @brief Handle buffer data.
- * @return None
+ * @return GST_FLOW_OK, or GST_FLOW_FLUSHING if the element is flushing while waiting for the space in the queue.
  * @param self pointer to GstTensorSink
  * @param buffer pointer to GstBuffer to be handled
  */
-static void
+static GstFlowReturn
 gst_tensor_sink_render_buffer (GstTensorSink * self, GstBuffer * buffer)
 {
   GstClockTime now = GST_CLOCK_TIME_NONE;
+  GstFlowReturn ret = GST_FLOW_OK;
   guint signal_rate;
   gboolean notify = FALSE;
 
-  g_return_if_fail (GST_IS_TENSOR_SINK (self));
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), GST_FLOW_ERROR);
 
   signal_rate = gst_tensor_sink_get_signal_rate (self);
 
@@ -517,15 +815,225 @@ gst_tensor_sink_render_buffer (GstTensorSink * self, GstBuffer * buffer)
     gst_tensor_sink_set_last_render_time (self, now);
 
     if (gst_tensor_sink_get_emit_signal (self)) {
-      silent_debug (self,
-          "Emit signal for new data [%" GST_TIME_FORMAT "] rate [%d]",
-          GST_TIME_ARGS (now), signal_rate);
-
-      g_signal_emit (self, _tensor_sink_signals[SIGNAL_NEW_DATA], 0, buffer);
+      if (gst_tensor_sink_get_batch_size (self) > 1) {
+        gst_tensor_sink_batch_buffer (self, buffer);
+      } else {
+        silent_debug (self,
+            "Emit signal for new data [%" GST_TIME_FORMAT "] rate [%d]",
+            GST_TIME_ARGS (now), signal_rate);
+
+        g_signal_emit (self, _tensor_sink_signals[SIGNAL_NEW_DATA], 0, buffer);
+      }
     }
+
+    ret = gst_tensor_sink_queue_buffer (self, buffer);
   }
 
   silent_debug_timestamp (self, buffer);
+  return ret;
+}
+
+/**
+ * @brief Push the buffer into the queue for pull mode.
+ * @return GST_FLOW_OK, or GST_FLOW_FLUSHING if the element is flushing while waiting for the space in the queue.
+ */
+static GstFlowReturn
+gst_tensor_sink_queue_buffer (GstTensorSink * self, GstBuffer * buffer)
+{
+  GstBuffer *old;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  g_mutex_lock (&self->mutex);
+
+  if (self->max_buffers == 0)
+    goto done;
+
+  while (!self->flushing &&
+      g_queue_get_length (&self->queue) >= self->max_buffers) {
+    if (self->drop) {
+      old = (GstBuffer *) g_queue_pop_head (&self->queue);
+      silent_debug (self, "The queue is full, drop the oldest buffer.");
+      gst_buffer_unref (old);
+    } else {
+      g_cond_wait (&self->cond, &self->mutex);
+    }
+  }
+
+  if (self->flushing) {
+    ret = GST_FLOW_FLUSHING;
+    goto done;
+  }
+
+  g_queue_push_tail (&self->queue, gst_buffer_ref (buffer));
+  gst_tensor_sink_wakeup_set (self);
+  g_cond_broadcast (&self->cond);
+
+done:
+  g_mutex_unlock (&self->mutex);
+  return ret;
+}
+
+/**
+ * @brief Add the buffer to the batch, and emit new-data-batch signal when the batch is full.
+ */
+static void
+gst_tensor_sink_batch_buffer (GstTensorSink * self, GstBuffer * buffer)
+{
+  GstBufferList *list = NULL;
+
+  g_mutex_lock (&self->mutex);
+  if (self->batch == NULL)
+    self->batch = gst_buffer_list_new_sized (self->batch_size);
+
+  gst_buffer_list_add (self->batch, gst_buffer_ref (buffer));
+
+  if (gst_buffer_list_length (self->batch) >= self->batch_size) {
+    list = self->batch;
+    self->batch = NULL;
+  }
+  g_mutex_unlock (&self->mutex);
+
+  if (list) {
+    silent_debug (self, "Emit signal for new data batch [%u]",
+        gst_buffer_list_length (list));
+
+    g_signal_emit (self, _tensor_sink_signals[SIGNAL_NEW_DATA_BATCH], 0, list);
+    gst_buffer_list_unref (list);
+  }
+}
+
+/**
+ * @brief Release the pending buffers in the batch.
+ * @param self pointer to GstTensorSink
+ * @param emit TRUE to emit new-data-batch signal with the remaining buffers
+ */
+static void
+gst_tensor_sink_flush_batch (GstTensorSink * self, gboolean emit)
+{
+  GstBufferList *list;
+
+  g_mutex_lock (&self->mutex);
+  list = self->batch;
+  self->batch = NULL;
+  g_mutex_unlock (&self->mutex);
+
+  if (list) {
+    if (emit && gst_buffer_list_length (list) > 0 &&
+        gst_tensor_sink_get_emit_signal (self)) {
+      silent_debug (self, "Emit signal for remaining data batch [%u]",
+          gst_buffer_list_length (list));
+
+      g_signal_emit (self, _tensor_sink_signals[SIGNAL_NEW_DATA_BATCH], 0,
+          list);
+    }
+
+    gst_buffer_list_unref (list);
+  }
+}
+
+/**
+ * @brief Release all buffers in the queue for pull mode.
+ */
+static void
+gst_tensor_sink_clear_queue (GstTensorSink * self)
+{
+  GstBuffer *buffer;
+
+  g_mutex_lock (&self->mutex);
+  while ((buffer = (GstBuffer *) g_queue_pop_head (&self->queue)) != NULL)
+    gst_buffer_unref (buffer);
+
+  self->is_eos = FALSE;
+  gst_tensor_sink_wakeup_clear (self);
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+}
+
+/**
+ * @brief Make the wakeup fd readable. Caller should hold the lock.
+ */
+static void
+gst_tensor_sink_wakeup_set (GstTensorSink * self)
+{
+#ifdef G_OS_UNIX
+  const guint8 c = 1;
+
+  if (self->wakeup_fd[1] >= 0 && !self->wakeup_signaled) {
+    if (write (self->wakeup_fd[1], &c, 1) == 1)
+      self->wakeup_signaled = TRUE;
+  }
+#endif
+}
+
+/**
+ * @brief Drain the wakeup fd. Caller should hold the lock.
+ */
+static void
+gst_tensor_sink_wakeup_clear (GstTensorSink * self)
+{
+#ifdef G_OS_UNIX
+  guint8 c;
+
+  if (self->wakeup_fd[0] >= 0 && self->wakeup_signaled) {
+    if (read (self->wakeup_fd[0], &c, 1) == 1)
+      self->wakeup_signaled = FALSE;
+  }
+#endif
+}
+
+/**
+ * @brief Get the buffer from the queue for pull mode, wait until a buffer is available or eos.
+ *
+ * Action signal implementation.
+ */
+static GstBuffer *
+gst_tensor_sink_pull_buffer (GstTensorSink * self)
+{
+  return gst_tensor_sink_try_pull_buffer (self, GST_CLOCK_TIME_NONE);
+}
+
+/**
+ * @brief Get the buffer from the queue for pull mode, wait until given timeout.
+ *
+ * Action signal implementation.
+ * @param self pointer to GstTensorSink
+ * @param timeout max time to wait (in nanoseconds), GST_CLOCK_TIME_NONE to wait until a buffer is available or eos
+ * @return The buffer (caller should unref it), or NULL if timed out, eos reached, or the element is stopped.
+ */
+static GstBuffer *
+gst_tensor_sink_try_pull_buffer (GstTensorSink * self, GstClockTime timeout)
+{
+  GstBuffer *buffer;
+  gint64 end_time = 0;
+
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), NULL);
+
+  if (GST_CLOCK_TIME_IS_VALID (timeout))
+    end_time = g_get_monotonic_time () + GST_TIME_AS_USECONDS (timeout);
+
+  g_mutex_lock (&self->mutex);
+
+  while (g_queue_is_empty (&self->queue) && !self->flushing && !self->is_eos) {
+    if (!GST_CLOCK_TIME_IS_VALID (timeout)) {
+      g_cond_wait (&self->cond, &self->mutex);
+    } else if (timeout == 0 ||
+        !g_cond_wait_until (&self->cond, &self->mutex, end_time)) {
+      break;
+    }
+  }
+
+  buffer = (GstBuffer *) g_queue_pop_head (&self->queue);
+  if (buffer) {
+    /** notify the streaming thread waiting for the space in the queue */
+    g_cond_broadcast (&self->cond);
+  }
+
+  if (g_queue_is_empty (&self->queue) && !self->is_eos)
+    gst_tensor_sink_wakeup_clear (self);
+
+  g_mutex_unlock (&self->mutex);
+
+  return buffer;
 }
 
 /**
@@ -642,3 +1150,134 @@ gst_tensor_sink_get_silent (GstTensorSink * self)
 
   return self->silent;
 }
+
+/**
+ * @brief Setter for value max_buffers.
+ */
+static void
+gst_tensor_sink_set_max_buffers (GstTensorSink * self, guint max)
+{
+  g_return_if_fail (GST_IS_TENSOR_SINK (self));
+
+  GST_INFO_OBJECT (self, "set max_buffers to %u", max);
+  g_mutex_lock (&self->mutex);
+  self->max_buffers = max;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+}
+
+/**
+ * @brief Getter for value max_buffers.
+ */
+static guint
+gst_tensor_sink_get_max_buffers (GstTensorSink * self)
+{
+  guint max;
+
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), 0);
+
+  g_mutex_lock (&self->mutex);
+  max = self->max_buffers;
+  g_mutex_unlock (&self->mutex);
+
+  return max;
+}
+
+/**
+ * @brief Setter for flag drop.
+ */
+static void
+gst_tensor_sink_set_drop (GstTensorSink * self, gboolean drop)
+{
+  g_return_if_fail (GST_IS_TENSOR_SINK (self));
+
+  GST_INFO_OBJECT (self, "set drop to %d", drop);
+  g_mutex_lock (&self->mutex);
+  self->drop = drop;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+}
+
+/**
+ * @brief Getter for flag drop.
+ */
+static gboolean
+gst_tensor_sink_get_drop (GstTensorSink * self)
+{
+  gboolean res;
+
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), FALSE);
+
+  g_mutex_lock (&self->mutex);
+  res = self->drop;
+  g_mutex_unlock (&self->mutex);
+
+  return res;
+}
+
+/**
+ * @brief Setter for value batch_size.
+ */
+static void
+gst_tensor_sink_set_batch_size (GstTensorSink * self, guint size)
+{
+  g_return_if_fail (GST_IS_TENSOR_SINK (self));
+
+  GST_INFO_OBJECT (self, "set batch_size to %u", size);
+  g_mutex_lock (&self->mutex);
+  self->batch_size = size;
+  g_mutex_unlock (&self->mutex);
+}
+
+/**
+ * @brief Getter for value batch_size.
+ */
+static guint
+gst_tensor_sink_get_batch_size (GstTensorSink * self)
+{
+  guint size;
+
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), DEFAULT_BATCH_SIZE);
+
+  g_mutex_lock (&self->mutex);
+  size = self->batch_size;
+  g_mutex_unlock (&self->mutex);
+
+  return size;
+}
+
+/**
+ * @brief Getter for wakeup fd. The pipe is created when an application gets this at first.
+ */
+static gint
+gst_tensor_sink_get_wakeup_fd (GstTensorSink * self)
+{
+  gint fd = -1;
+
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), -1);
+
+#ifdef G_OS_UNIX
+  g_mutex_lock (&self->mutex);
+  if (self->wakeup_fd[0] < 0) {
+    GError *err = NULL;
+
+    if (g_unix_open_pipe (self->wakeup_fd, FD_CLOEXEC, &err)) {
+      g_unix_set_fd_nonblocking (self->wakeup_fd[0], TRUE, NULL);
+      g_unix_set_fd_nonblocking (self->wakeup_fd[1], TRUE, NULL);
+
+      /** buffers may be queued before creating the pipe */
+      if (!g_queue_is_empty (&self->queue) || self->is_eos)
+        gst_tensor_sink_wakeup_set (self);
+    } else {
+      GST_ERROR_OBJECT (self, "Failed to create wakeup pipe: %s",
+          err ? err->message : "unknown error");
+      g_clear_error (&err);
+      self->wakeup_fd[0] = self->wakeup_fd[1] = -1;
+    }
+  }
+  fd = self->wakeup_fd[0];
+  g_mutex_unlock (&self->mutex);
+#endif
+
+  return fd;
+}
@@ -61,6 +61,19 @@ struct _GstTensorSink
   gboolean emit_signal; /**< true to emit signal for new data, eos */
   guint signal_rate; /**< new data signals per second */
   GstClockTime last_render_time; /**< buffer rendered time */
+
+  GCond cond; /**< condition for pull mode (buffer queued, space available, or flushing) */
+  GQueue queue; /**< bounded queue of buffers for pull mode */
+  guint max_buffers; /**< max number of queued buffers (0 to disable pull mode) */
+  gboolean drop; /**< true to drop the oldest buffer when the queue is full, false to block */
+  gboolean flushing; /**< true if the element is flushing or not started */
+  gboolean is_eos; /**< true if eos reached */
+
+  guint batch_size; /**< number of buffers delivered with one new-data-batch signal */
+  GstBufferList *batch; /**< buffers pending for new-data-batch signal */
+
+  gint wakeup_fd[2]; /**< pipe to notify the application of queued buffers or eos */
+  gboolean wakeup_signaled; /**< true if the read end of wakeup pipe is readable */
 };
 
 /**
@@ -76,6 +89,11 @@ struct _GstTensorSinkClass
   void (*new_data) (GstElement * element, GstBuffer * buffer); /**< signal when new data received */
   void (*stream_start) (GstElement * element); /**< signal when stream started */
   void (*eos) (GstElement * element); /**< signal when end of stream reached */
+  void (*new_data_batch) (GstElement * element, GstBufferList * list); /**< signal when the number of batch-size buffers received */
+
+  /** actions */
+  GstBuffer * (*pull_buffer) (GstTensorSink * sink); /**< get a buffer from the queue, wait until a buffer is available or eos */
+  GstBuffer * (*try_pull_buffer) (GstTensorSink * sink, GstClockTime timeout); /**< get a buffer from the queue, wait until given timeout */
 };
 
 /**
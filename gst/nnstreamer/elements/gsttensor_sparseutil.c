@@ -13,10 +13,105 @@
  */
 
 #include <string.h>
+#include <hw_accel.h>
 #include <tensor_common.h>
 #include <tensor_data.h>
 #include "gsttensor_sparseutil.h"
 
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define SPARSE_KERNEL_AVX2 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define SPARSE_KERNEL_NEON 1
+#endif
+
+/**
+ * @brief The size of block to find zero bytes in dense tensor. The element sizes divide it, so that a block has whole elements.
+ */
+#define SPARSE_ZERO_BLOCK (32)
+
+/**
+ * @brief Count the leading bytes of blocks, which are all zero (generic).
+ * @return The size of zero blocks, multiple of SPARSE_ZERO_BLOCK.
+ */
+static gsize
+_sparse_skip_zero_blocks_generic (const guint8 * data, gsize size)
+{
+  gsize offset = 0;
+  guint64 w[SPARSE_ZERO_BLOCK / sizeof (guint64)];
+
+  while (offset + SPARSE_ZERO_BLOCK <= size) {
+    memcpy (w, data + offset, SPARSE_ZERO_BLOCK);
+    if ((w[0] | w[1] | w[2] | w[3]) != 0)
+      break;
+    offset += SPARSE_ZERO_BLOCK;
+  }
+
+  return offset;
+}
+
+#if defined(SPARSE_KERNEL_AVX2)
+/**
+ * @brief Count the leading bytes of blocks, which are all zero (AVX2).
+ */
+__attribute__ ((target ("avx2")))
+static gsize
+_sparse_skip_zero_blocks_avx2 (const guint8 * data, gsize size)
+{
+  gsize offset = 0;
+
+  while (offset + SPARSE_ZERO_BLOCK <= size) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) (data + offset));
+
+    if (!_mm256_testz_si256 (v, v))
+      break;
+    offset += SPARSE_ZERO_BLOCK;
+  }
+
+  return offset;
+}
+#endif /* SPARSE_KERNEL_AVX2 */
+
+#if defined(SPARSE_KERNEL_NEON)
+/**
+ * @brief Count the leading bytes of blocks, which are all zero (NEON).
+ */
+static gsize
+_sparse_skip_zero_blocks_neon (const guint8 * data, gsize size)
+{
+  gsize offset = 0;
+
+  while (offset + SPARSE_ZERO_BLOCK <= size) {
+    uint8x16_t v = vorrq_u8 (vld1q_u8 (data + offset),
+        vld1q_u8 (data + offset + 16));
+
+    if (vmaxvq_u8 (v) != 0)
+      break;
+    offset += SPARSE_ZERO_BLOCK;
+  }
+
+  return offset;
+}
+#endif /* SPARSE_KERNEL_NEON */
+
+/**
+ * @brief The implementations to find zero blocks, selected with the CPU features at runtime.
+ */
+static const cpu_kernel_variant sparse_skip_zero_blocks_variants[] = {
+#if defined(SPARSE_KERNEL_AVX2)
+  {CPU_FEATURE_AVX2, (gpointer) _sparse_skip_zero_blocks_avx2},
+#endif
+#if defined(SPARSE_KERNEL_NEON)
+  {CPU_FEATURE_NEON, (gpointer) _sparse_skip_zero_blocks_neon},
+#endif
+  {CPU_FEATURE_NONE, (gpointer) _sparse_skip_zero_blocks_generic},
+};
+
+CPU_KERNEL_DEFINE (gsize, sparse_skip_zero_blocks,
+    (const guint8 * data, gsize size), (data, size),
+    sparse_skip_zero_blocks_variants);
+
 /**
  * @brief Make dense tensor with input sparse tensor.
  * @param[in,out] meta tensor meta structure to be updated
@@ -147,6 +242,14 @@ gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem)
 
   /** Consider using macro to reduce loc and readability */
   for (i = 0; i < element_count; ++i) {
+    /* skip the blocks of zero elements at the beginning of each block */
+    if ((i * element_size) % SPARSE_ZERO_BLOCK == 0) {
+      i += sparse_skip_zero_blocks (map.data + i * element_size,
+          (element_count - i) * element_size) / element_size;
+      if (i >= element_count)
+        break;
+    }
+
     switch (data_type) {
       case _NNS_INT32:
         if (((int32_t *) map.data)[i] != 0) {
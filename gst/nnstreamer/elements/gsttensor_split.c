@@ -417,34 +417,25 @@ gst_tensor_split_get_splited (GstTensorSplit * split, GstBuffer * buffer,
   GstMemory *mem;
   tensor_dim *dim;
   int i;
-  gsize size, offset;
-  GstMapInfo src_info, dest_info;
+  gsize size, offset, esize;
 
+  esize = gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
   dim = g_array_index (split->tensorseg, tensor_dim *, nth);
-  size = gst_tensor_get_element_count (*dim) *
-      gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
-
-  mem = gst_allocator_alloc (NULL, size, NULL);
-  if (!gst_memory_map (mem, &dest_info, GST_MAP_WRITE)) {
-    ml_logf ("Cannot map memory for destination buffer.\n");
-    return NULL;
-  }
-  if (!gst_buffer_map (buffer, &src_info, GST_MAP_READ)) {
-    ml_logf ("Cannot map src-memory to gst buffer at tensor-split.\n");
-    gst_memory_unmap (mem, &dest_info);
-    return NULL;
-  }
+  size = gst_tensor_get_element_count (*dim) * esize;
 
   offset = 0;
   for (i = 0; i < nth; i++) {
     dim = g_array_index (split->tensorseg, tensor_dim *, i);
-    offset += gst_tensor_get_element_count (*dim) *
-        gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
+    offset += gst_tensor_get_element_count (*dim) * esize;
   }
 
-  nns_memcpy (dest_info.data, src_info.data + offset, size);
-  gst_buffer_unmap (buffer, &src_info);
-  gst_memory_unmap (mem, &dest_info);
+  /**
+   * Each segment is a contiguous byte range of incoming tensor.
+   * Share the memory block without copy if the segment is in a single memory.
+   */
+  mem = gst_tensor_buffer_get_range (buffer, offset, size);
+  if (!mem)
+    ml_loge ("Cannot get the %dth segment from incoming buffer.\n", nth);
 
   return mem;
 }
@@ -494,6 +485,11 @@ gst_tensor_split_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
     outbuf = gst_buffer_new ();
     mem = gst_tensor_split_get_splited (split, buf, i);
+    if (!mem) {
+      gst_buffer_unref (outbuf);
+      res = GST_FLOW_ERROR;
+      break;
+    }
     gst_buffer_append_memory (outbuf, mem);
     ts = GST_BUFFER_TIMESTAMP (buf);
 
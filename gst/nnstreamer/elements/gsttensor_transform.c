@@ -78,6 +78,9 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_transform_debug);
     "(((add|mul|div)(:([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?))+(@[0-9]+)?)(,|))+$"
 
 #define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|float(16|32|64)))"
+#define REGEX_QUANT_OPTION "^(quantize:u?int8|dequantize:float(32|64)|requantize:u?int8)"\
+    "(,(scale|out-scale)(:[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?)+|,(zero-point|out-zero-point)(:[-+]?[0-9]+)+)+"\
+    "(,per-channel:(false|true@[0-3]))?$"
 
 /**
  * @brief The transpose rank is fixed to 4.
@@ -114,6 +117,13 @@ static const gchar *gst_tensor_transform_stand_string[] = {
   [STAND_END] = NULL
 };
 
+static const gchar *gst_tensor_transform_quant_string[] = {
+  [QUANT_QUANTIZE] = "quantize",
+  [QUANT_DEQUANTIZE] = "dequantize",
+  [QUANT_REQUANTIZE] = "requantize",
+  [QUANT_END] = NULL
+};
+
 static const gchar *gst_tensor_transform_operator_string[] = {
   [GTT_OP_TYPECAST] = "typecast",
   [GTT_OP_ADD] = "add",
@@ -196,6 +206,11 @@ gst_tensor_transform_mode_get_type (void)
       {GTT_CLAMP, "Mode for clamping all elements of tensor into the range, "
             "option=CLAMP_MIN:CLAMP_MAX",
           "clamp"},
+      {GTT_QUANT, "Mode for affine quantization of tensor, "
+            "option=(quantize:(u)int8|dequantize:float(32|64)|requantize:(u)int8),"
+            "scale:SCALE[:SCALE...],zero-point:ZP[:ZP...]"
+            "[,out-scale:SCALE,out-zero-point:ZP][,per-channel:(false|true@DIM)]",
+          "quant"},
       {GTT_UNKNOWN, "Unknown or not-implemented-yet mode",
           "unknown"},
       {0, NULL, NULL},
@@ -293,6 +308,7 @@ gst_tensor_transform_init (GstTensorTransform * filter)
   filter->option = NULL;
   filter->loaded = FALSE;
   filter->operators = NULL;
+  filter->quant_params = NULL;
   filter->acceleration = DEFAULT_ACCELERATION;
   filter->apply = NULL;
 
@@ -330,6 +346,161 @@ gst_tensor_transform_get_stand_mode (const gchar * str)
   return (index < 0) ? STAND_END : index;
 }
 
+/**
+ * @brief Get the corresponding quantization operation from the string value
+ * @param[in] str The string value for the operation
+ * @return corresponding operation for the string. QUANT_END for errors
+ */
+static tensor_transform_quant_op
+gst_tensor_transform_get_quant_op (const gchar * str)
+{
+  int index;
+
+  index = find_key_strv (gst_tensor_transform_quant_string, str);
+
+  return (index < 0) ? QUANT_END : index;
+}
+
+/**
+ * @brief Represent a real multiplier as a fixed-point Q31 multiplier and an exponent.
+ *        : real_multiplier = multiplier * 2^(shift - 31)
+ * @param[in] real_multiplier The real value to be represented
+ * @param[out] multiplier Q31 fixed-point multiplier
+ * @param[out] shift Exponent of the multiplier
+ */
+static void
+gst_tensor_transform_quantize_multiplier (double real_multiplier,
+    int32_t * multiplier, int *shift)
+{
+  double q;
+  int64_t q_fixed;
+
+  if (real_multiplier == 0.0) {
+    *multiplier = 0;
+    *shift = 0;
+    return;
+  }
+
+  q = frexp (real_multiplier, shift);
+  q_fixed = (int64_t) round (q * (double) (1LL << 31));
+
+  if (q_fixed == (1LL << 31)) {
+    q_fixed /= 2;
+    (*shift)++;
+  }
+
+  /* too small multiplier, flush to zero */
+  if (*shift < -31) {
+    *shift = 0;
+    q_fixed = 0;
+  }
+
+  *multiplier = (int32_t) q_fixed;
+}
+
+/**
+ * @brief Fields of the quantization parameters in the option string.
+ */
+typedef enum
+{
+  QUANT_FIELD_SCALE = 0,
+  QUANT_FIELD_ZERO_POINT,
+  QUANT_FIELD_OUT_SCALE,
+  QUANT_FIELD_OUT_ZERO_POINT,
+
+  QUANT_FIELD_END,
+} tensor_transform_quant_field;
+
+static const gchar *gst_tensor_transform_quant_field_string[] = {
+  [QUANT_FIELD_SCALE] = "scale",
+  [QUANT_FIELD_ZERO_POINT] = "zero-point",
+  [QUANT_FIELD_OUT_SCALE] = "out-scale",
+  [QUANT_FIELD_OUT_ZERO_POINT] = "out-zero-point",
+  [QUANT_FIELD_END] = NULL,
+};
+
+/**
+ * @brief Check the input type of the quantization operation.
+ * @param[in] op The quantization operation
+ * @param[in] type The input tensor type
+ * @return TRUE if the operation supports the input type
+ */
+static gboolean
+gst_tensor_transform_quant_check_type (tensor_transform_quant_op op,
+    tensor_type type)
+{
+  switch (op) {
+    case QUANT_QUANTIZE:
+      return (type == _NNS_FLOAT32 || type == _NNS_FLOAT64);
+    case QUANT_DEQUANTIZE:
+    case QUANT_REQUANTIZE:
+      return (type == _NNS_UINT8 || type == _NNS_INT8);
+    default:
+      break;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Parse the list of quantization parameters separated with ':'.
+ * @param[in/out] params Array of quantization parameters (one for each channel)
+ * @param[in] values Parameter strings (null-terminated), a value for each parameter or a value for all
+ * @param[in] field The field of the parameter
+ * @return TRUE if all values are valid numbers
+ */
+static gboolean
+gst_tensor_transform_parse_quant_params (GArray * params, gchar ** values,
+    tensor_transform_quant_field field)
+{
+  guint i, num;
+
+  num = g_strv_length (values);
+  if (num != 1 && num != params->len)
+    return FALSE;
+
+  for (i = 0; i < params->len; i++) {
+    tensor_transform_quant_param *param;
+    const gchar *str = values[(num == 1) ? 0 : i];
+    gchar *endptr = NULL;
+    gdouble dval = 0.0;
+    gint64 ival = 0;
+
+    param = &g_array_index (params, tensor_transform_quant_param, i);
+
+    if (field == QUANT_FIELD_SCALE || field == QUANT_FIELD_OUT_SCALE)
+      dval = g_ascii_strtod (str, &endptr);
+    else
+      ival = g_ascii_strtoll (str, &endptr, 10);
+
+    if (endptr == str || *endptr != '\0')
+      return FALSE;
+
+    switch (field) {
+      case QUANT_FIELD_SCALE:
+        param->scale = dval;
+        break;
+      case QUANT_FIELD_OUT_SCALE:
+        param->out_scale = dval;
+        break;
+      case QUANT_FIELD_ZERO_POINT:
+      case QUANT_FIELD_OUT_ZERO_POINT:
+        if (ival < G_MININT32 || ival > G_MAXINT32)
+          return FALSE;
+
+        if (field == QUANT_FIELD_ZERO_POINT)
+          param->zero_point = (int32_t) ival;
+        else
+          param->out_zero_point = (int32_t) ival;
+        break;
+      default:
+        return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
 #ifndef FLOAT16_SUPPORT
 /**
  * @brief Generate error if float16 is required.
@@ -934,6 +1105,142 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
       ret = filter->loaded = TRUE;
       break;
     }
+    case GTT_QUANT:
+    {
+      gchar **options = NULL;
+      gchar **fields[QUANT_FIELD_END] = { NULL, };
+      guint i, num_options, num_params;
+      gint f;
+
+      if (!g_regex_match_simple (REGEX_QUANT_OPTION, filter->option,
+              G_REGEX_CASELESS, 0)) {
+        ml_loge
+            ("%s: quant: \'%s\' is not a valid option string: it should be in the form of (quantize:(u)int8|dequantize:float(32|64)|requantize:(u)int8),scale:SCALE[:SCALE...],zero-point:ZP[:ZP...][,out-scale:SCALE,out-zero-point:ZP][,per-channel:(false|true@DIM)]\n",
+            filter_name, filter->option);
+        break;
+      }
+
+      filter->data_quant.per_channel = FALSE;
+      filter->data_quant.ch_dim = 0;
+
+      if (filter->quant_params)
+        g_array_free (filter->quant_params, TRUE);
+      filter->quant_params = g_array_new (FALSE, TRUE,
+          sizeof (tensor_transform_quant_param));
+
+      options = g_strsplit (filter->option, ",", -1);
+      num_options = g_strv_length (options);
+
+      /* the number of parameters is the longest list, the other lists should have the same length or one value for all */
+      num_params = 1;
+
+      for (i = 0; i < num_options; i++) {
+        gchar **strv = g_strsplit (options[i], ":", -1);
+
+        if (i == 0) {
+          filter->data_quant.op = gst_tensor_transform_get_quant_op (strv[0]);
+          filter->data_quant.out_type = gst_tensor_get_type (strv[1]);
+        } else if (g_ascii_strcasecmp (strv[0], "per-channel") == 0) {
+          gchar **values = g_strsplit (strv[1], "@", -1);
+
+          if (g_strv_length (values) > 1 &&
+              g_ascii_strcasecmp (values[0], "true") == 0) {
+            filter->data_quant.per_channel = TRUE;
+            filter->data_quant.ch_dim = g_ascii_strtoull (values[1], NULL, 10);
+          }
+
+          g_strfreev (values);
+        } else {
+          f = find_key_strv (gst_tensor_transform_quant_field_string, strv[0]);
+          if (f >= 0 && fields[f] == NULL) {
+            fields[f] = strv;
+            num_params = MAX (num_params, g_strv_length (strv) - 1);
+            continue;
+          }
+
+          ml_loge ("%s: quant: \'%s\' is given more than once\n",
+              filter_name, strv[0]);
+          g_strfreev (strv);
+          g_strfreev (options);
+          goto quant_error;
+        }
+
+        g_strfreev (strv);
+      }
+
+      g_strfreev (options);
+
+      g_array_set_size (filter->quant_params, num_params);
+      for (i = 0; i < num_params; i++) {
+        tensor_transform_quant_param p = { 1.0, 0, 1.0, 0, 0, 0 };
+        g_array_index (filter->quant_params, tensor_transform_quant_param,
+            i) = p;
+      }
+
+      for (f = 0; f < QUANT_FIELD_END; f++) {
+        if (fields[f] && !gst_tensor_transform_parse_quant_params
+            (filter->quant_params, &fields[f][1], f)) {
+          ml_loge ("%s: quant: %s should be %u number(s) or a number for all channels\n",
+              filter_name, gst_tensor_transform_quant_field_string[f],
+              num_params);
+          goto quant_error;
+        }
+      }
+
+      for (i = 0; i < filter->quant_params->len; i++) {
+        tensor_transform_quant_param *param;
+
+        param = &g_array_index (filter->quant_params,
+            tensor_transform_quant_param, i);
+
+        if (param->scale <= 0.0 || param->out_scale <= 0.0) {
+          ml_loge ("%s: quant: the scale should be a positive number\n",
+              filter_name);
+          goto quant_error;
+        }
+
+        gst_tensor_transform_quantize_multiplier (param->scale /
+            param->out_scale, &param->multiplier, &param->shift);
+      }
+
+      if (filter->quant_params->len > 1 && !filter->data_quant.per_channel) {
+        ml_loge ("%s: quant: multiple parameters are given without per-channel option\n",
+            filter_name);
+        goto quant_error;
+      }
+
+      /* the option may be updated after the caps are negotiated */
+      for (i = 0; i < filter->in_config.info.num_tensors; i++) {
+        tensor_type type = filter->in_config.info.info[i].type;
+
+        if (filter->apply && !g_list_find (filter->apply, GINT_TO_POINTER (i)))
+          continue;
+
+        if (type != _NNS_END &&
+            !gst_tensor_transform_quant_check_type (filter->data_quant.op,
+                type)) {
+          ml_loge ("%s: quant: %s does not support the input type %s\n",
+              filter_name,
+              gst_tensor_transform_quant_string[filter->data_quant.op],
+              gst_tensor_get_type_string (type));
+          goto quant_error;
+        }
+      }
+
+      for (f = 0; f < QUANT_FIELD_END; f++)
+        g_strfreev (fields[f]);
+
+      ret = filter->loaded = TRUE;
+      break;
+
+    quant_error:
+      for (f = 0; f < QUANT_FIELD_END; f++)
+        g_strfreev (fields[f]);
+
+      g_array_free (filter->quant_params, TRUE);
+      filter->quant_params = NULL;
+      break;
+    }
     default:
       GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
       ret = FALSE;
@@ -1086,6 +1393,11 @@ gst_tensor_transform_finalize (GObject * object)
     filter->operators = NULL;
   }
 
+  if (filter->quant_params) {
+    g_array_free (filter->quant_params, TRUE);
+    filter->quant_params = NULL;
+  }
+
   if (filter->apply) {
     g_list_free (filter->apply);
     filter->apply = NULL;
@@ -1612,6 +1924,234 @@ gst_tensor_transform_clamp (GstTensorTransform * filter,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Saturating rounding doubling high multiplication of Q31 values.
+ */
+static inline int32_t
+_quant_srdhm (int32_t a, int32_t b)
+{
+  int64_t ab;
+  int32_t nudge;
+
+  if (a == b && a == G_MININT32)
+    return G_MAXINT32;
+
+  ab = (int64_t) a * (int64_t) b;
+  nudge = (ab >= 0) ? (1 << 30) : (1 - (1 << 30));
+
+  return (int32_t) ((ab + nudge) / (1LL << 31));
+}
+
+/**
+ * @brief Rounding division by a power of two.
+ */
+static inline int32_t
+_quant_rdbpot (int32_t x, int exponent)
+{
+  const int32_t mask = (int32_t) ((1LL << exponent) - 1);
+  const int32_t remainder = x & mask;
+  const int32_t threshold = (mask >> 1) + ((x < 0) ? 1 : 0);
+
+  return (x >> exponent) + ((remainder > threshold) ? 1 : 0);
+}
+
+/**
+ * @brief Multiply an integer by the fixed-point multiplier.
+ */
+static inline int32_t
+_quant_multiply (int32_t x, int32_t multiplier, int shift)
+{
+  int64_t shifted;
+
+  if (shift > 0) {
+    shifted = (int64_t) x * (1LL << shift);
+    x = (int32_t) CLAMP (shifted, G_MININT32, G_MAXINT32);
+    shift = 0;
+  }
+
+  return _quant_rdbpot (_quant_srdhm (x, multiplier), -shift);
+}
+
+/**
+ * @brief Macro to quantize n elements of real values.
+ */
+#define _quant_quantize(itype,otype,i,o,n,p) do { \
+    const itype *_in = (const itype *) (i); \
+    otype *_out = (otype *) (o); \
+    const double _inv = 1.0 / (p)->scale; \
+    const double _zp = (double) (p)->zero_point; \
+    gsize _k; \
+    for (_k = 0; _k < (n); _k++) { \
+      double _v = round ((double) _in[_k] * _inv) + _zp; \
+      _out[_k] = (otype) CLAMP (_v, (double) otype##_MIN, (double) otype##_MAX); \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to dequantize n elements of quantized values.
+ */
+#define _quant_dequantize(itype,otype,i,o,n,p) do { \
+    const itype *_in = (const itype *) (i); \
+    otype *_out = (otype *) (o); \
+    const otype _scale = (otype) (p)->scale; \
+    const int32_t _zp = (p)->zero_point; \
+    gsize _k; \
+    for (_k = 0; _k < (n); _k++) \
+      _out[_k] = (otype) ((int32_t) _in[_k] - _zp) * _scale; \
+  } while (0)
+
+/**
+ * @brief Macro to requantize n elements of quantized values with fixed-point arithmetic.
+ */
+#define _quant_requantize(itype,otype,i,o,n,p) do { \
+    const itype *_in = (const itype *) (i); \
+    otype *_out = (otype *) (o); \
+    const int32_t _zp = (p)->zero_point; \
+    const int32_t _out_zp = (p)->out_zero_point; \
+    gsize _k; \
+    for (_k = 0; _k < (n); _k++) { \
+      int32_t _v = _quant_multiply ((int32_t) _in[_k] - _zp, \
+          (p)->multiplier, (p)->shift) + _out_zp; \
+      _out[_k] = (otype) CLAMP (_v, otype##_MIN, otype##_MAX); \
+    } \
+  } while (0)
+
+/** Min and max of output types for quant macros */
+#define int8_t_MIN INT8_MIN
+#define int8_t_MAX INT8_MAX
+#define uint8_t_MIN 0
+#define uint8_t_MAX UINT8_MAX
+
+/**
+ * @brief Macro to run quant macro with input and output types.
+ */
+#define _quant_run(func,intype,outtype,i,o,n,p) do { \
+    if ((intype) == _NNS_UINT8 && (outtype) == _NNS_UINT8) \
+      func (uint8_t, uint8_t, i, o, n, p); \
+    else if ((intype) == _NNS_UINT8 && (outtype) == _NNS_INT8) \
+      func (uint8_t, int8_t, i, o, n, p); \
+    else if ((intype) == _NNS_INT8 && (outtype) == _NNS_UINT8) \
+      func (int8_t, uint8_t, i, o, n, p); \
+    else \
+      func (int8_t, int8_t, i, o, n, p); \
+  } while (0)
+
+/**
+ * @brief Apply quantization operation to the contiguous elements with the same parameter.
+ */
+static void
+gst_tensor_transform_quant_block (tensor_transform_quant_op op,
+    tensor_type in_type, tensor_type out_type, const uint8_t * inptr,
+    uint8_t * outptr, gsize num, const tensor_transform_quant_param * param)
+{
+  switch (op) {
+    case QUANT_QUANTIZE:
+      if (in_type == _NNS_FLOAT32) {
+        if (out_type == _NNS_UINT8)
+          _quant_quantize (float, uint8_t, inptr, outptr, num, param);
+        else
+          _quant_quantize (float, int8_t, inptr, outptr, num, param);
+      } else {
+        if (out_type == _NNS_UINT8)
+          _quant_quantize (double, uint8_t, inptr, outptr, num, param);
+        else
+          _quant_quantize (double, int8_t, inptr, outptr, num, param);
+      }
+      break;
+    case QUANT_DEQUANTIZE:
+      if (in_type == _NNS_UINT8) {
+        if (out_type == _NNS_FLOAT32)
+          _quant_dequantize (uint8_t, float, inptr, outptr, num, param);
+        else
+          _quant_dequantize (uint8_t, double, inptr, outptr, num, param);
+      } else {
+        if (out_type == _NNS_FLOAT32)
+          _quant_dequantize (int8_t, float, inptr, outptr, num, param);
+        else
+          _quant_dequantize (int8_t, double, inptr, outptr, num, param);
+      }
+      break;
+    case QUANT_REQUANTIZE:
+      _quant_run (_quant_requantize, in_type, out_type, inptr, outptr, num,
+          param);
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "quant" case.
+ *        : quantize   q = clamp (round (r / scale) + zero_point)
+ *        : dequantize r = scale * (q - zero_point)
+ *        : requantize q' = clamp ((q - zero_point) * scale / out_scale + out_zero_point)
+ * @note Requantization is done with fixed-point arithmetic without float conversion.
+ * @todo Make this use SIMD. The kernels are scalar loops for now.
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_quant (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  tensor_transform_quant_param *params;
+  gsize in_element_size, out_element_size;
+  gsize num, inner, outer, ch_size;
+  guint num_params, d, ch;
+  gsize o;
+
+  if (!gst_tensor_transform_quant_check_type (filter->data_quant.op,
+          in_info->type)) {
+    ml_loge ("quant: %s does not support the input type %s\n",
+        gst_tensor_transform_quant_string[filter->data_quant.op],
+        gst_tensor_get_type_string (in_info->type));
+    return GST_FLOW_NOT_SUPPORTED;
+  }
+
+  params = (tensor_transform_quant_param *) filter->quant_params->data;
+  num_params = filter->quant_params->len;
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+  if (!filter->data_quant.per_channel || num_params <= 1) {
+    gst_tensor_transform_quant_block (filter->data_quant.op, in_info->type,
+        out_info->type, inptr, outptr, num, &params[0]);
+    return GST_FLOW_OK;
+  }
+
+  /* per-channel, apply the parameter to the contiguous block of each channel */
+  ch_size = in_info->dimension[filter->data_quant.ch_dim];
+  if (ch_size != num_params) {
+    ml_loge ("quant: the number of parameters (%u) is different from the channel size (%" G_GSIZE_FORMAT ")\n",
+        num_params, ch_size);
+    return GST_FLOW_ERROR;
+  }
+
+  inner = 1;
+  for (d = 0; d < filter->data_quant.ch_dim; d++)
+    inner *= in_info->dimension[d];
+  outer = num / (inner * ch_size);
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  for (o = 0; o < outer; o++) {
+    for (ch = 0; ch < ch_size; ch++) {
+      gst_tensor_transform_quant_block (filter->data_quant.op, in_info->type,
+          out_info->type, inptr, outptr, inner, &params[ch]);
+
+      inptr += inner * in_element_size;
+      outptr += inner * out_element_size;
+    }
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief non-ip transform. required vmethod for BaseTransform class.
  * @param[in/out] trans "super" pointer
@@ -1750,6 +2290,10 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
         res = gst_tensor_transform_clamp (filter, in_info, out_info,
             inptr, outptr);
         break;
+      case GTT_QUANT:
+        res = gst_tensor_transform_quant (filter, in_info, out_info,
+            inptr, outptr);
+        break;
       default:
         ml_loge ("Not supported tensor transform mode");
         res = GST_FLOW_NOT_SUPPORTED;
@@ -1906,6 +2450,25 @@ gst_tensor_transform_convert_dimension (GstTensorTransform * filter,
       /* same tensors info, do nothing. */
       break;
 
+    case GTT_QUANT:
+      /** For both directions, dimension does not change */
+      if (direction == GST_PAD_SINK) {
+        if (in_info->type != _NNS_END &&
+            !gst_tensor_transform_quant_check_type (filter->data_quant.op,
+                in_info->type)) {
+          GST_WARNING_OBJECT (filter, "quant: %s does not support the input type %s",
+              gst_tensor_transform_quant_string[filter->data_quant.op],
+              gst_tensor_get_type_string (in_info->type));
+          return FALSE;
+        }
+
+        out_info->type = filter->data_quant.out_type;
+      } else {
+        /* cannot get the incoming data type on sink pad */
+        out_info->type = _NNS_END;
+      }
+      break;
+
     default:
       return FALSE;
   }
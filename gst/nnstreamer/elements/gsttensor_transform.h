@@ -62,6 +62,7 @@ typedef enum _tensor_transform_mode
   GTT_TRANSPOSE,      /* Transpose. "transpose" */
   GTT_STAND,          /* Standardization. "stand" */
   GTT_CLAMP,          /* Clamp, "clamp" */
+  GTT_QUANT,          /* Affine quantization, "quant" */
 
   GTT_UNKNOWN = -1,   /* Unknown/Not-implemented-yet Mode. "unknown" */
 } tensor_transform_mode;
@@ -76,6 +77,14 @@ typedef enum
   GTT_OP_UNKNOWN
 } tensor_transform_operator;
 
+typedef enum
+{
+  QUANT_QUANTIZE = 0,
+  QUANT_DEQUANTIZE = 1,
+  QUANT_REQUANTIZE = 2,
+  QUANT_END,
+} tensor_transform_quant_op;
+
 typedef enum
 {
   STAND_DEFAULT = 0,
@@ -140,6 +149,30 @@ typedef struct _tensor_transform_clamp {
   double min, max;
 } tensor_transform_clamp;
 
+/**
+ * @brief Internal data structure for quant mode.
+ */
+typedef struct _tensor_transform_quant {
+  tensor_transform_quant_op op;
+  tensor_type out_type;
+  gboolean per_channel;
+  guint ch_dim;
+} tensor_transform_quant;
+
+/**
+ * @brief Quantization parameters of a tensor (or a channel) for quant mode.
+ * real_value = scale * (quantized_value - zero_point)
+ */
+typedef struct
+{
+  double scale;
+  int32_t zero_point;
+  double out_scale; /**< output scale for requantize */
+  int32_t out_zero_point; /**< output zero point for requantize */
+  int32_t multiplier; /**< fixed-point multiplier of (scale / out_scale) for requantize */
+  int shift; /**< exponent of fixed-point multiplier for requantize */
+} tensor_transform_quant_param;
+
 /**
  * @brief Internal data structure for tensor_transform instances.
  */
@@ -157,10 +190,12 @@ struct _GstTensorTransform
     tensor_transform_transpose data_transpose; /**< Parsed option value for "transpose" mode. */
     tensor_transform_stand data_stand; /**< Parsed option value for "stand" mode. */
     tensor_transform_clamp data_clamp; /**< Parsed option value for "clamp" mode. */
+    tensor_transform_quant data_quant; /**< Parsed option value for "quant" mode. */
   };
   gboolean loaded; /**< TRUE if mode & option are loaded */
   gboolean acceleration; /**< TRUE to set orc acceleration */
   GSList *operators; /**< operators list */
+  GArray *quant_params; /**< quantization parameters (tensor_transform_quant_param) for quant mode */
 
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
@@ -24,6 +24,12 @@
 #endif /* __TIZEN__ */
 #endif /* __arch64__ || __arm__ */
 
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(__GNUC__)
+#include <cpuid.h>
+#endif
+#endif /* __x86_64__ || __i386__ */
+
 #if !defined(__APPLE__)
 #include <sys/auxv.h>
 #else
@@ -62,3 +68,404 @@ cpu_neon_accel_available (void)
 
   return neon_available;
 }
+
+#if defined(__aarch64__)
+/* hwcap bits may not be defined in old kernel headers */
+#ifndef HWCAP_ASIMDHP
+#define HWCAP_ASIMDHP (1 << 10)
+#endif
+#ifndef HWCAP_ASIMDDP
+#define HWCAP_ASIMDDP (1 << 20)
+#endif
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+#endif /* __aarch64__ */
+
+/**
+ * @brief Names of the CPU features.
+ */
+static const struct
+{
+  cpu_feature feature;
+  const gchar *name;
+} cpu_feature_names[] = {
+  {CPU_FEATURE_NEON, "neon"},
+  {CPU_FEATURE_FP16, "fp16"},
+  {CPU_FEATURE_DOTPROD, "dotprod"},
+  {CPU_FEATURE_SVE, "sve"},
+  {CPU_FEATURE_SSE4_2, "sse4.2"},
+  {CPU_FEATURE_AVX, "avx"},
+  {CPU_FEATURE_AVX2, "avx2"},
+  {CPU_FEATURE_FMA, "fma"},
+  {CPU_FEATURE_F16C, "f16c"},
+  {CPU_FEATURE_AVX512F, "avx512f"},
+  {CPU_FEATURE_AVX512BW, "avx512bw"},
+  {CPU_FEATURE_AVX512_VNNI, "avx512vnni"},
+  {CPU_FEATURE_AVX_VNNI, "avxvnni"},
+};
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+/**
+ * @brief Internal function to read the extended control register, to check the OS support of AVX registers.
+ */
+static guint64
+_xgetbv (guint index)
+{
+  guint eax, edx;
+
+  __asm__ __volatile__ ("xgetbv":"=a" (eax), "=d" (edx):"c" (index));
+  return ((guint64) edx << 32) | eax;
+}
+
+/**
+ * @brief Internal function to detect the features of x86 CPU with cpuid.
+ */
+static guint
+_detect_x86_features (void)
+{
+  guint eax, ebx, ecx, edx;
+  guint max_leaf, features = 0;
+  guint64 xcr0 = 0;
+
+  if (!__get_cpuid (0, &max_leaf, &ebx, &ecx, &edx) || max_leaf < 1)
+    return 0;
+
+  __get_cpuid (1, &eax, &ebx, &ecx, &edx);
+
+  if (ecx & (1U << 20))
+    features |= CPU_FEATURE_SSE4_2;
+
+  /* the OS should save the YMM (and ZMM) registers to use AVX (and AVX-512) */
+  if (ecx & (1U << 27))
+    xcr0 = _xgetbv (0);
+
+  if ((xcr0 & 0x6) != 0x6)
+    return features;
+
+  if (ecx & (1U << 28))
+    features |= CPU_FEATURE_AVX;
+  if (ecx & (1U << 12))
+    features |= CPU_FEATURE_FMA;
+  if (ecx & (1U << 29))
+    features |= CPU_FEATURE_F16C;
+
+  if (max_leaf < 7)
+    return features;
+
+  __cpuid_count (7, 0, eax, ebx, ecx, edx);
+
+  if (ebx & (1U << 5))
+    features |= CPU_FEATURE_AVX2;
+
+  if ((xcr0 & 0xe6) == 0xe6) {
+    if (ebx & (1U << 16))
+      features |= CPU_FEATURE_AVX512F;
+    if (ebx & (1U << 30))
+      features |= CPU_FEATURE_AVX512BW;
+    if (ecx & (1U << 11))
+      features |= CPU_FEATURE_AVX512_VNNI;
+  }
+
+  __cpuid_count (7, 1, eax, ebx, ecx, edx);
+
+  if (eax & (1U << 4))
+    features |= CPU_FEATURE_AVX_VNNI;
+
+  return features;
+}
+#endif /* (__x86_64__ || __i386__) && __GNUC__ */
+
+/**
+ * @brief Internal function to detect the features of CPU.
+ */
+static gpointer
+_detect_cpu_features (gpointer data)
+{
+  guint features = 0;
+  gchar *str;
+#if defined(__aarch64__)
+  gulong hwcap = getauxval (AT_HWCAP);
+#endif
+
+  (void) data;
+
+#if defined(__aarch64__)
+  if (hwcap & HWCAP_ASIMD)
+    features |= CPU_FEATURE_NEON;
+#if !defined(__APPLE__)
+  if (hwcap & HWCAP_ASIMDHP)
+    features |= CPU_FEATURE_FP16;
+  if (hwcap & HWCAP_ASIMDDP)
+    features |= CPU_FEATURE_DOTPROD;
+  if (hwcap & HWCAP_SVE)
+    features |= CPU_FEATURE_SVE;
+#endif /* __APPLE__ */
+#elif defined(__arm__)
+  if (getauxval (AT_HWCAP) & HWCAP_NEON)
+    features |= CPU_FEATURE_NEON;
+#elif (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+  features = _detect_x86_features ();
+#endif
+
+  str = cpu_get_features_string (features);
+  g_debug ("Detected CPU features: %s", str);
+  g_free (str);
+
+  return GUINT_TO_POINTER (features);
+}
+
+/**
+ * @brief Get the SIMD features of the CPU, detected once at runtime.
+ * @return Bitwise OR of cpu_feature
+ */
+guint
+cpu_get_features (void)
+{
+  static GOnce detect_once = G_ONCE_INIT;
+
+  g_once (&detect_once, _detect_cpu_features, NULL);
+  return GPOINTER_TO_UINT (detect_once.retval);
+}
+
+/**
+ * @brief Get the names of the CPU features (e.g., "neon,fp16,dotprod").
+ * @return Newly allocated string. Caller should free it with g_free().
+ */
+gchar *
+cpu_get_features_string (guint features)
+{
+  GString *str = g_string_new (NULL);
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (cpu_feature_names); i++) {
+    if (features & cpu_feature_names[i].feature) {
+      if (str->len > 0)
+        g_string_append_c (str, ',');
+      g_string_append (str, cpu_feature_names[i].name);
+    }
+  }
+
+  return g_string_free (str, FALSE);
+}
+
+/**
+ * @brief Select the implementation of a kernel for this CPU.
+ * @param variants Array of the implementations from the most preferred one, terminated with the generic implementation which requires no feature.
+ * @return The first implementation which this CPU can run.
+ */
+gpointer
+cpu_kernel_select (const cpu_kernel_variant * variants)
+{
+  guint features = cpu_get_features ();
+  guint i;
+
+  g_return_val_if_fail (variants != NULL, NULL);
+
+  for (i = 0;; i++) {
+    if ((variants[i].features & features) == variants[i].features)
+      return variants[i].func;
+  }
+}
+
+#define SYSFS_CPU_PATH "/sys/devices/system/cpu"
+#define SYSFS_NODE_PATH "/sys/devices/system/node"
+
+/**
+ * @brief Parse the CPU list string (e.g., "0-3,6") and append the CPU numbers to the array of guint.
+ * @retval TRUE if the string is valid, else FALSE
+ */
+gboolean
+cpu_parse_list (const gchar * str, GArray * cpus)
+{
+  gchar **ranges;
+  guint i, len;
+  gboolean valid = TRUE;
+
+  g_return_val_if_fail (str != NULL, FALSE);
+  g_return_val_if_fail (cpus != NULL, FALSE);
+
+  ranges = g_strsplit (str, ",", -1);
+  len = g_strv_length (ranges);
+
+  for (i = 0; i < len && valid; i++) {
+    gchar *range = g_strstrip (ranges[i]);
+    gchar *end;
+    guint64 first, last;
+
+    if (*range == '\0')
+      continue;
+
+    first = g_ascii_strtoull (range, &end, 10);
+    last = first;
+
+    if (end == range) {
+      valid = FALSE;
+      break;
+    }
+
+    if (*end == '-') {
+      gchar *start = end + 1;
+
+      last = g_ascii_strtoull (start, &end, 10);
+      if (end == start || last < first)
+        valid = FALSE;
+    }
+
+    if (*end != '\0' || last >= G_MAXUINT16)
+      valid = FALSE;
+
+    for (; valid && first <= last; first++) {
+      guint cpu = (guint) first;
+
+      g_array_append_val (cpus, cpu);
+    }
+  }
+
+  g_strfreev (ranges);
+  return valid;
+}
+
+/**
+ * @brief Internal function to read an integer from sysfs.
+ */
+static gint64
+_read_sysfs_int (const gchar * path, gint64 default_value)
+{
+  gchar *contents = NULL;
+  gint64 value = default_value;
+
+  if (g_file_get_contents (path, &contents, NULL, NULL)) {
+    gchar *end;
+    gint64 val = g_ascii_strtoll (contents, &end, 10);
+
+    if (end != contents)
+      value = val;
+  }
+
+  g_free (contents);
+  return value;
+}
+
+/**
+ * @brief Internal function to read the CPU list from sysfs.
+ */
+static GArray *
+_read_sysfs_cpu_list (const gchar * path)
+{
+  gchar *contents = NULL;
+  GArray *cpus = NULL;
+
+  if (g_file_get_contents (path, &contents, NULL, NULL)) {
+    cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+
+    if (!cpu_parse_list (g_strstrip (contents), cpus) || cpus->len == 0) {
+      g_array_free (cpus, TRUE);
+      cpus = NULL;
+    }
+  }
+
+  g_free (contents);
+  return cpus;
+}
+
+/**
+ * @brief Internal function to find the NUMA node of the CPU (sysfs has a link 'nodeN' in the directory of each CPU).
+ */
+static gint
+_get_cpu_numa_node (guint cpu)
+{
+  gchar *path;
+  GDir *dir;
+  const gchar *name;
+  gint node = -1;
+
+  path = g_strdup_printf (SYSFS_CPU_PATH "/cpu%u", cpu);
+  dir = g_dir_open (path, 0, NULL);
+  g_free (path);
+
+  if (dir == NULL)
+    return -1;
+
+  while ((name = g_dir_read_name (dir)) != NULL) {
+    if (g_str_has_prefix (name, "node") && g_ascii_isdigit (name[4])) {
+      node = (gint) g_ascii_strtoll (name + 4, NULL, 10);
+      break;
+    }
+  }
+
+  g_dir_close (dir);
+  return node;
+}
+
+/**
+ * @brief Get the topology of online CPUs.
+ * @return Newly allocated array of cpu_core_info, NULL if not supported. Caller should free it with g_array_free().
+ */
+GArray *
+cpu_get_topology (void)
+{
+  GArray *online, *cores;
+  guint i;
+
+  online = _read_sysfs_cpu_list (SYSFS_CPU_PATH "/online");
+  if (online == NULL)
+    return NULL;
+
+  cores = g_array_sized_new (FALSE, TRUE, sizeof (cpu_core_info), online->len);
+
+  for (i = 0; i < online->len; i++) {
+    cpu_core_info info;
+    gchar *path;
+
+    info.id = g_array_index (online, guint, i);
+
+    path = g_strdup_printf (SYSFS_CPU_PATH "/cpu%u/topology/core_id", info.id);
+    info.core_id = (gint) _read_sysfs_int (path, -1);
+    g_free (path);
+
+    path = g_strdup_printf (SYSFS_CPU_PATH
+        "/cpu%u/topology/physical_package_id", info.id);
+    info.package_id = (gint) _read_sysfs_int (path, -1);
+    g_free (path);
+
+    info.numa_node = _get_cpu_numa_node (info.id);
+
+    /* arm provides the capacity of big.LITTLE cores, otherwise compare the max frequency */
+    path = g_strdup_printf (SYSFS_CPU_PATH "/cpu%u/cpu_capacity", info.id);
+    info.capacity = (guint) _read_sysfs_int (path, 0);
+    g_free (path);
+
+    if (info.capacity == 0) {
+      path = g_strdup_printf (SYSFS_CPU_PATH
+          "/cpu%u/cpufreq/cpuinfo_max_freq", info.id);
+      info.capacity = (guint) _read_sysfs_int (path, 0);
+      g_free (path);
+    }
+
+    g_array_append_val (cores, info);
+  }
+
+  g_array_free (online, TRUE);
+  return cores;
+}
+
+/**
+ * @brief Get the CPUs of given NUMA node.
+ * @return Newly allocated array of guint, NULL if the node is not available. Caller should free it with g_array_free().
+ */
+GArray *
+cpu_get_node_cpus (gint node)
+{
+  gchar *path;
+  GArray *cpus;
+
+  if (node < 0)
+    return NULL;
+
+  path = g_strdup_printf (SYSFS_NODE_PATH "/node%d/cpulist", node);
+  cpus = _read_sysfs_cpu_list (path);
+  g_free (path);
+
+  return cpus;
+}
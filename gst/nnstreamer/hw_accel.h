@@ -18,10 +18,113 @@
 
 #include <glib.h>
 
+G_BEGIN_DECLS
+
 /**
  * @brief Check if neon is supported
  * @retval 0 if supported, else -errno
  */
 gint cpu_neon_accel_available (void);
 
+/**
+ * @brief CPU features to select the implementation of the kernels.
+ */
+typedef enum
+{
+  CPU_FEATURE_NONE = 0,
+
+  /* arm */
+  CPU_FEATURE_NEON = (1 << 0), /**< NEON (ASIMD) */
+  CPU_FEATURE_FP16 = (1 << 1), /**< half-precision arithmetic of ASIMD */
+  CPU_FEATURE_DOTPROD = (1 << 2), /**< int8 dot product of ASIMD */
+  CPU_FEATURE_SVE = (1 << 3), /**< scalable vector extension */
+
+  /* x86 */
+  CPU_FEATURE_SSE4_2 = (1 << 8), /**< SSE4.2 */
+  CPU_FEATURE_AVX = (1 << 9), /**< AVX (with OS support of YMM registers) */
+  CPU_FEATURE_AVX2 = (1 << 10), /**< AVX2 */
+  CPU_FEATURE_FMA = (1 << 11), /**< FMA3 */
+  CPU_FEATURE_F16C = (1 << 12), /**< half-precision conversion */
+  CPU_FEATURE_AVX512F = (1 << 13), /**< AVX-512 foundation (with OS support of ZMM registers) */
+  CPU_FEATURE_AVX512BW = (1 << 14), /**< AVX-512 byte and word */
+  CPU_FEATURE_AVX512_VNNI = (1 << 15), /**< AVX-512 vector neural network instructions */
+  CPU_FEATURE_AVX_VNNI = (1 << 16), /**< AVX (VEX-encoded) vector neural network instructions */
+} cpu_feature;
+
+/**
+ * @brief Get the SIMD features of the CPU, detected once at runtime.
+ * @return Bitwise OR of cpu_feature
+ */
+guint cpu_get_features (void);
+
+/**
+ * @brief Get the names of the CPU features (e.g., "neon,fp16,dotprod").
+ * @return Newly allocated string. Caller should free it with g_free().
+ */
+gchar *cpu_get_features_string (guint features);
+
+/**
+ * @brief An implementation of a kernel with the CPU features it requires.
+ */
+typedef struct
+{
+  guint features; /**< bitwise OR of cpu_feature required to run the implementation */
+  gpointer func; /**< the implementation */
+} cpu_kernel_variant;
+
+/**
+ * @brief Select the implementation of a kernel for this CPU.
+ * @param variants Array of the implementations from the most preferred one, terminated with the generic implementation which requires no feature.
+ * @return The first implementation which this CPU can run.
+ */
+gpointer cpu_kernel_select (const cpu_kernel_variant * variants);
+
+/**
+ * @brief Define a function pointer which is resolved with the variants at the first call.
+ * @param ret The return type of the kernel
+ * @param name The name of the function pointer to call the kernel
+ * @param params The parameter list of the kernel in parentheses
+ * @param args The arguments of the kernel in parentheses
+ * @param variants Array of cpu_kernel_variant
+ */
+#define CPU_KERNEL_DEFINE(ret,name,params,args,variants) \
+  static ret name##_resolve params; \
+  static ret (*name) params = name##_resolve; \
+  static ret name##_resolve params \
+  { \
+    name = (ret (*) params) cpu_kernel_select (variants); \
+    return name args; \
+  }
+
+/**
+ * @brief Topology of a logical CPU.
+ */
+typedef struct
+{
+  guint id; /**< logical CPU number */
+  gint core_id; /**< physical core in the package, -1 if unknown */
+  gint package_id; /**< physical package (socket, or cluster of big.LITTLE), -1 if unknown */
+  gint numa_node; /**< NUMA node, -1 if unknown */
+  guint capacity; /**< relative performance of the core (cpu_capacity, or max frequency in kHz), 0 if unknown */
+} cpu_core_info;
+
+/**
+ * @brief Parse the CPU list string (e.g., "0-3,6") and append the CPU numbers to the array of guint.
+ * @retval TRUE if the string is valid, else FALSE
+ */
+gboolean cpu_parse_list (const gchar * str, GArray * cpus);
+
+/**
+ * @brief Get the topology of online CPUs.
+ * @return Newly allocated array of cpu_core_info, NULL if not supported. Caller should free it with g_array_free().
+ */
+GArray *cpu_get_topology (void);
+
+/**
+ * @brief Get the CPUs of given NUMA node.
+ * @return Newly allocated array of guint, NULL if the node is not available. Caller should free it with g_array_free().
+ */
+GArray *cpu_get_node_cpus (gint node);
+
+G_END_DECLS
 #endif /* __G_HW_ACCEL__ */
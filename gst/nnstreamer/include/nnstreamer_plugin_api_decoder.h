@@ -31,6 +31,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Information of tensor_decoder given to the sub-plugin with decodeBuffer.
+ */
+typedef struct _GstTensorDecoderContext
+{
+  GstBuffer *inbuf; /**< The input buffer of tensors. The sub-plugin may append the memory of input tensor to outbuf instead of copying the data. */
+  gboolean video_meta; /**< TRUE if downstream supports GstVideoMeta. The sub-plugin may add GstVideoMeta to describe the stride of video frame. */
+  gboolean overlay_composition; /**< TRUE if downstream supports GstVideoOverlayCompositionMeta. The sub-plugin may emit the overlay rectangles instead of drawing the whole frame. */
+} GstTensorDecoderContext;
+
 /**
  * @brief Decoder definitions for different semantics of tensors
  *        This allows developers to create their own decoders.
@@ -94,17 +104,43 @@ typedef struct _GstTensorDecoderDef
        * @param[in] direction The direction of a pad. Normally this is GST_PAD_SINK.
        * @return The size of a buffer.
        */
+  GstFlowReturn (*decodeBuffer) (void **private_data, const GstTensorsConfig *config,
+      const GstTensorMemory *input, const GstTensorDecoderContext *context,
+      GstBuffer *outbuf);
+      /**< Optional. If this is set, tensor_decoder calls this instead of decode (decoder API v2).
+       * This is available only if the sub-plugin is registered with nnstreamer_decoder_probe_v2().
+       * If getTransformSize returns the size of output frame, outbuf is given from the negotiated buffer pool and the sub-plugin should render the frame into it.
+       * If getTransformSize is NULL or returns 0, or downstream supports overlay composition (context->overlay_composition), outbuf is empty and the sub-plugin should append the memory for the negotiated media type.
+       * The sub-plugin may append the memory of input tensors (context->inbuf) to outbuf without copying the data.
+       *
+       * @param[in/out] private_data A sub-plugin may save its internal private data here. The sub-plugin is responsible for alloc/free of this pointer.
+       * @param[in] config The structure of input tensor info.
+       * @param[in] input The array of input tensor data. The maximum array size of input data is NNS_TENSOR_SIZE_LIMIT.
+       * @param[in] context The input buffer and the result of allocation query.
+       * @param[out] outbuf A sub-plugin should append proper memory for the negotiated media type.
+       * @return GST_FLOW_OK if OK.
+       */
 } GstTensorDecoderDef;
 
 /* extern functions for subplugin management, exist in tensor_decoder.c */
 /**
  * @brief Decoder's sub-plugin should call this function to register itself.
+ * The sub-plugin registered with this function uses decoder API v1. The fields after getTransformSize are not accessed, so the sub-plugin built with older header works as it is.
  * @param[in] decoder Decoder sub-plugin to be registered.
  * @return TRUE if registered. FALSE is failed or duplicated.
  */
 extern int
 nnstreamer_decoder_probe (GstTensorDecoderDef * decoder);
 
+/**
+ * @brief Decoder's sub-plugin with decoder API v2 (decodeBuffer) should call this function to register itself.
+ * @param[in] decoder Decoder sub-plugin to be registered.
+ * @param[in] size The size of decoder definition the sub-plugin is built with. It should be sizeof (GstTensorDecoderDef).
+ * @return TRUE if registered. FALSE is failed, duplicated, or the size is smaller than the definition of decoder API v2.
+ */
+extern int
+nnstreamer_decoder_probe_v2 (GstTensorDecoderDef * decoder, size_t size);
+
 /**
  * @brief Decoder's sub-plugin may call this to unregister itself.
  * @param[in] name The name of decoder sub-plugin.
@@ -161,6 +161,13 @@ typedef struct _GstTensorFilterProperties
 
   int latency; /**< The average latency over the recent 10 inferences in microseconds */
   int throughput; /**< The average throughput in the number of outputs per second */
+
+  const char *cache_path; /**< Directory where the sub-plugin may persist compiled or packed model artifacts (e.g., delegate serialization, network compile cache) and reuse them on the next start. The path is keyed by the model files and options, and created by tensor_filter. NULL if 'cache-dir' property is not set. */
+
+  const unsigned int *cpu_affinity; /**< CPUs to run the invoke, resolved from 'cpu-affinity' and 'numa-node' properties. Sub-plugins may pin their internal thread pools to these CPUs, or limit the number of threads. NULL if not set. */
+  unsigned int num_cpu_affinity; /**< the number of CPUs in cpu_affinity */
+  int numa_node; /**< NUMA node to run the invoke and to allocate memory, -1 if not set */
+  int thread_priority; /**< nice value (-20 to 19) of the threads to invoke, 0 if not changed */
 } GstTensorFilterProperties;
 
 /**
@@ -182,7 +189,7 @@ typedef struct _GstTensorFilterFrameworkStatistics
 typedef struct _GstTensorFilterFrameworkInfo
 {
   const char *name; /**< Name of the neural network framework, searchable by FRAMEWORK property. Subplugin is supposed to allocate/deallocate. */
-  int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
+  int allow_in_place; /**< TRUE(nonzero) if invoke allows the output tensors to be the same memory as the input tensors. tensor_filter invokes in-place only if the sub-plugin also accepts the CHECK_IN_PLACE event, and the input and output tensors have the same sizes. Do not change this value after cap negotiation is complete (or the stream has been started). */
   int allocate_in_invoke; /**< TRUE(nonzero) if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
   int run_without_model; /**< TRUE(nonzero) when the neural network framework does not need a model file. Tensor-filter will run invoke_NN without model. */
   int verify_model_path; /**< TRUE(nonzero) when the NNS framework, not the sub-plugin, should verify the path of model files. */
@@ -207,6 +214,7 @@ typedef enum
   SET_OUTPUT_PROP,  /**< Update output tensor info and layout */
   SET_ACCELERATOR,  /**< Update accelerator of the subplugin to be used as backend */
   CHECK_HW_AVAILABILITY, /**< Check the hw availability with custom option */
+  CHECK_IN_PLACE,   /**< Check if the opened model can invoke with the same memory for input and output */
 } event_ops;
 
 /**
@@ -258,6 +266,11 @@ typedef struct _GstTensorFilterFrameworkEventData
       accl_hw hw; /**< accelerator to check availability */
       const char *custom; /**< custom option for hardware detection */
     };
+
+    /** for CHECK_IN_PLACE event of v0 (handleEvent does not have the private data) */
+    struct {
+      void *private_data; /**< The private data of the opened model */
+    };
   };
 } GstTensorFilterFrameworkEventData;
 
@@ -306,7 +319,7 @@ struct _GstTensorFilterFramework
     struct /** _GstTensorFilterFramework_v0 */
     {
       char *name; /**< Name of the neural network framework, searchable by FRAMEWORK property */
-      int allow_in_place; /**< TRUE(nonzero) if InPlace transfer of input-to-output is allowed. Not supported in main, yet */
+      int allow_in_place; /**< TRUE(nonzero) if invoke_NN allows the output tensors to be the same memory as the input tensors. tensor_filter invokes in-place only if handleEvent also accepts the CHECK_IN_PLACE event, and the input and output tensors have the same sizes. */
       int allocate_in_invoke; /**< TRUE(nonzero) if invoke_NN is going to allocate outputptr by itself and return the address via outputptr. Do not change this value after cap negotiation is complete (or the stream has been started). */
       int run_without_model; /**< TRUE(nonzero) when the neural network framework does not need a model file. Tensor-filter will run invoke_NN without model. */
       int verify_model_path; /**< TRUE(nonzero) when the NNS framework, not the sub-plugin, should verify the path of model files. */
@@ -385,6 +398,7 @@ struct _GstTensorFilterFramework
       int (*handleEvent) (event_ops ops, GstTensorFilterFrameworkEventData * data);
       /**< Optional. Runs the event corresponding to the passed operation.
        * If ops == CHECK_HW_AVAILABILITY: tensor_filter will call to check the hw availability with custom option.
+       * If ops == CHECK_IN_PLACE: tensor_filter will call it when allow_in_place is TRUE, with the private_data of the opened model in the event data. Return 0 if the opened model can invoke with the same memory for input and output. Without handling this event, tensor_filter does not invoke in-place.
        * List of operations to be supported are optional.
        *
        * @param[in] ops operation to be performed
@@ -476,6 +490,7 @@ struct _GstTensorFilterFramework
        * If ops == SET_INPUT_PROP: tensor_filter will call to update the property of the subplugin. This function will take tensor info and layout as the argument. This operation can update input tensor shape, type, name and layout.
        * If ops == SET_OUTPUT_PROP: tensor_filter will call to update the property of the subplugin. This function will take tensor info and layout as the argument. This operation can update output tensor shape, type, name and layout.
        * If ops == SET_ACCELERATOR: tensor_filter will call to update the property of the subplugin. This function will take accelerator list as the argument. This operation will update the backend to be used by the corresponding subplugin.
+       * If ops == CHECK_IN_PLACE: tensor_filter will call it when 'allow_in_place' of the framework info is TRUE. Return 0 if the opened model can invoke with the same memory for input and output. Without handling this event, tensor_filter does not invoke in-place.
        * List of operations to be supported are optional.
        * Note: In these operations, the argument 'prop' will not contain the updated information, but will be updated after the corresponding operation is succeeded.
        *
@@ -615,6 +630,48 @@ extern void
 nnstreamer_filter_shared_model_replace (void *instance, const char *key,
     void *new_interpreter, void (*replace_callback) (void *, void *), void (*free_callback) (void*));
 
+/**
+ * @brief Hints to map the model file (bitwise-or of the values).
+ */
+typedef enum {
+  NNS_MODEL_MAP_DEFAULT = 0, /**< map the file without hint, pages are loaded on demand */
+  NNS_MODEL_MAP_WILLNEED = (1 << 0), /**< start the read-ahead of the whole file in background */
+  NNS_MODEL_MAP_POPULATE = (1 << 1), /**< load all pages before returning (prefault) */
+} nns_model_map_flags;
+
+/**
+ * @brief Read-only mapping of a model file.
+ */
+typedef struct _GstTensorFilterModelMap GstTensorFilterModelMap;
+
+/**
+ * @brief Map the model file into memory (read-only, shared).
+ *        The pages are backed by the page cache, so the processes and the filter instances loading the same model share the memory.
+ *        The mapping of the same (unmodified) file is reused in the process.
+ * @param[in] path The path of the model file.
+ * @param[in] flags The hints to load the pages (bitwise-or of nns_model_map_flags).
+ * @return The mapped model. NULL on error. Call nnstreamer_filter_model_unmap() to release it.
+ * @note The subplugin should not write the mapped data. To update the model, replace (rename) the file instead of overwriting it in place.
+ */
+extern GstTensorFilterModelMap *
+nnstreamer_filter_model_map (const char *path, int flags);
+
+/**
+ * @brief Get the data of the mapped model.
+ * @param[in] model The mapped model.
+ * @param[out] size The size of the model file (nullable).
+ * @return The address of the mapped data. NULL if the model is invalid.
+ */
+extern const void *
+nnstreamer_filter_model_map_get_data (GstTensorFilterModelMap *model, size_t *size);
+
+/**
+ * @brief Release the mapped model. The memory is unmapped when all references are released.
+ * @param[in] model The mapped model.
+ */
+extern void
+nnstreamer_filter_model_unmap (GstTensorFilterModelMap *model);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@
  * 1. Define struct, "NNStreamer_custom", with the functions defined.
  * 2. Compile as a shared object. (.so in Linux)
  * 3. Use NNStreamer (tensor_filter framework=custom, model=FILEPATH_OF_YOUR_SO.so, ...)
+ * 4. (Optional) Define int "NNStreamer_custom_in_place" with non-zero value if "invoke" can write the output into the input memory.
  *
  * To Packagers:
  *
@@ -140,4 +141,11 @@ typedef struct _NNStreamer_custom_class NNStreamer_custom_class;
  */
 extern NNStreamer_custom_class *NNStreamer_custom;
 
+/**
+ * @brief A custom filter MAY define NNStreamer_custom_in_place with non-zero value if invoke allows the output tensors to be the same memory as the input tensors.
+ * If defined, tensor_filter invokes in-place when the input and output tensors have the same sizes and the input buffer is writable.
+ * This is ignored if allocate_invoke is used.
+ */
+extern int NNStreamer_custom_in_place;
+
 #endif /*__NNS_TENSOR_FILTER_CUSTOM_H__*/
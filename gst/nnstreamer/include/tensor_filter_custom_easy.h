@@ -63,6 +63,20 @@ extern int NNS_custom_easy_register (const char * modelname,
     NNS_custom_invoke func, void *data,
     const GstTensorsInfo * in_info, const GstTensorsInfo * out_info);
 
+/**
+ * @brief Register the custom-easy tensor function which writes the output into the input memory.
+ * @param[in] modelname The name of custom-easy tensor function.
+ * @param[in] func The tensor function body
+ * @param[in/out] private_data The internal data for the function
+ * @param[in] in_info Input tensor metadata.
+ * @param[in] out_info Output tensor metadata. Each output tensor should have the same size as the input tensor.
+ * @note If the input buffer is writable, tensor_filter invokes func with the same memory for input and output.
+ *       Otherwise, the output buffers for func are copied from the input.
+ */
+extern int NNS_custom_easy_register_in_place (const char * modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info);
+
 /**
  * @brief Unregister the custom-easy tensor function.
  * @param[in] modelname The registered name of custom-easy tensor function.
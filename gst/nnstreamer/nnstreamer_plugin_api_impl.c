@@ -215,6 +215,55 @@ gst_tensor_time_sync_flush (GstCollectPads * collect)
   }
 }
 
+/**
+ * @brief A function to be called when the collect pad is removed.
+ * It should release the buffer and caps in pad data.
+ */
+void
+gst_tensor_time_sync_pad_data_free (GstCollectData * data)
+{
+  GstTensorCollectPadData *pad;
+
+  g_return_if_fail (data != NULL);
+
+  pad = (GstTensorCollectPadData *) data;
+
+  if (pad->buffer) {
+    gst_buffer_unref (pad->buffer);
+    pad->buffer = NULL;
+  }
+
+  gst_caps_replace (&pad->caps, NULL);
+}
+
+/**
+ * @brief Internal function to get the tensors config of the collect pad.
+ * The config is parsed only when the caps of the pad is changed, to avoid parsing the caps for every buffer.
+ * @return TRUE if the pad has valid tensors config.
+ */
+static gboolean
+_gst_tensor_time_sync_get_pad_config (GstTensorCollectPadData * pad,
+    GstTensorsConfig * config)
+{
+  GstCaps *caps;
+
+  caps = gst_pad_get_current_caps (pad->pad);
+  if (caps == NULL)
+    return FALSE;
+
+  if (caps != pad->caps) {
+    GstStructure *s = gst_caps_get_structure (caps, 0);
+
+    gst_tensors_config_from_structure (&pad->config, s);
+    gst_caps_replace (&pad->caps, caps);
+  }
+
+  gst_caps_unref (caps);
+
+  *config = pad->config;
+  return gst_tensors_config_validate (config);
+}
+
 /**
  * @brief Internal function to update buffer in pad data based on the sync mode.
  */
@@ -321,15 +370,7 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
     data = (GstCollectData *) walk->data;
     pad = (GstTensorCollectPadData *) data;
 
-    if (gst_pad_has_current_caps (pad->pad)) {
-      GstCaps *caps = gst_pad_get_current_caps (pad->pad);
-      GstStructure *s = gst_caps_get_structure (caps, 0);
-
-      gst_tensors_config_from_structure (&in_configs, s);
-      gst_caps_unref (caps);
-
-      configured = gst_tensors_config_validate (&in_configs);
-    }
+    configured = _gst_tensor_time_sync_get_pad_config (pad, &in_configs);
 
     /**
      * This would be an internal logic error.
@@ -440,6 +481,56 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
   return !(*is_eos);
 }
 
+/**
+ * @brief Get the memory of given byte range in gst-buffer.
+ * If the range is in a single memory block, this returns a shared sub-memory without copying the data.
+ * Otherwise, or if the memory cannot be shared (GST_MEMORY_FLAG_NO_SHARE), the range is copied into newly allocated memory.
+ */
+GstMemory *
+gst_tensor_buffer_get_range (GstBuffer * buffer, gsize offset, gsize size)
+{
+  GstMemory *mem, *block;
+  GstMapInfo map;
+  guint idx, length;
+  gsize skip;
+
+  if (!GST_IS_BUFFER (buffer) || size == 0) {
+    nns_loge ("Failed to get the memory, invalid parameter.");
+    return NULL;
+  }
+
+  if (offset + size > gst_buffer_get_size (buffer)) {
+    nns_loge ("Failed to get the memory, invalid range (offset %zu, size %zu).",
+        offset, size);
+    return NULL;
+  }
+
+  if (!gst_buffer_find_memory (buffer, offset, size, &idx, &length, &skip)) {
+    nns_loge ("Failed to find the memory of given range.");
+    return NULL;
+  }
+
+  /* The range is in single memory block, share it without copy. */
+  if (length == 1) {
+    block = gst_buffer_peek_memory (buffer, idx);
+
+    if (!GST_MEMORY_IS_NO_SHARE (block))
+      return gst_memory_share (block, (gssize) skip, (gssize) size);
+  }
+
+  mem = gst_allocator_alloc (NULL, size, NULL);
+  if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+    nns_loge ("Failed to map the memory to copy given range.");
+    gst_memory_unref (mem);
+    return NULL;
+  }
+
+  gst_buffer_extract (buffer, offset, map.data, size);
+  gst_memory_unmap (mem, &map);
+
+  return mem;
+}
+
 /**
  * @brief Configure gst-buffer with tensors information.
  * NNStreamer handles single memory chunk as single tensor.
@@ -453,7 +544,6 @@ GstBuffer *
 gst_tensor_buffer_from_config (GstBuffer * in, GstTensorsConfig * config)
 {
   GstBuffer *out = NULL;
-  GstMemory *all = NULL;
   GstMapInfo map;
   guint i, num;
   gsize total, offset;
@@ -521,17 +611,23 @@ gst_tensor_buffer_from_config (GstBuffer * in, GstTensorsConfig * config)
 
   /* configure output buffer */
   out = gst_buffer_new ();
-  all = gst_buffer_get_all_memory (in);
   offset = 0;
 
   for (i = 0; i < num; i++) {
+    GstMemory *mem;
+
     /* invalid memory size */
     if (offset + mem_size[i] > total) {
       nns_loge ("Failed to get tensor buffer, data size is mismatched.");
       goto error;
     }
 
-    gst_buffer_append_memory (out, gst_memory_share (all, offset, mem_size[i]));
+    /* share the memory block if possible, do not merge all memories. */
+    mem = gst_tensor_buffer_get_range (in, offset, mem_size[i]);
+    if (!mem)
+      goto error;
+
+    gst_buffer_append_memory (out, mem);
     offset += mem_size[i];
   }
 
@@ -542,9 +638,6 @@ done:
 error:
   gst_buffer_unref (in);
 
-  if (all)
-    gst_memory_unref (all);
-
   if (!configured) {
     if (out) {
       gst_buffer_unref (out);
@@ -0,0 +1,791 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file	tensor_codec.c
+ * @date	19 Oct 2026
+ * @brief	Internal functions to compress tensor data for the network transports.
+ * @see	http://github.com/nnstreamer/nnstreamer
+ * @bug	No known bugs except for NYI items
+ *
+ * The encoded tensor consists of a header, a chunk table and chunk payloads.
+ * Lossy methods first convert float32 elements to float16 or int8. Then each chunk
+ * is byte-shuffled by element size and run-length encoded, or stored raw if it is
+ * not compressible. The chunks are independent, so the decoder processes them in
+ * parallel. Multi-byte fields are written in host byte order.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "tensor_codec.h"
+#include "nnstreamer_log.h"
+#include "nnstreamer_plugin_api.h"
+#include "nnstreamer_util.h"
+
+#define TENSOR_CODEC_MAGIC (0x43534e4eU)
+#define TENSOR_CODEC_VERSION (1)
+
+/**
+ * @brief The size of a chunk. This should be a multiple of all element sizes.
+ */
+#define TENSOR_CODEC_CHUNK_SIZE (1024 * 1024)
+
+/**
+ * @brief The number of frames to skip lossless encoding after it failed to reduce the size.
+ */
+#define TENSOR_CODEC_PROBE_INTERVAL (30)
+
+/**
+ * @brief Lossless encoding is used only if it reduces the size at least 10%.
+ */
+#define TENSOR_CODEC_MIN_RATIO(s) ((s) - (s) / 10)
+
+/**
+ * @brief The max ratio of run-length decoding (2 bytes to 130 bytes).
+ */
+#define TENSOR_CODEC_RLE_MAX_RATIO (65)
+
+/**
+ * @brief Method of each chunk.
+ */
+typedef enum
+{
+  CHUNK_RAW = 0,
+  CHUNK_SHUFFLE_RLE = 1,
+} chunk_method_e;
+
+/**
+ * @brief Header of the encoded tensor.
+ */
+typedef struct
+{
+  guint32 magic;
+  guint8 version;
+  guint8 quant; /**< tensor_codec_e, NONE or lossy method */
+  guint8 elem_size; /**< element size for byte-shuffle */
+  guint8 reserved;
+  guint32 num_chunks;
+  gfloat scale; /**< scale of int8 quantization */
+  guint64 orig_size; /**< size of the original tensor */
+  guint64 packed_size; /**< size of the quantized tensor */
+} tensor_codec_header_s;
+
+/**
+ * @brief Chunk table entry.
+ */
+typedef struct
+{
+  guint32 method;
+  guint32 size;
+} tensor_codec_chunk_s;
+
+/**
+ * @brief Decoding job shared by the threads.
+ */
+typedef struct
+{
+  const tensor_codec_header_s *header;
+  const tensor_codec_chunk_s *table; /**< aligned copy of the chunk table */
+  const guint8 *payload;
+  guint8 *packed; /**< buffer for the decoded chunks */
+  guint8 *out;
+
+  GMutex lock;
+  GCond cond;
+  guint pending;
+  gboolean failed;
+} tensor_codec_job_s;
+
+/**
+ * @brief Decoding task for a chunk.
+ */
+typedef struct
+{
+  tensor_codec_job_s *job;
+  guint index;
+  gsize offset; /**< offset of the chunk in payload */
+} tensor_codec_task_s;
+
+/**
+ * @brief Register GEnumValue array for tensor codec property handling.
+ */
+GType
+gst_tensor_codec_get_type (void)
+{
+  static GType codec = 0;
+  if (codec == 0) {
+    static GEnumValue codecs[] = {
+      {TENSOR_CODEC_NONE, "none", "Send raw tensor data."},
+      {TENSOR_CODEC_LOSSLESS, "lossless",
+          "Byte-shuffle and run-length encoding if the tensor is compressible."},
+      {TENSOR_CODEC_FP16, "fp16",
+          "Convert float32 tensor to float16 (lossy), then lossless encoding."},
+      {TENSOR_CODEC_INT8, "int8",
+          "Convert float32 tensor to int8 with scale (lossy), then lossless encoding."},
+      {0, NULL, NULL},
+    };
+    codec = g_enum_register_static ("tensor_codec", codecs);
+  }
+
+  return codec;
+}
+
+/**
+ * @brief Convert float32 to float16 (round to nearest even).
+ */
+static inline guint16
+_float_to_half (gfloat value)
+{
+  union
+  {
+    gfloat f;
+    guint32 u;
+  } v;
+  guint32 sign, mant, rem, half;
+  gint32 exp;
+
+  v.f = value;
+  sign = (v.u >> 16) & 0x8000U;
+  exp = (gint32) ((v.u >> 23) & 0xff);
+  mant = v.u & 0x7fffffU;
+
+  if (exp == 0xff)
+    return (guint16) (sign | 0x7c00U | (mant ? 0x200U : 0U));
+
+  exp = exp - 127 + 15;
+  if (exp >= 0x1f)
+    return (guint16) (sign | 0x7c00U);
+
+  if (exp <= 0) {
+    guint32 shift;
+
+    if (exp < -10)
+      return (guint16) sign;
+
+    mant |= 0x800000U;
+    shift = (guint32) (14 - exp);
+    half = mant >> shift;
+    rem = mant & ((1U << shift) - 1U);
+    if (rem > (1U << (shift - 1)) ||
+        (rem == (1U << (shift - 1)) && (half & 1U)))
+      half++;
+
+    return (guint16) (sign | half);
+  }
+
+  half = ((guint32) exp << 10) | (mant >> 13);
+  rem = mant & 0x1fffU;
+  /* carry may overflow to the exponent, which is still the right value */
+  if (rem > 0x1000U || (rem == 0x1000U && (half & 1U)))
+    half++;
+
+  return (guint16) (sign | half);
+}
+
+/**
+ * @brief Convert float16 to float32.
+ */
+static inline gfloat
+_half_to_float (guint16 value)
+{
+  union
+  {
+    gfloat f;
+    guint32 u;
+  } v;
+  guint32 sign, mant;
+  gint32 exp;
+
+  sign = ((guint32) value & 0x8000U) << 16;
+  exp = (value >> 10) & 0x1f;
+  mant = value & 0x3ffU;
+
+  if (exp == 0) {
+    if (mant == 0) {
+      v.u = sign;
+    } else {
+      /* subnormal, normalize it */
+      exp = 1;
+      while (!(mant & 0x400U)) {
+        mant <<= 1;
+        exp--;
+      }
+      mant &= 0x3ffU;
+      v.u = sign | ((guint32) (exp + 127 - 15) << 23) | (mant << 13);
+    }
+  } else if (exp == 0x1f) {
+    v.u = sign | 0x7f800000U | (mant << 13);
+  } else {
+    v.u = sign | ((guint32) (exp + 127 - 15) << 23) | (mant << 13);
+  }
+
+  return v.f;
+}
+
+/**
+ * @brief Quantize float32 tensor.
+ */
+static void
+_quantize (tensor_codec_e quant, const gfloat * in, gsize num, guint8 * out,
+    gfloat * scale)
+{
+  gsize i;
+
+  if (quant == TENSOR_CODEC_FP16) {
+    guint16 *o = (guint16 *) out;
+
+    for (i = 0; i < num; i++)
+      o[i] = _float_to_half (in[i]);
+  } else {
+    gint8 *o = (gint8 *) out;
+    gfloat max_abs = 0.0f, inv;
+
+    for (i = 0; i < num; i++) {
+      gfloat a = fabsf (in[i]);
+      if (a > max_abs)
+        max_abs = a;
+    }
+
+    *scale = (max_abs > 0.0f && isfinite (max_abs)) ? max_abs / 127.0f : 1.0f;
+    inv = 1.0f / *scale;
+
+    for (i = 0; i < num; i++) {
+      gfloat q = roundf (in[i] * inv);
+      o[i] = (gint8) CLAMP (q, -127.0f, 127.0f);
+    }
+  }
+}
+
+/**
+ * @brief Dequantize to float32 tensor.
+ */
+static void
+_dequantize (tensor_codec_e quant, const guint8 * in, gsize num, gfloat * out,
+    gfloat scale)
+{
+  gsize i;
+
+  if (quant == TENSOR_CODEC_FP16) {
+    const guint16 *q = (const guint16 *) in;
+
+    for (i = 0; i < num; i++)
+      out[i] = _half_to_float (q[i]);
+  } else {
+    const gint8 *q = (const gint8 *) in;
+
+    for (i = 0; i < num; i++)
+      out[i] = (gfloat) q[i] * scale;
+  }
+}
+
+/**
+ * @brief Split the bytes of each element into the planes.
+ */
+static void
+_shuffle (const guint8 * in, gsize size, guint elem_size, guint8 * out)
+{
+  gsize num = size / elem_size;
+  gsize i;
+  guint b;
+
+  for (b = 0; b < elem_size; b++) {
+    const guint8 *s = in + b;
+    guint8 *d = out + b * num;
+
+    for (i = 0; i < num; i++)
+      d[i] = s[i * elem_size];
+  }
+}
+
+/**
+ * @brief Merge the planes to elements.
+ */
+static void
+_unshuffle (const guint8 * in, gsize size, guint elem_size, guint8 * out)
+{
+  gsize num = size / elem_size;
+  gsize i;
+  guint b;
+
+  for (b = 0; b < elem_size; b++) {
+    const guint8 *s = in + b * num;
+    guint8 *d = out + b;
+
+    for (i = 0; i < num; i++)
+      d[i * elem_size] = s[i];
+  }
+}
+
+/**
+ * @brief Run-length encoding. A control byte below 0x80 is followed by (c + 1) literals, otherwise the next byte is repeated (c - 0x80 + 3) times.
+ * @return The encoded size, or 0 if it exceeds the limit.
+ */
+static gsize
+_rle_encode (const guint8 * in, gsize size, guint8 * out, gsize limit)
+{
+  gsize i = 0, o = 0, lit_start = 0, lit_len = 0;
+
+  while (i < size) {
+    gsize run = 1;
+
+    while (i + run < size && run < 130 && in[i + run] == in[i])
+      run++;
+
+    if (run >= 3 || lit_len == 128) {
+      if (lit_len > 0) {
+        if (o + 1 + lit_len > limit)
+          return 0;
+        out[o++] = (guint8) (lit_len - 1);
+        memcpy (out + o, in + lit_start, lit_len);
+        o += lit_len;
+        lit_len = 0;
+      }
+    }
+
+    if (run >= 3) {
+      if (o + 2 > limit)
+        return 0;
+      out[o++] = (guint8) (0x80 + run - 3);
+      out[o++] = in[i];
+      i += run;
+    } else {
+      if (lit_len == 0)
+        lit_start = i;
+      lit_len++;
+      i++;
+    }
+  }
+
+  if (lit_len > 0) {
+    if (o + 1 + lit_len > limit)
+      return 0;
+    out[o++] = (guint8) (lit_len - 1);
+    memcpy (out + o, in + lit_start, lit_len);
+    o += lit_len;
+  }
+
+  return o;
+}
+
+/**
+ * @brief Run-length decoding.
+ * @return TRUE if the output is filled exactly.
+ */
+static gboolean
+_rle_decode (const guint8 * in, gsize size, guint8 * out, gsize out_size)
+{
+  gsize i = 0, o = 0, len;
+
+  while (i < size) {
+    guint8 c = in[i++];
+
+    if (c < 0x80) {
+      len = (gsize) c + 1;
+      if (i + len > size || o + len > out_size)
+        return FALSE;
+      memcpy (out + o, in + i, len);
+      i += len;
+    } else {
+      len = (gsize) c - 0x80 + 3;
+      if (i >= size || o + len > out_size)
+        return FALSE;
+      memset (out + o, in[i++], len);
+    }
+
+    o += len;
+  }
+
+  return (o == out_size);
+}
+
+/**
+ * @brief Encode the tensor data.
+ */
+gpointer
+gst_tensor_codec_encode (tensor_codec_e codec, tensor_type type,
+    const guint8 * data, gsize size, GstTensorCodecState * state,
+    gsize * enc_size)
+{
+  tensor_codec_header_s header;
+  tensor_codec_chunk_s *table;
+  guint8 *quantized = NULL, *encoded = NULL, *shuffled = NULL;
+  const guint8 *packed;
+  gboolean lossless;
+  gsize offset, total, hsize;
+  guint i;
+
+  g_return_val_if_fail (data != NULL && size > 0, NULL);
+  g_return_val_if_fail (enc_size != NULL, NULL);
+
+  if (codec == TENSOR_CODEC_NONE)
+    return NULL;
+
+  memset (&header, 0, sizeof (header));
+  header.magic = TENSOR_CODEC_MAGIC;
+  header.version = TENSOR_CODEC_VERSION;
+  header.quant = TENSOR_CODEC_NONE;
+  header.elem_size = 1;
+  header.scale = 1.0f;
+  header.orig_size = size;
+  header.packed_size = size;
+
+  if (type != _NNS_END && size % gst_tensor_get_element_size (type) == 0)
+    header.elem_size = (guint8) gst_tensor_get_element_size (type);
+
+  packed = data;
+
+  /* Lossy methods are applicable to float32 tensors. */
+  if ((codec == TENSOR_CODEC_FP16 || codec == TENSOR_CODEC_INT8) &&
+      type == _NNS_FLOAT32 && size % sizeof (gfloat) == 0) {
+    header.quant = codec;
+    header.elem_size = (codec == TENSOR_CODEC_FP16) ? 2 : 1;
+    header.packed_size = size / sizeof (gfloat) * header.elem_size;
+
+    quantized = g_malloc (header.packed_size);
+    _quantize (codec, (const gfloat *) data, size / sizeof (gfloat), quantized,
+        &header.scale);
+    packed = quantized;
+  }
+
+  lossless = TRUE;
+  if (state && state->skip > 0) {
+    state->skip--;
+    lossless = FALSE;
+
+    if (header.quant == TENSOR_CODEC_NONE)
+      goto raw;
+  }
+
+  header.num_chunks = (guint32) ((header.packed_size + TENSOR_CODEC_CHUNK_SIZE
+          - 1) / TENSOR_CODEC_CHUNK_SIZE);
+  hsize = sizeof (header) + sizeof (tensor_codec_chunk_s) * header.num_chunks;
+
+  encoded = g_malloc (hsize + header.packed_size);
+  table = g_new0 (tensor_codec_chunk_s, header.num_chunks);
+  if (lossless)
+    shuffled = g_malloc (MIN (header.packed_size, TENSOR_CODEC_CHUNK_SIZE));
+
+  offset = hsize;
+  for (i = 0; i < header.num_chunks; i++) {
+    gsize start = (gsize) i * TENSOR_CODEC_CHUNK_SIZE;
+    gsize len = MIN (header.packed_size - start, TENSOR_CODEC_CHUNK_SIZE);
+    gsize rle_size = 0;
+
+    if (lossless) {
+      if (header.elem_size > 1 && len % header.elem_size == 0) {
+        _shuffle (packed + start, len, header.elem_size, shuffled);
+        rle_size = _rle_encode (shuffled, len, encoded + offset, len - 1);
+      } else {
+        rle_size = _rle_encode (packed + start, len, encoded + offset, len - 1);
+      }
+    }
+
+    if (rle_size > 0) {
+      table[i].method = CHUNK_SHUFFLE_RLE;
+      table[i].size = (guint32) rle_size;
+    } else {
+      table[i].method = CHUNK_RAW;
+      table[i].size = (guint32) len;
+      memcpy (encoded + offset, packed + start, len);
+    }
+
+    offset += table[i].size;
+  }
+
+  total = offset;
+  g_free (shuffled);
+
+  memcpy (encoded + sizeof (header), table,
+      sizeof (tensor_codec_chunk_s) * header.num_chunks);
+  g_free (table);
+
+  if (header.quant == TENSOR_CODEC_NONE &&
+      total > TENSOR_CODEC_MIN_RATIO (size)) {
+    /* Not compressible, send raw data and probe again later. */
+    if (state)
+      state->skip = TENSOR_CODEC_PROBE_INTERVAL;
+    goto raw;
+  }
+
+  memcpy (encoded, &header, sizeof (header));
+  g_free (quantized);
+
+  *enc_size = total;
+  return encoded;
+
+raw:
+  g_free (encoded);
+  g_free (quantized);
+  return NULL;
+}
+
+/**
+ * @brief Decode a chunk and dequantize it.
+ */
+static gboolean
+_decode_chunk (tensor_codec_job_s * job, guint index, gsize offset)
+{
+  const tensor_codec_header_s *header = job->header;
+  const tensor_codec_chunk_s *chunk = &job->table[index];
+  gsize start = (gsize) index * TENSOR_CODEC_CHUNK_SIZE;
+  gsize len = MIN (header->packed_size - start, TENSOR_CODEC_CHUNK_SIZE);
+  const guint8 *src = job->payload + offset;
+  guint8 *dest;
+
+  /* Without quantization, decode to the output directly. */
+  dest = (header->quant == TENSOR_CODEC_NONE) ? job->out : job->packed;
+  dest += start;
+
+  if (chunk->method == CHUNK_RAW) {
+    if (chunk->size != len)
+      return FALSE;
+    memcpy (dest, src, len);
+  } else if (header->elem_size > 1 && len % header->elem_size == 0) {
+    guint8 *planes = g_malloc (len);
+    gboolean ret = _rle_decode (src, chunk->size, planes, len);
+
+    if (ret)
+      _unshuffle (planes, len, header->elem_size, dest);
+    g_free (planes);
+
+    if (!ret)
+      return FALSE;
+  } else if (!_rle_decode (src, chunk->size, dest, len)) {
+    return FALSE;
+  }
+
+  if (header->quant != TENSOR_CODEC_NONE) {
+    gsize first = start / header->elem_size;
+
+    _dequantize (header->quant, dest, len / header->elem_size,
+        ((gfloat *) job->out) + first, header->scale);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Thread function to decode a chunk.
+ */
+static void
+_decode_chunk_thread (gpointer data, gpointer user_data)
+{
+  tensor_codec_task_s *task = (tensor_codec_task_s *) data;
+  tensor_codec_job_s *job = task->job;
+  gboolean ret;
+  UNUSED (user_data);
+
+  ret = _decode_chunk (job, task->index, task->offset);
+
+  g_mutex_lock (&job->lock);
+  if (!ret)
+    job->failed = TRUE;
+  job->pending--;
+  g_cond_signal (&job->cond);
+  g_mutex_unlock (&job->lock);
+}
+
+/**
+ * @brief Get the thread pool shared by the decoders.
+ */
+static GThreadPool *
+_get_decode_pool (void)
+{
+  static gsize pool = 0;
+
+  if (g_once_init_enter (&pool)) {
+    GThreadPool *p;
+    gint n = (gint) g_get_num_processors ();
+
+    p = (n > 1) ? g_thread_pool_new (_decode_chunk_thread, NULL, n, FALSE,
+        NULL) : NULL;
+    g_once_init_leave (&pool, (gsize) p);
+  }
+
+  return (GThreadPool *) pool;
+}
+
+/**
+ * @brief Decode the tensor data.
+ */
+gpointer
+gst_tensor_codec_decode (const guint8 * data, gsize size, gsize max_size,
+    gsize * dec_size)
+{
+  tensor_codec_header_s header;
+  tensor_codec_chunk_s *table;
+  tensor_codec_job_s job;
+  tensor_codec_task_s *tasks;
+  GThreadPool *pool;
+  gsize hsize, offset, expected;
+  gboolean ret;
+  guint i;
+
+  g_return_val_if_fail (data != NULL, NULL);
+  g_return_val_if_fail (dec_size != NULL, NULL);
+
+  if (size < sizeof (header)) {
+    nns_loge ("Invalid encoded tensor, the size is too small.");
+    return NULL;
+  }
+
+  memcpy (&header, data, sizeof (header));
+  if (header.magic != TENSOR_CODEC_MAGIC ||
+      header.version != TENSOR_CODEC_VERSION) {
+    nns_loge ("Invalid encoded tensor, unknown header.");
+    return NULL;
+  }
+
+  if (header.quant == TENSOR_CODEC_NONE) {
+    expected = header.orig_size;
+  } else if (header.quant == TENSOR_CODEC_FP16 ||
+      header.quant == TENSOR_CODEC_INT8) {
+    guint es = (header.quant == TENSOR_CODEC_FP16) ? 2 : 1;
+
+    expected = header.orig_size / sizeof (gfloat) * es;
+    if (header.elem_size != es || header.orig_size % sizeof (gfloat) != 0)
+      expected = 0;
+  } else {
+    expected = 0;
+  }
+
+  if (header.elem_size == 0 || header.packed_size == 0 ||
+      header.packed_size != expected || header.num_chunks !=
+      (header.packed_size + TENSOR_CODEC_CHUNK_SIZE -
+          1) / TENSOR_CODEC_CHUNK_SIZE) {
+    nns_loge ("Invalid encoded tensor, mismatched size information.");
+    return NULL;
+  }
+
+  if (max_size > 0 && header.orig_size > max_size) {
+    nns_loge ("Invalid encoded tensor, the size %" G_GUINT64_FORMAT
+        " exceeds the tensor size %zu.", header.orig_size, max_size);
+    return NULL;
+  }
+
+  hsize = sizeof (header) + sizeof (tensor_codec_chunk_s) * header.num_chunks;
+  if (header.num_chunks > size / sizeof (tensor_codec_chunk_s) || size < hsize) {
+    nns_loge ("Invalid encoded tensor, the chunk table is truncated.");
+    return NULL;
+  }
+
+  /* The payload cannot be expanded more than the max ratio of the encoding. */
+  if (header.packed_size / TENSOR_CODEC_RLE_MAX_RATIO > size - hsize) {
+    nns_loge ("Invalid encoded tensor, the size %" G_GUINT64_FORMAT
+        " is too large for the payload.", header.packed_size);
+    return NULL;
+  }
+
+  /* The encoded data may not be aligned, copy the chunk table. */
+  table = g_new (tensor_codec_chunk_s, header.num_chunks);
+  memcpy (table, data + sizeof (header),
+      sizeof (tensor_codec_chunk_s) * header.num_chunks);
+
+  memset (&job, 0, sizeof (job));
+  job.header = &header;
+  job.table = table;
+  job.payload = data;
+  job.out = g_try_malloc (header.orig_size);
+  if (header.quant != TENSOR_CODEC_NONE)
+    job.packed = g_try_malloc (header.packed_size);
+
+  tasks = g_new0 (tensor_codec_task_s, header.num_chunks);
+
+  if (!job.out || (header.quant != TENSOR_CODEC_NONE && !job.packed)) {
+    nns_loge ("Failed to allocate the decoded tensor (%" G_GUINT64_FORMAT
+        " bytes).", header.orig_size);
+    job.failed = TRUE;
+    goto done;
+  }
+
+  offset = hsize;
+  for (i = 0; i < header.num_chunks; i++) {
+    tasks[i].job = &job;
+    tasks[i].index = i;
+    tasks[i].offset = offset;
+
+    if (table[i].size > size - offset)
+      break;
+    offset += table[i].size;
+  }
+
+  if (i != header.num_chunks || offset != size) {
+    nns_loge ("Invalid encoded tensor, the chunks are truncated.");
+    job.failed = TRUE;
+    goto done;
+  }
+
+  pool = (header.num_chunks > 1) ? _get_decode_pool () : NULL;
+  if (pool) {
+    g_mutex_init (&job.lock);
+    g_cond_init (&job.cond);
+
+    /* decode the last chunk in this thread */
+    job.pending = header.num_chunks - 1;
+    for (i = 0; i < header.num_chunks - 1; i++)
+      g_thread_pool_push (pool, &tasks[i], NULL);
+
+    ret = _decode_chunk (&job, header.num_chunks - 1, tasks[i].offset);
+
+    g_mutex_lock (&job.lock);
+    if (!ret)
+      job.failed = TRUE;
+    while (job.pending > 0)
+      g_cond_wait (&job.cond, &job.lock);
+    g_mutex_unlock (&job.lock);
+
+    g_mutex_clear (&job.lock);
+    g_cond_clear (&job.cond);
+  } else {
+    for (i = 0; i < header.num_chunks && !job.failed; i++) {
+      if (!_decode_chunk (&job, i, tasks[i].offset))
+        job.failed = TRUE;
+    }
+  }
+
+  if (job.failed)
+    nns_loge ("Invalid encoded tensor, failed to decode the chunks.");
+
+done:
+  g_free (tasks);
+  g_free (table);
+  g_free (job.packed);
+
+  if (job.failed) {
+    g_free (job.out);
+    return NULL;
+  }
+
+  *dec_size = header.orig_size;
+  return job.out;
+}
+
+/**
+ * @brief Get the size of each tensor from the negotiated caps, to limit the size of decoded tensors.
+ */
+void
+gst_tensor_codec_get_max_sizes (GstCaps * caps,
+    gsize max_sizes[NNS_TENSOR_SIZE_LIMIT])
+{
+  GstStructure *structure;
+  GstTensorsConfig config;
+  guint i;
+
+  g_return_if_fail (max_sizes != NULL);
+
+  memset (max_sizes, 0, sizeof (gsize) * NNS_TENSOR_SIZE_LIMIT);
+
+  if (!caps || !gst_caps_is_fixed (caps))
+    return;
+
+  structure = gst_caps_get_structure (caps, 0);
+  if (!gst_structure_is_tensor_stream (structure))
+    return;
+
+  gst_tensors_config_from_structure (&config, structure);
+  if (config.info.format == _NNS_TENSOR_FORMAT_STATIC) {
+    for (i = 0; i < config.info.num_tensors && i < NNS_TENSOR_SIZE_LIMIT; i++)
+      max_sizes[i] = gst_tensors_info_get_size (&config.info, i);
+  }
+  gst_tensors_config_free (&config);
+}
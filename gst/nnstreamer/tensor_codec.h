@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (c) 2022 Samsung Electronics Co., Ltd. All Rights Reserved.
+ *
+ * @file	tensor_codec.h
+ * @date	19 Oct 2026
+ * @brief	Internal functions to compress tensor data for the network transports.
+ * @see	http://github.com/nnstreamer/nnstreamer
+ * @bug	No known bugs except for NYI items
+ */
+
+#ifndef __NNS_TENSOR_CODEC_H__
+#define __NNS_TENSOR_CODEC_H__
+
+#include <glib.h>
+#include <glib-object.h>
+#include <gst/gst.h>
+#include <tensor_typedef.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The key of data info to describe the encoded memories. The value is a string of '0' (raw) or '1' (encoded) for each memory.
+ */
+#define TENSOR_CODEC_INFO_KEY "tensor_codec"
+
+/**
+ * @brief Compression of the tensor data.
+ */
+typedef enum
+{
+  TENSOR_CODEC_NONE = 0, /**< send raw data */
+  TENSOR_CODEC_LOSSLESS, /**< byte-shuffle and run-length encoding */
+  TENSOR_CODEC_FP16, /**< float32 to float16 (lossy), then lossless encoding */
+  TENSOR_CODEC_INT8, /**< float32 to int8 with scale (lossy), then lossless encoding */
+} tensor_codec_e;
+
+#define GST_TYPE_TENSOR_CODEC (gst_tensor_codec_get_type ())
+
+/**
+ * @brief State of the encoder for each tensor, to skip lossless encoding of the tensor which is not compressible.
+ */
+typedef struct
+{
+  guint skip; /**< the number of frames to send without lossless encoding */
+} GstTensorCodecState;
+
+/**
+ * @brief Get the GType of tensor codec enum for property handling.
+ */
+extern GType
+gst_tensor_codec_get_type (void);
+
+/**
+ * @brief Encode the tensor data.
+ * @param codec The compression method
+ * @param type The element type of the tensor (_NNS_END if unknown). Lossy methods are applied to float32 tensors only.
+ * @param data The tensor data
+ * @param size The size of the tensor data
+ * @param state The encoder state of the tensor (nullable)
+ * @param[out] enc_size The size of encoded data
+ * @return Newly allocated encoded data, or NULL if the tensor should be sent as it is. Caller should free the returned value using g_free().
+ */
+extern gpointer
+gst_tensor_codec_encode (tensor_codec_e codec, tensor_type type, const guint8 * data, gsize size, GstTensorCodecState * state, gsize * enc_size);
+
+/**
+ * @brief Decode the tensor data. Large tensors are decoded with multiple threads.
+ * @param data The encoded data
+ * @param size The size of encoded data
+ * @param max_size The max size of decoded tensor, usually the size of negotiated tensor (0 if unknown, e.g., flexible tensor)
+ * @param[out] dec_size The size of decoded tensor
+ * @return Newly allocated tensor data, or NULL on error. Caller should free the returned value using g_free().
+ */
+extern gpointer
+gst_tensor_codec_decode (const guint8 * data, gsize size, gsize max_size, gsize * dec_size);
+
+/**
+ * @brief Get the size of each tensor from the negotiated caps, to limit the size of decoded tensors.
+ * @param caps The negotiated caps (nullable)
+ * @param[out] max_sizes The size of each tensor, 0 if unknown (e.g., flexible tensor)
+ */
+extern void
+gst_tensor_codec_get_max_sizes (GstCaps * caps, gsize max_sizes[NNS_TENSOR_SIZE_LIMIT]);
+
+G_END_DECLS
+#endif /* __NNS_TENSOR_CODEC_H__ */
@@ -95,6 +95,8 @@ typedef struct
   GstCollectData collect;
   GstBuffer *buffer;
   GstPad *pad;
+  GstCaps *caps; /**< the caps that config is parsed from */
+  GstTensorsConfig config; /**< cached tensors config of the pad */
 } GstTensorCollectPadData;
 
 /**
@@ -152,6 +154,14 @@ gst_tensor_time_sync_get_current_time (GstCollectPads * collect, tensor_time_syn
 extern void
 gst_tensor_time_sync_flush (GstCollectPads * collect);
 
+/**
+ * @brief A function to be called when the collect pad is removed.
+ * It should release the buffer and caps in pad data.
+ * @param data Pad data of the collect pad.
+ */
+extern void
+gst_tensor_time_sync_pad_data_free (GstCollectData * data);
+
 /**
  * @brief  A function call to make tensors from collected pads
  * It decide which buffer is going to be used according to sync option.
@@ -166,6 +176,18 @@ gst_tensor_time_sync_flush (GstCollectPads * collect);
 extern gboolean
 gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect, tensor_time_sync_data * sync, GstClockTime current_time, GstBuffer * tensors_buf, GstTensorsConfig * configs, gboolean * is_eos);
 
+/**
+ * @brief Get the memory of given byte range in gst-buffer.
+ * If the range is in a single memory block, this returns a shared sub-memory without copying the data.
+ * Otherwise, the range is copied into newly allocated memory.
+ * @param buffer gst-buffer to be referred
+ * @param offset the offset of the range in the buffer
+ * @param size the size of the range
+ * @return The memory of given range. Null if failed. Caller should unref the memory using gst_memory_unref().
+ */
+extern GstMemory *
+gst_tensor_buffer_get_range (GstBuffer * buffer, gsize offset, gsize size);
+
 /**
  * @brief Configure gst-buffer with tensors information.
  * NNStreamer handles single memory chunk as single tensor.
@@ -129,6 +129,8 @@ static void gst_tensor_filter_finalize (GObject * object);
 /* GstBaseTransform vmethod implementations */
 static GstFlowReturn gst_tensor_filter_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf);
+static GstFlowReturn gst_tensor_filter_transform_ip (GstBaseTransform * trans,
+    GstBuffer * buf);
 static GstCaps *gst_tensor_filter_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_tensor_filter_fixate_caps (GstBaseTransform * trans,
@@ -186,6 +188,8 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
 
   /* Processing units */
   trans_class->transform = GST_DEBUG_FUNCPTR (gst_tensor_filter_transform);
+  trans_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_transform_ip);
 
   /* Negotiation units */
   trans_class->transform_caps =
@@ -399,7 +403,9 @@ record_statistics (GstTensorFilterPrivate * priv)
   /* the queue should have at least one element */
   g_assert (g_queue_get_length (recent_latencies) != 0);
 
-  if (priv->latency_mode > 0 || priv->latency_reporting) {
+  /* the scheduler drops the frame with the average latency */
+  if (priv->latency_mode > 0 || priv->latency_reporting ||
+      priv->sched.registered) {
     gint64 avg_latency = 0;
 
     g_queue_foreach (recent_latencies, accumulate_latency, &avg_latency);
@@ -410,7 +416,9 @@ record_statistics (GstTensorFilterPrivate * priv)
       priv->prop.latency = (gint) avg_latency;
     else
       priv->prop.latency = -1;
+  }
 
+  if (priv->latency_mode > 0 || priv->latency_reporting) {
     ml_logi ("[%s] Invoke took %.3f ms", TF_MODELNAME (&(priv->prop)),
         (*latency) / 1000.0);
   }
@@ -551,6 +559,47 @@ gst_tensor_filter_check_throttling_delay (GstBaseTransform * trans,
   return FALSE;
 }
 
+/**
+ * @brief Check the deadline of input buffer and the share of invoke time with the process-wide scheduler.
+ * @return TRUE if the buffer should be dropped.
+ */
+static gboolean
+gst_tensor_filter_check_schedule (GstBaseTransform * trans, GstBuffer * inbuf)
+{
+  GstTensorFilter *self;
+  GstTensorFilterPrivate *priv;
+  GstClock *clock;
+  gint64 lateness = G_MININT64;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+  priv = &self->priv;
+
+  if (priv->sched.priority == 0 && priv->sched.deadline == 0 &&
+      !priv->sched.registered)
+    return FALSE;
+
+  clock = gst_element_get_clock (GST_ELEMENT_CAST (self));
+  if (clock) {
+    if (trans->segment.format == GST_FORMAT_TIME &&
+        GST_BUFFER_PTS_IS_VALID (inbuf)) {
+      GstClockTime running_time, now;
+
+      running_time = gst_segment_to_running_time (&trans->segment,
+          GST_FORMAT_TIME, GST_BUFFER_PTS (inbuf));
+
+      if (GST_CLOCK_TIME_IS_VALID (running_time)) {
+        now = gst_clock_get_time (clock) -
+            gst_element_get_base_time (GST_ELEMENT_CAST (self));
+        lateness = GST_CLOCK_DIFF (running_time, now) / GST_USECOND;
+      }
+    }
+
+    gst_object_unref (clock);
+  }
+
+  return !gst_tensor_filter_common_schedule_admit (priv, lateness);
+}
+
 /**
  * @brief Check input paramters for gst_tensor_filter_transform ();
  */
@@ -609,13 +658,18 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
   if (gst_tensor_filter_check_throttling_delay (trans, inbuf))
     return GST_BASE_TRANSFORM_FLOW_DROPPED;
 
+  /* skip input data which cannot make its deadline */
+  if (gst_tensor_filter_check_schedule (trans, inbuf))
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+
   if (!outbuf) {
     GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
         ("The output buffer for the instance of tensor-filter subplugin (%s / %s) is null. Cannot proceed.",
             prop->fwname, TF_MODELNAME (prop)));
     return GST_FLOW_ERROR;
   }
-  if (gst_buffer_get_size (outbuf) != 0) {
+  /* in-place transform writes the result into the input buffer */
+  if (outbuf != inbuf && gst_buffer_get_size (outbuf) != 0) {
     GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
         ("The output buffer for the isntance of tensor-filter subplugin (%s / %s) already has a content (buffer size = %zu). It should be 0.",
             prop->fwname, TF_MODELNAME (prop), gst_buffer_get_size (outbuf)));
@@ -625,6 +679,135 @@ _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
   return GST_FLOW_OK;
 }
 
+/**
+ * @brief Copy the tensor data into the zero-filled tensor of larger dimension.
+ */
+static void
+gst_tensor_filter_pad_tensor (const guint8 * src, const GstTensorInfo * src_info,
+    guint8 * dest, const GstTensorInfo * dest_info)
+{
+  const uint32_t *sdim = src_info->dimension;
+  const uint32_t *ddim = dest_info->dimension;
+  gsize esize, row_size, rows, r, idx, offset, stride;
+  guint d;
+
+  esize = gst_tensor_get_element_size (src_info->type);
+  row_size = sdim[0] * esize;
+  rows = gst_tensor_get_element_count (sdim) / sdim[0];
+
+  for (r = 0; r < rows; r++) {
+    idx = r;
+    offset = 0;
+    stride = ddim[0];
+
+    for (d = 1; d < NNS_TENSOR_RANK_LIMIT; d++) {
+      offset += (idx % sdim[d]) * stride;
+      idx /= sdim[d];
+      stride *= ddim[d];
+    }
+
+    memcpy (dest + offset * esize, src + r * row_size, row_size);
+  }
+}
+
+/**
+ * @brief Update the input shape of the model with the flexible input tensors.
+ * If the shape buckets are given, the input tensors are padded to the bucket.
+ * @param self "this" pointer
+ * @param num_tensors the number of input tensors
+ * @param in_meta the meta info parsed from the header of input tensors
+ * @param in_tensors the input tensors, updated if padded
+ * @param padded the padded data of input tensors, caller should free it
+ * @return TRUE if the model is ready to invoke the input tensors.
+ */
+static gboolean
+gst_tensor_filter_update_flexible_input (GstTensorFilter * self,
+    guint num_tensors, GstTensorMetaInfo * in_meta,
+    GstTensorMemory * in_tensors, gpointer * padded)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorsInfo in_info, bucket, out_info;
+  GstTensorsInfo *target = &in_info;
+  gboolean ret = FALSE;
+  gsize size;
+  guint i;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&bucket);
+  gst_tensors_info_init (&out_info);
+
+  in_info.num_tensors = num_tensors;
+  for (i = 0; i < num_tensors; i++) {
+    if (!gst_tensor_meta_info_convert (&in_meta[i], &in_info.info[i])) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_transform: The header of %u'th flexible input tensor is invalid.\n",
+          i);
+      goto done;
+    }
+  }
+
+  if (gst_tensor_filter_common_get_shape_bucket (priv, &in_info, &bucket)) {
+    gboolean is_padded = FALSE;
+
+    target = &bucket;
+
+    for (i = 0; i < num_tensors; i++) {
+      if (gst_tensor_info_is_equal (&in_info.info[i], &bucket.info[i]))
+        continue;
+
+      size = gst_tensor_info_get_size (&bucket.info[i]);
+      padded[i] = g_try_malloc0 (size);
+      if (!padded[i]) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_transform: cannot allocate memory (%zd bytes) to pad %u'th input tensor to the shape bucket.\n",
+            size, i);
+        goto done;
+      }
+
+      gst_tensor_filter_pad_tensor (in_tensors[i].data, &in_info.info[i],
+          padded[i], &bucket.info[i]);
+
+      in_tensors[i].data = padded[i];
+      in_tensors[i].size = size;
+      is_padded = TRUE;
+    }
+
+    if (is_padded)
+      priv->shape_cache.padded++;
+  }
+
+  if (gst_tensors_info_is_equal (target, &prop->input_meta)) {
+    ret = TRUE;
+    goto done;
+  }
+
+  gst_tensors_info_copy (&out_info, &prop->output_meta);
+
+  if (!gst_tensor_filter_common_update_shape (priv, target)) {
+    ml_loge_stacktrace
+        ("gst_tensor_filter_transform: The shape of flexible input is changed, but the tensor-filter subplugin (%s:%s) cannot be re-configured with new shape.\n",
+        prop->fwname, TF_MODELNAME (prop));
+    goto done;
+  }
+
+  if (!gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (self)) &&
+      !gst_tensors_info_is_equal (&out_info, &prop->output_meta)) {
+    ml_loge_stacktrace
+        ("gst_tensor_filter_transform: The output shape of the model is changed with new input shape, but the output of tensor-filter (%s:%s) is static. Please use format=flexible for the output.\n",
+        prop->fwname, TF_MODELNAME (prop));
+    goto done;
+  }
+
+  ret = TRUE;
+
+done:
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&bucket);
+  gst_tensors_info_free (&out_info);
+  return ret;
+}
+
 /**
  * @brief non-ip transform. required vmethod of GstBaseTransform.
  */
@@ -642,6 +825,7 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
   GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
   GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT];
   GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  gpointer padded[NNS_TENSOR_SIZE_LIMIT] = { 0, };
   GList *list;
   guint i, num_mems;
   gint ret;
@@ -689,6 +873,13 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     in_tensors[i].size = in_info[i].size - hsize;
   }
 
+  /* 1.0 Re-configure the model if the shape of flexible input is changed. */
+  if (in_flexible && !priv->combi.in_combi_defined) {
+    if (!gst_tensor_filter_update_flexible_input (self, num_mems, in_meta,
+            in_tensors, padded))
+      goto mem_map_error;
+  }
+
   /* 1.1 Prepare tensors to invoke. */
   if (priv->combi.in_combi_defined) {
     guint info_idx = 0;
@@ -778,21 +969,29 @@ gst_tensor_filter_transform (GstBaseTransform * trans,
     }
   }
 
+  /* pin the streaming thread during invoke, the worker threads of sub-plugin may inherit it */
+  gst_tensor_filter_common_apply_cpu_placement (priv);
+
   need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
-      priv->latency_reporting);
+      priv->latency_reporting || priv->sched.registered);
   if (need_profiling)
     prepare_statistics (priv);
 
   /* 3. Call the filter-subplugin callback, "invoke" */
   GST_TF_FW_INVOKE_COMPAT (priv, ret, invoke_tensors, out_tensors);
+  gst_tensor_filter_common_restore_cpu_placement (priv);
   if (need_profiling) {
+    gst_tensor_filter_common_schedule_done (priv,
+        g_get_real_time () - priv->stat.latest_invoke_time);
     record_statistics (priv);
     track_latency (self);
   }
 
   /* 4. Free map info and handle error case */
-  for (i = 0; i < num_mems; i++)
+  for (i = 0; i < num_mems; i++) {
     gst_memory_unmap (in_mem[i], &in_info[i]);
+    g_free (padded[i]);
+  }
 
   if (!allocate_in_invoke) {
     for (i = 0; i < prop->output_meta.num_tensors; i++) {
@@ -880,6 +1079,7 @@ mem_map_error:
   for (i = 0; i < num_mems; i++) {
     if (in_mem[i])
       gst_memory_unmap (in_mem[i], &in_info[i]);
+    g_free (padded[i]);
   }
 
   if (!allocate_in_invoke) {
@@ -893,6 +1093,100 @@ mem_map_error:
   return GST_FLOW_ERROR;
 }
 
+/**
+ * @brief in-place transform. optional vmethod of GstBaseTransform.
+ * This is called if the sub-plugin allows in-place invoke and the input and output tensors have the same sizes (refer to gst_tensor_filter_set_caps ()).
+ * The base class gives a writable buffer (copied if incoming buffer is not writable) and the sub-plugin writes the result into the same memory.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMapInfo info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory tensors[NNS_TENSOR_SIZE_LIMIT];
+  guint i, num_mems, num_mapped = 0;
+  gint ret;
+  gboolean need_profiling;
+  gsize expected;
+
+  /* 0. Check all properties. */
+  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, buf,
+      buf);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  /* 1. Map all tensors for read and write. The memory is copied if it is shared with other buffers. */
+  num_mems = gst_buffer_n_memory (buf);
+  if (num_mems != prop->input_meta.num_tensors) {
+    ml_loge_stacktrace
+        ("gst_tensor_filter_transform_ip: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors). Maybe, the pad capability is not consistent with the actual input stream.\n",
+        num_mems, prop->input_meta.num_tensors);
+    return GST_FLOW_ERROR;
+  }
+
+  for (i = 0; i < num_mems; i++) {
+    if (!gst_buffer_map_range (buf, i, 1, &info[i], GST_MAP_READWRITE)) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_transform_ip: For the given input buffer, tensor-filter (%s : %s) cannot map the %u-th memory chunk (%u-th tensor) for in-place invoke.\n",
+          prop->fwname, TF_MODELNAME (prop), i, i);
+      goto mem_map_error;
+    }
+    num_mapped++;
+
+    expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+    if (expected != info[i].size) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_transform_ip: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd, which is the frame size of the corresponding tensor. Maybe, the pad capability is not consistent with the actual input stream.\n",
+          i, info[i].size, expected);
+      goto mem_map_error;
+    }
+
+    tensors[i].data = info[i].data;
+    tensors[i].size = info[i].size;
+  }
+
+  /* pin the streaming thread during invoke, the worker threads of sub-plugin may inherit it */
+  gst_tensor_filter_common_apply_cpu_placement (priv);
+
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_reporting || priv->sched.registered);
+  if (need_profiling)
+    prepare_statistics (priv);
+
+  /* 2. Call the filter-subplugin callback, "invoke" with the same memory for input and output */
+  GST_TF_FW_INVOKE_COMPAT (priv, ret, tensors, tensors);
+  gst_tensor_filter_common_restore_cpu_placement (priv);
+  if (need_profiling) {
+    gst_tensor_filter_common_schedule_done (priv,
+        g_get_real_time () - priv->stat.latest_invoke_time);
+    record_statistics (priv);
+    track_latency (self);
+  }
+
+  /* 3. Free map info and handle error case */
+  for (i = 0; i < num_mems; i++)
+    gst_buffer_unmap (buf, &info[i]);
+
+  /** @todo define enum to indicate status code */
+  if (ret < 0) {
+    ml_loge_stacktrace
+        ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
+        prop->fwname, TF_MODELNAME (prop), ret);
+    return GST_FLOW_ERROR;
+  } else if (ret > 0) {
+    /* drop this buffer */
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  }
+
+  return GST_FLOW_OK;
+mem_map_error:
+  for (i = 0; i < num_mapped; i++)
+    gst_buffer_unmap (buf, &info[i]);
+  return GST_FLOW_ERROR;
+}
+
 /**
  * @brief Configure input and output tensor info from incaps.
  * @param self "this" pointer
@@ -1250,6 +1544,41 @@ gst_tensor_filter_fixate_caps (GstBaseTransform * trans,
   return result;
 }
 
+/**
+ * @brief Check if tensor_filter can invoke in-place with the negotiated tensor info.
+ * The sub-plugin should allow it, and the input and output tensors should have the same sizes without the combination option.
+ */
+static gboolean
+gst_tensor_filter_check_in_place (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  guint i;
+
+  if (!gst_tensor_filter_allow_in_place (priv) ||
+      gst_tensor_filter_allocate_in_invoke (priv))
+    return FALSE;
+
+  if (priv->combi.in_combi_defined || priv->combi.out_combi_i_defined ||
+      priv->combi.out_combi_o_defined)
+    return FALSE;
+
+  if (gst_tensors_config_is_flexible (&priv->in_config) ||
+      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (self)))
+    return FALSE;
+
+  if (prop->input_meta.num_tensors != prop->output_meta.num_tensors)
+    return FALSE;
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    if (gst_tensor_filter_get_tensor_size (self, i, TRUE) !=
+        gst_tensor_filter_get_tensor_size (self, i, FALSE))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief set caps. required vmethod of GstBaseTransform.
  */
@@ -1304,6 +1633,13 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
     return FALSE;
   }
 
+  /* invoke in-place if the sub-plugin allows it and the tensor sizes are the same */
+  gst_base_transform_set_in_place (trans,
+      gst_tensor_filter_check_in_place (self));
+
+  /* warm-up with the negotiated tensor info, if not done when starting */
+  gst_tensor_filter_common_warmup (priv);
+
   return TRUE;
 }
 
@@ -1500,6 +1836,13 @@ gst_tensor_filter_start (GstBaseTransform * trans)
   if (priv->fw == NULL)
     return FALSE;
   gst_tensor_filter_common_open_fw (priv);
+
+  /* run warm-up before streaming if the model has fixed tensor info */
+  if (priv->prop.fw_opened && priv->warmup > 0) {
+    gst_tensor_filter_load_tensor_info (priv);
+    gst_tensor_filter_common_warmup (priv);
+  }
+
   return priv->prop.fw_opened;
 }
 
@@ -1515,6 +1858,7 @@ gst_tensor_filter_stop (GstBaseTransform * trans)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+  gst_tensor_filter_common_schedule_leave (priv);
   gst_tensor_filter_common_close_fw (priv);
   return TRUE;
 }
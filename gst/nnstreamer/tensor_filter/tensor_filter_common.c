@@ -23,7 +23,20 @@
  *
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE             /* sched_setaffinity () */
+#endif
+
 #include <string.h>
+#include <glib/gstdio.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
 
 #include <hw_accel.h>
 #include <nnstreamer_log.h>
@@ -97,6 +110,36 @@ static gint _gtfc_setprop_ACCELERATOR (GstTensorFilterPrivate * priv,
 G_LOCK_DEFINE_STATIC (shared_model_table);
 static GHashTable *shared_model_table = NULL;
 
+/**
+ * @brief Read-only mapping of the model file, shared in the process.
+ */
+struct _GstTensorFilterModelMap
+{
+  gchar *path; /**< the path of the model file, the key of the table */
+  GMappedFile *file; /**< the mapped file */
+  dev_t dev; /**< the device of the file, to check the file is not changed */
+  ino_t ino; /**< the inode of the file, to check the file is not changed */
+  gsize size; /**< the size of the file */
+  time_t mtime; /**< the last modification time of the file */
+  gint refcount; /**< the number of references, protected by the lock */
+};
+
+/**
+ * @brief mutex for the table of the mapped model files.
+ */
+G_LOCK_DEFINE_STATIC (model_map_table);
+static GHashTable *model_map_table = NULL;
+
+/**
+ * @brief mutex for the process-wide scheduler of tensor-filter instances.
+ */
+G_LOCK_DEFINE_STATIC (filter_scheduler);
+static GList *scheduled_filters = NULL;
+static gint64 sched_window_start = 0;
+
+#define SCHED_WINDOW_USEC (G_USEC_PER_SEC)
+#define SCHED_WEIGHT(s) MAX ((s)->priority, 1U)
+
 /**
  * @brief GstTensorFilter properties.
  */
@@ -126,6 +169,18 @@ enum
   PROP_OUTPUTCOMBINATION,
   PROP_SHARED_TENSOR_FILTER_KEY,
   PROP_LATENCY_REPORT,
+  PROP_WARMUP,
+  PROP_CACHE_DIR,
+  PROP_SCHED_PRIORITY,
+  PROP_DEADLINE,
+  PROP_SCHED_STATS,
+  PROP_CPU_AFFINITY,
+  PROP_NUMA_NODE,
+  PROP_THREAD_PRIORITY,
+  PROP_SHAPE_CACHE_SIZE,
+  PROP_SHAPE_BUCKETS,
+  PROP_SHAPE_CACHE_STATS,
+  PROP_RELOAD_STATS,
 };
 
 /**
@@ -794,6 +849,32 @@ gst_tensor_filter_allocate_in_invoke (GstTensorFilterPrivate * priv)
   return allocate_in_invoke;
 }
 
+/**
+ * @brief check if the framework allows in-place invoke (same memory for input and output)
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if allowed, FALSE otherwise
+ * @note allow_in_place was not used before, the sub-plugin should opt in with CHECK_IN_PLACE event.
+ */
+gboolean
+gst_tensor_filter_allow_in_place (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterFrameworkEventData data;
+  int allow_in_place = 0;
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    if (priv->fw->allow_in_place && priv->fw->handleEvent) {
+      data.private_data = priv->privateData;
+      allow_in_place = (priv->fw->handleEvent (CHECK_IN_PLACE, &data) == 0);
+    }
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    if (priv->info.allow_in_place)
+      allow_in_place = (priv->fw->eventHandler (priv->fw, &priv->prop,
+              priv->privateData, CHECK_IN_PLACE, NULL) == 0);
+  }
+
+  return (allow_in_place != 0);
+}
+
 /**
  * @brief Free the data allocated for tensor filter output
  * @param[in] priv Struct containing the properties of the object
@@ -1010,6 +1091,157 @@ gst_tensor_filter_install_properties (GObjectClass * gobject_class)
       g_param_spec_boolean ("latency-report", "Latency report",
           "Report to the pipeline the estimated tensor-filter element latency.",
           FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_WARMUP,
+      g_param_spec_uint ("warmup", "Warm-up invokes",
+          "The number of invokes with zero-filled input to run once the model "
+          "is opened, so that the first-invoke overhead of the framework "
+          "(e.g., delegate preparation, weight packing, network compile) "
+          "is paid before the stream starts. 0 to disable warm-up.",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CACHE_DIR,
+      g_param_spec_string ("cache-dir", "Model cache directory",
+          "Root directory where the sub-plugin persists compiled or packed "
+          "model artifacts, keyed by the model files and options, to reuse "
+          "them on the next start. Note that only a few subplugins support "
+          "this property.",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SCHED_PRIORITY,
+      g_param_spec_uint ("sched-priority", "Scheduling priority",
+          "The weight of this instance in the process-wide scheduler of "
+          "tensor-filters. When another instance of higher or equal priority "
+          "misses its deadline, this instance drops incoming frames if it uses "
+          "more invoke time than its share (weighted by this value). "
+          "0 to leave the scheduler unless 'deadline' is set.",
+          0, 100, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DEADLINE,
+      g_param_spec_uint ("deadline", "Per-frame deadline (msec)",
+          "The deadline of each frame from its running time in milliseconds. "
+          "A frame is dropped before invoke if the average invoke latency "
+          "cannot meet the deadline. 0 to disable.",
+          0, G_MAXINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SCHED_STATS,
+      g_param_spec_string ("sched-stats", "Scheduler statistics",
+          "The counters of the process-wide scheduler for this instance: "
+          "the number of invokes, frames dropped by deadline and by priority, "
+          "and invokes finished after the deadline.",
+          "", G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CPU_AFFINITY,
+      g_param_spec_string ("cpu-affinity", "CPU affinity",
+          "The CPUs to run the invoke of the model, as a CPU list "
+          "(e.g., '0-3,6') or the type of cores ('big' or 'little'). "
+          "The streaming thread is pinned to the CPUs, and the list is passed "
+          "to the sub-plugin to pin its worker threads.",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_NUMA_NODE,
+      g_param_spec_int ("numa-node", "NUMA node",
+          "The NUMA node to run the invoke of the model and to allocate "
+          "memory preferably. The CPUs are limited to the CPUs of the node. "
+          "-1 to disable.",
+          -1, G_MAXINT16, -1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_THREAD_PRIORITY,
+      g_param_spec_int ("thread-priority", "Thread priority",
+          "The nice value of the streaming thread to run the invoke of the "
+          "model (-20 for the highest priority to 19 for the lowest). "
+          "Note that a negative value requires the privilege. "
+          "0 to leave the priority unchanged.",
+          -20, 19, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SHAPE_CACHE_SIZE,
+      g_param_spec_uint ("shape-cache-size", "Shape cache size",
+          "The max number of prepared plans for the flexible input stream, "
+          "including the active one. When the shape of incoming tensors is "
+          "changed, the framework is re-configured with new shape. If this "
+          "is larger than 1, the framework instances configured with recent "
+          "shapes are kept, so that re-planning is not paid again when the "
+          "shape is repeated. Note that each plan holds its own instance of "
+          "the model.",
+          1, 64, 1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SHAPE_BUCKETS,
+      g_param_spec_string ("shape-buckets", "Shape buckets",
+          "The list of input shapes separated by ';' (e.g., "
+          "'1:16000;1:32000' or '3:224:224:1,1:1;3:448:448:1,1:1' for "
+          "multiple tensors). The flexible input is padded with zero to the "
+          "smallest bucket which can hold it, to limit the number of shapes "
+          "to be planned.",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SHAPE_CACHE_STATS,
+      g_param_spec_string ("shape-cache-stats", "Shape cache statistics",
+          "The counters of the plan cache for the flexible input stream: "
+          "shape changes served by the prepared plans (hits), shape changes "
+          "which required re-planning (misses), and buffers padded to "
+          "the shape bucket.",
+          "", G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_RELOAD_STATS,
+      g_param_spec_string ("reload-stats", "Reload statistics",
+          "The statistics of the model reloads of this instance: the number "
+          "of successful and failed reloads, and the total time the reloads "
+          "blocked the caller updating the model (usec). With the background "
+          "reload of the framework, a reload is counted when it is requested.",
+          "", G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+}
+
+/**
+ * @brief Free the shape buckets for the flexible input.
+ */
+static void
+gst_tensor_filter_free_shape_buckets (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterShapeCache *cache = &priv->shape_cache;
+  GList *list;
+
+  for (list = cache->buckets; list != NULL; list = list->next) {
+    gst_tensors_info_free ((GstTensorsInfo *) list->data);
+    g_free (list->data);
+  }
+
+  g_list_free (cache->buckets);
+  cache->buckets = NULL;
+
+  g_free (cache->buckets_str);
+  cache->buckets_str = NULL;
+}
+
+/**
+ * @brief Parse the shape buckets for the flexible input. (e.g., '1:16000;1:32000')
+ */
+static void
+gst_tensor_filter_parse_shape_buckets (GstTensorFilterPrivate * priv,
+    const gchar * str)
+{
+  GstTensorFilterShapeCache *cache = &priv->shape_cache;
+  GstTensorsInfo *bucket;
+  gchar **strv;
+  guint i, num;
+
+  gst_tensor_filter_free_shape_buckets (priv);
+
+  if (str == NULL || str[0] == '\0')
+    return;
+
+  strv = g_strsplit (str, ";", -1);
+  num = g_strv_length (strv);
+
+  for (i = 0; i < num; i++) {
+    g_strstrip (strv[i]);
+    if (strv[i][0] == '\0')
+      continue;
+
+    bucket = g_new0 (GstTensorsInfo, 1);
+    gst_tensors_info_init (bucket);
+    bucket->num_tensors =
+        gst_tensors_info_parse_dimensions_string (bucket, strv[i]);
+
+    if (bucket->num_tensors == 0) {
+      ml_logw ("Invalid shape bucket '%s', ignored.", strv[i]);
+      g_free (bucket);
+      continue;
+    }
+
+    cache->buckets = g_list_append (cache->buckets, bucket);
+  }
+
+  g_strfreev (strv);
+  cache->buckets_str = g_strdup (str);
 }
 
 /**
@@ -1031,6 +1263,10 @@ gst_tensor_filter_common_init_property (GstTensorFilterPrivate * priv)
 
   /* init internal properties */
   priv->silent = TRUE;
+  priv->sched.lateness = G_MININT64;
+  priv->prop.numa_node = -1;
+  priv->shape_cache.size = 1;
+  g_mutex_init (&priv->reload_stats.lock);
   gst_tensors_config_init (&priv->in_config);
   gst_tensors_config_init (&priv->out_config);
 }
@@ -1045,10 +1281,19 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
 
   prop = &priv->prop;
 
+  gst_tensor_filter_common_schedule_leave (priv);
+  gst_tensor_filter_common_clear_shape_cache (priv);
+  gst_tensor_filter_free_shape_buckets (priv);
+
   g_free_const (prop->fwname);
   g_free_const (prop->accl_str);
   g_free (prop->hw_list);
   g_free (prop->shared_tensor_filter_key);
+  g_free_const (prop->cache_path);
+  g_free (priv->cache_dir);
+  g_free_const (prop->cpu_affinity);
+  g_free (priv->cpu_affinity);
+  g_free (priv->cpu_placement);
 
   g_free_const (prop->custom_properties);
   g_strfreev_const (prop->model_files);
@@ -1058,6 +1303,7 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
 
   gst_tensors_config_free (&priv->in_config);
   gst_tensors_config_free (&priv->out_config);
+  g_mutex_clear (&priv->reload_stats.lock);
 
   g_list_free (priv->combi.in_combi);
   g_list_free (priv->combi.out_combi_i);
@@ -1195,6 +1441,180 @@ _detect_framework_from_config (const gchar * extension)
   return detected;
 }
 
+/**
+ * @brief The CPU placement of the streaming thread saved before invoke.
+ */
+typedef struct
+{
+#if defined(__linux__)
+  gboolean affinity_saved; /**< TRUE if the CPU affinity is changed */
+  cpu_set_t affinity; /**< the CPU affinity of the thread */
+
+  gboolean mempolicy_saved; /**< TRUE if the memory policy is changed */
+  int mempolicy; /**< the memory policy of the thread */
+  gulong nodemask; /**< the node mask of the memory policy */
+
+  gboolean priority_saved; /**< TRUE if the nice value is changed */
+  int priority; /**< the nice value of the thread */
+  gboolean priority_skipped; /**< TRUE if thread-priority is not applied because the nice value cannot be restored */
+#else
+  gboolean warned; /**< TRUE if the warning for the unsupported platform is printed */
+#endif
+} GstTensorFilterCpuPlacement;
+
+#if defined(__linux__)
+/**
+ * @brief Check whether the calling thread can set its nice value to the given value after raising it.
+ */
+static gboolean
+_gtfc_can_lower_nice (int nice)
+{
+  struct rlimit rlim;
+
+  if (geteuid () == 0)
+    return TRUE;
+
+  if (getrlimit (RLIMIT_NICE, &rlim) != 0)
+    return FALSE;
+
+  /* RLIMIT_NICE allows the nice value down to (20 - rlim_cur). */
+  return (rlim.rlim_cur == RLIM_INFINITY || 20 - (gint64) rlim.rlim_cur <= nice);
+}
+#endif
+
+/**
+ * @brief Apply the CPU placement (cpu-affinity, numa-node and thread-priority) to the calling thread before invoke.
+ * The previous placement of the thread is saved, and restored with gst_tensor_filter_common_restore_cpu_placement() after invoke.
+ */
+void
+gst_tensor_filter_common_apply_cpu_placement (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterCpuPlacement *saved;
+
+  if (prop->num_cpu_affinity == 0 && prop->numa_node < 0 &&
+      prop->thread_priority == 0)
+    return;
+
+  if (priv->cpu_placement == NULL)
+    priv->cpu_placement = g_new0 (GstTensorFilterCpuPlacement, 1);
+
+  saved = (GstTensorFilterCpuPlacement *) priv->cpu_placement;
+
+#if defined(__linux__)
+  saved->affinity_saved = saved->mempolicy_saved = saved->priority_saved = FALSE;
+
+  if (prop->num_cpu_affinity > 0) {
+    cpu_set_t set;
+    guint i;
+
+    CPU_ZERO (&set);
+    for (i = 0; i < prop->num_cpu_affinity; i++) {
+      if (prop->cpu_affinity[i] < CPU_SETSIZE)
+        CPU_SET (prop->cpu_affinity[i], &set);
+    }
+
+    if (sched_getaffinity (0, sizeof (saved->affinity), &saved->affinity) != 0)
+      ml_logw ("Failed to get the CPU affinity of the thread (errno %d).",
+          errno);
+    else if (sched_setaffinity (0, sizeof (set), &set) != 0)
+      ml_logw ("Failed to set the CPU affinity of the thread (errno %d).",
+          errno);
+    else
+      saved->affinity_saved = TRUE;
+  }
+
+#if defined(SYS_set_mempolicy) && defined(SYS_get_mempolicy)
+  if (prop->numa_node >= 0 && prop->numa_node < (gint) (sizeof (gulong) * 8)) {
+    gulong nodemask = 1UL << prop->numa_node;
+
+    /* MPOL_PREFERRED (1) in linux/mempolicy.h, allocate memory on the node if possible. */
+    if (syscall (SYS_get_mempolicy, &saved->mempolicy, &saved->nodemask,
+            sizeof (saved->nodemask) * 8, NULL, 0) != 0)
+      ml_logw ("Failed to get the memory policy of the thread (errno %d).",
+          errno);
+    else if (syscall (SYS_set_mempolicy, 1, &nodemask,
+            sizeof (nodemask) * 8) != 0)
+      ml_logw ("Failed to set the memory policy of the thread (errno %d).",
+          errno);
+    else
+      saved->mempolicy_saved = TRUE;
+  }
+#endif
+
+  if (prop->thread_priority != 0) {
+    id_t tid = (id_t) syscall (SYS_gettid);
+
+    /* getpriority() may return -1 as a valid nice value */
+    errno = 0;
+    saved->priority = getpriority (PRIO_PROCESS, tid);
+
+    if (saved->priority == -1 && errno != 0) {
+      ml_logw ("Failed to get the priority of the thread (errno %d).", errno);
+    } else if (prop->thread_priority > saved->priority &&
+        !_gtfc_can_lower_nice (saved->priority)) {
+      /* unprivileged thread cannot lower the nice value again */
+      if (!saved->priority_skipped)
+        ml_logw ("Cannot restore the priority of the thread after invoke, "
+            "thread-priority %d is ignored.", prop->thread_priority);
+      saved->priority_skipped = TRUE;
+    } else if (saved->priority != prop->thread_priority) {
+      if (setpriority (PRIO_PROCESS, tid, prop->thread_priority) != 0)
+        ml_logw ("Failed to set the priority of the thread (errno %d).",
+            errno);
+      else
+        saved->priority_saved = TRUE;
+    }
+  }
+#else
+  if (!saved->warned)
+    ml_logw ("The CPU placement of tensor-filter is not supported on this platform.");
+  saved->warned = TRUE;
+#endif
+}
+
+/**
+ * @brief Restore the CPU placement of the calling thread saved by gst_tensor_filter_common_apply_cpu_placement(), so that the other elements sharing the streaming thread are not affected.
+ */
+void
+gst_tensor_filter_common_restore_cpu_placement (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterCpuPlacement *saved;
+
+  saved = (GstTensorFilterCpuPlacement *) priv->cpu_placement;
+  if (saved == NULL)
+    return;
+
+#if defined(__linux__)
+  if (saved->priority_saved) {
+    id_t tid = (id_t) syscall (SYS_gettid);
+
+    if (setpriority (PRIO_PROCESS, tid, saved->priority) != 0)
+      ml_logw ("Failed to restore the priority of the thread (errno %d).",
+          errno);
+  }
+
+#if defined(SYS_set_mempolicy)
+  if (saved->mempolicy_saved) {
+    /* MPOL_DEFAULT (0) does not take the node mask. */
+    if (syscall (SYS_set_mempolicy, saved->mempolicy,
+            (saved->mempolicy == 0) ? NULL : &saved->nodemask,
+            (saved->mempolicy == 0) ? 0 : sizeof (saved->nodemask) * 8) != 0)
+      ml_logw ("Failed to restore the memory policy of the thread (errno %d).",
+          errno);
+  }
+#endif
+
+  if (saved->affinity_saved) {
+    if (sched_setaffinity (0, sizeof (saved->affinity), &saved->affinity) != 0)
+      ml_logw ("Failed to restore the CPU affinity of the thread (errno %d).",
+          errno);
+  }
+
+  saved->affinity_saved = saved->mempolicy_saved = saved->priority_saved = FALSE;
+#endif
+}
+
 /**
  * @brief Get neural network framework name from given model file. This does not guarantee the framework is available on the target device.
  * @param[in] model_files the prediction model paths
@@ -1265,6 +1685,8 @@ gst_tensor_filter_detect_framework (const gchar * const *model_files,
       detected_fw = g_strdup ("openvino");
     else if (g_str_equal (ext[0], ".tvn"))
       detected_fw = g_strdup ("trix-engine");
+    else if (g_str_equal (ext[0], ".onnx"))
+      detected_fw = g_strdup ("onnxruntime");
   } else if (num_models == 2) {
     if (g_str_equal (ext[0], ".pb") && g_str_equal (ext[1], ".pb") &&
         !g_str_equal (model_files[0], model_files[1]))
@@ -1432,6 +1854,8 @@ _gtfc_setprop_MODEL (GstTensorFilterPrivate * priv,
    * has responsibility for the verification of the path regardless of priv->fw->verify_model_path.
    */
   if (prop->fw_opened) {
+    gint64 start_time = g_get_monotonic_time ();
+
     if (GST_TF_FW_V0 (priv->fw) && priv->is_updatable) {
       if (priv->fw->reloadModel &&
           priv->fw->reloadModel (prop, &priv->privateData) != 0) {
@@ -1448,8 +1872,20 @@ _gtfc_setprop_MODEL (GstTensorFilterPrivate * priv,
       }
     }
 
+    if (priv->is_updatable) {
+      g_mutex_lock (&priv->reload_stats.lock);
+      if (status == 0)
+        priv->reload_stats.num++;
+      else
+        priv->reload_stats.failed++;
+      priv->reload_stats.latency += g_get_monotonic_time () - start_time;
+      g_mutex_unlock (&priv->reload_stats.lock);
+    }
+
     if (status == 0) {
       g_strfreev_const (_prop.model_files);
+      /* the prepared plans hold the old model */
+      gst_tensor_filter_common_clear_shape_cache (priv);
     } else {
       ml_loge ("Fail to reload model\n");
       g_strfreev_const (prop->model_files);
@@ -1902,6 +2338,144 @@ _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (GstTensorFilterProperties * prop,
   return 0;
 }
 
+/**
+ * @brief Get the CPUs of the highest (big) or lowest (little) capacity.
+ */
+static GArray *
+gst_tensor_filter_get_cpus_by_capacity (gboolean big)
+{
+  GArray *cores, *cpus;
+  guint i, capacity;
+
+  cores = cpu_get_topology ();
+  if (cores == NULL)
+    return NULL;
+
+  capacity = big ? 0 : G_MAXUINT;
+  for (i = 0; i < cores->len; i++) {
+    cpu_core_info *info = &g_array_index (cores, cpu_core_info, i);
+
+    capacity = big ? MAX (capacity, info->capacity) :
+        MIN (capacity, info->capacity);
+  }
+
+  cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+  for (i = 0; i < cores->len; i++) {
+    cpu_core_info *info = &g_array_index (cores, cpu_core_info, i);
+
+    if (info->capacity == capacity)
+      g_array_append_val (cpus, info->id);
+  }
+
+  g_array_free (cores, TRUE);
+  return cpus;
+}
+
+/**
+ * @brief Remove the CPUs which are not online from the list. The list is kept if the topology is unknown.
+ */
+static void
+gst_tensor_filter_remove_offline_cpus (GArray * cpus)
+{
+  GArray *cores;
+  guint i, j;
+
+  cores = cpu_get_topology ();
+  if (cores == NULL)
+    return;
+
+  for (i = 0; i < cpus->len;) {
+    guint cpu = g_array_index (cpus, guint, i);
+
+    for (j = 0; j < cores->len; j++) {
+      if (g_array_index (cores, cpu_core_info, j).id == cpu)
+        break;
+    }
+
+    if (j < cores->len) {
+      i++;
+    } else {
+      ml_logw ("CPU %u is not available, it is ignored.", cpu);
+      g_array_remove_index (cpus, i);
+    }
+  }
+
+  g_array_free (cores, TRUE);
+}
+
+/**
+ * @brief Resolve the CPUs to run the invoke from 'cpu-affinity' and 'numa-node' properties.
+ */
+static void
+gst_tensor_filter_update_cpu_affinity (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop = &priv->prop;
+  GArray *cpus = NULL;
+  GArray *node_cpus;
+  guint i, j;
+
+  g_free_const (prop->cpu_affinity);
+  prop->cpu_affinity = NULL;
+  prop->num_cpu_affinity = 0;
+
+  if (priv->cpu_affinity && priv->cpu_affinity[0] != '\0') {
+    if (g_ascii_strcasecmp (priv->cpu_affinity, "big") == 0) {
+      cpus = gst_tensor_filter_get_cpus_by_capacity (TRUE);
+    } else if (g_ascii_strcasecmp (priv->cpu_affinity, "little") == 0) {
+      cpus = gst_tensor_filter_get_cpus_by_capacity (FALSE);
+    } else {
+      cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+
+      if (!cpu_parse_list (priv->cpu_affinity, cpus)) {
+        ml_logw ("Invalid CPU list '%s' for cpu-affinity, it is ignored.",
+            priv->cpu_affinity);
+        g_array_free (cpus, TRUE);
+        cpus = NULL;
+      } else {
+        gst_tensor_filter_remove_offline_cpus (cpus);
+      }
+    }
+  }
+
+  if (prop->numa_node >= 0) {
+    node_cpus = cpu_get_node_cpus (prop->numa_node);
+
+    if (node_cpus == NULL) {
+      ml_logw ("Cannot find the CPUs of NUMA node %d.", prop->numa_node);
+    } else if (cpus == NULL) {
+      cpus = node_cpus;
+    } else {
+      /* limit the CPUs to the node */
+      for (i = 0; i < cpus->len;) {
+        guint cpu = g_array_index (cpus, guint, i);
+
+        for (j = 0; j < node_cpus->len; j++) {
+          if (g_array_index (node_cpus, guint, j) == cpu)
+            break;
+        }
+
+        if (j < node_cpus->len)
+          i++;
+        else
+          g_array_remove_index (cpus, i);
+      }
+
+      g_array_free (node_cpus, TRUE);
+    }
+  }
+
+  if (cpus) {
+    if (cpus->len > 0) {
+      prop->num_cpu_affinity = cpus->len;
+      prop->cpu_affinity = (const unsigned int *) g_array_free (cpus, FALSE);
+    } else {
+      ml_logw ("No CPU is available with cpu-affinity '%s' and numa-node %d.",
+          priv->cpu_affinity, prop->numa_node);
+      g_array_free (cpus, TRUE);
+    }
+  }
+}
+
 /**
  * @brief Set the properties for tensor_filter
  * @param[in] priv Struct containing the properties of the object
@@ -1985,6 +2559,37 @@ gst_tensor_filter_common_set_property (GstTensorFilterPrivate * priv,
     case PROP_LATENCY_REPORT:
       priv->latency_reporting = g_value_get_boolean (value);
       break;
+    case PROP_WARMUP:
+      priv->warmup = g_value_get_uint (value);
+      break;
+    case PROP_CACHE_DIR:
+      g_free (priv->cache_dir);
+      priv->cache_dir = g_value_dup_string (value);
+      break;
+    case PROP_SCHED_PRIORITY:
+      priv->sched.priority = g_value_get_uint (value);
+      break;
+    case PROP_DEADLINE:
+      priv->sched.deadline = g_value_get_uint (value);
+      break;
+    case PROP_CPU_AFFINITY:
+      g_free (priv->cpu_affinity);
+      priv->cpu_affinity = g_value_dup_string (value);
+      gst_tensor_filter_update_cpu_affinity (priv);
+      break;
+    case PROP_NUMA_NODE:
+      prop->numa_node = g_value_get_int (value);
+      gst_tensor_filter_update_cpu_affinity (priv);
+      break;
+    case PROP_THREAD_PRIORITY:
+      prop->thread_priority = g_value_get_int (value);
+      break;
+    case PROP_SHAPE_CACHE_SIZE:
+      priv->shape_cache.size = g_value_get_uint (value);
+      break;
+    case PROP_SHAPE_BUCKETS:
+      gst_tensor_filter_parse_shape_buckets (priv, g_value_get_string (value));
+      break;
     default:
       return FALSE;
   }
@@ -2190,6 +2795,61 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
     case PROP_LATENCY_REPORT:
       g_value_set_boolean (value, priv->latency_reporting);
       break;
+    case PROP_WARMUP:
+      g_value_set_uint (value, priv->warmup);
+      break;
+    case PROP_CACHE_DIR:
+      g_value_set_string (value, priv->cache_dir ? priv->cache_dir : "");
+      break;
+    case PROP_SCHED_PRIORITY:
+      g_value_set_uint (value, priv->sched.priority);
+      break;
+    case PROP_DEADLINE:
+      g_value_set_uint (value, priv->sched.deadline);
+      break;
+    case PROP_SCHED_STATS:
+      G_LOCK (filter_scheduler);
+      strval = g_strdup_printf ("invoked=%" G_GUINT64_FORMAT
+          ",deadline-drops=%" G_GUINT64_FORMAT
+          ",budget-drops=%" G_GUINT64_FORMAT
+          ",deadline-misses=%" G_GUINT64_FORMAT, priv->sched.invoked,
+          priv->sched.deadline_drops, priv->sched.budget_drops,
+          priv->sched.deadline_misses);
+      G_UNLOCK (filter_scheduler);
+      g_value_take_string (value, strval);
+      break;
+    case PROP_CPU_AFFINITY:
+      g_value_set_string (value, priv->cpu_affinity ? priv->cpu_affinity : "");
+      break;
+    case PROP_NUMA_NODE:
+      g_value_set_int (value, prop->numa_node);
+      break;
+    case PROP_THREAD_PRIORITY:
+      g_value_set_int (value, prop->thread_priority);
+      break;
+    case PROP_SHAPE_CACHE_SIZE:
+      g_value_set_uint (value, priv->shape_cache.size);
+      break;
+    case PROP_SHAPE_BUCKETS:
+      g_value_set_string (value,
+          priv->shape_cache.buckets_str ? priv->shape_cache.buckets_str : "");
+      break;
+    case PROP_SHAPE_CACHE_STATS:
+      strval = g_strdup_printf ("hits=%" G_GUINT64_FORMAT
+          ",misses=%" G_GUINT64_FORMAT ",padded=%" G_GUINT64_FORMAT,
+          priv->shape_cache.hits, priv->shape_cache.misses,
+          priv->shape_cache.padded);
+      g_value_take_string (value, strval);
+      break;
+    case PROP_RELOAD_STATS:
+      g_mutex_lock (&priv->reload_stats.lock);
+      strval = g_strdup_printf ("reloads=%" G_GINT64_FORMAT
+          ",failed=%" G_GINT64_FORMAT ",latency=%" G_GINT64_FORMAT,
+          priv->reload_stats.num, priv->reload_stats.failed,
+          priv->reload_stats.latency);
+      g_mutex_unlock (&priv->reload_stats.lock);
+      g_value_take_string (value, strval);
+      break;
     default:
       /* unknown property */
       return FALSE;
@@ -2334,42 +2994,255 @@ gst_tensor_filter_common_get_out_info (GstTensorFilterPrivate * priv,
 }
 
 /**
- * @brief Load tensor info from NN model.
- * (both input and output tensor)
+ * @brief Find the smallest shape bucket which can hold the given input tensors.
  */
-void
-gst_tensor_filter_load_tensor_info (GstTensorFilterPrivate * priv)
+gboolean
+gst_tensor_filter_common_get_shape_bucket (GstTensorFilterPrivate * priv,
+    const GstTensorsInfo * in, GstTensorsInfo * bucket)
 {
-  GstTensorFilterProperties *prop;
-  GstTensorsInfo in_info, out_info;
-  int res_in = -1, res_out = -1;
+  GstTensorsInfo *found = NULL;
+  GList *list;
+  gulong count, min_count = 0;
+  guint i, d;
 
-  prop = &priv->prop;
+  g_return_val_if_fail (in != NULL, FALSE);
+  g_return_val_if_fail (bucket != NULL, FALSE);
 
-  gst_tensors_info_init (&in_info);
-  gst_tensors_info_init (&out_info);
+  for (list = priv->shape_cache.buckets; list != NULL; list = list->next) {
+    GstTensorsInfo *b = (GstTensorsInfo *) list->data;
 
-  if (GST_TF_FW_V1 (priv->fw)) {
-    if (!prop->input_configured || !prop->output_configured) {
-      gst_tensor_filter_v1_call (priv, res_in, getModelInfo, GET_IN_OUT_INFO,
-          &in_info, &out_info);
-      res_out = res_in;
+    if (b->num_tensors != in->num_tensors)
+      continue;
+
+    count = 0;
+    for (i = 0; i < in->num_tensors; i++) {
+      for (d = 0; d < NNS_TENSOR_RANK_LIMIT; d++) {
+        if (b->info[i].dimension[d] < in->info[i].dimension[d])
+          break;
+      }
+
+      if (d < NNS_TENSOR_RANK_LIMIT)
+        break;
+
+      count += gst_tensor_get_element_count (b->info[i].dimension);
+    }
+
+    if (i < in->num_tensors)
+      continue;
+
+    if (found == NULL || count < min_count) {
+      found = b;
+      min_count = count;
     }
-  } else {
-    if (!prop->input_configured)
-      gst_tensor_filter_v0_call (priv, res_in, getInputDimension, &in_info);
-    if (!prop->output_configured)
-      gst_tensor_filter_v0_call (priv, res_out, getOutputDimension, &out_info);
   }
 
-  /* supposed fixed in-tensor info if getInputDimension was success. */
-  if (!prop->input_configured && res_in == 0) {
-    g_assert (in_info.num_tensors > 0);
+  if (found == NULL)
+    return FALSE;
 
-    /** if set-property called and already has info, verify it! */
-    if (prop->input_meta.num_tensors > 0) {
-      if (!gst_tensors_info_is_equal (&in_info, &prop->input_meta)) {
-        gchar *cmpstr =
+  gst_tensors_info_copy (bucket, in);
+  for (i = 0; i < in->num_tensors; i++) {
+    for (d = 0; d < NNS_TENSOR_RANK_LIMIT; d++)
+      bucket->info[i].dimension[d] = found->info[i].dimension[d];
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Set the input info to the given instance of the framework.
+ */
+static gint
+_gtfc_shape_set_input_info (GstTensorFilterPrivate * priv,
+    void **private_data, const GstTensorsInfo * in, GstTensorsInfo * out)
+{
+  gint status = -ENOENT;
+
+  gst_tensors_info_init (out);
+
+  if (GST_TF_FW_V0 (priv->fw)) {
+    if (priv->fw->setInputDimension)
+      status = priv->fw->setInputDimension (&priv->prop, private_data, in, out);
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    status = priv->fw->getModelInfo (priv->fw, &priv->prop, *private_data,
+        SET_INPUT_INFO, (GstTensorsInfo *) in, out);
+  }
+
+  return status;
+}
+
+/**
+ * @brief Close the framework instance of the plan and free it.
+ */
+static void
+_gtfc_shape_free_plan (GstTensorFilterPrivate * priv,
+    GstTensorFilterShapePlan * plan)
+{
+  if (plan->privateData && priv->fw && priv->fw->close)
+    priv->fw->close (&priv->prop, &plan->privateData);
+
+  gst_tensors_info_free (&plan->in_info);
+  gst_tensors_info_free (&plan->out_info);
+  g_free (plan);
+}
+
+/**
+ * @brief Prepare the framework for the new input shape, using the plan cache.
+ */
+gboolean
+gst_tensor_filter_common_update_shape (GstTensorFilterPrivate * priv,
+    const GstTensorsInfo * in)
+{
+  GstTensorFilterShapeCache *cache = &priv->shape_cache;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterShapePlan *plan = NULL;
+  GstTensorsInfo out, tmp;
+  GList *list;
+  void *private_data;
+
+  g_return_val_if_fail (in != NULL, FALSE);
+
+  if (G_UNLIKELY (!priv->fw || !prop->fw_opened))
+    return FALSE;
+
+  for (list = cache->plans; list != NULL; list = list->next) {
+    GstTensorFilterShapePlan *p = (GstTensorFilterShapePlan *) list->data;
+
+    if (gst_tensors_info_is_equal (&p->in_info, in)) {
+      plan = p;
+      cache->plans = g_list_delete_link (cache->plans, list);
+      break;
+    }
+  }
+
+  if (plan) {
+    cache->hits++;
+  } else {
+    cache->misses++;
+
+    /**
+     * The instances cannot be duplicated if the model representation is shared with other filters.
+     * Re-plan the active instance in this case.
+     */
+    if (cache->size <= 1 || prop->shared_tensor_filter_key || !priv->fw->open) {
+      if (_gtfc_shape_set_input_info (priv, &priv->privateData, in, &out) != 0) {
+        ml_loge ("Failed to set the input shape to the framework %s.",
+            prop->fwname);
+        gst_tensors_info_free (&out);
+        return FALSE;
+      }
+
+      gst_tensors_info_free (&prop->input_meta);
+      gst_tensors_info_copy (&prop->input_meta, in);
+      gst_tensors_info_free (&prop->output_meta);
+      gst_tensors_info_copy (&prop->output_meta, &out);
+      gst_tensors_info_free (&out);
+      return TRUE;
+    }
+
+    if (g_list_length (cache->plans) + 1 >= cache->size) {
+      /* evict the least recently used plan and re-plan its instance */
+      list = g_list_last (cache->plans);
+      plan = (GstTensorFilterShapePlan *) list->data;
+      cache->plans = g_list_delete_link (cache->plans, list);
+    } else {
+      plan = g_new0 (GstTensorFilterShapePlan, 1);
+      gst_tensors_info_init (&plan->in_info);
+      gst_tensors_info_init (&plan->out_info);
+
+      if (priv->fw->open (prop, &plan->privateData) < 0) {
+        ml_loge ("Failed to open new instance of the framework %s.",
+            prop->fwname);
+        plan->privateData = NULL;
+        _gtfc_shape_free_plan (priv, plan);
+        return FALSE;
+      }
+    }
+
+    if (_gtfc_shape_set_input_info (priv, &plan->privateData, in, &out) != 0) {
+      ml_loge ("Failed to set the input shape to the framework %s.",
+          prop->fwname);
+      gst_tensors_info_free (&out);
+      _gtfc_shape_free_plan (priv, plan);
+      return FALSE;
+    }
+
+    gst_tensors_info_free (&plan->in_info);
+    gst_tensors_info_copy (&plan->in_info, in);
+    gst_tensors_info_free (&plan->out_info);
+    gst_tensors_info_copy (&plan->out_info, &out);
+    gst_tensors_info_free (&out);
+  }
+
+  /* swap the active instance with the plan, the active one is kept as the most recently used plan */
+  private_data = priv->privateData;
+  priv->privateData = plan->privateData;
+  plan->privateData = private_data;
+
+  tmp = prop->input_meta;
+  prop->input_meta = plan->in_info;
+  plan->in_info = tmp;
+
+  tmp = prop->output_meta;
+  prop->output_meta = plan->out_info;
+  plan->out_info = tmp;
+
+  cache->plans = g_list_prepend (cache->plans, plan);
+  return TRUE;
+}
+
+/**
+ * @brief Close the framework instances of the prepared plans.
+ */
+void
+gst_tensor_filter_common_clear_shape_cache (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterShapeCache *cache = &priv->shape_cache;
+  GList *list;
+
+  for (list = cache->plans; list != NULL; list = list->next)
+    _gtfc_shape_free_plan (priv, (GstTensorFilterShapePlan *) list->data);
+
+  g_list_free (cache->plans);
+  cache->plans = NULL;
+}
+
+/**
+ * @brief Load tensor info from NN model.
+ * (both input and output tensor)
+ */
+void
+gst_tensor_filter_load_tensor_info (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop;
+  GstTensorsInfo in_info, out_info;
+  int res_in = -1, res_out = -1;
+
+  prop = &priv->prop;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  if (GST_TF_FW_V1 (priv->fw)) {
+    if (!prop->input_configured || !prop->output_configured) {
+      gst_tensor_filter_v1_call (priv, res_in, getModelInfo, GET_IN_OUT_INFO,
+          &in_info, &out_info);
+      res_out = res_in;
+    }
+  } else {
+    if (!prop->input_configured)
+      gst_tensor_filter_v0_call (priv, res_in, getInputDimension, &in_info);
+    if (!prop->output_configured)
+      gst_tensor_filter_v0_call (priv, res_out, getOutputDimension, &out_info);
+  }
+
+  /* supposed fixed in-tensor info if getInputDimension was success. */
+  if (!prop->input_configured && res_in == 0) {
+    g_assert (in_info.num_tensors > 0);
+
+    /** if set-property called and already has info, verify it! */
+    if (prop->input_meta.num_tensors > 0) {
+      if (!gst_tensors_info_is_equal (&in_info, &prop->input_meta)) {
+        gchar *cmpstr =
             gst_tensorsinfo_compare_to_string (&in_info, &prop->input_meta);
         ml_loge
             ("The input tensor is not compatible with the configuration of the model or tensor-filter property. The two tensor meta (GstTensorsInfo) are not compatible: %s\n",
@@ -2413,6 +3286,83 @@ done:
   gst_tensors_info_free (&out_info);
 }
 
+/**
+ * @brief Get the key of model cache from the model files and options.
+ * @note The size and modified time of the model files are used instead of the contents, to avoid reading whole model files at every start.
+ * @return Newly allocated string of the key. Caller should free the value.
+ */
+static gchar *
+gst_tensor_filter_get_cache_key (const GstTensorFilterProperties * prop)
+{
+  GChecksum *checksum;
+  GStatBuf st;
+  gchar *key;
+  gint i;
+
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+
+  if (prop->fwname)
+    g_checksum_update (checksum, (const guchar *) prop->fwname, -1);
+
+  for (i = 0; i < prop->num_models; i++) {
+    const gchar *model = prop->model_files[i];
+
+    if (model == NULL)
+      continue;
+
+    g_checksum_update (checksum, (const guchar *) model, -1);
+    if (g_stat (model, &st) == 0) {
+      g_checksum_update (checksum, (const guchar *) &st.st_size,
+          sizeof (st.st_size));
+      g_checksum_update (checksum, (const guchar *) &st.st_mtime,
+          sizeof (st.st_mtime));
+    }
+  }
+
+  if (prop->custom_properties)
+    g_checksum_update (checksum, (const guchar *) prop->custom_properties, -1);
+  if (prop->accl_str)
+    g_checksum_update (checksum, (const guchar *) prop->accl_str, -1);
+  if (prop->num_hw > 0)
+    g_checksum_update (checksum, (const guchar *) prop->hw_list,
+        sizeof (accl_hw) * prop->num_hw);
+
+  key = g_strdup (g_checksum_get_string (checksum));
+  g_checksum_free (checksum);
+
+  return key;
+}
+
+/**
+ * @brief Update the model cache path for the sub-plugin.
+ */
+static void
+gst_tensor_filter_update_cache_path (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop = &priv->prop;
+  gchar *key, *path;
+
+  g_free_const (prop->cache_path);
+  prop->cache_path = NULL;
+
+  if (priv->cache_dir == NULL || priv->cache_dir[0] == '\0')
+    return;
+
+  key = gst_tensor_filter_get_cache_key (prop);
+  path = g_build_filename (priv->cache_dir,
+      prop->fwname ? prop->fwname : "unknown", key, NULL);
+  g_free (key);
+
+  if (g_mkdir_with_parents (path, 0700) != 0) {
+    ml_logw ("Failed to create the model cache directory %s, "
+        "the model cache is disabled.", path);
+    g_free (path);
+    return;
+  }
+
+  prop->cache_path = path;
+}
+
 /**
  * @brief Open NN framework.
  */
@@ -2439,6 +3389,7 @@ gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
       }
       /* 0 if successfully loaded. 1 if skipped (already loaded). */
       if (verify_model_path (priv)) {
+        gst_tensor_filter_update_cache_path (priv);
         if (priv->fw->open (&priv->prop, &priv->privateData) >= 0)
           priv->prop.fw_opened = TRUE;
       }
@@ -2473,6 +3424,8 @@ void
 gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv)
 {
   if (priv->prop.fw_opened) {
+    gst_tensor_filter_common_clear_shape_cache (priv);
+
     if (priv->fw && priv->fw->close) {
       priv->fw->close (&priv->prop, &priv->privateData);
     }
@@ -2480,9 +3433,96 @@ gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv)
     priv->prop.fw_opened = FALSE;
     g_free_const (priv->prop.fwname);
     priv->prop.fwname = NULL;
+    g_free_const (priv->prop.cache_path);
+    priv->prop.cache_path = NULL;
     priv->fw = NULL;
     priv->privateData = NULL;
     priv->configured = FALSE;
+    priv->warmed_up = FALSE;
+  }
+}
+
+/**
+ * @brief Run warm-up invokes of NN framework with zero-filled input.
+ * @note This does nothing if the tensor info of the model is not configured yet.
+ */
+void
+gst_tensor_filter_common_warmup (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT] = { {0} };
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT] = { {0} };
+  gboolean allocate_in_invoke;
+  gint64 start_time, end_time;
+  guint i, n;
+  gint ret = 0;
+
+  if (priv->warmup == 0 || priv->warmed_up)
+    return;
+
+  if (!prop->fw_opened || !prop->input_configured || !prop->output_configured)
+    return;
+
+  /* warm-up is done once for the opened framework, even if it fails. */
+  priv->warmed_up = TRUE;
+
+  if (!gst_tensors_info_validate (&prop->input_meta) ||
+      !gst_tensors_info_validate (&prop->output_meta)) {
+    ml_logw ("The tensor info of the model is not fixed, skip warm-up.");
+    return;
+  }
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    in_tensors[i].size = gst_tensor_info_get_size (&prop->input_meta.info[i]);
+    in_tensors[i].data = g_try_malloc0 (in_tensors[i].size);
+    if (in_tensors[i].data == NULL) {
+      ml_loge ("Failed to allocate the input tensor for warm-up.");
+      goto done;
+    }
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    out_tensors[i].size = gst_tensor_info_get_size (&prop->output_meta.info[i]);
+    if (!allocate_in_invoke) {
+      out_tensors[i].data = g_try_malloc (out_tensors[i].size);
+      if (out_tensors[i].data == NULL) {
+        ml_loge ("Failed to allocate the output tensor for warm-up.");
+        goto done;
+      }
+    }
+  }
+
+  start_time = g_get_monotonic_time ();
+
+  for (n = 0; n < priv->warmup; n++) {
+    GST_TF_FW_INVOKE_COMPAT (priv, ret, in_tensors, out_tensors);
+
+    if (allocate_in_invoke && ret == 0) {
+      for (i = 0; i < prop->output_meta.num_tensors; i++) {
+        gst_tensor_filter_destroy_notify_util (priv, out_tensors[i].data);
+        out_tensors[i].data = NULL;
+      }
+    }
+
+    if (ret < 0) {
+      ml_logw ("Failed to invoke the model for warm-up (%d).", ret);
+      break;
+    }
+  }
+
+  end_time = g_get_monotonic_time ();
+  ml_logi ("Filter %s warm-up with %u invokes took %" G_GINT64_FORMAT " us",
+      prop->fwname ? prop->fwname : "(null)", n, end_time - start_time);
+
+done:
+  for (i = 0; i < prop->input_meta.num_tensors; i++)
+    g_free (in_tensors[i].data);
+
+  if (!allocate_in_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++)
+      g_free (out_tensors[i].data);
   }
 }
 
@@ -2634,7 +3674,8 @@ add_basic_supported_accelerators (const gchar ** supported_accelerators)
  * @brief Filter accelerators based on the runtime system
  * @note returned array must be freed by the caller
  * @details This filters out NEON accelerator if the system running the
- * tensor_filter does not support NEON instructions
+ * tensor_filter does not support NEON instructions, and SIMD accelerator if
+ * no SIMD feature of the CPU is detected.
  */
 static const gchar **
 filter_supported_accelerators (const gchar ** supported_accelerators)
@@ -2642,6 +3683,7 @@ filter_supported_accelerators (const gchar ** supported_accelerators)
   gint num_hw = 0, idx = 0;
   const gchar **accl_support;
   gint neon_available = cpu_neon_accel_available ();
+  guint cpu_features = cpu_get_features ();
 
   /** Count number of elements for the array */
   while (supported_accelerators[num_hw] != NULL) {
@@ -2658,6 +3700,10 @@ filter_supported_accelerators (const gchar ** supported_accelerators)
     if (g_ascii_strncasecmp (supported_accelerators[idx], ACCL_CPU_NEON_STR,
             strlen (ACCL_CPU_NEON_STR)) == 0 && neon_available != 0) {
       ml_logw ("Neon instructions are not available on this device.");
+    } else if (g_ascii_strncasecmp (supported_accelerators[idx],
+            ACCL_CPU_SIMD_STR, strlen (ACCL_CPU_SIMD_STR)) == 0 &&
+        cpu_features == CPU_FEATURE_NONE) {
+      ml_logw ("SIMD instructions are not available on this device.");
     } else {
       accl_support[num_hw] = supported_accelerators[idx];
       num_hw += 1;
@@ -2862,6 +3908,9 @@ gst_tensor_filter_check_hw_availability (const gchar * name, const accl_hw hw,
   /** Only check for specific HW, DEFAULT/AUTO are always supported */
   if (hw == ACCL_AUTO || hw == ACCL_DEFAULT) {
     available = TRUE;
+  } else if (hw == ACCL_CPU_SIMD && cpu_get_features () == CPU_FEATURE_NONE) {
+    /* SIMD is available only if the CPU has any SIMD feature */
+    available = FALSE;
   } else if (GST_TF_FW_V0 (fw)) {
     if (fw->checkAvailability && fw->checkAvailability (hw) == 0)
       available = TRUE;
@@ -3074,3 +4123,309 @@ nnstreamer_filter_shared_model_replace (void *instance, const char *key,
   }
   G_UNLOCK (shared_model_table);
 }
+
+/**
+ * @brief Prefault the pages of the mapped model.
+ */
+static void
+_gtfc_model_map_populate (const gchar * data, gsize size)
+{
+  gsize offset, page;
+  volatile gchar sum = 0;
+
+#if defined(__linux__) && defined(MADV_POPULATE_READ)
+  if (madvise ((void *) data, size, MADV_POPULATE_READ) == 0)
+    return;
+#endif
+
+#if defined(__linux__)
+  page = (gsize) sysconf (_SC_PAGESIZE);
+#else
+  page = 4096;
+#endif
+  if (page == 0)
+    page = 4096;
+
+  /* read one byte in each page */
+  for (offset = 0; offset < size; offset += page)
+    sum += data[offset];
+  sum += data[size - 1];
+  (void) sum;
+}
+
+/**
+ * @brief Map the model file into memory (read-only, shared).
+ */
+GstTensorFilterModelMap *
+nnstreamer_filter_model_map (const char *path, int flags)
+{
+  GstTensorFilterModelMap *model = NULL;
+  GStatBuf st;
+  GError *err = NULL;
+
+  if (!path || g_stat (path, &st) != 0 || !S_ISREG (st.st_mode)) {
+    ml_loge ("Cannot map the model, the file %s is invalid.", GST_STR_NULL (path));
+    return NULL;
+  }
+
+  if (st.st_size <= 0) {
+    ml_loge ("Cannot map the model, the file %s is empty.", path);
+    return NULL;
+  }
+
+  G_LOCK (model_map_table);
+  if (!model_map_table) {
+    model_map_table = g_hash_table_new (g_str_hash, g_str_equal);
+  }
+
+  /* reuse the mapping if the file is not changed */
+  model = g_hash_table_lookup (model_map_table, path);
+  if (model && model->dev == st.st_dev && model->ino == st.st_ino &&
+      model->size == (gsize) st.st_size && model->mtime == st.st_mtime) {
+    model->refcount++;
+    goto done;
+  }
+
+  model = g_new0 (GstTensorFilterModelMap, 1);
+  model->file = g_mapped_file_new (path, FALSE, &err);
+  if (!model->file) {
+    ml_loge ("Failed to map the model %s: %s", path,
+        err ? err->message : "unknown reason");
+    g_clear_error (&err);
+    g_free (model);
+    model = NULL;
+    goto done;
+  }
+
+  model->path = g_strdup (path);
+  model->dev = st.st_dev;
+  model->ino = st.st_ino;
+  model->size = g_mapped_file_get_length (model->file);
+  model->mtime = st.st_mtime;
+  model->refcount = 1;
+
+  /* the old mapping (modified file) is released when its references are released */
+  g_hash_table_replace (model_map_table, model->path, model);
+
+#if defined(__linux__)
+  if (flags & (NNS_MODEL_MAP_WILLNEED | NNS_MODEL_MAP_POPULATE)) {
+    if (madvise (g_mapped_file_get_contents (model->file), model->size,
+            MADV_WILLNEED) != 0)
+      ml_logw ("Failed to set the read-ahead hint of the model %s.", path);
+  }
+#endif
+
+  if (flags & NNS_MODEL_MAP_POPULATE)
+    _gtfc_model_map_populate (g_mapped_file_get_contents (model->file),
+        model->size);
+
+done:
+  G_UNLOCK (model_map_table);
+  return model;
+}
+
+/**
+ * @brief Get the data of the mapped model.
+ */
+const void *
+nnstreamer_filter_model_map_get_data (GstTensorFilterModelMap * model,
+    size_t *size)
+{
+  if (!model || !model->file)
+    return NULL;
+
+  if (size)
+    *size = model->size;
+
+  return g_mapped_file_get_contents (model->file);
+}
+
+/**
+ * @brief Release the mapped model.
+ */
+void
+nnstreamer_filter_model_unmap (GstTensorFilterModelMap * model)
+{
+  if (!model)
+    return;
+
+  G_LOCK (model_map_table);
+  if (--model->refcount > 0) {
+    G_UNLOCK (model_map_table);
+    return;
+  }
+
+  if (model_map_table &&
+      g_hash_table_lookup (model_map_table, model->path) == model)
+    g_hash_table_remove (model_map_table, model->path);
+  G_UNLOCK (model_map_table);
+
+  g_mapped_file_unref (model->file);
+  g_free (model->path);
+  g_free (model);
+}
+
+/**
+ * @brief Start new time window of the scheduler if the current one is expired. Caller should hold the lock.
+ */
+static void
+_gtfc_schedule_update_window (gint64 now)
+{
+  GList *list;
+  gboolean consecutive;
+
+  if (now - sched_window_start < SCHED_WINDOW_USEC)
+    return;
+
+  /* forget the history if the scheduler has been idle for a while */
+  consecutive = (now - sched_window_start < 2 * SCHED_WINDOW_USEC);
+
+  for (list = scheduled_filters; list != NULL; list = list->next) {
+    GstTensorFilterSchedule *s = (GstTensorFilterSchedule *) list->data;
+
+    s->busy_prev = consecutive ? s->busy : 0;
+    s->busy = 0;
+    s->missed_prev = consecutive ? s->missed : 0;
+    s->missed = 0;
+  }
+
+  sched_window_start = now;
+}
+
+/**
+ * @brief Check whether the instance uses more invoke time than its share while the other instances of higher or equal priority miss their deadlines. Caller should hold the lock.
+ */
+static gboolean
+_gtfc_schedule_is_over_budget (const GstTensorFilterSchedule * sched)
+{
+  GList *list;
+  guint weight = SCHED_WEIGHT (sched);
+  guint64 total_weight = 0;
+  gint64 busy, total_busy = 0;
+  gboolean missed = FALSE;
+
+  /**
+   * The instance missing its own deadline is not throttled here.
+   * It drops the frames by its deadline, and yields to the others.
+   */
+  for (list = scheduled_filters; list != NULL; list = list->next) {
+    GstTensorFilterSchedule *s = (GstTensorFilterSchedule *) list->data;
+
+    if (s != sched && SCHED_WEIGHT (s) >= weight &&
+        (s->missed > 0 || s->missed_prev > 0)) {
+      missed = TRUE;
+      break;
+    }
+  }
+
+  if (!missed)
+    return FALSE;
+
+  /* apportion the invoke time among the instances running recently */
+  for (list = scheduled_filters; list != NULL; list = list->next) {
+    GstTensorFilterSchedule *s = (GstTensorFilterSchedule *) list->data;
+
+    busy = s->busy + s->busy_prev;
+    if (busy > 0) {
+      total_busy += busy;
+      total_weight += SCHED_WEIGHT (s);
+    }
+  }
+
+  busy = sched->busy + sched->busy_prev;
+  if (busy == 0 || total_busy == 0)
+    return FALSE;
+
+  /* busy / total_busy > weight / total_weight */
+  return ((gdouble) busy * total_weight > (gdouble) weight * total_busy);
+}
+
+/**
+ * @brief Check whether the frame can be invoked with the process-wide scheduler.
+ */
+gboolean
+gst_tensor_filter_common_schedule_admit (GstTensorFilterPrivate * priv,
+    gint64 lateness)
+{
+  GstTensorFilterSchedule *sched = &priv->sched;
+  gboolean admit = TRUE;
+
+  if (sched->priority == 0 && sched->deadline == 0) {
+    if (sched->registered)
+      gst_tensor_filter_common_schedule_leave (priv);
+    return TRUE;
+  }
+
+  G_LOCK (filter_scheduler);
+
+  if (!sched->registered) {
+    scheduled_filters = g_list_append (scheduled_filters, sched);
+    sched->registered = TRUE;
+  }
+
+  _gtfc_schedule_update_window (g_get_monotonic_time ());
+
+  sched->lateness = lateness;
+  if (sched->deadline > 0 && lateness != G_MININT64) {
+    gint64 remaining = (gint64) sched->deadline * 1000 - lateness;
+
+    /* the average latency is updated by the statistics of recent invokes */
+    if (remaining < MAX (priv->prop.latency, 0)) {
+      sched->deadline_drops++;
+      sched->missed++;
+      admit = FALSE;
+    }
+  }
+
+  if (admit && _gtfc_schedule_is_over_budget (sched)) {
+    sched->budget_drops++;
+    admit = FALSE;
+  }
+
+  if (admit)
+    sched->invoked++;
+
+  G_UNLOCK (filter_scheduler);
+  return admit;
+}
+
+/**
+ * @brief Update the scheduler with the latency of the invoke admitted by gst_tensor_filter_common_schedule_admit().
+ */
+void
+gst_tensor_filter_common_schedule_done (GstTensorFilterPrivate * priv,
+    gint64 latency)
+{
+  GstTensorFilterSchedule *sched = &priv->sched;
+
+  if (!sched->registered)
+    return;
+
+  G_LOCK (filter_scheduler);
+
+  sched->busy += latency;
+
+  if (sched->deadline > 0 && sched->lateness != G_MININT64 &&
+      sched->lateness + latency > (gint64) sched->deadline * 1000) {
+    sched->deadline_misses++;
+    sched->missed++;
+  }
+
+  G_UNLOCK (filter_scheduler);
+}
+
+/**
+ * @brief Remove the instance from the process-wide scheduler.
+ */
+void
+gst_tensor_filter_common_schedule_leave (GstTensorFilterPrivate * priv)
+{
+  GstTensorFilterSchedule *sched = &priv->sched;
+
+  G_LOCK (filter_scheduler);
+  if (sched->registered) {
+    scheduled_filters = g_list_remove (scheduled_filters, sched);
+    sched->registered = FALSE;
+  }
+  G_UNLOCK (filter_scheduler);
+}
@@ -90,6 +90,62 @@ typedef struct _GstTensorFilterStatistics
   guint latency_ignore_count;   /* number of initial latency measurements to ignore in averaging */
 } GstTensorFilterStatistics;
 
+/**
+ * @brief Structure definition for deadline-aware scheduling of tensor-filter instances in the process
+ */
+typedef struct _GstTensorFilterSchedule
+{
+  guint priority; /**< weight to apportion the invoke time among the scheduled instances (0 for default weight) */
+  guint deadline; /**< per-frame deadline (msec) from the running time of the buffer, 0 to disable */
+  gboolean registered; /**< TRUE if this instance is registered in the process-wide scheduler */
+  gint64 lateness; /**< lateness (usec) of the buffer being processed, G_MININT64 if unknown */
+  gint64 busy; /**< accumulated invoke time (usec) in current window */
+  gint64 busy_prev; /**< accumulated invoke time (usec) in previous window */
+  guint missed; /**< number of frames dropped or finished after the deadline in current window */
+  guint missed_prev; /**< number of frames dropped or finished after the deadline in previous window */
+
+  guint64 invoked; /**< number of invokes admitted by the scheduler */
+  guint64 deadline_drops; /**< number of frames dropped because the deadline cannot be met */
+  guint64 budget_drops; /**< number of frames dropped to yield the CPU time to the instances of higher priority */
+  guint64 deadline_misses; /**< number of invokes finished after the deadline */
+} GstTensorFilterSchedule;
+
+/**
+ * @brief Structure definition for the prepared plan of dynamic input shape (the framework instance configured with the shape)
+ */
+typedef struct _GstTensorFilterShapePlan
+{
+  void *privateData; /**< NNFW plugin's private data configured with the input shape */
+  GstTensorsInfo in_info; /**< input tensor info of the plan */
+  GstTensorsInfo out_info; /**< output tensor info of the plan */
+} GstTensorFilterShapePlan;
+
+/**
+ * @brief Structure definition for the plan cache of dynamic input shapes
+ */
+typedef struct _GstTensorFilterShapeCache
+{
+  guint size; /**< max number of prepared plans including the active instance. 1 to re-plan the active instance. */
+  gchar *buckets_str; /**< shape buckets given by 'shape-buckets' property */
+  GList *buckets; /**< list of GstTensorsInfo, the shapes to pad the input tensors */
+  GList *plans; /**< inactive plans (GstTensorFilterShapePlan), the most recently used first */
+
+  guint64 hits; /**< number of shape changes served by the prepared plans */
+  guint64 misses; /**< number of shape changes which required re-planning */
+  guint64 padded; /**< number of input buffers padded to the shape bucket */
+} GstTensorFilterShapeCache;
+
+/**
+ * @brief Structure definition for the statistics of the model reloads
+ */
+typedef struct _GstTensorFilterReloadStats
+{
+  GMutex lock; /**< lock for the counters, the model can be updated by another thread */
+  gint64 num; /**< number of successful reloads */
+  gint64 failed; /**< number of failed reloads */
+  gint64 latency; /**< accumulated time the caller was blocked by the reloads (usec) */
+} GstTensorFilterReloadStats;
+
 /**
  * @brief Structure definition for tensor-filter in/out combination
  */
@@ -134,6 +190,15 @@ typedef struct _GstTensorFilterPrivate
   gboolean latency_reporting; /**< reporting of estimated filter latency is enabled */
   guint64 latency_reported; /**< latency value reported (ns) in last LATENCY query */
 
+  guint warmup; /**< the number of warm-up invokes with synthetic input after opening the framework */
+  gboolean warmed_up; /**< TRUE if warm-up invokes are done for the opened framework */
+  gchar *cache_dir; /**< root directory for the compiled model artifacts of sub-plugins */
+  GstTensorFilterSchedule sched; /**< state of the process-wide scheduler */
+  gchar *cpu_affinity; /**< CPU list or core type ('big' or 'little') given by 'cpu-affinity' property */
+  gpointer cpu_placement; /**< the CPU placement of the streaming thread saved before invoke */
+  GstTensorFilterShapeCache shape_cache; /**< prepared plans for the dynamic input shapes */
+  GstTensorFilterReloadStats reload_stats; /**< statistics of the model reloads */
+
   GstTensorFilterCombination combi;
 } GstTensorFilterPrivate;
 
@@ -164,6 +229,14 @@ gst_tensorsinfo_compare_print (const GstTensorsInfo * info1,
 extern gboolean
 gst_tensor_filter_allocate_in_invoke (GstTensorFilterPrivate * priv);
 
+/**
+ * @brief check if the framework allows in-place invoke (same memory for input and output)
+ * @param[in] priv Struct containing the properties of the object
+ * @return TRUE if allowed, FALSE otherwise
+ */
+extern gboolean
+gst_tensor_filter_allow_in_place (GstTensorFilterPrivate * priv);
+
 /**
  * @brief Installs all the properties for tensor_filter
  * @param[in] gobject_class Glib object class whose properties will be set
@@ -227,6 +300,33 @@ extern gboolean
 gst_tensor_filter_common_get_out_info (GstTensorFilterPrivate * priv,
     GstTensorsInfo * in, GstTensorsInfo * out);
 
+/**
+ * @brief Find the smallest shape bucket which can hold the given input tensors.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] in The input tensors info
+ * @param[out] bucket The tensors info of the bucket (type of the input tensors). Caller should free it.
+ * @return TRUE if the bucket is found.
+ */
+extern gboolean
+gst_tensor_filter_common_get_shape_bucket (GstTensorFilterPrivate * priv,
+    const GstTensorsInfo * in, GstTensorsInfo * bucket);
+
+/**
+ * @brief Prepare the framework for the new input shape, using the plan cache.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] in The new input tensors info
+ * @return TRUE if the framework is ready to invoke the input. The input and output info of the properties are updated.
+ */
+extern gboolean
+gst_tensor_filter_common_update_shape (GstTensorFilterPrivate * priv,
+    const GstTensorsInfo * in);
+
+/**
+ * @brief Close the framework instances of the prepared plans.
+ */
+extern void
+gst_tensor_filter_common_clear_shape_cache (GstTensorFilterPrivate * priv);
+
 /**
  * @brief Load tensor info from NN model.
  * (both input and output tensor)
@@ -244,6 +344,49 @@ extern void gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv);
  */
 extern void gst_tensor_filter_common_close_fw (GstTensorFilterPrivate * priv);
 
+/**
+ * @brief Run warm-up invokes of NN framework with zero-filled input.
+ * @note This does nothing if the tensor info of the model is not configured yet.
+ */
+extern void gst_tensor_filter_common_warmup (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Check whether the frame can be invoked with the process-wide scheduler.
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] lateness Lateness (usec) of the frame, from its running time to current clock time. G_MININT64 if unknown.
+ * @return TRUE if the frame should be invoked, FALSE if it should be dropped.
+ * @note This registers the instance in the scheduler if 'sched-priority' or 'deadline' is set.
+ */
+extern gboolean
+gst_tensor_filter_common_schedule_admit (GstTensorFilterPrivate * priv, gint64 lateness);
+
+/**
+ * @brief Update the scheduler with the latency of the invoke admitted by gst_tensor_filter_common_schedule_admit().
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] latency Invoke latency (usec)
+ */
+extern void
+gst_tensor_filter_common_schedule_done (GstTensorFilterPrivate * priv, gint64 latency);
+
+/**
+ * @brief Remove the instance from the process-wide scheduler.
+ */
+extern void
+gst_tensor_filter_common_schedule_leave (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Apply the CPU placement (cpu-affinity, numa-node and thread-priority) to the calling thread before invoke.
+ * @note The worker threads created by the calling thread inherit the CPU affinity.
+ */
+extern void
+gst_tensor_filter_common_apply_cpu_placement (GstTensorFilterPrivate * priv);
+
+/**
+ * @brief Restore the CPU placement of the calling thread after invoke.
+ */
+extern void
+gst_tensor_filter_common_restore_cpu_placement (GstTensorFilterPrivate * priv);
+
 /**
  * @brief Get neural network framework name from given model file. This does not guarantee the framework is available on the target device.
  * @param[in] model_files the prediction model paths
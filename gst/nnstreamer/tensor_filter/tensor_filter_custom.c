@@ -51,6 +51,7 @@ struct _internal_data
 {
   GModule *module;
   NNStreamer_custom_class *methods;
+  int in_place; /**< non-zero if invoke allows the same memory for input and output */
 
   void *customFW_private_data;
 };
@@ -65,6 +66,7 @@ custom_loadlib (const GstTensorFilterProperties * prop, void **private_data)
 {
   internal_data *ptr;
   gpointer custom_cls;
+  gpointer in_place;
 
   if (*private_data != NULL) {
     /** @todo : Check the integrity of filter->data and filter->model_file, nnfw */
@@ -111,6 +113,10 @@ custom_loadlib (const GstTensorFilterProperties * prop, void **private_data)
 
   ptr->methods = *(NNStreamer_custom_class **) custom_cls;
 
+  /* Optional symbol to allow in-place invoke */
+  if (g_module_symbol (ptr->module, "NNStreamer_custom_in_place", &in_place))
+    ptr->in_place = *(int *) in_place;
+
   if (NULL == ptr->methods->initfunc) {
     ml_loge ("tensor_filter_custom (%s) requires a valid 'initfunc'.",
         prop->model_files[0]);
@@ -291,6 +297,28 @@ custom_allocateInInvoke (void **private_data)
   return -EINVAL;
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework, to check in-place invoke of the opened model.
+ */
+static int
+custom_handleEvent (event_ops ops, GstTensorFilterFrameworkEventData * data)
+{
+  internal_data *ptr;
+
+  if (ops != CHECK_IN_PLACE)
+    return -ENOENT;
+
+  if (data == NULL)
+    return -EINVAL;
+
+  ptr = data->private_data;
+  if (ptr && ptr->in_place && ptr->methods->invoke) {
+    return 0;
+  }
+
+  return -EINVAL;
+}
+
 /**
  * @brief Check support of the backend
  */
@@ -308,11 +336,11 @@ static gchar filter_subplugin_custom[] = "custom";
 static GstTensorFilterFramework NNS_support_custom = {
   .version = GST_TENSOR_FILTER_FRAMEWORK_V0,
   .name = filter_subplugin_custom,
-  .allow_in_place = FALSE,      /* custom cannot support in-place (output == input). */
+  .allow_in_place = TRUE,       /* custom filter may support in-place (output == input) with NNStreamer_custom_in_place. */
   .allocate_in_invoke = TRUE,   /* GstTensorFilter allocates output buffers */
   .run_without_model = FALSE,   /* custom needs a so file */
   .invoke_NN = custom_invoke,
-  .handleEvent = NULL,          /* do not set event function for custom filter */
+  .handleEvent = custom_handleEvent,    /* only to check in-place invoke (NNStreamer_custom_in_place) */
   .getInputDimension = custom_getInputDim,
   .getOutputDimension = custom_getOutputDim,
   .setInputDimension = custom_setInputDim,
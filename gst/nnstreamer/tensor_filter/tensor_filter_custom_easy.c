@@ -42,6 +42,7 @@ typedef struct _internal_data
   GstTensorsInfo in_info;
   GstTensorsInfo out_info;
   void *data; /**< The easy-filter writer's data */
+  gboolean in_place; /**< TRUE if func writes the output into the input memory */
 } internal_data;
 
 /**
@@ -66,15 +67,17 @@ custom_free_internal_data (internal_data * data)
 }
 
 /**
- * @brief Register the custom-easy tensor function. More info in .h
+ * @brief Internal function to register the custom-easy tensor function.
  * @return 0 if success. -ERRNO if error.
  */
-int
-NNS_custom_easy_register (const char *modelname,
+static int
+custom_easy_register (const char *modelname,
     NNS_custom_invoke func, void *data,
-    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info,
+    gboolean in_place)
 {
   internal_data *ptr;
+  guint i;
 
   if (!func || !in_info || !out_info)
     return -EINVAL;
@@ -83,6 +86,18 @@ NNS_custom_easy_register (const char *modelname,
       !gst_tensors_info_validate (out_info))
     return -EINVAL;
 
+  if (in_place) {
+    /* in-place invoke requires the same size for each input and output tensor */
+    if (in_info->num_tensors != out_info->num_tensors)
+      return -EINVAL;
+
+    for (i = 0; i < in_info->num_tensors; i++) {
+      if (gst_tensor_info_get_size (&in_info->info[i]) !=
+          gst_tensor_info_get_size (&out_info->info[i]))
+        return -EINVAL;
+    }
+  }
+
   ptr = g_new0 (internal_data, 1);
 
   if (!ptr)
@@ -90,6 +105,7 @@ NNS_custom_easy_register (const char *modelname,
 
   ptr->func = func;
   ptr->data = data;
+  ptr->in_place = in_place;
   gst_tensors_info_copy (&ptr->in_info, in_info);
   gst_tensors_info_copy (&ptr->out_info, out_info);
 
@@ -100,6 +116,32 @@ NNS_custom_easy_register (const char *modelname,
   return -EINVAL;
 }
 
+/**
+ * @brief Register the custom-easy tensor function. More info in .h
+ * @return 0 if success. -ERRNO if error.
+ */
+int
+NNS_custom_easy_register (const char *modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+{
+  return custom_easy_register (modelname, func, data, in_info, out_info,
+      FALSE);
+}
+
+/**
+ * @brief Register the custom-easy tensor function which can be invoked in-place. More info in .h
+ * @return 0 if success. -ERRNO if error.
+ */
+int
+NNS_custom_easy_register_in_place (const char *modelname,
+    NNS_custom_invoke func, void *data,
+    const GstTensorsInfo * in_info, const GstTensorsInfo * out_info)
+{
+  return custom_easy_register (modelname, func, data, in_info, out_info,
+      TRUE);
+}
+
 /**
  * @brief Unregister the custom-easy tensor function.
  * @return 0 if success. -EINVAL if invalid model name.
@@ -225,11 +267,32 @@ custom_close (const GstTensorFilterProperties * prop, void **private_data)
   *private_data = NULL;
 }
 
+/**
+ * @brief Callback to check in-place invoke of the registered model
+ */
+static int
+custom_handleEvent (event_ops ops, GstTensorFilterFrameworkEventData * data)
+{
+  runtime_data *rd;
+
+  if (ops != CHECK_IN_PLACE)
+    return -ENOENT;
+
+  if (data == NULL)
+    return -EINVAL;
+
+  rd = data->private_data;
+  if (rd && rd->model && rd->model->in_place)
+    return 0;
+
+  return -EINVAL;
+}
+
 static char name_str[] = "custom-easy";
 static GstTensorFilterFramework NNS_support_custom_easy = {
   .version = GST_TENSOR_FILTER_FRAMEWORK_V0,
   .name = name_str,
-  .allow_in_place = FALSE,      /* custom cannot support in-place. */
+  .allow_in_place = TRUE,       /* if registered with NNS_custom_easy_register_in_place. */
   .allocate_in_invoke = FALSE,  /* we allocate output buffers for you. */
   .run_without_model = FALSE,   /* we need a func to run. */
   .invoke_NN = custom_invoke,
@@ -240,6 +303,7 @@ static GstTensorFilterFramework NNS_support_custom_easy = {
   .open = custom_open,
   .close = custom_close,
   .destroyNotify = NULL,        /* No need. We don't support "allocate_in_invoke." */
+  .handleEvent = custom_handleEvent,    /* only to check in-place invoke */
 };
 
 /** @brief Initialize this object for tensor_filter subplugin runtime register */
@@ -54,6 +54,7 @@ typedef struct _GTensorFilterSinglePrivate
 {
   GstTensorFilterPrivate filter_priv; /**< Internal properties for tensor-filter */
   gboolean allocate_in_invoke;  /**< cached value after first invoke */
+  guint info_version; /**< increased when the tensor info is updated, to validate the binding */
 } GTensorFilterSinglePrivate;
 
 #define G_TENSOR_FILTER_SINGLE_PRIV(obj) ((GTensorFilterSinglePrivate *) (obj)->priv)
@@ -81,6 +82,14 @@ static void g_tensor_filter_destroy_notify (GTensorFilterSingle * self,
 static gboolean g_tensor_filter_allocate_in_invoke (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_single_start (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_single_stop (GTensorFilterSingle * self);
+static GTensorFilterSingleBinding
+    * g_tensor_filter_single_binding_new (GTensorFilterSingle * self);
+static gboolean g_tensor_filter_single_invoke_binding (GTensorFilterSingle *
+    self, GTensorFilterSingleBinding * binding);
+static void g_tensor_filter_single_binding_release (GTensorFilterSingle * self,
+    GTensorFilterSingleBinding * binding);
+static void g_tensor_filter_single_binding_free (GTensorFilterSingle * self,
+    GTensorFilterSingleBinding * binding);
 
 /**
  * @brief initialize the tensor_filter's class
@@ -106,6 +115,10 @@ g_tensor_filter_single_class_init (GTensorFilterSingleClass * klass)
   klass->set_input_info = g_tensor_filter_set_input_info;
   klass->destroy_notify = g_tensor_filter_destroy_notify;
   klass->allocate_in_invoke = g_tensor_filter_allocate_in_invoke;
+  klass->binding_new = g_tensor_filter_single_binding_new;
+  klass->invoke_binding = g_tensor_filter_single_invoke_binding;
+  klass->binding_release = g_tensor_filter_single_binding_release;
+  klass->binding_free = g_tensor_filter_single_binding_free;
 }
 
 /**
@@ -124,6 +137,7 @@ g_tensor_filter_single_init (GTensorFilterSingle * self)
 
   gst_tensor_filter_common_init_property (priv);
   spriv->allocate_in_invoke = FALSE;
+  spriv->info_version = 0;
 }
 
 /**
@@ -262,6 +276,8 @@ g_tensor_filter_single_start (GTensorFilterSingle * self)
 
   gst_tensor_filter_load_tensor_info (priv);
   spriv->allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  spriv->info_version++;
+  gst_tensor_filter_common_warmup (priv);
 
   priv->configured = TRUE;
 
@@ -426,7 +442,151 @@ g_tensor_filter_set_input_info (GTensorFilterSingle * self,
   if (status == 0) {
     gst_tensors_info_copy (&priv->prop.input_meta, in_info);
     gst_tensors_info_copy (&priv->prop.output_meta, out_info);
+    spriv->info_version++;
   }
 
   return status;
 }
+
+/**
+ * @brief Create the binding of input and output tensors for repeated invoke
+ * @param self "this" pointer
+ * @return Newly allocated binding, NULL on error. Caller should free it with binding_free.
+ * @note If the framework does not allocate in invoke, the output data is allocated once here and reused in every invoke.
+ */
+static GTensorFilterSingleBinding *
+g_tensor_filter_single_binding_new (GTensorFilterSingle * self)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  GTensorFilterSingleBinding *binding;
+  guint i;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  /** start if not already started */
+  if (!priv->configured) {
+    if (!g_tensor_filter_single_start (self)) {
+      return NULL;
+    }
+  }
+
+  binding = g_new0 (GTensorFilterSingleBinding, 1);
+  binding->num_input = priv->prop.input_meta.num_tensors;
+  binding->num_output = priv->prop.output_meta.num_tensors;
+  binding->info_version = spriv->info_version;
+
+  for (i = 0; i < binding->num_input; i++)
+    binding->input[i].size =
+        gst_tensor_info_get_size (&priv->prop.input_meta.info[i]);
+
+  for (i = 0; i < binding->num_output; i++)
+    binding->output[i].size =
+        gst_tensor_info_get_size (&priv->prop.output_meta.info[i]);
+
+  if (!spriv->allocate_in_invoke) {
+    binding->output_allocated = TRUE;
+
+    for (i = 0; i < binding->num_output; i++) {
+      binding->output[i].data = g_try_malloc (binding->output[i].size);
+      if (!binding->output[i].data) {
+        ml_loge ("Failed to allocate the output tensor.");
+        g_tensor_filter_single_binding_free (self, binding);
+        return NULL;
+      }
+    }
+  }
+
+  return binding;
+}
+
+/**
+ * @brief Invoke the filter with the binding
+ * @param self "this" pointer
+ * @param binding the binding with input data
+ * @return TRUE if there is no error.
+ * @note If the framework allocates in invoke, the output data of the binding is owned by the framework and handed back without copy. It is released in next invoke or binding_release.
+ */
+static gboolean
+g_tensor_filter_single_invoke_binding (GTensorFilterSingle * self,
+    GTensorFilterSingleBinding * binding)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  gint status;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  if (G_UNLIKELY (!binding))
+    return FALSE;
+
+  if (G_UNLIKELY (!priv->configured
+          || binding->info_version != spriv->info_version)) {
+    ml_loge ("The tensor info of the filter is updated, create new binding.");
+    return FALSE;
+  }
+
+  /* release the output of previous invoke */
+  g_tensor_filter_single_binding_release (self, binding);
+
+  GST_TF_FW_INVOKE_COMPAT (priv, status, binding->input, binding->output);
+
+  if (!binding->output_allocated)
+    binding->output_fw_owned = (status == 0);
+
+  return (status == 0);
+}
+
+/**
+ * @brief Release the output data allocated by the framework
+ * @param self "this" pointer
+ * @param binding the binding to release the output
+ */
+static void
+g_tensor_filter_single_binding_release (GTensorFilterSingle * self,
+    GTensorFilterSingleBinding * binding)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  guint i;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  if (!binding || binding->output_allocated)
+    return;
+
+  for (i = 0; i < binding->num_output; i++) {
+    if (binding->output_fw_owned)
+      gst_tensor_filter_destroy_notify_util (priv, binding->output[i].data);
+    binding->output[i].data = NULL;
+  }
+
+  binding->output_fw_owned = FALSE;
+}
+
+/**
+ * @brief Release the output data and free the binding
+ * @param self "this" pointer
+ * @param binding the binding to be freed
+ */
+static void
+g_tensor_filter_single_binding_free (GTensorFilterSingle * self,
+    GTensorFilterSingleBinding * binding)
+{
+  guint i;
+
+  if (!binding)
+    return;
+
+  if (binding->output_allocated) {
+    for (i = 0; i < binding->num_output; i++)
+      g_free (binding->output[i].data);
+  } else {
+    g_tensor_filter_single_binding_release (self, binding);
+  }
+
+  g_free (binding);
+}
@@ -45,6 +45,24 @@ G_BEGIN_DECLS
 typedef struct _GTensorFilterSingle GTensorFilterSingle;
 typedef struct _GTensorFilterSingleClass GTensorFilterSingleClass;
 
+/**
+ * @brief Reusable binding of input and output tensors for single-shot invoke.
+ * The sizes of the tensors are filled when the binding is created, caller should set the input data before invoke.
+ * After invoke, the output data is valid until the next invoke or release of the binding.
+ */
+typedef struct
+{
+  guint num_input; /**< the number of input tensors */
+  guint num_output; /**< the number of output tensors */
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT]; /**< input tensors */
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT]; /**< output tensors */
+  gboolean output_fw_owned; /**< TRUE if the output data is allocated by the framework in invoke */
+
+  /* private */
+  guint info_version; /**< version of the tensor info when the binding is created */
+  gboolean output_allocated; /**< TRUE if the output data is allocated by the binding */
+} GTensorFilterSingleBinding;
+
 /**
  * @brief Internal data structure for tensor_filter_single instances.
  */
@@ -81,6 +99,17 @@ struct _GTensorFilterSingleClass
   gboolean (*allocate_in_invoke) (GTensorFilterSingle * self);
   /** Free the data allocated by the tensor filter in invoke */
   void (*destroy_notify) (GTensorFilterSingle * self, GstTensorMemory * mem);
+  /** Create the binding of input and output tensors with current tensor info. */
+  GTensorFilterSingleBinding * (*binding_new) (GTensorFilterSingle * self);
+  /** Invoke the filter with the binding. The output is handed back without copy. */
+  gboolean (*invoke_binding) (GTensorFilterSingle * self,
+      GTensorFilterSingleBinding * binding);
+  /** Release the output data allocated by the framework in invoke_binding */
+  void (*binding_release) (GTensorFilterSingle * self,
+      GTensorFilterSingleBinding * binding);
+  /** Release the output data and free the binding */
+  void (*binding_free) (GTensorFilterSingle * self,
+      GTensorFilterSingleBinding * binding);
 };
 
 /**
@@ -14,6 +14,7 @@
 #include "config.h"
 #endif
 
+#include <string.h>
 #include <nnstreamer_util.h>
 #include "tensor_meta.h"
 
@@ -51,6 +52,9 @@ gst_meta_query_init (GstMeta * meta, gpointer params, GstBuffer * buffer)
   UNUSED (params);
   UNUSED (buffer);
   emeta->client_id = 0;
+  emeta->batch_size = 0;
+  emeta->num_requests = 0;
+  memset (emeta->batch_client_ids, 0, sizeof (emeta->batch_client_ids));
   return TRUE;
 }
 
@@ -77,6 +81,10 @@ gst_meta_query_transform (GstBuffer * transbuf, GstMeta * meta,
   UNUSED (type);
   UNUSED (data);
   dest_meta->client_id = src_meta->client_id;
+  dest_meta->batch_size = src_meta->batch_size;
+  dest_meta->num_requests = src_meta->num_requests;
+  memcpy (dest_meta->batch_client_ids, src_meta->batch_client_ids,
+      sizeof (src_meta->batch_client_ids));
   return TRUE;
 }
 
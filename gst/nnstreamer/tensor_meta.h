@@ -20,6 +20,11 @@ G_BEGIN_DECLS
 
 typedef int64_t query_client_id_t;
 
+/**
+ * @brief The max number of requests in a batched buffer of tensor query.
+ */
+#define QUERY_META_MAX_BATCH (16)
+
 /**
  * @brief GstMetaQuery meta structure
  */
@@ -28,6 +33,11 @@ typedef struct
   GstMeta meta;
 
   query_client_id_t client_id;
+
+  /* batched requests from multiple clients */
+  unsigned int batch_size; /**< the number of slots in the batched tensors (0 if the buffer is not batched) */
+  unsigned int num_requests; /**< the number of valid requests, the requests are in the first slots */
+  query_client_id_t batch_client_ids[QUERY_META_MAX_BATCH]; /**< client ID of each request */
 } GstMetaQuery;
 
 /**
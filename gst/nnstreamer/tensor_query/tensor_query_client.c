@@ -46,6 +46,7 @@ enum
   PROP_TOPIC,
   PROP_TIMEOUT,
   PROP_SILENT,
+  PROP_COMPRESSION,
 };
 
 #define TCP_HIGHEST_PORT        65535
@@ -54,6 +55,7 @@ enum
 #define TCP_DEFAULT_CLIENT_SRC_PORT 3001
 #define DEFAULT_CLIENT_TIMEOUT  0
 #define DEFAULT_SILENT TRUE
+#define DEFAULT_COMPRESSION TENSOR_CODEC_NONE
 
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_client_debug);
 #define GST_CAT_DEFAULT gst_tensor_query_client_debug
@@ -145,6 +147,13 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
           "A timeout value (in ms) to wait message from query server after sending buffer to server. 0 means no wait.",
           0, G_MAXUINT, DEFAULT_CLIENT_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_COMPRESSION,
+      g_param_spec_enum ("compression", "Compression",
+          "Compression of the request tensors sent to query server. "
+          "Lossless encoding is skipped for a while if the tensor is not compressible. "
+          "Lossy methods are applied to float32 tensors only.",
+          GST_TYPE_TENSOR_CODEC, DEFAULT_COMPRESSION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&sinktemplate));
@@ -166,6 +175,8 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
 static void
 gst_tensor_query_client_init (GstTensorQueryClient * self)
 {
+  guint i;
+
   /** setup sink pad */
   self->sinkpad = gst_pad_new_from_static_template (&sinktemplate, "sink");
   gst_element_add_pad (GST_ELEMENT (self), self->sinkpad);
@@ -192,6 +203,10 @@ gst_tensor_query_client_init (GstTensorQueryClient * self)
   self->timeout = DEFAULT_CLIENT_TIMEOUT;
   self->edge_h = NULL;
   self->msg_queue = g_async_queue_new ();
+  self->compression = DEFAULT_COMPRESSION;
+  memset (self->codec_states, 0, sizeof (self->codec_states));
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++)
+    self->codec_types[i] = _NNS_END;
 }
 
 /**
@@ -279,6 +294,9 @@ gst_tensor_query_client_set_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
+    case PROP_COMPRESSION:
+      self->compression = g_value_get_enum (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -319,6 +337,9 @@ gst_tensor_query_client_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_COMPRESSION:
+      g_value_set_enum (value, self->compression);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -563,6 +584,32 @@ done:
   return started;
 }
 
+/**
+ * @brief Update the element type of each tensor to be compressed.
+ */
+static void
+_client_update_codec_types (GstTensorQueryClient * self, GstCaps * caps)
+{
+  GstStructure *structure;
+  GstTensorsConfig config;
+  guint i;
+
+  memset (self->codec_states, 0, sizeof (self->codec_states));
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++)
+    self->codec_types[i] = _NNS_END;
+
+  structure = gst_caps_get_structure (caps, 0);
+  if (!gst_structure_is_tensor_stream (structure))
+    return;
+
+  gst_tensors_config_from_structure (&config, structure);
+  if (config.info.format == _NNS_TENSOR_FORMAT_STATIC) {
+    for (i = 0; i < config.info.num_tensors; i++)
+      self->codec_types[i] = config.info.info[i].type;
+  }
+  gst_tensors_config_free (&config);
+}
+
 /**
  * @brief This function handles sink event.
  */
@@ -584,6 +631,7 @@ gst_tensor_query_client_sink_event (GstPad * pad,
       gst_event_parse_caps (event, &caps);
       g_free (self->in_caps_str);
       self->in_caps_str = gst_caps_to_string (caps);
+      _client_update_codec_types (self, caps);
 
       ret = gst_tensor_query_client_create_edge_handle (self);
       if (!ret)
@@ -665,6 +713,8 @@ gst_tensor_query_client_chain (GstPad * pad,
   int ret;
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
+  gsize max_sizes[NNS_TENSOR_SIZE_LIMIT];
+  GstCaps *caps;
   gchar *val;
   UNUSED (pad);
 
@@ -682,9 +732,11 @@ gst_tensor_query_client_chain (GstPad * pad,
       num_mems = i;
       goto done;
     }
-    nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
   }
 
+  gst_tensor_query_add_encoded_data (data_h, map, num_mems, self->compression,
+      self->codec_types, self->codec_states);
+
   nns_edge_get_info (self->edge_h, "client_id", &val);
   nns_edge_data_set_info (data_h, "client_id", val);
   g_free (val);
@@ -699,6 +751,26 @@ gst_tensor_query_client_chain (GstPad * pad,
   data_h = g_async_queue_timeout_pop (self->msg_queue,
       self->timeout * G_TIME_SPAN_MILLISECOND);
   if (data_h) {
+    if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h,
+            QUERY_ERROR_INFO_KEY, &val)) {
+      /* The server dropped the request, skip this buffer. */
+      nns_logw ("The query server rejected the request: %s", val);
+      g_free (val);
+      goto done;
+    }
+
+    /* The decoded result cannot be larger than the negotiated tensor. */
+    caps = gst_pad_get_current_caps (self->srcpad);
+    gst_tensor_codec_get_max_sizes (caps, max_sizes);
+    if (caps)
+      gst_caps_unref (caps);
+
+    data_h = gst_tensor_query_decode_data (data_h, max_sizes);
+    if (!data_h) {
+      res = GST_FLOW_ERROR;
+      goto done;
+    }
+
     ret = nns_edge_data_get_count (data_h, &num_data);
     if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
       nns_loge ("Failed to get the number of memories of the edge data.");
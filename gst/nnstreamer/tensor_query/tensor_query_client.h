@@ -16,6 +16,7 @@
 #include <gst/gst.h>
 #include <gio/gio.h>
 #include <tensor_common.h>
+#include "tensor_codec.h"
 #include "nnstreamer-edge.h"
 
 G_BEGIN_DECLS
@@ -59,6 +60,10 @@ struct _GstTensorQueryClient
   nns_edge_connect_type_e connect_type;
   nns_edge_h edge_h;
   GAsyncQueue *msg_queue;
+
+  tensor_codec_e compression; /**< compression of the request */
+  tensor_type codec_types[NNS_TENSOR_SIZE_LIMIT]; /**< element type of each tensor to be compressed */
+  GstTensorCodecState codec_states[NNS_TENSOR_SIZE_LIMIT]; /**< encoder state of each tensor */
 };
 
 /**
@@ -18,6 +18,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "tensor_query_common.h"
+#include "nnstreamer_util.h"
 
 #ifndef EREMOTEIO
 #define EREMOTEIO 121           /* This is Linux-specific. Define this for non-Linux systems */
@@ -47,3 +48,191 @@ gst_tensor_query_get_connect_type (void)
 
   return protocol;
 }
+
+/**
+ * @brief Register GEnumValue array for query overload-policy property.
+ */
+GType
+gst_tensor_query_get_overload_policy (void)
+{
+  static GType policy = 0;
+  if (policy == 0) {
+    static GEnumValue policies[] = {
+      {QUERY_OVERLOAD_REJECT, "reject",
+          "Drop the incoming request when the queue is full."},
+      {QUERY_OVERLOAD_SHED, "shed",
+          "Drop the oldest request in the queue when the queue is full."},
+      {0, NULL, NULL},
+    };
+    policy = g_enum_register_static ("tensor_query_overload_policy", policies);
+  }
+
+  return policy;
+}
+
+/**
+ * @brief Get the caps string of a single request from the caps of batched tensors.
+ */
+gchar *
+gst_tensor_query_get_unbatched_caps_str (GstCaps * caps, guint batch)
+{
+  GstStructure *structure;
+  GstTensorsConfig config;
+  GstCaps *unbatched;
+  gchar *caps_str = NULL;
+  guint i, rank;
+
+  g_return_val_if_fail (caps != NULL, NULL);
+
+  if (batch < 2)
+    return gst_caps_to_string (caps);
+
+  if (!gst_caps_is_fixed (caps)) {
+    nns_loge ("The caps of batched tensors should be fixed.");
+    return NULL;
+  }
+
+  structure = gst_caps_get_structure (caps, 0);
+  if (!gst_structure_is_tensor_stream (structure)) {
+    nns_loge ("Batched query requires tensor stream.");
+    return NULL;
+  }
+
+  gst_tensors_config_from_structure (&config, structure);
+  if (!gst_tensors_info_validate (&config.info) ||
+      config.info.format != _NNS_TENSOR_FORMAT_STATIC) {
+    nns_loge ("Batched query requires static tensor stream.");
+    goto done;
+  }
+
+  for (i = 0; i < config.info.num_tensors; i++) {
+    rank = gst_tensor_info_get_rank (&config.info.info[i]);
+
+    if (config.info.info[i].dimension[rank - 1] % batch != 0) {
+      nns_loge ("The outermost dimension of tensor %u (%u) is not a multiple "
+          "of the batch (%u).", i, config.info.info[i].dimension[rank - 1],
+          batch);
+      goto done;
+    }
+
+    config.info.info[i].dimension[rank - 1] /= batch;
+  }
+
+  if (gst_structure_has_name (structure, NNS_MIMETYPE_TENSOR))
+    unbatched = gst_tensor_caps_from_config (&config);
+  else
+    unbatched = gst_tensors_caps_from_config (&config);
+
+  caps_str = gst_caps_to_string (unbatched);
+  gst_caps_unref (unbatched);
+
+done:
+  gst_tensors_config_free (&config);
+  return caps_str;
+}
+
+/**
+ * @brief Add the mapped memories to the edge data, encoding each memory with given codec.
+ */
+void
+gst_tensor_query_add_encoded_data (nns_edge_data_h data_h, GstMapInfo * map,
+    guint num_mems, tensor_codec_e codec, const tensor_type * types,
+    GstTensorCodecState * states)
+{
+  gchar flags[NNS_TENSOR_SIZE_LIMIT + 1];
+  gboolean encoded = FALSE;
+  guint i;
+
+  for (i = 0; i < num_mems; i++) {
+    gpointer enc = NULL;
+    gsize enc_size = 0;
+
+    if (codec != TENSOR_CODEC_NONE && i < NNS_TENSOR_SIZE_LIMIT) {
+      enc = gst_tensor_codec_encode (codec, types ? types[i] : _NNS_END,
+          map[i].data, map[i].size, &states[i], &enc_size);
+    }
+
+    if (enc) {
+      nns_edge_data_add (data_h, enc, enc_size, g_free);
+      encoded = TRUE;
+    } else {
+      nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
+    }
+
+    if (i < NNS_TENSOR_SIZE_LIMIT)
+      flags[i] = enc ? '1' : '0';
+  }
+
+  if (encoded) {
+    flags[MIN (num_mems, NNS_TENSOR_SIZE_LIMIT)] = '\0';
+    nns_edge_data_set_info (data_h, TENSOR_CODEC_INFO_KEY, flags);
+  }
+}
+
+/**
+ * @brief Decode the encoded memories of the received edge data.
+ */
+nns_edge_data_h
+gst_tensor_query_decode_data (nns_edge_data_h data_h, const gsize * max_sizes)
+{
+  nns_edge_data_h decoded_h = NULL;
+  char *flags = NULL, *val = NULL;
+  guint i, num_data;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h,
+          TENSOR_CODEC_INFO_KEY, &flags) || !flags) {
+    /* Nothing is encoded. */
+    return data_h;
+  }
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_count (data_h, &num_data) ||
+      strlen (flags) != num_data) {
+    nns_loge ("Invalid codec information of the received data.");
+    goto error;
+  }
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_create (&decoded_h)) {
+    nns_loge ("Failed to create data handle to decode the received data.");
+    goto error;
+  }
+
+  for (i = 0; i < num_data; i++) {
+    void *data = NULL;
+    nns_size_t data_len = 0;
+    gpointer new_data;
+    gsize new_size;
+
+    nns_edge_data_get (data_h, i, &data, &data_len);
+
+    if (flags[i] == '1') {
+      new_data = gst_tensor_codec_decode (data, data_len,
+          (max_sizes && i < NNS_TENSOR_SIZE_LIMIT) ? max_sizes[i] : 0,
+          &new_size);
+      if (!new_data) {
+        nns_loge ("Failed to decode the %uth memory of the received data.", i);
+        goto error;
+      }
+    } else {
+      new_data = _g_memdup (data, data_len);
+      new_size = data_len;
+    }
+
+    nns_edge_data_add (decoded_h, new_data, new_size, g_free);
+  }
+
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "client_id", &val)) {
+    nns_edge_data_set_info (decoded_h, "client_id", val);
+    g_free (val);
+  }
+
+  g_free (flags);
+  nns_edge_data_destroy (data_h);
+  return decoded_h;
+
+error:
+  g_free (flags);
+  if (decoded_h)
+    nns_edge_data_destroy (decoded_h);
+  nns_edge_data_destroy (data_h);
+  return NULL;
+}
@@ -16,6 +16,7 @@
 #include "tensor_typedef.h"
 #include "tensor_common.h"
 #include "tensor_meta.h"
+#include "tensor_codec.h"
 #include "nnstreamer-edge.h"
 
 #ifdef __cplusplus
@@ -40,6 +41,61 @@ extern "C" {
 GType
 gst_tensor_query_get_connect_type (void);
 
+/**
+ * @brief Policy when the request queue of query server is full.
+ */
+typedef enum
+{
+  QUERY_OVERLOAD_REJECT = 0, /**< drop the incoming request */
+  QUERY_OVERLOAD_SHED, /**< drop the oldest request in the queue */
+} query_overload_policy_e;
+
+#define DEFAULT_OVERLOAD_POLICY (QUERY_OVERLOAD_REJECT)
+
+/**
+ * @brief The info key of the error response for the dropped request.
+ */
+#define QUERY_ERROR_INFO_KEY "query_error"
+#define GST_TYPE_QUERY_OVERLOAD_POLICY (gst_tensor_query_get_overload_policy ())
+
+/**
+ * @brief Register GEnumValue array for query overload-policy property.
+ */
+GType
+gst_tensor_query_get_overload_policy (void);
+
+/**
+ * @brief Get the caps string of a single request from the caps of batched tensors.
+ * @param caps The caps of batched tensors. The outermost dimension of each tensor is the batch.
+ * @param batch The number of requests in the batched tensors. Given caps is returned as string if batch is less than 2.
+ * @return Newly allocated caps string, NULL if given caps cannot be split with the batch. Caller should free returned value using g_free().
+ */
+gchar *
+gst_tensor_query_get_unbatched_caps_str (GstCaps * caps, guint batch);
+
+/**
+ * @brief Add the mapped memories to the edge data, encoding each memory with given codec.
+ * @param data_h The edge data to be sent
+ * @param map The mapped memories. Raw memories are not copied, keep them mapped until the data is sent.
+ * @param num_mems The number of mapped memories
+ * @param codec The compression method
+ * @param types The element type of each tensor (nullable)
+ * @param states The encoder state of each tensor
+ */
+void
+gst_tensor_query_add_encoded_data (nns_edge_data_h data_h, GstMapInfo * map,
+    guint num_mems, tensor_codec_e codec, const tensor_type * types,
+    GstTensorCodecState * states);
+
+/**
+ * @brief Decode the encoded memories of the received edge data.
+ * @param data_h The received edge data. It is released if the memories are decoded.
+ * @param max_sizes The max size of each decoded memory, 0 if unknown (nullable). See gst_tensor_codec_get_max_sizes().
+ * @return The edge data with decoded memories (given data if nothing is encoded), NULL on error.
+ */
+nns_edge_data_h
+gst_tensor_query_decode_data (nns_edge_data_h data_h, const gsize * max_sizes);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
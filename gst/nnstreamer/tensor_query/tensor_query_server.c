@@ -94,6 +94,7 @@ gst_tensor_query_server_add_data (const char *id,
   g_cond_init (&data->cond);
   data->id = g_strdup (id);
   data->configured = FALSE;
+  data->batch = 1;
 
   ret = nns_edge_create_handle (id, connect_type,
       NNS_EDGE_NODE_TYPE_QUERY_SERVER, &data->edge_h);
@@ -184,6 +185,40 @@ gst_tensor_query_server_set_configured (edge_server_handle server_h)
   g_mutex_unlock (&data->lock);
 }
 
+/**
+ * @brief Set the number of requests in a batched buffer.
+ */
+void
+gst_tensor_query_server_set_batch (edge_server_handle server_h, guint batch)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) server_h;
+  if (NULL == data) {
+    return;
+  }
+  g_mutex_lock (&data->lock);
+  data->batch = batch;
+  g_mutex_unlock (&data->lock);
+}
+
+/**
+ * @brief Get the number of requests in a batched buffer.
+ */
+guint
+gst_tensor_query_server_get_batch (edge_server_handle server_h)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) server_h;
+  guint batch;
+
+  if (NULL == data) {
+    return 1;
+  }
+  g_mutex_lock (&data->lock);
+  batch = data->batch;
+  g_mutex_unlock (&data->lock);
+
+  return batch;
+}
+
 /**
  * @brief Initialize the query server.
  */
@@ -31,6 +31,7 @@ typedef struct
 {
   char *id;
   gboolean configured;
+  guint batch; /**< the number of requests in a batched buffer (set by serversrc) */
   GMutex lock;
   GCond cond;
 
@@ -73,6 +74,18 @@ gst_tensor_query_server_get_edge_handle (edge_server_handle server_h);
 void
 gst_tensor_query_server_set_configured (edge_server_handle server_h);
 
+/**
+ * @brief Set the number of requests in a batched buffer.
+ */
+void
+gst_tensor_query_server_set_batch (edge_server_handle server_h, guint batch);
+
+/**
+ * @brief Get the number of requests in a batched buffer.
+ */
+guint
+gst_tensor_query_server_get_batch (edge_server_handle server_h);
+
 G_END_DECLS
 
 #endif /* __GST_TENSOR_QUERY_CLIENT_H__ */
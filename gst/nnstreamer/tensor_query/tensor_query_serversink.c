@@ -219,7 +219,13 @@ gst_tensor_query_serversink_set_caps (GstBaseSink * bsink, GstCaps * caps)
   GstTensorQueryServerSink *sink = GST_TENSOR_QUERY_SERVERSINK (bsink);
   gchar *caps_str, *prev_caps_str, *new_caps_str;
 
-  caps_str = gst_caps_to_string (caps);
+  /* The clients receive the result of a request, not the batched tensors. */
+  caps_str = gst_tensor_query_get_unbatched_caps_str (caps,
+      gst_tensor_query_server_get_batch (sink->server_h));
+  if (!caps_str) {
+    nns_loge ("Failed to get the caps of a response from the batched tensors.");
+    return FALSE;
+  }
 
   nns_edge_get_info (sink->edge_h, "CAPS", &prev_caps_str);
   if (!prev_caps_str)
@@ -234,6 +240,76 @@ gst_tensor_query_serversink_set_caps (GstBaseSink * bsink, GstCaps * caps)
   return TRUE;
 }
 
+/**
+ * @brief Split the batched buffer and send the result of each request to the client.
+ */
+static GstFlowReturn
+_gst_tensor_query_serversink_send_batch (GstTensorQueryServerSink * sink,
+    GstBuffer * buf, GstMetaQuery * meta_query)
+{
+  nns_edge_data_h data_h;
+  guint i, k, num_mems;
+  GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
+  GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
+  GstFlowReturn ret = GST_FLOW_OK;
+  gsize chunk;
+  char *val;
+
+  num_mems = gst_buffer_n_memory (buf);
+  if (num_mems > NNS_TENSOR_SIZE_LIMIT ||
+      meta_query->num_requests > meta_query->batch_size ||
+      meta_query->batch_size > QUERY_META_MAX_BATCH) {
+    nns_loge ("Invalid batched buffer in server sink.");
+    return GST_FLOW_ERROR;
+  }
+
+  for (i = 0; i < num_mems; i++) {
+    mem[i] = gst_buffer_peek_memory (buf, i);
+    if (!gst_memory_map (mem[i], &map[i], GST_MAP_READ)) {
+      ml_loge ("Cannot map the %uth memory in gst-buffer.", i);
+      num_mems = i;
+      ret = GST_FLOW_ERROR;
+      goto done;
+    }
+
+    if (map[i].size % meta_query->batch_size != 0) {
+      nns_loge ("The size of the %uth tensor (%" G_GSIZE_FORMAT
+          ") is not a multiple of the batch (%u).", i, map[i].size,
+          meta_query->batch_size);
+      num_mems = i + 1;
+      ret = GST_FLOW_ERROR;
+      goto done;
+    }
+  }
+
+  for (k = 0; k < meta_query->num_requests; k++) {
+    if (nns_edge_data_create (&data_h) != NNS_EDGE_ERROR_NONE) {
+      nns_loge ("Failed to create data handle in server sink.");
+      ret = GST_FLOW_ERROR;
+      goto done;
+    }
+
+    for (i = 0; i < num_mems; i++) {
+      chunk = map[i].size / meta_query->batch_size;
+      nns_edge_data_add (data_h, map[i].data + k * chunk, chunk, NULL);
+    }
+
+    val = g_strdup_printf ("%lld",
+        (long long) meta_query->batch_client_ids[k]);
+    nns_edge_data_set_info (data_h, "client_id", val);
+    g_free (val);
+
+    nns_edge_send (sink->edge_h, data_h);
+    nns_edge_data_destroy (data_h);
+  }
+
+done:
+  for (i = 0; i < num_mems; i++)
+    gst_memory_unmap (mem[i], &map[i]);
+
+  return ret;
+}
+
 /**
  * @brief render buffer, send buffer to client
  */
@@ -250,7 +326,11 @@ gst_tensor_query_serversink_render (GstBaseSink * bsink, GstBuffer * buf)
   char *val;
 
   meta_query = gst_buffer_get_meta_query (buf);
-  if (meta_query) {
+  if (meta_query && meta_query->batch_size > 1) {
+    sink->metaless_frame_count = 0;
+
+    return _gst_tensor_query_serversink_send_batch (sink, buf, meta_query);
+  } else if (meta_query) {
     sink->metaless_frame_count = 0;
 
     ret = nns_edge_data_create (&data_h);
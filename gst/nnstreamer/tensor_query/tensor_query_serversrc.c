@@ -14,6 +14,7 @@
 #include <config.h>
 #endif
 
+#include <string.h>
 #include <tensor_typedef.h>
 #include <tensor_common.h>
 #include "tensor_query_serversrc.h"
@@ -27,6 +28,9 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_serversrc_debug);
 #define DEFAULT_IS_LIVE TRUE
 #define DEFAULT_MQTT_HOST "127.0.0.1"
 #define DEFAULT_MQTT_PORT 1883
+#define DEFAULT_MAX_QUEUE 0
+#define DEFAULT_MAX_BATCH 1
+#define DEFAULT_MAX_DELAY 0
 
 /**
  * @brief the capabilities of the outputs
@@ -50,7 +54,13 @@ enum
   PROP_TIMEOUT,
   PROP_TOPIC,
   PROP_ID,
-  PROP_IS_LIVE
+  PROP_IS_LIVE,
+  PROP_MAX_QUEUE,
+  PROP_OVERLOAD_POLICY,
+  PROP_QUEUE_DEPTH,
+  PROP_DROPPED,
+  PROP_MAX_BATCH,
+  PROP_MAX_DELAY
 };
 
 #define gst_tensor_query_serversrc_parent_class parent_class
@@ -125,6 +135,35 @@ gst_tensor_query_serversrc_class_init (GstTensorQueryServerSrcClass * klass)
       g_param_spec_boolean ("is-live", "Is Live",
           "Synchronize the incoming buffers' timestamp with the current running time",
           DEFAULT_IS_LIVE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_QUEUE,
+      g_param_spec_uint ("max-queue", "Max queue",
+          "The max number of pending requests (0 for unlimited)", 0,
+          G_MAXINT, DEFAULT_MAX_QUEUE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OVERLOAD_POLICY,
+      g_param_spec_enum ("overload-policy", "Overload policy",
+          "The policy to drop the request when the queue is full",
+          GST_TYPE_QUERY_OVERLOAD_POLICY, DEFAULT_OVERLOAD_POLICY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_QUEUE_DEPTH,
+      g_param_spec_uint ("queue-depth", "Queue depth",
+          "The number of pending requests in the queue", 0, G_MAXUINT, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DROPPED,
+      g_param_spec_uint ("dropped", "Dropped",
+          "The number of requests dropped by the overload policy", 0,
+          G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_BATCH,
+      g_param_spec_uint ("max-batch", "Max batch",
+          "The max number of requests from the clients combined into a batched buffer. "
+          "If larger than 1, the outermost dimension of the tensors is the batch.",
+          1, QUERY_META_MAX_BATCH, DEFAULT_MAX_BATCH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_DELAY,
+      g_param_spec_uint ("max-delay", "Max delay",
+          "The max time (in milliseconds) to wait for the requests to fill the batch "
+          "(0 to batch the pending requests only)", 0, G_MAXUINT,
+          DEFAULT_MAX_DELAY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&srctemplate));
@@ -157,6 +196,12 @@ gst_tensor_query_serversrc_init (GstTensorQueryServerSrc * src)
   src->src_id = DEFAULT_SERVER_ID;
   src->configured = FALSE;
   src->msg_queue = g_async_queue_new ();
+  src->max_queue = DEFAULT_MAX_QUEUE;
+  src->overload_policy = DEFAULT_OVERLOAD_POLICY;
+  src->dropped = 0;
+  src->max_batch = DEFAULT_MAX_BATCH;
+  src->max_delay = DEFAULT_MAX_DELAY;
+  src->pending_data = NULL;
 
   gst_base_src_set_format (GST_BASE_SRC (src), GST_FORMAT_TIME);
   /** set the timestamps on each buffer */
@@ -186,6 +231,11 @@ gst_tensor_query_serversrc_finalize (GObject * object)
   }
   g_async_queue_unref (src->msg_queue);
 
+  if (src->pending_data) {
+    nns_edge_data_destroy (src->pending_data);
+    src->pending_data = NULL;
+  }
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -242,12 +292,39 @@ gst_tensor_query_serversrc_set_property (GObject * object, guint prop_id,
       gst_base_src_set_live (GST_BASE_SRC (serversrc),
           g_value_get_boolean (value));
       break;
+    case PROP_MAX_QUEUE:
+      serversrc->max_queue = g_value_get_uint (value);
+      break;
+    case PROP_OVERLOAD_POLICY:
+      serversrc->overload_policy = g_value_get_enum (value);
+      break;
+    case PROP_MAX_BATCH:
+      serversrc->max_batch = g_value_get_uint (value);
+      break;
+    case PROP_MAX_DELAY:
+      serversrc->max_delay = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/**
+ * @brief Get the number of pending requests, including the request kept for the next batch.
+ * @note The caller should hold the lock of the message queue.
+ */
+static guint
+_gst_tensor_query_serversrc_get_depth_unlocked (GstTensorQueryServerSrc * src)
+{
+  guint depth = MAX (0, g_async_queue_length_unlocked (src->msg_queue));
+
+  if (src->pending_data)
+    depth++;
+
+  return depth;
+}
+
 /**
  * @brief get property of query_serversrc
  */
@@ -286,12 +363,101 @@ gst_tensor_query_serversrc_get_property (GObject * object, guint prop_id,
       g_value_set_boolean (value,
           gst_base_src_is_live (GST_BASE_SRC (serversrc)));
       break;
+    case PROP_MAX_QUEUE:
+      g_value_set_uint (value, serversrc->max_queue);
+      break;
+    case PROP_OVERLOAD_POLICY:
+      g_value_set_enum (value, serversrc->overload_policy);
+      break;
+    case PROP_QUEUE_DEPTH:
+      g_async_queue_lock (serversrc->msg_queue);
+      g_value_set_uint (value,
+          _gst_tensor_query_serversrc_get_depth_unlocked (serversrc));
+      g_async_queue_unlock (serversrc->msg_queue);
+      break;
+    case PROP_DROPPED:
+      g_value_set_uint (value, g_atomic_int_get (&serversrc->dropped));
+      break;
+    case PROP_MAX_BATCH:
+      g_value_set_uint (value, serversrc->max_batch);
+      break;
+    case PROP_MAX_DELAY:
+      g_value_set_uint (value, serversrc->max_delay);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/**
+ * @brief Send an error response to the client of the dropped request.
+ */
+static void
+_gst_tensor_query_serversrc_send_error (GstTensorQueryServerSrc * src,
+    nns_edge_data_h dropped_h, const gchar * reason)
+{
+  nns_edge_data_h data_h;
+  char *val = NULL;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (dropped_h, "client_id",
+          &val))
+    return;
+
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_create (&data_h)) {
+    nns_edge_data_set_info (data_h, "client_id", val);
+    nns_edge_data_set_info (data_h, QUERY_ERROR_INFO_KEY, reason);
+
+    if (NNS_EDGE_ERROR_NONE != nns_edge_send (src->edge_h, data_h))
+      nns_logw ("Failed to send the error response to the client %s.", val);
+
+    nns_edge_data_destroy (data_h);
+  }
+
+  g_free (val);
+}
+
+/**
+ * @brief Push the received request into the message queue, drop the request if the queue is full.
+ * The client of the dropped request gets an error response instead of the result.
+ */
+static void
+_gst_tensor_query_serversrc_push_data (GstTensorQueryServerSrc * src,
+    nns_edge_data_h data_h)
+{
+  nns_edge_data_h dropped = NULL;
+
+  g_async_queue_lock (src->msg_queue);
+  if (src->max_queue > 0 &&
+      _gst_tensor_query_serversrc_get_depth_unlocked (src) >= src->max_queue) {
+    if (src->overload_policy == QUERY_OVERLOAD_SHED) {
+      /* The request kept for the next batch is the oldest one. */
+      if (src->pending_data) {
+        dropped = src->pending_data;
+        src->pending_data = NULL;
+      } else {
+        dropped = g_async_queue_try_pop_unlocked (src->msg_queue);
+      }
+      g_async_queue_push_unlocked (src->msg_queue, data_h);
+    } else {
+      dropped = data_h;
+    }
+  } else {
+    g_async_queue_push_unlocked (src->msg_queue, data_h);
+  }
+  g_async_queue_unlock (src->msg_queue);
+
+  if (dropped) {
+    g_atomic_int_inc (&src->dropped);
+    nns_logw ("The request queue is full (max-queue %u), drop the %s request.",
+        src->max_queue,
+        (src->overload_policy == QUERY_OVERLOAD_SHED) ? "oldest" : "incoming");
+    _gst_tensor_query_serversrc_send_error (src, dropped,
+        "The request queue of the server is full.");
+    nns_edge_data_destroy (dropped);
+  }
+}
+
 /**
  * @brief nnstreamer-edge event callback.
  */
@@ -311,9 +477,24 @@ _nns_edge_event_cb (nns_edge_event_h event_h, void *user_data)
     case NNS_EDGE_EVENT_NEW_DATA_RECEIVED:
     {
       nns_edge_data_h data;
+      gsize max_sizes[NNS_TENSOR_SIZE_LIMIT];
+      GstCaps *caps;
+      guint i;
 
       nns_edge_event_parse_new_data (event_h, &data);
-      g_async_queue_push (src->msg_queue, data);
+
+      /* The decoded request cannot be larger than the negotiated tensor. */
+      caps = gst_pad_get_current_caps (GST_BASE_SRC_PAD (src));
+      gst_tensor_codec_get_max_sizes (caps, max_sizes);
+      for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++)
+        max_sizes[i] /= src->max_batch;
+      if (caps)
+        gst_caps_unref (caps);
+
+      /* Decode in the receiving thread, before it is batched or queued. */
+      data = gst_tensor_query_decode_data (data, max_sizes);
+      if (data)
+        _gst_tensor_query_serversrc_push_data (src, data);
       break;
     }
     default:
@@ -355,6 +536,7 @@ gst_tensor_query_serversrc_start (GstBaseSrc * bsrc)
     nns_edge_set_info (src->edge_h, "TOPIC", src->topic);
 
   nns_edge_set_event_callback (src->edge_h, _nns_edge_event_cb, src);
+  gst_tensor_query_server_set_batch (src->server_h, src->max_batch);
 
   if (NNS_EDGE_ERROR_NONE != nns_edge_start (src->edge_h)) {
     nns_loge
@@ -370,6 +552,23 @@ gst_tensor_query_serversrc_start (GstBaseSrc * bsrc)
   return TRUE;
 }
 
+/**
+ * @brief Get client ID of the request.
+ */
+static gboolean
+_gst_tensor_query_serversrc_get_client_id (nns_edge_data_h data_h,
+    query_client_id_t * client_id)
+{
+  char *val;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "client_id", &val))
+    return FALSE;
+
+  *client_id = g_ascii_strtoll (val, NULL, 10);
+  g_free (val);
+  return TRUE;
+}
+
 /**
  * @brief Get buffer from message queue.
  */
@@ -380,6 +579,7 @@ _gst_tensor_query_serversrc_get_buffer (GstTensorQueryServerSrc * src)
   GstBuffer *buffer = NULL;
   guint i, num_data;
   GstMetaQuery *meta_query;
+  query_client_id_t client_id;
   int ret;
 
   data_h = g_async_queue_pop (src->msg_queue);
@@ -411,15 +611,11 @@ _gst_tensor_query_serversrc_get_buffer (GstTensorQueryServerSrc * src)
 
   meta_query = gst_buffer_add_meta_query (buffer);
   if (meta_query) {
-    char *val;
-
-    ret = nns_edge_data_get_info (data_h, "client_id", &val);
-    if (NNS_EDGE_ERROR_NONE != ret) {
+    if (!_gst_tensor_query_serversrc_get_client_id (data_h, &client_id)) {
       gst_buffer_unref (buffer);
       buffer = NULL;
     } else {
-      meta_query->client_id = g_ascii_strtoll (val, NULL, 10);
-      g_free (val);
+      meta_query->client_id = client_id;
     }
   }
 
@@ -428,6 +624,140 @@ done:
   return buffer;
 }
 
+/**
+ * @brief Check the request can be batched with the first request in the batch.
+ */
+static gboolean
+_gst_tensor_query_serversrc_is_batchable (nns_edge_data_h data_h,
+    guint num_data, const nns_size_t * sizes)
+{
+  guint i, count;
+  void *data;
+  nns_size_t data_len;
+
+  if (nns_edge_data_get_count (data_h, &count) != NNS_EDGE_ERROR_NONE ||
+      count != num_data)
+    return FALSE;
+
+  for (i = 0; i < num_data; i++) {
+    if (nns_edge_data_get (data_h, i, &data, &data_len) != NNS_EDGE_ERROR_NONE
+        || data_len != sizes[i])
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Get batched buffer of the requests from multiple clients.
+ * The requests are stacked in the outermost dimension, and the unused slots are filled with zero.
+ */
+static GstBuffer *
+_gst_tensor_query_serversrc_get_batched_buffer (GstTensorQueryServerSrc * src)
+{
+  nns_edge_data_h reqs[QUERY_META_MAX_BATCH];
+  query_client_id_t ids[QUERY_META_MAX_BATCH];
+  nns_size_t sizes[NNS_TENSOR_SIZE_LIMIT];
+  nns_edge_data_h data_h;
+  GstBuffer *buffer = NULL;
+  GstMetaQuery *meta_query;
+  guint i, k, n = 0, num_data = 0;
+  gint64 end_time, timeout;
+  void *data;
+  nns_size_t data_len;
+
+  /* Wait for the first request. */
+  while (n == 0) {
+    g_async_queue_lock (src->msg_queue);
+    data_h = src->pending_data;
+    src->pending_data = NULL;
+    g_async_queue_unlock (src->msg_queue);
+
+    if (!data_h)
+      data_h = g_async_queue_pop (src->msg_queue);
+
+    if (!data_h) {
+      nns_loge ("Failed to get message from the server message queue");
+      return NULL;
+    }
+
+    if (nns_edge_data_get_count (data_h, &num_data) != NNS_EDGE_ERROR_NONE ||
+        num_data == 0 || num_data > NNS_TENSOR_SIZE_LIMIT ||
+        !_gst_tensor_query_serversrc_get_client_id (data_h, &ids[0])) {
+      nns_loge ("Failed to parse the request, drop it.");
+      nns_edge_data_destroy (data_h);
+      continue;
+    }
+
+    for (i = 0; i < num_data; i++) {
+      nns_edge_data_get (data_h, i, &data, &data_len);
+      sizes[i] = data_len;
+    }
+
+    reqs[n++] = data_h;
+  }
+
+  /* Fill the batch with the pending requests until max-delay expires. */
+  end_time = g_get_monotonic_time () + src->max_delay * G_TIME_SPAN_MILLISECOND;
+  while (n < src->max_batch) {
+    if (src->max_delay == 0) {
+      data_h = g_async_queue_try_pop (src->msg_queue);
+    } else {
+      timeout = end_time - g_get_monotonic_time ();
+      if (timeout <= 0)
+        break;
+      data_h = g_async_queue_timeout_pop (src->msg_queue, timeout);
+    }
+
+    if (!data_h)
+      break;
+
+    if (!_gst_tensor_query_serversrc_is_batchable (data_h, num_data, sizes)) {
+      /* Keep it for the next batch. */
+      g_async_queue_lock (src->msg_queue);
+      src->pending_data = data_h;
+      g_async_queue_unlock (src->msg_queue);
+      break;
+    }
+
+    if (!_gst_tensor_query_serversrc_get_client_id (data_h, &ids[n])) {
+      nns_loge ("Failed to get client ID of the request, drop it.");
+      nns_edge_data_destroy (data_h);
+      continue;
+    }
+
+    reqs[n++] = data_h;
+  }
+
+  buffer = gst_buffer_new ();
+  for (i = 0; i < num_data; i++) {
+    guint8 *batched = (guint8 *) g_malloc0 (sizes[i] * src->max_batch);
+
+    for (k = 0; k < n; k++) {
+      nns_edge_data_get (reqs[k], i, &data, &data_len);
+      memcpy (batched + k * sizes[i], data, sizes[i]);
+    }
+
+    gst_buffer_append_memory (buffer,
+        gst_memory_new_wrapped (0, batched, sizes[i] * src->max_batch, 0,
+            sizes[i] * src->max_batch, batched, g_free));
+  }
+
+  meta_query = gst_buffer_add_meta_query (buffer);
+  if (meta_query) {
+    meta_query->client_id = ids[0];
+    meta_query->batch_size = src->max_batch;
+    meta_query->num_requests = n;
+    for (k = 0; k < n; k++)
+      meta_query->batch_client_ids[k] = ids[k];
+  }
+
+  for (k = 0; k < n; k++)
+    nns_edge_data_destroy (reqs[k]);
+
+  return buffer;
+}
+
 /**
  * @brief create query_serversrc, wait on socket and receive data
  */
@@ -445,7 +775,13 @@ gst_tensor_query_serversrc_create (GstPushSrc * psrc, GstBuffer ** outbuf)
       gst_base_src_set_caps (bsrc, caps);
     }
 
-    caps_str = gst_caps_to_string (caps);
+    caps_str = gst_tensor_query_get_unbatched_caps_str (caps, src->max_batch);
+    if (!caps_str) {
+      nns_loge ("Failed to get the caps of a request with max-batch %u.",
+          src->max_batch);
+      gst_caps_unref (caps);
+      return GST_FLOW_NOT_NEGOTIATED;
+    }
 
     nns_edge_get_info (src->edge_h, "CAPS", &prev_caps_str);
     if (!prev_caps_str)
@@ -461,7 +797,10 @@ gst_tensor_query_serversrc_create (GstPushSrc * psrc, GstBuffer ** outbuf)
     src->configured = TRUE;
   }
 
-  *outbuf = _gst_tensor_query_serversrc_get_buffer (src);
+  if (src->max_batch > 1)
+    *outbuf = _gst_tensor_query_serversrc_get_batched_buffer (src);
+  else
+    *outbuf = _gst_tensor_query_serversrc_get_buffer (src);
   if (*outbuf == NULL) {
     nns_loge ("Failed to get buffer to push to the tensor query serversrc.");
     return GST_FLOW_ERROR;
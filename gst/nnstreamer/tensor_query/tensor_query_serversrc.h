@@ -17,6 +17,7 @@
 #include <gst/base/gstpushsrc.h>
 #include <tensor_meta.h>
 #include "tensor_query_server.h"
+#include "tensor_query_common.h"
 
 G_BEGIN_DECLS
 
@@ -57,6 +58,16 @@ struct _GstTensorQueryServerSrc
   edge_server_handle server_h;
   nns_edge_h edge_h;
   GAsyncQueue *msg_queue;
+
+  /* Admission control */
+  guint max_queue; /**< max number of pending requests (0 for unlimited) */
+  query_overload_policy_e overload_policy; /**< policy when the queue is full */
+  guint dropped; /**< the number of dropped requests (atomic) */
+
+  /* Batching requests from multiple clients */
+  guint max_batch; /**< max number of requests in a batched buffer */
+  guint max_delay; /**< max time (ms) to wait for the requests to fill the batch */
+  nns_edge_data_h pending_data; /**< request not compatible with the previous batch */
 };
 
 /**
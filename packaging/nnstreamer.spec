@@ -35,6 +35,7 @@
 %define		tvm_support 1
 %define		snpe_support 1
 %define		trix_engine_support 1
+%define		onnxruntime_support 0
 # Support AI offloading (tensor_query) using nnstreamer-edge interface
 %define		nnstreamer_edge_support 1
 
@@ -107,6 +108,7 @@
 %define		tvm_support 0
 %define		snpe_support 0
 %define		trix_engine_support 0
+%define		onnxruntime_support 0
 %define		nnstreamer_edge_support 0
 %endif
 
@@ -121,6 +123,7 @@
 %define		mqtt_support 0
 %define		tvm_support 0
 %define		trix_engine_support 0
+%define		onnxruntime_support 0
 %endif
 
 # Release unit test suite as a subpackage only if check_test is enabled.
@@ -291,6 +294,10 @@ BuildRequires:	lua-devel
 BuildRequires:	tvm-runtime-devel
 %endif
 
+%if 0%{?onnxruntime_support}
+BuildRequires:	onnxruntime-devel
+%endif
+
 %if 0%{?snpe_support}
 BuildRequires:	snpe-devel
 %endif
@@ -473,6 +480,15 @@ Requires:	tvm
 NNStreamer's tensor_filter subplugin of tvm
 %endif
 
+%if 0%{?onnxruntime_support}
+%package onnxruntime
+Summary:	NNStreamer ONNX Runtime support
+Requires:	nnstreamer = %{version}-%{release}
+Requires:	onnxruntime
+%description onnxruntime
+NNStreamer's tensor_filter subplugin of ONNX Runtime
+%endif
+
 # for snpe
 %if 0%{?snpe_support}
 %package snpe
@@ -783,6 +799,13 @@ Provides additional gstreamer plugins for nnstreamer pipelines
 %define enable_tvm -Dtvm-support=disabled
 %endif
 
+# Support ONNX Runtime
+%if 0%{?onnxruntime_support}
+%define enable_onnxruntime -Donnxruntime-support=enabled
+%else
+%define enable_onnxruntime -Donnxruntime-support=disabled
+%endif
+
 # Support trix-engine
 %if 0%{?trix_engine_support}
 %define enable_trix_engine -Dtrix-engine-support=enabled
@@ -847,7 +870,7 @@ meson --buildtype=plain --prefix=%{_prefix} --sysconfdir=%{_sysconfdir} --libdir
 	%{enable_tf_lite} %{enable_tf2_lite} %{enable_tf} %{enable_pytorch} %{enable_caffe2} %{enable_python3} \
 	%{enable_nnfw_runtime} %{enable_mvncsdk2} %{enable_openvino} %{enable_armnn} %{enable_edgetpu}  %{enable_vivante} \
 	%{enable_flatbuf} %{enable_trix_engine} \
-	%{enable_tizen_sensor} %{enable_mqtt} %{enable_lua} %{enable_tvm} %{enable_test} %{enable_test_coverage} %{install_test} \
+	%{enable_tizen_sensor} %{enable_mqtt} %{enable_lua} %{enable_tvm} %{enable_onnxruntime} %{enable_test} %{enable_test_coverage} %{install_test} \
         %{fp16_support} \
 	build
 
@@ -889,6 +912,9 @@ export NNSTREAMER_CONVERTERS=${NNSTREAMER_BUILD_ROOT_PATH}/ext/nnstreamer/tensor
 %endif
 %ifarch %arm x86_64 aarch64 ## @todo This is a workaround. Need to remove %ifarch/%endif some day.
     bash %{test_script} ./tests/nnstreamer_filter_tvm
+%endif
+%if 0%{?onnxruntime_support}
+    bash %{test_script} ./tests/nnstreamer_filter_onnxruntime
 %endif
     pushd tests
 
@@ -1089,6 +1115,14 @@ cp -r result %{buildroot}%{_datadir}/nnstreamer/unittest/
 %{_prefix}/lib/nnstreamer/filters/libnnstreamer_filter_tvm.so
 %endif
 
+# for onnxruntime
+%if 0%{?onnxruntime_support}
+%files onnxruntime
+%manifest nnstreamer.manifest
+%defattr(-,root,root,-)
+%{_prefix}/lib/nnstreamer/filters/libnnstreamer_filter_onnxruntime.so
+%endif
+
 # for snpe
 %if 0%{?snpe_support}
 # Workaround: Conditionally enable nnstreamer-snpe rpm package
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include <glib.h>
 #include <glib/gstdio.h>
+#include <hw_accel.h>
 #include <nnstreamer_conf.h>
 #include <nnstreamer_plugin_api.h>
 #include <tensor_common.h>
@@ -1911,6 +1912,262 @@ TEST (commonUtil, createTensorBufferInvalidSize_n)
   EXPECT_FALSE (out != NULL);
 }
 
+/**
+ * @brief Test tensor buffer util (get the range in single memory without copy)
+ */
+TEST (commonUtil, getBufferRangeShared)
+{
+  GstBuffer *buffer;
+  GstMemory *mem, *range;
+  GstMapInfo map, range_map;
+  guint i;
+  guint8 *data;
+
+  data = (guint8 *) g_malloc (100);
+  for (i = 0; i < 100U; i++)
+    data[i] = i;
+
+  buffer = gst_buffer_new_wrapped (data, 100);
+  mem = gst_buffer_peek_memory (buffer, 0);
+
+  range = gst_tensor_buffer_get_range (buffer, 20, 30);
+  ASSERT_TRUE (range != NULL);
+  EXPECT_TRUE (range->parent == mem);
+
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (range, &range_map, GST_MAP_READ));
+  EXPECT_EQ (range_map.size, 30U);
+  EXPECT_TRUE (range_map.data == map.data + 20);
+  gst_memory_unmap (range, &range_map);
+  gst_memory_unmap (mem, &map);
+
+  gst_memory_unref (range);
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Test tensor buffer util (get the range over multiple memories)
+ */
+TEST (commonUtil, getBufferRangeCopied)
+{
+  GstBuffer *buffer;
+  GstMemory *range;
+  GstMapInfo map;
+  guint i;
+  guint8 *data1, *data2;
+
+  data1 = (guint8 *) g_malloc (50);
+  data2 = (guint8 *) g_malloc (50);
+  for (i = 0; i < 50U; i++) {
+    data1[i] = i;
+    data2[i] = i + 50;
+  }
+
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, gst_memory_new_wrapped (
+      (GstMemoryFlags) 0, data1, 50, 0, 50, data1, g_free));
+  gst_buffer_append_memory (buffer, gst_memory_new_wrapped (
+      (GstMemoryFlags) 0, data2, 50, 0, 50, data2, g_free));
+
+  range = gst_tensor_buffer_get_range (buffer, 40, 20);
+  ASSERT_TRUE (range != NULL);
+  EXPECT_TRUE (range->parent == NULL);
+
+  ASSERT_TRUE (gst_memory_map (range, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, 20U);
+  for (i = 0; i < 20U; i++)
+    EXPECT_EQ (map.data[i], i + 40);
+  gst_memory_unmap (range, &map);
+
+  gst_memory_unref (range);
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Test tensor buffer util (get the range in single memory which cannot be shared)
+ */
+TEST (commonUtil, getBufferRangeNoShare)
+{
+  GstBuffer *buffer;
+  GstMemory *mem, *range;
+  GstMapInfo map, range_map;
+  guint i;
+  guint8 *data;
+
+  data = (guint8 *) g_malloc (100);
+  for (i = 0; i < 100U; i++)
+    data[i] = i;
+
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, gst_memory_new_wrapped (
+      GST_MEMORY_FLAG_NO_SHARE, data, 100, 0, 100, data, g_free));
+  mem = gst_buffer_peek_memory (buffer, 0);
+
+  range = gst_tensor_buffer_get_range (buffer, 20, 30);
+  ASSERT_TRUE (range != NULL);
+  EXPECT_TRUE (range->parent == NULL);
+
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  ASSERT_TRUE (gst_memory_map (range, &range_map, GST_MAP_READ));
+  EXPECT_EQ (range_map.size, 30U);
+  EXPECT_TRUE (range_map.data != map.data + 20);
+  for (i = 0; i < 30U; i++)
+    EXPECT_EQ (range_map.data[i], i + 20);
+  gst_memory_unmap (range, &range_map);
+  gst_memory_unmap (mem, &map);
+
+  gst_memory_unref (range);
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Test tensor buffer util (get the range with invalid param)
+ */
+TEST (commonUtil, getBufferRangeInvalidParam_n)
+{
+  GstBuffer *buffer;
+
+  buffer = gst_buffer_new_allocate (NULL, 100, NULL);
+
+  EXPECT_TRUE (gst_tensor_buffer_get_range (NULL, 0, 10) == NULL);
+  EXPECT_TRUE (gst_tensor_buffer_get_range (buffer, 0, 0) == NULL);
+  EXPECT_TRUE (gst_tensor_buffer_get_range (buffer, 90, 20) == NULL);
+
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Dummy kernel for the test of CPU dispatch.
+ */
+static int
+_test_kernel_generic (int x)
+{
+  return x;
+}
+
+/**
+ * @brief Dummy kernel for the test of CPU dispatch, which requires all features.
+ */
+static int
+_test_kernel_all_features (int x)
+{
+  return -x;
+}
+
+/**
+ * @brief Test CPU features and the kernel dispatch.
+ */
+TEST (commonHwAccel, cpuKernelSelect)
+{
+  const cpu_kernel_variant variants[] = {
+    { G_MAXUINT, (gpointer) _test_kernel_all_features },
+    { CPU_FEATURE_NONE, (gpointer) _test_kernel_generic },
+  };
+  const cpu_kernel_variant detected[] = {
+    { cpu_get_features (), (gpointer) _test_kernel_all_features },
+    { CPU_FEATURE_NONE, (gpointer) _test_kernel_generic },
+  };
+
+  /* detected once */
+  EXPECT_EQ (cpu_get_features (), cpu_get_features ());
+
+  EXPECT_TRUE (cpu_kernel_select (variants) == (gpointer) _test_kernel_generic);
+  EXPECT_TRUE (cpu_kernel_select (detected) == (gpointer) _test_kernel_all_features);
+}
+
+/**
+ * @brief Test the names of CPU features.
+ */
+TEST (commonHwAccel, cpuFeaturesString)
+{
+  gchar *str;
+
+  str = cpu_get_features_string (CPU_FEATURE_NEON | CPU_FEATURE_DOTPROD);
+  EXPECT_STREQ (str, "neon,dotprod");
+  g_free (str);
+
+  str = cpu_get_features_string (CPU_FEATURE_AVX2 | CPU_FEATURE_AVX512_VNNI);
+  EXPECT_STREQ (str, "avx2,avx512vnni");
+  g_free (str);
+
+  str = cpu_get_features_string (CPU_FEATURE_NONE);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+}
+
+/**
+ * @brief Test to parse the CPU list.
+ */
+TEST (commonHwAccel, cpuParseList)
+{
+  GArray *cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  EXPECT_TRUE (cpu_parse_list ("0-3,6", cpus));
+  ASSERT_EQ (cpus->len, 5U);
+  EXPECT_EQ (g_array_index (cpus, guint, 0), 0U);
+  EXPECT_EQ (g_array_index (cpus, guint, 3), 3U);
+  EXPECT_EQ (g_array_index (cpus, guint, 4), 6U);
+  g_array_set_size (cpus, 0);
+
+  /* spaces and empty ranges are ignored */
+  EXPECT_TRUE (cpu_parse_list (" 2 , ,5-5 ", cpus));
+  ASSERT_EQ (cpus->len, 2U);
+  EXPECT_EQ (g_array_index (cpus, guint, 0), 2U);
+  EXPECT_EQ (g_array_index (cpus, guint, 1), 5U);
+  g_array_set_size (cpus, 0);
+
+  EXPECT_TRUE (cpu_parse_list ("", cpus));
+  EXPECT_EQ (cpus->len, 0U);
+
+  g_array_free (cpus, TRUE);
+}
+
+/**
+ * @brief Test to parse the CPU list with invalid string.
+ */
+TEST (commonHwAccel, cpuParseListInvalid_n)
+{
+  GArray *cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  EXPECT_FALSE (cpu_parse_list ("big", cpus));
+  EXPECT_FALSE (cpu_parse_list ("1-", cpus));
+  EXPECT_FALSE (cpu_parse_list ("-1", cpus));
+  EXPECT_FALSE (cpu_parse_list ("3-1", cpus));
+  EXPECT_FALSE (cpu_parse_list ("0-3x", cpus));
+  EXPECT_FALSE (cpu_parse_list ("0;1", cpus));
+  EXPECT_EQ (cpus->len, 0U);
+
+  g_array_free (cpus, TRUE);
+}
+
+/**
+ * @brief Test to parse the CPU list with the CPU out of range.
+ */
+TEST (commonHwAccel, cpuParseListOutOfRange_n)
+{
+  GArray *cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  EXPECT_FALSE (cpu_parse_list ("65535", cpus));
+  EXPECT_FALSE (cpu_parse_list ("0-99999999999", cpus));
+  EXPECT_FALSE (cpu_parse_list ("18446744073709551616", cpus));
+  EXPECT_EQ (cpus->len, 0U);
+
+  g_array_free (cpus, TRUE);
+}
+
+/**
+ * @brief Test to parse the CPU list with invalid param.
+ */
+TEST (commonHwAccel, cpuParseListInvalidParam_n)
+{
+  GArray *cpus = g_array_new (FALSE, FALSE, sizeof (guint));
+
+  EXPECT_FALSE (cpu_parse_list (NULL, cpus));
+  EXPECT_FALSE (cpu_parse_list ("0", NULL));
+
+  g_array_free (cpus, TRUE);
+}
+
 /**
  * @brief Main function for unit test.
  */
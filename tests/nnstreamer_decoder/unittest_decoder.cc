@@ -11,8 +11,11 @@
 #include <flatbuffers/flexbuffers.h>
 #include <glib.h>
 #include <gst/gst.h>
+#include <gst/check/gstharness.h>
+#include <gst/video/video.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_subplugin.h>
+#include <nnstreamer_util.h>
 #include <tensor_common.h>
 #include <unittest_util.h>
 #include <tensor_decoder_custom.h>
@@ -346,6 +349,461 @@ TEST (tensorDecoder, subpluginNullDesc_n)
   free_default_decoder (sub);
 }
 
+/** @brief tensordec-plugin's decodeBuffer callback */
+static GstFlowReturn
+decsub_decodeBuffer (void **pdata, const GstTensorsConfig *config,
+    const GstTensorMemory *input, const GstTensorDecoderContext *context,
+    GstBuffer *outbuf)
+{
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Test for plugin registration with decoder API v1, decodeBuffer should not be accessed.
+ */
+TEST (tensorDecoder, probeSubpluginV1)
+{
+  const GstTensorDecoderDef *found;
+  GstTensorDecoderDef *sub = get_default_decoder ("mode");
+
+  sub->decodeBuffer = decsub_decodeBuffer;
+  EXPECT_TRUE (nnstreamer_decoder_probe (sub));
+
+  found = nnstreamer_decoder_find ("mode");
+  ASSERT_TRUE (found != NULL);
+  EXPECT_TRUE (found->decode == decsub_decode);
+  EXPECT_TRUE (found->decodeBuffer == NULL);
+
+  nnstreamer_decoder_exit ("mode");
+  EXPECT_TRUE (nnstreamer_decoder_find ("mode") == NULL);
+  free_default_decoder (sub);
+}
+
+/**
+ * @brief Test for plugin registration with decoder API v2.
+ */
+TEST (tensorDecoder, probeSubpluginV2)
+{
+  const GstTensorDecoderDef *found;
+  GstTensorDecoderDef *sub = get_default_decoder ("mode");
+
+  sub->decodeBuffer = decsub_decodeBuffer;
+  EXPECT_TRUE (nnstreamer_decoder_probe_v2 (sub, sizeof (GstTensorDecoderDef)));
+
+  found = nnstreamer_decoder_find ("mode");
+  ASSERT_TRUE (found != NULL);
+  EXPECT_TRUE (found->decodeBuffer == decsub_decodeBuffer);
+
+  nnstreamer_decoder_exit ("mode");
+  free_default_decoder (sub);
+}
+
+/**
+ * @brief Test for plugin registration with decoder API v2 (invalid size of definition).
+ */
+TEST (tensorDecoder, probeSubpluginV2InvalidSize_n)
+{
+  GstTensorDecoderDef *sub = get_default_decoder ("mode");
+
+  sub->decodeBuffer = decsub_decodeBuffer;
+  EXPECT_FALSE (nnstreamer_decoder_probe_v2 (sub,
+      offsetof (GstTensorDecoderDef, decodeBuffer)));
+  EXPECT_TRUE (nnstreamer_decoder_find ("mode") == NULL);
+
+  free_default_decoder (sub);
+}
+
+/**
+ * @brief Test for plugin registration with decoder API v2 (invalid param).
+ */
+TEST (tensorDecoder, probeSubpluginV2InvalidParam_n)
+{
+  EXPECT_FALSE (nnstreamer_decoder_probe_v2 (NULL, sizeof (GstTensorDecoderDef)));
+}
+
+/**
+ * @brief Push a frame to direct_video decoder and pull the output buffer.
+ * Returns the data pointer of input memory in in_data.
+ */
+static GstBuffer *
+_direct_video_push_frame (GstHarness *h, gsize size, GstMemoryFlags flags,
+    gpointer *in_data)
+{
+  GstBuffer *in_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  gsize i;
+
+  mem = gst_allocator_alloc (NULL, size, NULL);
+  GST_MINI_OBJECT_FLAG_SET (mem, flags);
+
+  g_assert (gst_memory_map (mem, &map, GST_MAP_WRITE));
+  for (i = 0; i < size; i++)
+    map.data[i] = (guint8) i;
+  *in_data = map.data;
+  gst_memory_unmap (mem, &map);
+
+  in_buf = gst_buffer_new ();
+  gst_buffer_append_memory (in_buf, mem);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+
+  return gst_harness_pull (h);
+}
+
+/**
+ * @brief Check the data of video frame (each row is not padded).
+ */
+static void
+_direct_video_check_frame (GstBuffer *buf, gsize size)
+{
+  GstMapInfo map;
+  gsize i;
+
+  ASSERT_TRUE (gst_buffer_map (buf, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, size);
+  for (i = 0; i < size; i++)
+    EXPECT_EQ (map.data[i], (guint8) i);
+  gst_buffer_unmap (buf, &map);
+}
+
+/**
+ * @brief Test for direct_video decoder, the frame without padding is not copied.
+ */
+TEST (tensorDecoderDirectVideo, zeroCopyAligned)
+{
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstMapInfo map;
+  gpointer in_data;
+  const gsize size = 3 * 4 * 4;
+
+  h = gst_harness_new_parse ("tensor_decoder mode=direct_video");
+  gst_harness_set_src_caps_str (h, "other/tensors,num_tensors=1,format=static,"
+      "types=uint8,dimensions=3:4:4:1,framerate=0/1");
+
+  out_buf = _direct_video_push_frame (h, size, (GstMemoryFlags) 0, &in_data);
+  ASSERT_TRUE (out_buf != NULL);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_TRUE (map.data == in_data);
+  gst_buffer_unmap (out_buf, &map);
+
+  EXPECT_TRUE (gst_buffer_get_video_meta (out_buf) == NULL);
+  _direct_video_check_frame (out_buf, size);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for direct_video decoder, the stride is described with video meta.
+ */
+TEST (tensorDecoderDirectVideo, zeroCopyVideoMeta)
+{
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstVideoMeta *meta;
+  GstMapInfo map;
+  gpointer in_data;
+  const gsize size = 3 * 3 * 4;
+
+  h = gst_harness_new_parse ("tensor_decoder mode=direct_video");
+  gst_harness_add_propose_allocation_meta (h, GST_VIDEO_META_API_TYPE, NULL);
+  gst_harness_set_src_caps_str (h, "other/tensors,num_tensors=1,format=static,"
+      "types=uint8,dimensions=3:3:4:1,framerate=0/1");
+
+  out_buf = _direct_video_push_frame (h, size, (GstMemoryFlags) 0, &in_data);
+  ASSERT_TRUE (out_buf != NULL);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_TRUE (map.data == in_data);
+  gst_buffer_unmap (out_buf, &map);
+
+  meta = gst_buffer_get_video_meta (out_buf);
+  ASSERT_TRUE (meta != NULL);
+  EXPECT_EQ (meta->format, GST_VIDEO_FORMAT_RGB);
+  EXPECT_EQ (meta->width, 3U);
+  EXPECT_EQ (meta->height, 4U);
+  EXPECT_EQ (meta->stride[0], 9);
+  _direct_video_check_frame (out_buf, size);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for direct_video decoder, the frame is padded if downstream does not support video meta.
+ */
+TEST (tensorDecoderDirectVideo, copyWithoutVideoMeta)
+{
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstMapInfo map;
+  gpointer in_data;
+  guint r, c;
+
+  h = gst_harness_new_parse ("tensor_decoder mode=direct_video");
+  gst_harness_set_src_caps_str (h, "other/tensors,num_tensors=1,format=static,"
+      "types=uint8,dimensions=3:3:4:1,framerate=0/1");
+
+  out_buf = _direct_video_push_frame (h, 3 * 3 * 4, (GstMemoryFlags) 0, &in_data);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_TRUE (gst_buffer_get_video_meta (out_buf) == NULL);
+
+  /* each row (9 bytes) is padded to 12 bytes */
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_TRUE (map.data != in_data);
+  ASSERT_EQ (map.size, 12U * 4);
+  for (r = 0; r < 4; r++) {
+    for (c = 0; c < 9; c++)
+      EXPECT_EQ (map.data[r * 12 + c], (guint8) (r * 9 + c));
+  }
+  gst_buffer_unmap (out_buf, &map);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for direct_video decoder, the memory with no-share flag should be copied.
+ */
+TEST (tensorDecoderDirectVideo, copyNoShareMemory)
+{
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstMapInfo map;
+  gpointer in_data;
+  const gsize size = 3 * 4 * 4;
+
+  h = gst_harness_new_parse ("tensor_decoder mode=direct_video");
+  gst_harness_set_src_caps_str (h, "other/tensors,num_tensors=1,format=static,"
+      "types=uint8,dimensions=3:4:4:1,framerate=0/1");
+
+  out_buf = _direct_video_push_frame (h, size, GST_MEMORY_FLAG_NO_SHARE, &in_data);
+  ASSERT_TRUE (out_buf != NULL);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_TRUE (map.data != in_data);
+  gst_buffer_unmap (out_buf, &map);
+
+  _direct_video_check_frame (out_buf, size);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief The pipeline description of bounding_boxes decoder for the test (32x32 output).
+ */
+#define BB_TEST_DECODER "tensor_decoder mode=bounding_boxes " \
+    "option1=mobilenet-ssd-postprocess option4=32:32 option5=32:32"
+
+/**
+ * @brief The input caps of bounding_boxes decoder for the test.
+ */
+#define BB_TEST_CAPS "other/tensors,num_tensors=4,format=static," \
+    "types=(string)float32.float32.float32.float32," \
+    "dimensions=(string)1:1.2:1.2:1.4:2,framerate=(fraction)0/1"
+
+/**
+ * @brief Push the tensors (mobilenet-ssd-postprocess) to bounding_boxes decoder.
+ * One box is detected at (8,8) - (24,24) on the output frame.
+ */
+static void
+_bb_push_tensors (GstHarness *h)
+{
+  const float num[1] = { 1.0f };
+  const float classes[2] = { 0.0f, 0.0f };
+  const float scores[2] = { 0.9f, 0.0f };
+  const float boxes[8] = { 0.25f, 0.25f, 0.75f, 0.75f, 0.0f, 0.0f, 0.0f, 0.0f };
+  GstBuffer *in_buf;
+
+  in_buf = gst_buffer_new_wrapped (_g_memdup (num, sizeof (num)), sizeof (num));
+  in_buf = gst_buffer_append (in_buf,
+      gst_buffer_new_wrapped (_g_memdup (classes, sizeof (classes)), sizeof (classes)));
+  in_buf = gst_buffer_append (in_buf,
+      gst_buffer_new_wrapped (_g_memdup (scores, sizeof (scores)), sizeof (scores)));
+  in_buf = gst_buffer_append (in_buf,
+      gst_buffer_new_wrapped (_g_memdup (boxes, sizeof (boxes)), sizeof (boxes)));
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+}
+
+/**
+ * @brief Check the frame rendered by bounding_boxes decoder.
+ */
+static void
+_bb_check_frame (GstBuffer *buf)
+{
+  GstMapInfo map;
+  guint8 *pixel;
+
+  ASSERT_TRUE (gst_buffer_map (buf, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, 32U * 32 * 4);
+
+  /* background is transparent */
+  pixel = map.data;
+  EXPECT_EQ (pixel[0], 0U);
+  EXPECT_EQ (pixel[3], 0U);
+
+  /* top-left corner of the box, red 100% in RGBA */
+  pixel = map.data + (8 * 32 + 8) * 4;
+  EXPECT_EQ (pixel[0], 0xFFU);
+  EXPECT_EQ (pixel[1], 0U);
+  EXPECT_EQ (pixel[2], 0U);
+  EXPECT_EQ (pixel[3], 0xFFU);
+
+  /* inside of the box is not drawn */
+  pixel = map.data + (16 * 32 + 16) * 4;
+  EXPECT_EQ (pixel[3], 0U);
+
+  gst_buffer_unmap (buf, &map);
+}
+
+/**
+ * @brief Test for bounding_boxes decoder, the boxes are emitted as overlay rectangles if downstream supports overlay composition.
+ */
+TEST (tensorDecoderBoundingBox, overlayComposition)
+{
+  GstHarness *h;
+  GstBuffer *out_buf1, *out_buf2;
+  GstVideoOverlayCompositionMeta *meta;
+  GstVideoOverlayRectangle *rect;
+  GstMapInfo map1, map2;
+  gint x, y;
+  guint w, h_rect, i;
+
+  h = gst_harness_new_parse (BB_TEST_DECODER);
+  gst_harness_add_propose_allocation_meta (h,
+      GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE, NULL);
+  gst_harness_set_src_caps_str (h, BB_TEST_CAPS);
+
+  _bb_push_tensors (h);
+  _bb_push_tensors (h);
+  EXPECT_EQ (gst_harness_buffers_received (h), 2U);
+
+  out_buf1 = gst_harness_pull (h);
+  out_buf2 = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf1 != NULL && out_buf2 != NULL);
+
+  /* The transparent frame is shared and the box is not drawn on it. */
+  ASSERT_TRUE (gst_buffer_map (out_buf1, &map1, GST_MAP_READ));
+  ASSERT_TRUE (gst_buffer_map (out_buf2, &map2, GST_MAP_READ));
+  EXPECT_EQ (map1.size, 32U * 32 * 4);
+  EXPECT_TRUE (map1.data == map2.data);
+  for (i = 0; i < map1.size; i++) {
+    if (map1.data[i] != 0)
+      break;
+  }
+  EXPECT_EQ (i, map1.size);
+  gst_buffer_unmap (out_buf2, &map2);
+  gst_buffer_unmap (out_buf1, &map1);
+
+  meta = gst_buffer_get_video_overlay_composition_meta (out_buf1);
+  ASSERT_TRUE (meta != NULL);
+  ASSERT_EQ (gst_video_overlay_composition_n_rectangles (meta->overlay), 1U);
+
+  rect = gst_video_overlay_composition_get_rectangle (meta->overlay, 0);
+  gst_video_overlay_rectangle_get_render_rectangle (rect, &x, &y, &w, &h_rect);
+  EXPECT_EQ (x, 8);
+  EXPECT_EQ (y, 8);
+  EXPECT_EQ (w, 17U);
+  EXPECT_EQ (h_rect, 17U);
+
+  gst_buffer_unref (out_buf1);
+  gst_buffer_unref (out_buf2);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for bounding_boxes decoder, the frame is rendered into the buffer from the pool added by tensor_decoder.
+ */
+TEST (tensorDecoderBoundingBox, bufferPoolDefault)
+{
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstBufferPool *pool;
+
+  h = gst_harness_new_parse (BB_TEST_DECODER);
+  gst_harness_set_src_caps_str (h, BB_TEST_CAPS);
+
+  _bb_push_tensors (h);
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_TRUE (gst_buffer_get_video_overlay_composition_meta (out_buf) == NULL);
+
+  pool = out_buf->pool;
+  ASSERT_TRUE (pool != NULL);
+  gst_object_ref (pool);
+  _bb_check_frame (out_buf);
+  gst_buffer_unref (out_buf);
+
+  /* The next frame also comes from the same pool. */
+  _bb_push_tensors (h);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_TRUE (out_buf->pool == pool);
+  _bb_check_frame (out_buf);
+
+  gst_buffer_unref (out_buf);
+  gst_object_unref (pool);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Pad probe to propose the buffer pool from downstream.
+ */
+static GstPadProbeReturn
+_bb_propose_pool_probe (GstPad *pad, GstPadProbeInfo *info, gpointer user_data)
+{
+  GstQuery *query = GST_PAD_PROBE_INFO_QUERY (info);
+  GstBufferPool *pool = GST_BUFFER_POOL (user_data);
+  UNUSED (pad);
+
+  if (GST_QUERY_TYPE (query) == GST_QUERY_ALLOCATION &&
+      gst_query_get_n_allocation_pools (query) == 0)
+    gst_query_add_allocation_pool (query, pool, 32 * 32 * 4, 2, 0);
+
+  return GST_PAD_PROBE_OK;
+}
+
+/**
+ * @brief Test for bounding_boxes decoder, the frame is rendered into the buffer from the pool proposed by downstream.
+ */
+TEST (tensorDecoderBoundingBox, bufferPoolDownstream)
+{
+  GstHarness *h;
+  GstBuffer *out_buf;
+  GstBufferPool *pool;
+  GstPad *srcpad;
+
+  pool = gst_buffer_pool_new ();
+  h = gst_harness_new_parse (BB_TEST_DECODER);
+
+  srcpad = gst_element_get_static_pad (h->element, "src");
+  gst_pad_add_probe (srcpad, (GstPadProbeType) (GST_PAD_PROBE_TYPE_QUERY_DOWNSTREAM
+      | GST_PAD_PROBE_TYPE_PULL), _bb_propose_pool_probe, pool, NULL);
+  gst_object_unref (srcpad);
+
+  gst_harness_set_src_caps_str (h, BB_TEST_CAPS);
+
+  _bb_push_tensors (h);
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_TRUE (out_buf->pool == pool);
+  _bb_check_frame (out_buf);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+  gst_object_unref (pool);
+}
+
 /**
  * @brief Main GTest
  */
@@ -60,4 +60,19 @@ callCompareTest palm_detection_result_golden.0 palm_detection_result_0.log 5-0 "
 callCompareTest palm_detection_result_golden.1 palm_detection_result_1.log 5-1 "palm detection Decode 1" 0
 rm palm_detection_result_*.log
 
+# extract the box candidates with multiple threads, the result should be same
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_mux name=mux ! tensor_decoder mode=bounding_boxes option1=mobilenet-ssd option2=coco_labels_list.txt option3=box_priors.txt option4=160:120 option5=300:300 option7=4 ! videoconvert ! video/x-raw,format=BGRx ! multifilesink location=mobilenetssd_threads_output.%d  multifilesrc name=fs1 location=mobilenetssd_tensors.0.%d start-index=$CASESTART stop-index=$CASEEND caps=application/octet-stream ! tensor_converter input-dim=4:1:1917:1 input-type=float32 ! mux.sink_0  multifilesrc name=fs2 location=mobilenetssd_tensors.1.%d start-index=$CASESTART stop-index=$CASEEND caps=application/octet-stream ! tensor_converter input-dim=91:1917:1 input-type=float32 ! mux.sink_1  " 6 0 0 $PERFORMANCE
+
+callCompareTest mobilenetssd_golden.0 mobilenetssd_threads_output.0 6-1 "mobilenet-ssd Decode with threads 1" 0
+callCompareTest mobilenetssd_golden.1 mobilenetssd_threads_output.1 6-2 "mobilenet-ssd Decode with threads 2" 0
+rm mobilenetssd_threads_output.*
+
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_mux name=mux ! tensor_decoder mode=bounding_boxes option1=mp-palm-detection option3=0.5:4:1.0:1.0:0.5:0.5:8:16:16:16 option4=160:120 option5=300:300 option7=3 ! videoconvert !  video/x-raw,format=RGBA ! multifilesink location=palm_detection_threads_result_%1d.log \
+    multifilesrc location=palm_detection_input_0.%1d start-index=$CASESTART stop-index=$CASEEND caps=application/octet-stream ! tensor_converter input-dim=18:2016:1:1 input-type=float32 ! mux.sink_0 \
+    multifilesrc location=palm_detection_input_1.%1d start-index=$CASESTART stop-index=$CASEEND caps=application/octet-stream ! tensor_converter input-dim=1:2016:1:1 input-type=float32 ! mux.sink_1" 7 0 0 $PERFORMANCE
+
+callCompareTest palm_detection_result_golden.0 palm_detection_threads_result_0.log 7-0 "palm detection Decode with threads 0" 0
+callCompareTest palm_detection_result_golden.1 palm_detection_threads_result_1.log 7-1 "palm detection Decode with threads 1" 0
+rm palm_detection_threads_result_*.log
+
 report
@@ -93,6 +93,26 @@ for result in tensordecoder.orange.*.log; do
     let i++
 done
 
+# Top-k labels, the first label should be 'orange'.
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}\" ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format=RGB, framerate=0/1 ! tensor_converter ! tensor_filter framework=\"tensorflow1-lite\" model=\"${PATH_TO_MODEL}\" ! \
+tee name=t ! queue ! tensor_decoder mode=image_labeling option1=\"${PATH_TO_LABEL}\" option2=3 ! filesink location=\"tensordecoder.topk.log\" \
+t. ! queue ! tensor_decoder mode=image_labeling option1=\"${PATH_TO_LABEL}\" option3=256 ! filesink location=\"tensordecoder.threshold.log\"" D2 0 0 $PERFORMANCE
+
+label=$(head -n 1 tensordecoder.topk.log)
+num_labels=$(cat tensordecoder.topk.log | wc -l)
+if [ "$label" == "orange" ] && [ "$num_labels" == "2" ]; then
+    testResult 1 D2-1 "Decoding top-k labels"
+else
+    testResult 0 D2-1 "Decoding top-k labels"
+fi
+
+# uint8 score cannot be over the threshold, no label.
+if [[ ! -s tensordecoder.threshold.log ]]; then
+    testResult 1 D2-2 "Decoding labels with threshold"
+else
+    testResult 0 D2-2 "Decoding labels with threshold"
+fi
+
 rm *.log
 
 report
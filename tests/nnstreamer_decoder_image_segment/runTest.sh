@@ -97,6 +97,32 @@ videotestsrc num_buffers=1 ! videoconvert ! videoscale ! video/x-raw,format=RGB,
 videomixer name=mix sink_0::alpha=0.7 sink_1::alpha=0.6 ! videoconvert ! fakesink" \
 3_n 0 1
 
+# Label map with the rows partitioned to the threads should be the same as the one with a single thread.
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} \
+videotestsrc num-buffers=1 ! videoconvert ! videoscale ! video/x-raw,format=RGB,width=257,height=257 ! \
+    tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,div:255.0 ! \
+    tensor_filter framework=tensorflow1-lite model=${PATH_TO_MODEL} ! tee name=t \
+    t. ! queue ! tensor_decoder mode=image_segment option1=tflite-deeplab option3=label-map ! filesink location=test_output.label.1 \
+    t. ! queue ! tensor_decoder mode=image_segment option1=tflite-deeplab option3=label-map option4=4 ! filesink location=test_output.label.4" \
+4 0 0 $PERFORMANCE
+
+callCompareTest test_output.label.1 test_output.label.4 4-1 "label map with threads" 0
+
+label_size=$(stat -c %s test_output.label.4)
+if [[ "$label_size" == "66049" ]]; then
+    testResult 1 4-2 "label map size"
+else
+    testResult 0 4-2 "label map size"
+fi
+
+# THIS SHOULD EMIT ERROR (label map is not available for snpe-depth)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} \
+videotestsrc num_buffers=1 ! videoconvert ! videoscale ! video/x-raw,format=RGB,width=257,height=257 ! \
+    tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,div:255.0 ! \
+    tensor_filter framework=tensorflow1-lite model=${PATH_TO_MODEL} ! \
+    tensor_decoder mode=image_segment option1=snpe-depth option3=label-map ! fakesink" \
+5_n 0 1
+
 rm test_output.*
 
 report
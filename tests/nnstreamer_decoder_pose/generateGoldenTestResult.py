@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2021 Samsung Electronics
+#
+# @file generateGoldenTestResult.py
+# @brief Generate the heatmaps and the golden keypoints for pose decoder tests
+#
+# The heatmap (float32, 14:14:14:1, [height][width][#labels]) has all keypoints
+# of a person at the same cell, so the expected keypoints are exactly computable.
+# In heatmap-only mode, x = cell_x * width / i_width, y = cell_y * height / i_height.
+#
+
+import struct
+
+LABELS = 14
+GRID = 14
+OUT_WIDTH = 320
+OUT_HEIGHT = 240
+
+# (cell x, cell y) of the persons, far enough to be grouped separately
+PERSON_A = (2, 2)
+PERSON_B = (11, 11)
+
+
+##
+# @brief Write the heatmap with the given persons [(cell, score), ...]
+def write_heatmap(filename, persons):
+    heatmap = [0.0] * (GRID * GRID * LABELS)
+    for (cx, cy), score in persons:
+        base = (cy * GRID + cx) * LABELS
+        for k in range(LABELS):
+            heatmap[base + k] = score
+
+    with open(filename, 'wb') as f:
+        f.write(struct.pack('%df' % len(heatmap), *heatmap))
+
+
+##
+# @brief Get the keypoints (x, y, score) of max_poses poses, the persons are sorted by score
+def get_keypoints(persons, max_poses):
+    kpts = []
+    ordered = sorted(persons, key=lambda p: p[1], reverse=True)[:max_poses]
+    for (cx, cy), score in ordered:
+        x = (cx * OUT_WIDTH) // GRID
+        y = (cy * OUT_HEIGHT) // GRID
+        kpts += [float(x), float(y), score] * LABELS
+    kpts += [0.0] * (3 * LABELS * (max_poses - len(ordered)))
+    return struct.pack('%df' % len(kpts), *kpts)
+
+
+frames = [
+    [(PERSON_A, 0.875), (PERSON_B, 0.75)],
+    [(PERSON_A, 0.625), (PERSON_B, 0.9375)],
+    [(PERSON_A, 0.875)],
+]
+
+single = b''
+multi = b''
+for i, persons in enumerate(frames):
+    write_heatmap('pose_heatmap.%d' % i, persons)
+    single += get_keypoints(persons, 1)
+    multi += get_keypoints(persons, 3)
+
+with open('pose_single_golden.log', 'wb') as f:
+    f.write(single)
+
+with open('pose_multi_golden.log', 'wb') as f:
+    f.write(multi)
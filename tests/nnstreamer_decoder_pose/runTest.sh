@@ -23,6 +23,16 @@ PATH_TO_PLUGIN="../../build"
 CASESTART=0
 CASEEND=1
 
+if [ "$SKIPGEN" == "YES" ]; then
+    echo "Test Case Generation Skipped"
+else
+    echo "Test Case Generation Started"
+    python3 generateGoldenTestResult.py
+fi
+
+# Synthetic heatmaps (float32 14:14:14:1) with the golden keypoints
+HEATMAP_SRC="multifilesrc location=pose_heatmap.%d start-index=0 stop-index=2 caps=application/octet-stream ! tensor_converter input-dim=14:14:14:1 input-type=float32"
+
 # THIS SHOULD EMIT ERROR
 gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc ! videoconvert ! videoscale ! video/x-raw,width=640,height=480,format=RGB ! tensor_converter ! tensor_split name=a tensorseg=1:640:480:1,2:640:480:1 a.src_0 ! tensor_transform mode=transpose option=1:2:0:3 ! tensor_decoder mode=pose_estimation option1=320:240 option2=640:480 ! fakesink" 0_n 0 1 $PERFORMANCE
 
@@ -32,4 +42,34 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=4 ! videoc
 # TEST WITH MORE BUFFERS
 gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=20 ! videoconvert ! videoscale ! video/x-raw,width=14,height=14,format=RGB ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:128,div:255 ! tensor_split name=a tensorseg=1:14:14:1,2:14:14:1 a.src_0 ! tensor_transform mode=transpose option=1:2:0:3 ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 ! fakesink" 2 0 0 $PERFORMANCE
 
+# TEST MULTI-POSE DECODING
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=20 ! videoconvert ! videoscale ! video/x-raw,width=14,height=14,format=RGB ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:128,div:255 ! tensor_split name=a tensorseg=1:14:14:1,2:14:14:1 a.src_0 ! tensor_transform mode=transpose option=1:2:0:3 ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 option5=3:0.5:2 ! fakesink" 3 0 0 $PERFORMANCE
+
+# TEST MULTI-POSE KEYPOINTS WITH GOLDEN (float32 3:14:3 per frame, sorted by score)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} ${HEATMAP_SRC} ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 option5=3:0.5:0.5 option6=keypoints ! filesink location=pose_multi.log" 3-1 0 0 $PERFORMANCE
+callCompareTest pose_multi_golden.log pose_multi.log 3-2 "Golden test for multi-pose keypoints" 0 0
+
+# TEST MULTI-POSE RENDERING, A SINGLE PERSON SHOULD BE DRAWN AS THE SINGLE-POSE DOES
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} multifilesrc location=pose_heatmap.%d start-index=2 stop-index=2 caps=application/octet-stream ! tensor_converter input-dim=14:14:14:1 input-type=float32 ! tee name=t ! queue ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 option5=3:0.5:0.5 ! filesink location=pose_multi_render.log t. ! queue ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 ! filesink location=pose_single_render.log" 3-3 0 0 $PERFORMANCE
+callCompareTest pose_single_render.log pose_multi_render.log 3-4 "Compare multi-pose rendering with single-pose" 0 0
+
+# TEST KEYPOINT LIST OUTPUT (float32 3:14:1, 168 bytes per frame)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} ${HEATMAP_SRC} ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 option6=keypoints ! filesink location=keypoints.log" 4 0 0 $PERFORMANCE
+callCompareTest pose_single_golden.log keypoints.log 4-1 "Golden test for single-pose keypoints" 0 0
+
+# TEST KEYPOINT LIST SIZE WITH MAX POSES (float32 3:14:3, 504 bytes per frame)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=4 ! videoconvert ! videoscale ! video/x-raw,width=14,height=14,format=RGB ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:128,div:255 ! tensor_split name=a tensorseg=1:14:14:1,2:14:14:1 a.src_0 ! tensor_transform mode=transpose option=1:2:0:3 ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 option5=3 option6=keypoints ! filesink location=keypoints_multi.log" 4-2 0 0 $PERFORMANCE
+keypoints_size=$(stat -c %s keypoints_multi.log)
+if [[ "$keypoints_size" == "2016" ]]; then
+    testResult 1 4-3 "keypoint list size"
+else
+    testResult 0 4-3 "keypoint list size"
+fi
+
+# THIS SHOULD EMIT ERROR (invalid output format)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num_buffers=4 ! videoconvert ! videoscale ! video/x-raw,width=14,height=14,format=RGB ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:128,div:255 ! tensor_split name=a tensorseg=1:14:14:1,2:14:14:1 a.src_0 ! tensor_transform mode=transpose option=1:2:0:3 ! tensor_decoder mode=pose_estimation option1=320:240 option2=14:14 option6=invalid ! fakesink" 5_n 0 1 $PERFORMANCE
+
+rm -f keypoints.log keypoints_multi.log pose_multi.log pose_multi_render.log pose_single_render.log
+rm -f pose_heatmap.* pose_single_golden.log pose_multi_golden.log
+
 report
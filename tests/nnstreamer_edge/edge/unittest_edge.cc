@@ -14,6 +14,14 @@
 #include "unittest_util.h"
 #include <gst/app/gstappsrc.h>
 #include "nnstreamer_log.h"
+#include "tensor_typedef.h"
+#ifdef __linux__
+#include <stddef.h>
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
 
 static int data_received;
 
@@ -68,6 +76,12 @@ TEST (edgeSink, properties0)
   EXPECT_STREQ ("TEMP_TEST_TOPIC", str_val);
   g_free (str_val);
 
+  g_object_get (edge_handle, "compression", &int_val, NULL);
+  EXPECT_EQ (0, int_val);
+  g_object_set (edge_handle, "compression", 1, NULL);
+  g_object_get (edge_handle, "compression", &int_val, NULL);
+  EXPECT_EQ (1, int_val);
+
   gst_object_unref (edge_handle);
   gst_object_unref (gstpipe);
   g_free (pipeline);
@@ -279,6 +293,399 @@ TEST (edgeSinkSrc, runNormal)
   g_free (sink_pipeline);
 }
 
+/**
+ * @brief Test for edgesink and edgesrc with lossless compression.
+ */
+TEST (edgeSinkSrc, runNormalCompressed)
+{
+  gchar *sink_pipeline, *src_pipeline;
+  GstElement *sink_gstpipe, *src_gstpipe;
+  GstElement *appsrc_handle, *sink_handle, *edge_handle;
+  guint port;
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo info;
+  int ret, i;
+
+  /* Create a nnstreamer pipeline */
+  port= get_available_port ();
+  sink_pipeline = g_strdup_printf (
+      "appsrc name=appsrc ! other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! edgesink name=sinkx port=%u compression=lossless async=false", port);
+  sink_gstpipe = gst_parse_launch (sink_pipeline, NULL);
+  EXPECT_NE (sink_gstpipe, nullptr);
+
+  edge_handle = gst_bin_get_by_name (GST_BIN (sink_gstpipe), "sinkx");
+  EXPECT_NE (edge_handle, nullptr);
+  g_object_get (edge_handle, "port", &port, NULL);
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (sink_gstpipe), "appsrc");
+  EXPECT_NE (appsrc_handle, nullptr);
+
+  src_pipeline = g_strdup_printf (
+      "gst-launch-1.0 edgesrc dest-port=%u name=srcx ! "
+      "other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! "
+      "tensor_sink name=sinkx async=false", port);
+  src_gstpipe = gst_parse_launch (src_pipeline, NULL);
+  EXPECT_NE (src_gstpipe, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (src_gstpipe), "sinkx");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, NULL);
+
+  buf = gst_buffer_new ();
+  mem = gst_allocator_alloc (NULL, 192, NULL);
+  ret = gst_memory_map (mem, &info, GST_MAP_WRITE);
+  ASSERT_TRUE (ret);
+  memcpy (info.data, test_frames, 192);
+  gst_memory_unmap (mem, &info);
+  gst_buffer_append_memory (buf, mem);
+  data_received = 0;
+
+  EXPECT_EQ (setPipelineStateSync (sink_gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (1000000);
+
+  EXPECT_EQ (setPipelineStateSync (src_gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (1000000);
+
+  /* new_data_cb compares the decoded data with test frames */
+  buf = gst_buffer_ref (buf);
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf), GST_FLOW_OK);
+  g_usleep (100000);
+
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf), GST_FLOW_OK);
+
+  for (i = 0; i < 30 && data_received < 2; i++)
+    g_usleep (100000);
+
+  EXPECT_EQ (data_received, 2);
+
+  EXPECT_EQ (setPipelineStateSync (src_gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (setPipelineStateSync (sink_gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_object_unref (src_gstpipe);
+  g_free (src_pipeline);
+
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (edge_handle);
+  gst_object_unref (sink_handle);
+  gst_object_unref (sink_gstpipe);
+  g_free (sink_pipeline);
+}
+
+/**
+ * @brief Test for edgesink and edgesrc using local transport.
+ */
+TEST (edgeSinkSrc, runNormalLocal)
+{
+  gchar *sink_pipeline, *src_pipeline;
+  GstElement *sink_gstpipe, *src_gstpipe;
+  GstElement *appsrc_handle, *sink_handle;
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo info;
+  int ret;
+
+  /* Create a nnstreamer pipeline */
+  sink_pipeline = g_strdup_printf (
+      "appsrc name=appsrc ! other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! edgesink name=sinkx connect-type=LOCAL topic=localTestTopic async=false");
+  sink_gstpipe = gst_parse_launch (sink_pipeline, NULL);
+  EXPECT_NE (sink_gstpipe, nullptr);
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (sink_gstpipe), "appsrc");
+  EXPECT_NE (appsrc_handle, nullptr);
+
+  src_pipeline = g_strdup_printf (
+      "gst-launch-1.0 edgesrc connect-type=LOCAL topic=localTestTopic name=srcx ! "
+      "other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! "
+      "tensor_sink name=sinkx async=false");
+  src_gstpipe = gst_parse_launch (src_pipeline, NULL);
+  EXPECT_NE (src_gstpipe, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (src_gstpipe), "sinkx");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, NULL);
+
+  buf = gst_buffer_new ();
+  mem = gst_allocator_alloc (NULL, 192, NULL);
+  ret = gst_memory_map (mem, &info, GST_MAP_WRITE);
+  ASSERT_TRUE (ret);
+  memcpy (info.data, test_frames, 192);
+  gst_memory_unmap (mem, &info);
+  gst_buffer_append_memory (buf, mem);
+  data_received = 0;
+
+  EXPECT_EQ (setPipelineStateSync (sink_gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  EXPECT_EQ (setPipelineStateSync (src_gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  buf = gst_buffer_ref (buf);
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf), GST_FLOW_OK);
+  g_usleep (100000);
+
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf), GST_FLOW_OK);
+  g_usleep (100000);
+
+  EXPECT_EQ (data_received, 2);
+
+  EXPECT_EQ (setPipelineStateSync (src_gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (setPipelineStateSync (sink_gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_object_unref (src_gstpipe);
+  g_free (src_pipeline);
+
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (sink_handle);
+  gst_object_unref (sink_gstpipe);
+  g_free (sink_pipeline);
+}
+
+#ifdef __linux__
+/**
+ * @brief Connect to the local edge publisher without reading the messages.
+ */
+static int
+_connect_stuck_subscriber (const gchar *topic)
+{
+  struct sockaddr_un addr;
+  gchar *name;
+  gsize len;
+  int fd;
+
+  fd = socket (AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return -1;
+
+  name = g_strdup_printf ("nnstreamer-edge-%u/%s", getuid (), topic);
+  memset (&addr, 0, sizeof (addr));
+  addr.sun_family = AF_UNIX;
+  len = MIN (strlen (name), sizeof (addr.sun_path) - 1);
+  memcpy (addr.sun_path + 1, name, len);
+  g_free (name);
+
+  if (connect (fd, (struct sockaddr *) &addr,
+          (socklen_t) (offsetof (struct sockaddr_un, sun_path) + 1 + len)) != 0) {
+    close (fd);
+    return -1;
+  }
+
+  return fd;
+}
+
+/**
+ * @brief Test for local transport, a subscriber which does not read should not block the publisher.
+ */
+TEST (edgeSinkSrc, runLocalStuckSubscriber)
+{
+  gchar *sink_pipeline, *src_pipeline;
+  GstElement *sink_gstpipe, *src_gstpipe;
+  GstElement *appsrc_handle, *sink_handle;
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo info;
+  int ret, stuck_fd, i;
+  const int num_buffers = 100;
+
+  /* Create a nnstreamer pipeline */
+  sink_pipeline = g_strdup_printf (
+      "appsrc name=appsrc ! other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! edgesink name=sinkx connect-type=LOCAL topic=localStuckTopic async=false");
+  sink_gstpipe = gst_parse_launch (sink_pipeline, NULL);
+  EXPECT_NE (sink_gstpipe, nullptr);
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (sink_gstpipe), "appsrc");
+  EXPECT_NE (appsrc_handle, nullptr);
+
+  src_pipeline = g_strdup_printf (
+      "gst-launch-1.0 edgesrc connect-type=LOCAL topic=localStuckTopic name=srcx ! "
+      "other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! "
+      "tensor_sink name=sinkx async=false");
+  src_gstpipe = gst_parse_launch (src_pipeline, NULL);
+  EXPECT_NE (src_gstpipe, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (src_gstpipe), "sinkx");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, NULL);
+
+  buf = gst_buffer_new ();
+  mem = gst_allocator_alloc (NULL, 192, NULL);
+  ret = gst_memory_map (mem, &info, GST_MAP_WRITE);
+  ASSERT_TRUE (ret);
+  memcpy (info.data, test_frames, 192);
+  gst_memory_unmap (mem, &info);
+  gst_buffer_append_memory (buf, mem);
+  data_received = 0;
+
+  EXPECT_EQ (setPipelineStateSync (sink_gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  /* This subscriber never reads, its socket will be full. */
+  stuck_fd = _connect_stuck_subscriber ("localStuckTopic");
+  EXPECT_GE (stuck_fd, 0);
+
+  EXPECT_EQ (setPipelineStateSync (src_gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  for (i = 0; i < num_buffers; i++) {
+    EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), gst_buffer_ref (buf)), GST_FLOW_OK);
+    g_usleep (10000);
+  }
+
+  for (i = 0; i < 50 && data_received < num_buffers; i++)
+    g_usleep (100000);
+
+  EXPECT_EQ (data_received, num_buffers);
+
+  if (stuck_fd >= 0)
+    close (stuck_fd);
+
+  EXPECT_EQ (setPipelineStateSync (src_gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (setPipelineStateSync (sink_gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_buffer_unref (buf);
+  gst_object_unref (src_gstpipe);
+  g_free (src_pipeline);
+
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (sink_handle);
+  gst_object_unref (sink_gstpipe);
+  g_free (sink_pipeline);
+}
+
+/**
+ * @brief Message header of local edge, same as the one in edge_local.c.
+ */
+typedef struct
+{
+  guint32 magic;
+  guint32 num_mems;
+  guint64 offset[NNS_TENSOR_SIZE_LIMIT];
+  guint64 size[NNS_TENSOR_SIZE_LIMIT];
+} TestEdgeLocalHeader;
+
+/**
+ * @brief Test for local transport, the subscriber should reject the memory size over the file.
+ */
+TEST (edgeSinkSrc, runLocalForgedSize_n)
+{
+  gchar *src_pipeline, *name;
+  GstElement *src_gstpipe, *sink_handle;
+  struct sockaddr_un addr;
+  socklen_t addr_len;
+  TestEdgeLocalHeader header;
+  union
+  {
+    struct cmsghdr hdr;
+    gchar buf[CMSG_SPACE (sizeof (int))];
+  } cmsg_buf;
+  struct msghdr msg;
+  struct cmsghdr *cmsg;
+  struct iovec iov;
+  int listen_fd, client_fd, mem_fd, i;
+  gsize len;
+
+  /* A fake publisher sends 16 bytes memfd with larger size. */
+  listen_fd = socket (AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  ASSERT_GE (listen_fd, 0);
+
+  name = g_strdup_printf ("nnstreamer-edge-%u/%s", getuid (), "localForgedTopic");
+  memset (&addr, 0, sizeof (addr));
+  addr.sun_family = AF_UNIX;
+  len = MIN (strlen (name), sizeof (addr.sun_path) - 1);
+  memcpy (addr.sun_path + 1, name, len);
+  g_free (name);
+  addr_len = (socklen_t) (offsetof (struct sockaddr_un, sun_path) + 1 + len);
+
+  ASSERT_EQ (bind (listen_fd, (struct sockaddr *) &addr, addr_len), 0);
+  ASSERT_EQ (listen (listen_fd, 1), 0);
+
+  src_pipeline = g_strdup_printf (
+      "gst-launch-1.0 edgesrc connect-type=LOCAL topic=localForgedTopic name=srcx ! "
+      "other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! "
+      "tensor_sink name=sinkx async=false");
+  src_gstpipe = gst_parse_launch (src_pipeline, NULL);
+  EXPECT_NE (src_gstpipe, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (src_gstpipe), "sinkx");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, NULL);
+  data_received = 0;
+
+  EXPECT_EQ (setPipelineStateSync (src_gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  client_fd = accept (listen_fd, NULL, NULL);
+  ASSERT_GE (client_fd, 0);
+
+  mem_fd = memfd_create ("forged", MFD_CLOEXEC);
+  ASSERT_GE (mem_fd, 0);
+  ASSERT_EQ (ftruncate (mem_fd, 16), 0);
+
+  memset (&header, 0, sizeof (header));
+  header.magic = 0x4e4e534cU;
+  header.num_mems = 1;
+  header.size[0] = 192;
+
+  iov.iov_base = &header;
+  iov.iov_len = sizeof (header);
+  memset (&msg, 0, sizeof (msg));
+  memset (&cmsg_buf, 0, sizeof (cmsg_buf));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = cmsg_buf.buf;
+  msg.msg_controllen = sizeof (cmsg_buf.buf);
+
+  cmsg = CMSG_FIRSTHDR (&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN (sizeof (int));
+  memcpy (CMSG_DATA (cmsg), &mem_fd, sizeof (int));
+
+  EXPECT_EQ (sendmsg (client_fd, &msg, MSG_NOSIGNAL), (ssize_t) sizeof (header));
+
+  for (i = 0; i < 10 && data_received == 0; i++)
+    g_usleep (100000);
+
+  /* The frame is rejected, nothing is pushed to downstream. */
+  EXPECT_EQ (data_received, 0);
+
+  EXPECT_EQ (setPipelineStateSync (src_gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  close (mem_fd);
+  close (client_fd);
+  close (listen_fd);
+
+  gst_object_unref (sink_handle);
+  gst_object_unref (src_gstpipe);
+  g_free (src_pipeline);
+}
+#endif /* __linux__ */
+
+/**
+ * @brief Test for edgesrc using local transport without edgesink.
+ */
+TEST (edgeSinkSrc, runLocalNoPublisher_n)
+{
+  gchar *pipeline;
+  GstElement *gstpipe;
+
+  /* Create a nnstreamer pipeline */
+  pipeline = g_strdup_printf (
+      "gst-launch-1.0 edgesrc connect-type=LOCAL topic=localNoPublisherTopic name=srcx ! "
+      "other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! "
+      "tensor_sink");
+  gstpipe = gst_parse_launch (pipeline, NULL);
+  EXPECT_NE (gstpipe, nullptr);
+
+  EXPECT_NE (setPipelineStateSync (gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  gst_object_unref (gstpipe);
+  g_free (pipeline);
+}
+
 #ifdef ENABLE_AITT
 /**
  * @brief Check whether MQTT broker is running or not.
@@ -141,6 +141,33 @@ _callCompareTest raw8_2.log result8_2.log 8-5 "Compare 8-5" 1 0
 kill -9 $pid &> /dev/null
 wait $pid
 
+# Batched query test. The server combines the requests into a batched tensor (max-batch 2) and sends back the result of each request.
+PORT=`python3 ../../get_available_port.py`
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc port=${PORT} max-batch=2 max-delay=10 ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:2,types=(string)uint8,framerate=0/1 ! tensor_query_serversink async=false" 10-1 0 0 30
+pid=$!
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc is-live=true num-buffers=10 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name = t t. ! queue ! multifilesink location= raw10_%1d.log t. ! queue ! tensor_query_client port=0 dest-port=${PORT} ! multifilesink location=result10_%1d.log" 10-2 0 0 $PERFORMANCE $TIMEOUT_SEC
+_callCompareTest raw10_0.log result10_0.log 10-3 "Compare 10-3" 1 0
+_callCompareTest raw10_1.log result10_1.log 10-4 "Compare 10-4" 1 0
+_callCompareTest raw10_2.log result10_2.log 10-5 "Compare 10-5" 1 0
+kill -9 $pid &> /dev/null
+wait $pid
+
+# Concurrent clients test. Three clients send the requests at the same time, and each client should get the result of its own request.
+PORT=`python3 ../../get_available_port.py`
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc port=${PORT} max-batch=2 max-delay=10 max-queue=16 ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:2,types=(string)uint8,framerate=0/1 ! tensor_query_serversink async=false" 11-1 0 0 30
+pid=$!
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc is-live=true num-buffers=10 pattern=13 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name=t0 t0. ! queue ! multifilesink location=raw11_a_%1d.log t0. ! queue ! tensor_query_client port=0 dest-port=${PORT} ! multifilesink location=result11_a_%1d.log \
+    videotestsrc is-live=true num-buffers=10 pattern=18 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name=t1 t1. ! queue ! multifilesink location=raw11_b_%1d.log t1. ! queue ! tensor_query_client port=0 dest-port=${PORT} ! multifilesink location=result11_b_%1d.log \
+    videotestsrc is-live=true num-buffers=10 pattern=1 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name=t2 t2. ! queue ! multifilesink location=raw11_c_%1d.log t2. ! queue ! tensor_query_client port=0 dest-port=${PORT} ! multifilesink location=result11_c_%1d.log" 11-2 0 0 $PERFORMANCE $TIMEOUT_SEC
+_callCompareTest raw11_a_0.log result11_a_0.log 11-3 "Compare 11-3" 1 0
+_callCompareTest raw11_a_1.log result11_a_1.log 11-4 "Compare 11-4" 1 0
+_callCompareTest raw11_b_0.log result11_b_0.log 11-5 "Compare 11-5" 1 0
+_callCompareTest raw11_b_1.log result11_b_1.log 11-6 "Compare 11-6" 1 0
+_callCompareTest raw11_c_0.log result11_c_0.log 11-7 "Compare 11-7" 1 0
+_callCompareTest raw11_c_1.log result11_c_1.log 11-8 "Compare 11-8" 1 0
+kill -9 $pid &> /dev/null
+wait $pid
+
 if [ -f /usr/sbin/mosquitto ]
 then
   testResult 1 9-0 "mosquitto mqtt broker search" 1
@@ -125,6 +125,136 @@ TEST (tensorQuery, serverProperties0)
   g_free (pipeline);
 }
 
+/**
+ * @brief Test for tensor_query_serversrc properties for batching and admission control.
+ */
+TEST (tensorQuery, serverPropertiesBatch)
+{
+  gchar *pipeline;
+  GstElement *gstpipe;
+  GstElement *srv_handle;
+  gint int_val;
+  guint uint_val;
+
+  /* Create a nnstreamer pipeline */
+  pipeline = g_strdup_printf (
+      "tensor_query_serversrc name=serversrc ! "
+      "other/tensors,num_tensors=1,dimensions=3:300:300:4,types=uint8 ! "
+      "tensor_query_serversink name=serversink");
+  gstpipe = gst_parse_launch (pipeline, NULL);
+  EXPECT_NE (gstpipe, nullptr);
+
+  srv_handle = gst_bin_get_by_name (GST_BIN (gstpipe), "serversrc");
+  EXPECT_NE (srv_handle, nullptr);
+
+  /* Default values */
+  g_object_get (srv_handle, "max-batch", &uint_val, NULL);
+  EXPECT_EQ (1U, uint_val);
+
+  g_object_get (srv_handle, "max-delay", &uint_val, NULL);
+  EXPECT_EQ (0U, uint_val);
+
+  g_object_get (srv_handle, "max-queue", &uint_val, NULL);
+  EXPECT_EQ (0U, uint_val);
+
+  g_object_get (srv_handle, "overload-policy", &int_val, NULL);
+  EXPECT_EQ (QUERY_OVERLOAD_REJECT, int_val);
+
+  g_object_get (srv_handle, "queue-depth", &uint_val, NULL);
+  EXPECT_EQ (0U, uint_val);
+
+  g_object_get (srv_handle, "dropped", &uint_val, NULL);
+  EXPECT_EQ (0U, uint_val);
+
+  /* Set properties */
+  g_object_set (srv_handle, "max-batch", 4U, NULL);
+  g_object_get (srv_handle, "max-batch", &uint_val, NULL);
+  EXPECT_EQ (4U, uint_val);
+
+  g_object_set (srv_handle, "max-delay", 20U, NULL);
+  g_object_get (srv_handle, "max-delay", &uint_val, NULL);
+  EXPECT_EQ (20U, uint_val);
+
+  g_object_set (srv_handle, "max-queue", 8U, NULL);
+  g_object_get (srv_handle, "max-queue", &uint_val, NULL);
+  EXPECT_EQ (8U, uint_val);
+
+  g_object_set (srv_handle, "overload-policy", QUERY_OVERLOAD_SHED, NULL);
+  g_object_get (srv_handle, "overload-policy", &int_val, NULL);
+  EXPECT_EQ (QUERY_OVERLOAD_SHED, int_val);
+
+  gst_object_unref (srv_handle);
+  gst_object_unref (gstpipe);
+  g_free (pipeline);
+}
+
+/**
+ * @brief Test to get the caps of a request from the caps of batched tensors.
+ */
+TEST (tensorQuery, unbatchedCaps)
+{
+  GstCaps *caps, *result;
+  GstTensorsConfig config;
+  gchar *caps_str;
+
+  caps = gst_caps_from_string ("other/tensors,format=static,num_tensors=2,"
+      "dimensions=(string)\"3:300:300:4,10:4\",types=(string)\"uint8,float32\",framerate=(fraction)0/1");
+
+  caps_str = gst_tensor_query_get_unbatched_caps_str (caps, 4);
+  ASSERT_TRUE (caps_str != NULL);
+  result = gst_caps_from_string (caps_str);
+  EXPECT_TRUE (gst_tensors_config_from_structure (&config, gst_caps_get_structure (result, 0)));
+  EXPECT_EQ (config.info.num_tensors, 2U);
+  EXPECT_EQ (config.info.info[0].type, _NNS_UINT8);
+  EXPECT_EQ (config.info.info[0].dimension[0], 3U);
+  EXPECT_EQ (config.info.info[0].dimension[1], 300U);
+  EXPECT_EQ (config.info.info[0].dimension[2], 300U);
+  EXPECT_EQ (config.info.info[0].dimension[3], 1U);
+  EXPECT_EQ (config.info.info[1].type, _NNS_FLOAT32);
+  EXPECT_EQ (config.info.info[1].dimension[0], 10U);
+  EXPECT_EQ (config.info.info[1].dimension[1], 1U);
+  gst_tensors_config_free (&config);
+  gst_caps_unref (result);
+  g_free (caps_str);
+
+  /* No batch, same caps */
+  caps_str = gst_tensor_query_get_unbatched_caps_str (caps, 1);
+  ASSERT_TRUE (caps_str != NULL);
+  result = gst_caps_from_string (caps_str);
+  EXPECT_TRUE (gst_caps_is_equal (result, caps));
+  gst_caps_unref (result);
+  g_free (caps_str);
+
+  gst_caps_unref (caps);
+}
+
+/**
+ * @brief Test to get the caps of a request with invalid batch.
+ */
+TEST (tensorQuery, unbatchedCapsInvalid_n)
+{
+  GstCaps *caps;
+  gchar *caps_str;
+
+  /* The outermost dimension is not a multiple of the batch. */
+  caps = gst_caps_from_string ("other/tensors,format=static,num_tensors=1,"
+      "dimensions=(string)3:300:300:3,types=(string)uint8,framerate=(fraction)0/1");
+  caps_str = gst_tensor_query_get_unbatched_caps_str (caps, 2);
+  EXPECT_TRUE (caps_str == NULL);
+  gst_caps_unref (caps);
+
+  /* Batching requires static tensor stream. */
+  caps = gst_caps_from_string ("video/x-raw,format=RGB,width=300,height=300,framerate=(fraction)0/1");
+  caps_str = gst_tensor_query_get_unbatched_caps_str (caps, 2);
+  EXPECT_TRUE (caps_str == NULL);
+  gst_caps_unref (caps);
+
+  caps = gst_caps_from_string ("other/tensors,format=flexible,framerate=(fraction)0/1");
+  caps_str = gst_tensor_query_get_unbatched_caps_str (caps, 2);
+  EXPECT_TRUE (caps_str == NULL);
+  gst_caps_unref (caps);
+}
+
 /**
  * @brief Test for tensor_query_server with invalid host name.
  */
@@ -699,6 +699,390 @@ end
   sp->close (&prop, &data);
 }
 
+/**
+ * @brief Positive case with bulk operations for lua model
+ */
+TEST (nnstreamerFilterLua, bulkOps00)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output[3];
+  GstTensorFilterProperties prop;
+  const char *lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'uint8', }
+}
+outputTensorsInfo = {
+  num = 3,
+  dim = {{4, 1, 1, 1}, {4, 1, 1, 1}, {3, 1, 1, 1}, },
+  type = {'float32', 'float32', 'float32', }
+}
+function nnstreamer_invoke()
+  input = input_tensor(1)
+  scaled = output_tensor(1)
+  clamped = output_tensor(2)
+  result = output_tensor(3)
+
+  tensor_scale (scaled, input, 0.5, -1.0)
+  tensor_copy (clamped, scaled)
+  tensor_map (clamped, clamped, 'clamp', 0.0, 10.0)
+  idx, value = tensor_argmax (input)
+
+  result[1] = idx
+  result[2] = value
+  result[3] = #input
+end
+)"""";
+  const gchar *model_files[] = {
+    lua_script,
+    NULL,
+  };
+  const uint8_t in_data[4] = { 0U, 40U, 8U, 2U };
+  float *out;
+
+  input.size = sizeof (uint8_t) * 4;
+  input.data = g_malloc (input.size);
+  memcpy (input.data, in_data, input.size);
+
+  output[0].size = output[1].size = sizeof (float) * 4;
+  output[2].size = sizeof (float) * 3;
+  for (int i = 0; i < 3; i++)
+    output[i].data = g_malloc0 (output[i].size);
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, output);
+  EXPECT_EQ (ret, 0);
+
+  out = static_cast<float *> (output[0].data);
+  EXPECT_FLOAT_EQ (out[0], -1.0f);
+  EXPECT_FLOAT_EQ (out[1], 19.0f);
+  EXPECT_FLOAT_EQ (out[2], 3.0f);
+  EXPECT_FLOAT_EQ (out[3], 0.0f);
+
+  out = static_cast<float *> (output[1].data);
+  EXPECT_FLOAT_EQ (out[0], 0.0f);
+  EXPECT_FLOAT_EQ (out[1], 10.0f);
+  EXPECT_FLOAT_EQ (out[2], 3.0f);
+  EXPECT_FLOAT_EQ (out[3], 0.0f);
+
+  out = static_cast<float *> (output[2].data);
+  EXPECT_FLOAT_EQ (out[0], 2.0f);
+  EXPECT_FLOAT_EQ (out[1], 40.0f);
+  EXPECT_FLOAT_EQ (out[2], 4.0f);
+
+  g_free (input.data);
+  for (int i = 0; i < 3; i++)
+    g_free (output[i].data);
+  sp->close (&prop, &data);
+}
+
+/**
+ * @brief Negative case with bulk operations for lua model: different number of elements
+ */
+TEST (nnstreamerFilterLua, bulkOps01_n)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output;
+  GstTensorFilterProperties prop;
+  const char *lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'uint8', }
+}
+outputTensorsInfo = {
+  num = 1,
+  dim = {{2, 1, 1, 1}, },
+  type = {'uint8', }
+}
+function nnstreamer_invoke()
+  tensor_copy (output_tensor(1), input_tensor(1))
+end
+)"""";
+  const gchar *model_files[] = {
+    lua_script,
+    NULL,
+  };
+
+  input.size = sizeof (uint8_t) * 4;
+  output.size = sizeof (uint8_t) * 2;
+  input.data = g_malloc0 (input.size);
+  output.data = g_malloc0 (output.size);
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, &output);
+  EXPECT_NE (ret, 0);
+
+  g_free (input.data);
+  g_free (output.data);
+  sp->close (&prop, &data);
+}
+
+/**
+ * @brief Negative case with bulk operations for lua model: invalid operation
+ */
+TEST (nnstreamerFilterLua, bulkOps02_n)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output;
+  GstTensorFilterProperties prop;
+  const char *lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'float32', }
+}
+outputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'float32', }
+}
+function nnstreamer_invoke()
+  tensor_map (output_tensor(1), input_tensor(1), 'invalid')
+end
+)"""";
+  const gchar *model_files[] = {
+    lua_script,
+    NULL,
+  };
+
+  output.size = input.size = sizeof (float) * 4;
+  input.data = g_malloc0 (input.size);
+  output.data = g_malloc0 (output.size);
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, &output);
+  EXPECT_NE (ret, 0);
+
+  g_free (input.data);
+  g_free (output.data);
+  sp->close (&prop, &data);
+}
+
+/**
+ * @brief Positive case with FFI pointer of the tensors (LuaJIT only, bulk copy otherwise)
+ */
+TEST (nnstreamerFilterLua, ffi00)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output;
+  GstTensorFilterProperties prop;
+  const char *lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'int16', }
+}
+outputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'int16', }
+}
+function nnstreamer_invoke()
+  if input_tensor_ffi then
+    input, num = input_tensor_ffi(1)
+    output = output_tensor_ffi(1)
+    for i=0,num-1 do
+      output[i] = input[i] * 2
+    end
+  else
+    tensor_scale (output_tensor(1), input_tensor(1), 2)
+  end
+end
+)"""";
+  const gchar *model_files[] = {
+    lua_script,
+    NULL,
+  };
+  const int16_t in_data[4] = { -3, 0, 5, 100 };
+
+  output.size = input.size = sizeof (int16_t) * 4;
+  input.data = g_malloc (input.size);
+  output.data = g_malloc0 (output.size);
+  memcpy (input.data, in_data, input.size);
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, &output);
+  EXPECT_EQ (ret, 0);
+
+  for (int i = 0; i < 4; i++)
+    EXPECT_EQ (static_cast<int16_t *> (output.data)[i], in_data[i] * 2);
+
+  g_free (input.data);
+  g_free (output.data);
+  sp->close (&prop, &data);
+}
+
+#ifdef ENABLE_LUAJIT
+/**
+ * @brief Positive case with FFI pointer of the tensors, the sub-plugin built with LuaJIT should use FFI
+ */
+TEST (nnstreamerFilterLua, ffi01)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output;
+  GstTensorFilterProperties prop;
+  const char *lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'float32', }
+}
+outputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'float32', }
+}
+function nnstreamer_invoke()
+  input, num = input_tensor_ffi(1)
+  output = output_tensor_ffi(1)
+  if type(input) ~= 'cdata' or type(output) ~= 'cdata' or num ~= 4 then
+    error('The tensors are not accessed with FFI')
+  end
+  for i=0,num-1 do
+    output[i] = input[i] + 0.5
+  end
+end
+)"""";
+  const gchar *model_files[] = {
+    lua_script,
+    NULL,
+  };
+  const float in_data[4] = { -1.0f, 0.0f, 2.5f, 100.0f };
+
+  output.size = input.size = sizeof (float) * 4;
+  input.data = g_malloc (input.size);
+  output.data = g_malloc0 (output.size);
+  memcpy (input.data, in_data, input.size);
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, &output);
+  EXPECT_EQ (ret, 0);
+
+  for (int i = 0; i < 4; i++)
+    EXPECT_FLOAT_EQ (static_cast<float *> (output.data)[i], in_data[i] + 0.5f);
+
+  g_free (input.data);
+  g_free (output.data);
+  sp->close (&prop, &data);
+}
+#endif /* ENABLE_LUAJIT */
+
+/**
+ * @brief Positive case with the conversion of out-of-range values, clamped to the range of the type
+ */
+TEST (nnstreamerFilterLua, bulkOps03)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output[3];
+  GstTensorFilterProperties prop;
+  const char *lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{4, 1, 1, 1}, },
+  type = {'float64', }
+}
+outputTensorsInfo = {
+  num = 3,
+  dim = {{4, 1, 1, 1}, {4, 1, 1, 1}, {4, 1, 1, 1}, },
+  type = {'uint8', 'int16', 'float32', }
+}
+function nnstreamer_invoke()
+  tensor_copy (output_tensor(1), input_tensor(1))
+  tensor_scale (output_tensor(2), input_tensor(1), 1000.0)
+  tensor_map (output_tensor(3), input_tensor(1), 'clamp', -1e300, 1e300)
+end
+)"""";
+  const gchar *model_files[] = {
+    lua_script,
+    NULL,
+  };
+  const double in_data[4] = { -1e40, -3.0, 300.0, 1e40 };
+  uint8_t *u8;
+  int16_t *i16;
+  float *f32;
+
+  input.size = sizeof (double) * 4;
+  input.data = g_malloc (input.size);
+  memcpy (input.data, in_data, input.size);
+
+  output[0].size = sizeof (uint8_t) * 4;
+  output[1].size = sizeof (int16_t) * 4;
+  output[2].size = sizeof (float) * 4;
+  for (int i = 0; i < 3; i++)
+    output[i].data = g_malloc0 (output[i].size);
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, output);
+  EXPECT_EQ (ret, 0);
+
+  u8 = static_cast<uint8_t *> (output[0].data);
+  EXPECT_EQ (u8[0], 0U);
+  EXPECT_EQ (u8[1], 0U);
+  EXPECT_EQ (u8[2], 255U);
+  EXPECT_EQ (u8[3], 255U);
+
+  i16 = static_cast<int16_t *> (output[1].data);
+  EXPECT_EQ (i16[0], G_MININT16);
+  EXPECT_EQ (i16[1], -3000);
+  EXPECT_EQ (i16[2], G_MAXINT16);
+  EXPECT_EQ (i16[3], G_MAXINT16);
+
+  f32 = static_cast<float *> (output[2].data);
+  EXPECT_FLOAT_EQ (f32[0], -G_MAXFLOAT);
+  EXPECT_FLOAT_EQ (f32[1], -3.0f);
+  EXPECT_FLOAT_EQ (f32[2], 300.0f);
+  EXPECT_FLOAT_EQ (f32[3], G_MAXFLOAT);
+
+  g_free (input.data);
+  for (int i = 0; i < 3; i++)
+    g_free (output[i].data);
+  sp->close (&prop, &data);
+}
+
 /**
  * @brief Positive case with reload lua model file
  */
@@ -0,0 +1,427 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * @file    unittest_filter_onnxruntime.cc
+ * @date    19 Oct 2026
+ * @brief   Unit test for ONNX Runtime tensor filter sub-plugin
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs
+ */
+#include <gtest/gtest.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <gst/gst.h>
+#include <unistd.h>
+#include <unittest_util.h>
+
+#include <nnstreamer_plugin_api_filter.h>
+#include <nnstreamer_util.h>
+#include <tensor_common.h>
+
+/**
+ * @brief Test Fixture class for a tensor-filter ONNX Runtime functionality
+ * @note To prevent svace warning, initialize member variables in constructor.
+ */
+class NNStreamerFilterONNXRuntimeTest : public ::testing::Test
+{
+  protected:
+  const GstTensorFilterFramework *sp;
+  const gchar *wrong_model_files[2];
+  const gchar *proper_model_files[2];
+  gchar *model_file;
+  gchar *pipeline;
+  GstElement *gstpipe;
+  GstTensorMemory input;
+  GstTensorMemory output;
+
+  public:
+  /**
+   * @brief Construct a new NNStreamerFilterONNXRuntimeTest object
+   */
+  NNStreamerFilterONNXRuntimeTest ()
+      : sp (nullptr), model_file (nullptr), pipeline (nullptr), gstpipe (nullptr)
+  {
+    input.data = output.data = nullptr;
+    input.size = output.size = 0;
+    wrong_model_files[0] = wrong_model_files[1] = nullptr;
+    proper_model_files[0] = proper_model_files[1] = nullptr;
+  }
+
+  /**
+   * @brief Set tensor filter properties
+   */
+  void SetFilterProperty (GstTensorFilterProperties *prop, const gchar **models)
+  {
+    memset (prop, 0, sizeof (GstTensorFilterProperties));
+    prop->fwname = "onnxruntime";
+    prop->fw_opened = 0;
+    prop->model_files = models;
+    prop->num_models = g_strv_length ((gchar **) models);
+  }
+
+  /**
+   * @brief Invoke the model (add one) and check the output
+   */
+  void InvokeAndCheck (void *data)
+  {
+    float *in, *out;
+    guint i;
+
+    in = static_cast<float *> (input.data);
+    out = static_cast<float *> (output.data);
+
+    for (i = 0; i < 4; i++) {
+      in[i] = (float) i;
+      out[i] = 0.0f;
+    }
+
+    EXPECT_EQ (sp->invoke (NULL, NULL, data, &input, &output), 0);
+
+    for (i = 0; i < 4; i++)
+      EXPECT_FLOAT_EQ (out[i], (float) (i + 1));
+  }
+
+  /**
+   * @brief SetUp method for each test case
+   */
+  void SetUp () override
+  {
+    const gchar *src_root = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+    g_autofree gchar *root_path = src_root ? g_strdup (src_root) : g_get_current_dir ();
+
+    model_file = g_build_filename (root_path, "tests", "test_models", "models",
+        "onnxruntime_add_one.onnx", NULL);
+
+    wrong_model_files[0] = "temp.onnx";
+    proper_model_files[0] = model_file;
+
+    input.size = output.size = sizeof (float) * 4;
+    input.data = g_malloc0 (input.size);
+    output.data = g_malloc0 (output.size);
+
+    sp = nnstreamer_filter_find ("onnxruntime");
+  }
+
+  /**
+   * @brief TearDown method for each test case
+   */
+  void TearDown () override
+  {
+    g_free (model_file);
+    g_free (pipeline);
+
+    g_clear_object (&gstpipe);
+
+    g_free (input.data);
+    g_free (output.data);
+  }
+};
+
+/**
+ * @brief Negative test case with wrong model file
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, openClose00_n)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+
+  ASSERT_NE (sp, nullptr);
+
+  SetFilterProperty (&prop, wrong_model_files);
+  EXPECT_NE (sp->open (&prop, &data), 0);
+}
+
+/**
+ * @brief Positive case with open/close
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, openClose00)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+
+  ASSERT_TRUE (g_file_test (model_file, G_FILE_TEST_EXISTS));
+  ASSERT_NE (sp, nullptr);
+
+  SetFilterProperty (&prop, proper_model_files);
+
+  /* close before open */
+  sp->close (&prop, &data);
+
+  EXPECT_EQ (sp->open (&prop, &data), 0);
+  sp->close (&prop, &data);
+
+  /* double close */
+  sp->close (&prop, &data);
+}
+
+/**
+ * @brief Positive case with successful getModelInfo
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, getModelInfo00)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+  GstTensorsInfo in_info, out_info;
+
+  ASSERT_NE (sp, nullptr);
+  SetFilterProperty (&prop, proper_model_files);
+
+  ASSERT_EQ (sp->open (&prop, &data), 0);
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+  EXPECT_EQ (sp->getModelInfo (NULL, NULL, data, GET_IN_OUT_INFO, &in_info, &out_info), 0);
+
+  EXPECT_EQ (in_info.num_tensors, 1U);
+  EXPECT_EQ (in_info.info[0].dimension[0], 4U);
+  EXPECT_EQ (in_info.info[0].dimension[1], 1U);
+  EXPECT_EQ (in_info.info[0].type, _NNS_FLOAT32);
+  EXPECT_STREQ (in_info.info[0].name, "input");
+  EXPECT_EQ (out_info.num_tensors, 1U);
+  EXPECT_EQ (out_info.info[0].dimension[0], 4U);
+  EXPECT_EQ (out_info.info[0].dimension[1], 1U);
+  EXPECT_EQ (out_info.info[0].type, _NNS_FLOAT32);
+  EXPECT_STREQ (out_info.info[0].name, "output");
+
+  sp->close (&prop, &data);
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+}
+
+/**
+ * @brief Negative case with unsupported operation of getModelInfo
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, getModelInfo00_n)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+  GstTensorsInfo in_info, out_info;
+
+  ASSERT_NE (sp, nullptr);
+  SetFilterProperty (&prop, proper_model_files);
+
+  ASSERT_EQ (sp->open (&prop, &data), 0);
+  EXPECT_NE (sp->getModelInfo (NULL, NULL, data, SET_INPUT_INFO, &in_info, &out_info), 0);
+
+  sp->close (&prop, &data);
+}
+
+/**
+ * @brief Positive case with invoke
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, invoke00)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+
+  ASSERT_NE (sp, nullptr);
+  SetFilterProperty (&prop, proper_model_files);
+
+  ASSERT_EQ (sp->open (&prop, &data), 0);
+
+  /* the same binding is reused for each invoke */
+  InvokeAndCheck (data);
+  InvokeAndCheck (data);
+
+  sp->close (&prop, &data);
+}
+
+/**
+ * @brief Negative case with invoke before open
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, invoke00_n)
+{
+  void *data = NULL;
+
+  ASSERT_NE (sp, nullptr);
+  EXPECT_NE (sp->invoke (NULL, NULL, data, &input, &output), 0);
+}
+
+/**
+ * @brief Positive case with custom properties
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, customProp00)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+
+  ASSERT_NE (sp, nullptr);
+  SetFilterProperty (&prop, proper_model_files);
+  prop.custom_properties = "intra_op_threads:2, inter_op_threads:2, graph_optimization:basic";
+
+  ASSERT_EQ (sp->open (&prop, &data), 0);
+  InvokeAndCheck (data);
+  sp->close (&prop, &data);
+}
+
+/**
+ * @brief Negative case with invalid custom properties
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, customProp00_n)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+
+  ASSERT_NE (sp, nullptr);
+  SetFilterProperty (&prop, proper_model_files);
+
+  prop.custom_properties = "intra_op_threads:-1";
+  EXPECT_NE (sp->open (&prop, &data), 0);
+
+  prop.custom_properties = "inter_op_threads:two";
+  EXPECT_NE (sp->open (&prop, &data), 0);
+
+  prop.custom_properties = "graph_optimization:invalid";
+  EXPECT_NE (sp->open (&prop, &data), 0);
+}
+
+/**
+ * @brief Positive case to save the optimized model and load it again
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, optimizedModel00)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+  g_autofree gchar *opt_model = NULL;
+  g_autofree gchar *custom = NULL;
+
+  ASSERT_NE (sp, nullptr);
+  opt_model = g_strdup_printf ("%s/nns_ort_optimized_%d.onnx", g_get_tmp_dir (), (int) getpid ());
+  custom = g_strdup_printf ("optimized_model:%s", opt_model);
+
+  SetFilterProperty (&prop, proper_model_files);
+  prop.custom_properties = custom;
+
+  /* the optimized model is saved when the session is created */
+  g_remove (opt_model);
+  ASSERT_EQ (sp->open (&prop, &data), 0);
+  InvokeAndCheck (data);
+  sp->close (&prop, &data);
+  EXPECT_TRUE (g_file_test (opt_model, G_FILE_TEST_IS_REGULAR));
+
+  /* load the saved model */
+  ASSERT_EQ (sp->open (&prop, &data), 0);
+  InvokeAndCheck (data);
+  sp->close (&prop, &data);
+
+  g_remove (opt_model);
+}
+
+/**
+ * @brief Positive case with a corrupted optimized model, the model is optimized and saved again
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, optimizedModel01)
+{
+  void *data = NULL;
+  GstTensorFilterProperties prop;
+  g_autofree gchar *opt_model = NULL;
+  g_autofree gchar *custom = NULL;
+  g_autofree gchar *contents = NULL;
+  const gchar broken[] = "not an onnx model";
+  gsize len = 0;
+
+  ASSERT_NE (sp, nullptr);
+  opt_model = g_strdup_printf ("%s/nns_ort_broken_%d.onnx", g_get_tmp_dir (), (int) getpid ());
+  custom = g_strdup_printf ("optimized_model:%s", opt_model);
+
+  SetFilterProperty (&prop, proper_model_files);
+  prop.custom_properties = custom;
+
+  /* a truncated file newer than the model */
+  ASSERT_TRUE (g_file_set_contents (opt_model, broken, -1, NULL));
+
+  ASSERT_EQ (sp->open (&prop, &data), 0);
+  InvokeAndCheck (data);
+  sp->close (&prop, &data);
+
+  /* the broken file is replaced with the optimized model */
+  ASSERT_TRUE (g_file_get_contents (opt_model, &contents, &len, NULL));
+  EXPECT_GT (len, 0U);
+  EXPECT_FALSE (len == strlen (broken) && memcmp (contents, broken, len) == 0);
+
+  ASSERT_EQ (sp->open (&prop, &data), 0);
+  InvokeAndCheck (data);
+  sp->close (&prop, &data);
+
+  g_remove (opt_model);
+}
+
+/**
+ * @brief Positive case with the shared model representation
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, sharedModel00)
+{
+  void *data1 = NULL, *data2 = NULL;
+  GstTensorFilterProperties prop1, prop2;
+
+  ASSERT_NE (sp, nullptr);
+  SetFilterProperty (&prop1, proper_model_files);
+  SetFilterProperty (&prop2, proper_model_files);
+  prop1.shared_tensor_filter_key = "ort_key";
+  prop2.shared_tensor_filter_key = "ort_key";
+
+  ASSERT_EQ (sp->open (&prop1, &data1), 0);
+  ASSERT_EQ (sp->open (&prop2, &data2), 0);
+
+  InvokeAndCheck (data1);
+  InvokeAndCheck (data2);
+
+  /* the shared model is still available after closing one of the instances */
+  sp->close (&prop1, &data1);
+  InvokeAndCheck (data2);
+  sp->close (&prop2, &data2);
+}
+
+/**
+ * @brief Positive case to launch gst pipeline with auto-detected framework
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, launch00)
+{
+  pipeline = g_strdup_printf ("videotestsrc num-buffers=3 ! videoconvert ! video/x-raw,format=RGBA,width=1,height=1 ! tensor_converter ! tensor_transform mode=typecast option=float32 ! tensor_filter framework=auto model=\"%s\" ! fakesink",
+      model_file);
+
+  gstpipe = gst_parse_launch (pipeline, nullptr);
+  ASSERT_NE (gstpipe, nullptr);
+
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+}
+
+/**
+ * @brief Negative case with invalid model path
+ */
+TEST_F (NNStreamerFilterONNXRuntimeTest, launch00_n)
+{
+  pipeline = g_strdup_printf ("videotestsrc num-buffers=1 ! videoconvert ! video/x-raw,format=RGBA,width=1,height=1 ! tensor_converter ! tensor_transform mode=typecast option=float32 ! tensor_filter framework=onnxruntime model=\"%s\" ! fakesink",
+      "temp.onnx");
+
+  gstpipe = gst_parse_launch (pipeline, nullptr);
+  ASSERT_NE (gstpipe, nullptr);
+
+  EXPECT_NE (setPipelineStateSync (gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+}
+
+/**
+ * @brief Main gtest
+ */
+int
+main (int argc, char **argv)
+{
+  int result = -1;
+
+  try {
+    testing::InitGoogleTest (&argc, argv);
+  } catch (...) {
+    g_warning ("catch 'testing::internal::<unnamed>::ClassUniqueToAlwaysTrue'");
+  }
+
+  gst_init (&argc, &argv);
+
+  try {
+    result = RUN_ALL_TESTS ();
+  } catch (...) {
+    g_warning ("catch `testing::internal::GoogleTestFailureException`");
+  }
+
+  return result;
+}
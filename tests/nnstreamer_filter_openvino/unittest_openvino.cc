@@ -592,6 +592,225 @@ TEST (tensorFilterOpenvino, openAndClose2_n)
   g_free (test_model);
 }
 
+/**
+ * @brief Test case for the open callback with the custom properties to configure the infer requests
+ */
+TEST (tensorFilterOpenvino, openWithCustomProp0)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  const gchar fw_name[] = "openvino";
+  const GstTensorFilterFramework *fw = nnstreamer_filter_find (fw_name);
+  GstTensorFilterProperties *prop = NULL;
+  gpointer private_data = NULL;
+  gchar *test_model;
+  gint ret;
+
+  /* Check if mandatory methods are contained */
+  ASSERT_TRUE (fw && fw->open && fw->close);
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      MODEL_BASE_NAME_MOBINET_V2, NULL);
+  const gchar *model_files[] = {
+    test_model, NULL,
+  };
+
+  /* prepare properties */
+  prop = g_new0 (GstTensorFilterProperties, 1);
+  ASSERT_TRUE (prop != NULL);
+
+  prop->fwname = fw_name;
+  prop->model_files = model_files;
+  prop->num_models = 1;
+  prop->accl_str = "true:cpu";
+  prop->custom_properties = "num_requests:2,num_streams:auto,num_threads:2";
+
+  ret = fw->open (prop, &private_data);
+#ifdef __OPENVINO_CPU_EXT__
+  EXPECT_EQ (ret, TensorFilterOpenvino::RetSuccess);
+  ASSERT_TRUE (private_data != NULL);
+  EXPECT_EQ (static_cast<TensorFilterOpenvino *> (private_data)->getNumRequests (), 2U);
+#else
+  EXPECT_NE (ret, TensorFilterOpenvino::RetSuccess);
+#endif
+  fw->close (prop, &private_data);
+
+  g_free (prop);
+  g_free (test_model);
+}
+
+/**
+ * @brief Negative test cases for the custom properties to configure the infer requests
+ */
+TEST (tensorFilterOpenvino, parseCustomProp0_n)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  std::string str_test_model;
+  gchar *test_model_xml;
+  gchar *test_model_bin;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model_xml = g_build_filename (root_path, "tests", "test_models", "models",
+      str_test_model.assign (MODEL_BASE_NAME_MOBINET_V2)
+          .append (TensorFilterOpenvino::extXml)
+          .c_str (),
+      NULL);
+  test_model_bin = g_build_filename (root_path, "tests", "test_models", "models",
+      str_test_model.assign (MODEL_BASE_NAME_MOBINET_V2)
+          .append (TensorFilterOpenvino::extBin)
+          .c_str (),
+      NULL);
+
+  {
+    TensorFilterOpenvino tfOv (str_test_model.assign (test_model_xml),
+        std::string (test_model_bin));
+
+    EXPECT_EQ (tfOv.parseCustomProperties ("num_requests:17"),
+        TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.parseCustomProperties ("num_requests:-1"),
+        TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.parseCustomProperties ("num_streams:-1"),
+        TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.parseCustomProperties ("num_streams:0"),
+        TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.parseCustomProperties ("num_threads:two"),
+        TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.parseCustomProperties ("num_requests"),
+        TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.parseCustomProperties ("num_requests:auto,num_streams:4"),
+        TensorFilterOpenvino::RetSuccess);
+  }
+
+  g_free (test_model_xml);
+  g_free (test_model_bin);
+}
+
+#ifdef __OPENVINO_CPU_EXT__
+#define OV_INVOKE_NUM_THREADS (4)
+#define OV_INVOKE_REPEAT (8)
+
+/**
+ * @brief Data for the concurrent invoke test
+ */
+typedef struct
+{
+  const GstTensorFilterFramework *fw;
+  GstTensorFilterProperties *prop;
+  gpointer *private_data;
+  GstTensorMemory *input;
+  const GstTensorMemory *expected;
+  gint failed;
+} ov_invoke_data;
+
+/**
+ * @brief Thread to invoke the model repeatedly and compare the output with the expected one
+ */
+static gpointer
+ov_invoke_thread (gpointer data)
+{
+  ov_invoke_data *d = (ov_invoke_data *) data;
+  GstTensorMemory output;
+  guint i;
+
+  output.size = d->expected->size;
+  output.data = g_malloc0 (output.size);
+
+  for (i = 0; i < OV_INVOKE_REPEAT; ++i) {
+    memset (output.data, 0, output.size);
+    if (d->fw->invoke_NN (d->prop, d->private_data, d->input, &output) != 0
+        || memcmp (output.data, d->expected->data, output.size) != 0)
+      g_atomic_int_inc (&d->failed);
+  }
+
+  g_free (output.data);
+  return NULL;
+}
+
+/**
+ * @brief Test case for the invokes from multiple threads sharing the model
+ */
+TEST (tensorFilterOpenvino, invokeConcurrent0)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  const gchar fw_name[] = "openvino";
+  const GstTensorFilterFramework *fw = nnstreamer_filter_find (fw_name);
+  GstTensorFilterProperties *prop = NULL;
+  GThread *threads[OV_INVOKE_NUM_THREADS];
+  GstTensorMemory input, expected;
+  ov_invoke_data data;
+  gpointer private_data = NULL;
+  gchar *test_model;
+  gint ret;
+  guint i;
+
+  ASSERT_TRUE (fw && fw->open && fw->close && fw->invoke_NN);
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      MODEL_BASE_NAME_MOBINET_V2, NULL);
+  const gchar *model_files[] = {
+    test_model, NULL,
+  };
+
+  prop = g_new0 (GstTensorFilterProperties, 1);
+  ASSERT_TRUE (prop != NULL);
+
+  prop->fwname = fw_name;
+  prop->model_files = model_files;
+  prop->num_models = 1;
+  prop->accl_str = "true:cpu";
+  prop->custom_properties = "num_requests:2,num_streams:2";
+
+  ret = fw->open (prop, &private_data);
+  ASSERT_EQ (ret, TensorFilterOpenvino::RetSuccess);
+  EXPECT_EQ (static_cast<TensorFilterOpenvino *> (private_data)->getNumRequests (), 2U);
+
+  ASSERT_EQ (fw->getInputDimension (prop, &private_data, &prop->input_meta), 0);
+  ASSERT_EQ (fw->getOutputDimension (prop, &private_data, &prop->output_meta), 0);
+
+  input.size = gst_tensor_info_get_size (&prop->input_meta.info[0]);
+  input.data = g_malloc (input.size);
+  for (i = 0; i < input.size; ++i)
+    ((guint8 *) input.data)[i] = (guint8) (i % 251);
+
+  expected.size = gst_tensor_info_get_size (&prop->output_meta.info[0]);
+  expected.data = g_malloc0 (expected.size);
+  EXPECT_EQ (fw->invoke_NN (prop, &private_data, &input, &expected), 0);
+
+  data.fw = fw;
+  data.prop = prop;
+  data.private_data = &private_data;
+  data.input = &input;
+  data.expected = &expected;
+  data.failed = 0;
+
+  for (i = 0; i < OV_INVOKE_NUM_THREADS; ++i)
+    threads[i] = g_thread_new ("ov-invoke", ov_invoke_thread, &data);
+  for (i = 0; i < OV_INVOKE_NUM_THREADS; ++i)
+    g_thread_join (threads[i]);
+
+  EXPECT_EQ (g_atomic_int_get (&data.failed), 0);
+
+  fw->close (prop, &private_data);
+
+  gst_tensors_info_free (&prop->input_meta);
+  gst_tensors_info_free (&prop->output_meta);
+  g_free (input.data);
+  g_free (expected.data);
+  g_free (prop);
+  g_free (test_model);
+}
+#endif /* __OPENVINO_CPU_EXT__ */
+
 /**
  * @brief Test cases for getInputTensorDim and getOutputTensorDim callbacks
  */
@@ -9,6 +9,7 @@
 
 #include <gtest/gtest.h>
 #include <glib.h>
+#include <nnstreamer_plugin_api_filter.h>
 #include <nnstreamer_plugin_api_util.h>
 
 #include "../gst/nnstreamer/tensor_filter/tensor_filter_single.h"
@@ -156,6 +157,69 @@ TEST_F (NNSFilterSingleTest, invokeInvalidSize_n)
   EXPECT_TRUE (klass->stop (single));
 }
 
+/**
+ * @brief Test to invoke tf-lite model with the binding of tensors.
+ */
+TEST_F (NNSFilterSingleTest, invokeBinding_p)
+{
+  GTensorFilterSingleBinding *binding;
+  guint i;
+
+  ASSERT_TRUE (this->loaded);
+
+  binding = klass->binding_new (single);
+  ASSERT_TRUE (binding != NULL);
+  EXPECT_EQ (binding->num_input, 1U);
+  EXPECT_EQ (binding->num_output, 1U);
+  EXPECT_EQ (binding->input[0].size, input.size);
+  EXPECT_EQ (binding->output[0].size, output.size);
+
+  /* invoke the model repeatedly and check label 'orange' (index 951) */
+  binding->input[0].data = input.data;
+  for (i = 0; i < 3U; i++) {
+    EXPECT_TRUE (klass->invoke_binding (single, binding));
+    EXPECT_EQ (951U, get_max_score (&binding->output[0]));
+  }
+
+  /* tf-lite does not allocate in invoke, output is owned by the binding. */
+  EXPECT_FALSE (binding->output_fw_owned);
+  klass->binding_release (single, binding);
+  EXPECT_TRUE (binding->output[0].data != NULL);
+
+  klass->binding_free (single, binding);
+}
+
+/**
+ * @brief Test to invoke with the binding after updating tensor info.
+ */
+TEST_F (NNSFilterSingleTest, invokeBindingInfoUpdated_n)
+{
+  GTensorFilterSingleBinding *binding;
+  GstTensorsInfo in_info, out_info;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  ASSERT_TRUE (this->loaded);
+  EXPECT_FALSE (klass->invoke_binding (single, NULL));
+
+  binding = klass->binding_new (single);
+  ASSERT_TRUE (binding != NULL);
+  binding->input[0].data = input.data;
+
+  in_info.num_tensors = 1U;
+  in_info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", in_info.info[0].dimension);
+  EXPECT_TRUE (klass->set_input_info (single, &in_info, &out_info) == 0);
+
+  /* binding should be created again after updating tensor info */
+  EXPECT_FALSE (klass->invoke_binding (single, binding));
+
+  klass->binding_free (single, binding);
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+}
+
 /**
  * @brief Test to set invalid info.
  */
@@ -248,6 +312,198 @@ TEST (testTensorFilterSingle, invokeUnknownFW_n)
   g_free (out.data);
 }
 
+/**
+ * @brief The number of output data released by the framework allocating in invoke.
+ */
+static guint alloc_fw_released = 0;
+
+/**
+ * @brief The callback to open the framework allocating in invoke.
+ */
+static int
+alloc_fw_open (const GstTensorFilterProperties *prop, void **private_data)
+{
+  *private_data = NULL;
+  return 0;
+}
+
+/**
+ * @brief The callback to close the framework allocating in invoke.
+ */
+static void
+alloc_fw_close (const GstTensorFilterProperties *prop, void **private_data)
+{
+  *private_data = NULL;
+}
+
+/**
+ * @brief The callback to get the tensor info (uint8, 4:1:1:1) of the framework allocating in invoke.
+ */
+static int
+alloc_fw_get_dim (const GstTensorFilterProperties *prop, void **private_data,
+    GstTensorsInfo *info)
+{
+  gst_tensors_info_init (info);
+  info->num_tensors = 1U;
+  info->info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:1:1:1", info->info[0].dimension);
+  return 0;
+}
+
+/**
+ * @brief The callback to invoke the framework allocating in invoke (adds 1 to each element).
+ */
+static int
+alloc_fw_invoke (const GstTensorFilterProperties *prop, void **private_data,
+    const GstTensorMemory *input, GstTensorMemory *output)
+{
+  guint8 *in, *out;
+  gsize i;
+
+  if (input[0].data == NULL)
+    return -1;
+
+  in = (guint8 *) input[0].data;
+  out = (guint8 *) g_malloc (output[0].size);
+  for (i = 0; i < output[0].size; i++)
+    out[i] = in[i] + 1;
+
+  output[0].data = out;
+  return 0;
+}
+
+/**
+ * @brief The callback to release the output data of the framework allocating in invoke.
+ */
+static void
+alloc_fw_destroy_notify (void **private_data, void *data)
+{
+  alloc_fw_released++;
+  g_free (data);
+}
+
+/**
+ * @brief Register the framework allocating the output data in invoke.
+ */
+static GstTensorFilterFramework *
+_register_alloc_fw (void)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V0;
+  fw->name = (char *) "single-alloc-in-invoke";
+  fw->allocate_in_invoke = TRUE;
+  fw->run_without_model = TRUE;
+  fw->open = alloc_fw_open;
+  fw->close = alloc_fw_close;
+  fw->invoke_NN = alloc_fw_invoke;
+  fw->getInputDimension = alloc_fw_get_dim;
+  fw->getOutputDimension = alloc_fw_get_dim;
+  fw->destroyNotify = alloc_fw_destroy_notify;
+
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+  return fw;
+}
+
+/**
+ * @brief Test to invoke with the binding, the output is allocated by the framework.
+ */
+TEST (testTensorFilterSingle, invokeBindingAllocInInvoke)
+{
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  GTensorFilterSingleBinding *binding;
+  GstTensorFilterFramework *fw;
+  guint8 in_data[4] = { 1, 2, 3, 4 };
+  guint8 *out;
+
+  fw = _register_alloc_fw ();
+  alloc_fw_released = 0;
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE, NULL);
+  klass = (GTensorFilterSingleClass *) g_type_class_ref (G_TYPE_TENSOR_FILTER_SINGLE);
+  g_object_set (G_OBJECT (single), "framework", "single-alloc-in-invoke", NULL);
+
+  binding = klass->binding_new (single);
+  ASSERT_TRUE (binding != NULL);
+  EXPECT_TRUE (klass->allocate_in_invoke (single));
+  EXPECT_FALSE (binding->output_allocated);
+  EXPECT_EQ (binding->output[0].size, 4U);
+  EXPECT_TRUE (binding->output[0].data == NULL);
+
+  /* the output is owned by the framework and handed back without copy */
+  binding->input[0].data = in_data;
+  EXPECT_TRUE (klass->invoke_binding (single, binding));
+  EXPECT_TRUE (binding->output_fw_owned);
+  out = (guint8 *) binding->output[0].data;
+  ASSERT_TRUE (out != NULL);
+  EXPECT_EQ (out[0], 2U);
+  EXPECT_EQ (out[3], 5U);
+  EXPECT_EQ (alloc_fw_released, 0U);
+
+  /* the output of previous invoke is released in next invoke */
+  EXPECT_TRUE (klass->invoke_binding (single, binding));
+  EXPECT_EQ (alloc_fw_released, 1U);
+  EXPECT_TRUE (binding->output[0].data != NULL);
+  EXPECT_TRUE (binding->output_fw_owned);
+
+  /* release the output explicitly, release again does nothing */
+  klass->binding_release (single, binding);
+  EXPECT_EQ (alloc_fw_released, 2U);
+  EXPECT_TRUE (binding->output[0].data == NULL);
+  EXPECT_FALSE (binding->output_fw_owned);
+  klass->binding_release (single, binding);
+  EXPECT_EQ (alloc_fw_released, 2U);
+
+  /* the output is released when the binding is freed */
+  EXPECT_TRUE (klass->invoke_binding (single, binding));
+  klass->binding_free (single, binding);
+  EXPECT_EQ (alloc_fw_released, 3U);
+
+  EXPECT_TRUE (klass->stop (single));
+  g_type_class_unref (klass);
+  g_object_unref (single);
+
+  nnstreamer_filter_exit (fw->name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test to invoke with the binding, the framework fails to invoke.
+ */
+TEST (testTensorFilterSingle, invokeBindingAllocInInvokeFail_n)
+{
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  GTensorFilterSingleBinding *binding;
+  GstTensorFilterFramework *fw;
+
+  fw = _register_alloc_fw ();
+  alloc_fw_released = 0;
+
+  single = (GTensorFilterSingle *) g_object_new (G_TYPE_TENSOR_FILTER_SINGLE, NULL);
+  klass = (GTensorFilterSingleClass *) g_type_class_ref (G_TYPE_TENSOR_FILTER_SINGLE);
+  g_object_set (G_OBJECT (single), "framework", "single-alloc-in-invoke", NULL);
+
+  binding = klass->binding_new (single);
+  ASSERT_TRUE (binding != NULL);
+
+  /* no input data, the framework returns error and the output is not owned */
+  EXPECT_FALSE (klass->invoke_binding (single, binding));
+  EXPECT_FALSE (binding->output_fw_owned);
+  EXPECT_TRUE (binding->output[0].data == NULL);
+
+  klass->binding_free (single, binding);
+  EXPECT_EQ (alloc_fw_released, 0U);
+
+  EXPECT_TRUE (klass->stop (single));
+  g_type_class_unref (klass);
+  g_object_unref (single);
+
+  nnstreamer_filter_exit (fw->name);
+  g_free (fw);
+}
+
 /**
  * @brief Main GTest.
  */
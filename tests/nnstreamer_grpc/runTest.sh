@@ -159,6 +159,22 @@ for BLOCKING in "${BLOCKING_LIST[@]}"; do
 
   INDEX=$((INDEX + 1))
   rm result_*.log
+
+  PORT=`python3 ../get_available_port.py`
+  # tensor_sink (client) --> tensor_src (server), other/tensors split into 64KiB chunks with bounded queues
+  gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_src_grpc port=${PORT} num-buffers=$((NUM_BUFFERS/2)) idl=${IDL} blocking=${BLOCKING} max-in-flight=2 num-threads=2 ! other/tensors,num_tensors=2,dimensions=3:640:480.3:640:480,types=uint8.uint8,framerate=5/1 ! multifilesink async=false location=result_%1d.log" ${INDEX}-1 0 0 ${TIMEOUT_SEC}
+  pid=$!
+  gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc num-buffers=${NUM_BUFFERS} ! video/x-raw,width=640,height=480,framerate=5/1 ! tensor_converter frames-per-tensor=2 ! tensor_sink_grpc port=${PORT} idl=${IDL} blocking=${BLOCKING} max-chunk-size=65536 max-in-flight=2" ${INDEX}-2 0 0 $PERFORMANCE
+  kill -9 $pid &> /dev/null
+  wait $pid
+
+  for i in `seq 0 $((NUM_BUFFERS/2-1))`
+  do
+    callCompareTest original2_${i}.log result_${i}.log GoldenTest-${INDEX} "gRPC ${IDL}/${BLOCKING_STR} chunked $((i+1))/$((NUM_BUFFERS/2))" 0 0
+  done
+
+  INDEX=$((INDEX + 1))
+  rm result_*.log
 done
 done
 
@@ -12,6 +12,7 @@
 
 #include <nnstreamer_plugin_api_filter.h>
 #include <nnstreamer_plugin_api.h>
+#include <nnstreamer_grpc_common.h>
 
 #define NNS_GRPC_PLUGIN_NAME "nnstreamer_grpc"
 #define NNS_GRPC_TENSOR_SRC_NAME "tensor_src_grpc"
@@ -312,6 +313,108 @@ TEST (nnstreamerGrpc, sinkSetProperty)
   gst_object_unref (test_data.pipeline);
 }
 
+/**
+ * @brief Test gRPC tensor_src properties for streaming
+ */
+TEST (nnstreamerGrpc, srcStreamingProperty)
+{
+  TestOption option;
+  GstElement *src;
+  guint max_in_flight, num_threads;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SRC;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  src = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "src");
+  ASSERT_TRUE (src != NULL);
+
+  g_object_get (src, "max-in-flight", &max_in_flight, NULL);
+  EXPECT_EQ (max_in_flight, 0U);
+
+  g_object_get (src, "num-threads", &num_threads, NULL);
+  EXPECT_EQ (num_threads, 1U);
+
+  g_object_set (src, "max-in-flight", 4, NULL);
+  g_object_get (src, "max-in-flight", &max_in_flight, NULL);
+  EXPECT_EQ (max_in_flight, 4U);
+
+  g_object_set (src, "num-threads", 2, NULL);
+  g_object_get (src, "num-threads", &num_threads, NULL);
+  EXPECT_EQ (num_threads, 2U);
+
+  gst_object_unref (src);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Test gRPC tensor_sink properties for streaming
+ */
+TEST (nnstreamerGrpc, sinkStreamingProperty)
+{
+  TestOption option;
+  GstElement *sink;
+  guint max_chunk_size, max_in_flight, num_threads;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SINK;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  sink = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+
+  g_object_get (sink, "max-chunk-size", &max_chunk_size, NULL);
+  EXPECT_EQ (max_chunk_size, 0U);
+
+  g_object_get (sink, "max-in-flight", &max_in_flight, NULL);
+  EXPECT_EQ (max_in_flight, 0U);
+
+  g_object_get (sink, "num-threads", &num_threads, NULL);
+  EXPECT_EQ (num_threads, 1U);
+
+  g_object_set (sink, "max-chunk-size", 65536, NULL);
+  g_object_get (sink, "max-chunk-size", &max_chunk_size, NULL);
+  EXPECT_EQ (max_chunk_size, 65536U);
+
+  g_object_set (sink, "max-in-flight", 4, NULL);
+  g_object_get (sink, "max-in-flight", &max_in_flight, NULL);
+  EXPECT_EQ (max_in_flight, 4U);
+
+  g_object_set (sink, "num-threads", 2, NULL);
+  g_object_get (sink, "num-threads", &num_threads, NULL);
+  EXPECT_EQ (num_threads, 2U);
+
+  gst_object_unref (sink);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Test gRPC tensor_sink invalid number of threads
+ */
+TEST (nnstreamerGrpc, sinkInvalidNumThreads_n)
+{
+  TestOption option;
+  GstElement *sink;
+  guint num_threads;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SINK;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  sink = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+
+  g_object_set (sink, "num-threads", 0, NULL);
+  g_object_get (sink, "num-threads", &num_threads, NULL);
+  EXPECT_EQ (num_threads, 1U);
+
+  gst_object_unref (sink);
+  gst_object_unref (test_data.pipeline);
+}
+
 /**
  * @brief Test gRPC tensor_src invalid host
  */
@@ -422,6 +525,308 @@ TEST (nnstreamerGrpc, sinkInvalidPort_n)
   gst_object_unref (test_data.pipeline);
 }
 
+/**
+ * @brief Test to stop gRPC tensor_sink (client) blocked by max-in-flight without the server
+ */
+TEST (nnstreamerGrpc, sinkStopWithoutServer_n)
+{
+  TestOption option;
+  GstElement *sink;
+  gint64 start_time;
+
+  _set_default_option (option);
+  option.mode = GRPC_MODE_SINK;
+  option.server = FALSE;
+  option.fps = 100;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  sink = gst_bin_get_by_name (GST_BIN (test_data.pipeline), "sink");
+  ASSERT_TRUE (sink != NULL);
+
+  /* no server is listening on the port, the buffers are never sent */
+  g_object_set (sink, "max-in-flight", 1, NULL);
+
+  EXPECT_NE (gst_element_set_state (test_data.pipeline, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_FAILURE);
+  g_usleep (G_USEC_PER_SEC / 2);
+
+  /* the streaming thread blocked in render should be released, and stop should not wait forever */
+  start_time = g_get_monotonic_time ();
+  EXPECT_EQ (gst_element_set_state (test_data.pipeline, GST_STATE_NULL),
+      GST_STATE_CHANGE_SUCCESS);
+  EXPECT_LT (g_get_monotonic_time () - start_time, 5 * G_USEC_PER_SEC);
+
+  gst_object_unref (sink);
+  gst_object_unref (test_data.pipeline);
+}
+
+/**
+ * @brief Set the tensors info (uint8 8 and 4 bytes) for chunker and assembler test
+ */
+static void
+_set_chunk_test_info (GstTensorsInfo *info)
+{
+  gst_tensors_info_init (info);
+  info->num_tensors = 2;
+  info->info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("8:1:1:1", info->info[0].dimension);
+  info->info[1].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:1:1:1", info->info[1].dimension);
+}
+
+/**
+ * @brief Make the buffer of the tensors, the value is the index in the frame
+ */
+static GstBuffer *
+_make_chunk_test_buffer (const GstTensorsInfo *info)
+{
+  GstBuffer *buffer = gst_buffer_new ();
+  guint8 value = 0;
+
+  for (guint i = 0; i < info->num_tensors; i++) {
+    gsize size = gst_tensor_info_get_size (&info->info[i]);
+    guint8 *data = (guint8 *) g_malloc (size);
+
+    for (gsize j = 0; j < size; j++)
+      data[j] = value++;
+
+    gst_buffer_append_memory (buffer,
+        gst_memory_new_wrapped ((GstMemoryFlags) 0, data, size, 0, size, data, g_free));
+  }
+
+  return buffer;
+}
+
+/**
+ * @brief Test to split the tensors into the chunks and reassemble them
+ */
+TEST (nnstreamerGrpc, chunkerAssembler)
+{
+  GstTensorsInfo info;
+  grpc::TensorsChunker chunker;
+  std::vector<grpc::TensorChunk> chunks;
+  GstBuffer *buffer;
+  GstMapInfo map;
+  gboolean more;
+  guint num_msgs = 0;
+
+  _set_chunk_test_info (&info);
+  grpc::TensorsAssembler assembler (&info);
+
+  ASSERT_TRUE (chunker.setBuffer (_make_chunk_test_buffer (&info), &info));
+
+  /* 12 bytes in 5 bytes messages: [0:5], [5:8] + [0:2], [2:4] */
+  do {
+    chunks.clear ();
+    more = chunker.next (5, chunks);
+
+    for (const grpc::TensorChunk &chunk : chunks) {
+      EXPECT_LE (chunk.size, 5U);
+      EXPECT_TRUE (assembler.append (chunk.data, chunk.size, chunk.offset, chunk.total));
+    }
+    num_msgs++;
+  } while (more);
+
+  EXPECT_EQ (num_msgs, 3U);
+  EXPECT_EQ (chunks.size (), 1U);
+  EXPECT_EQ (chunks[0].index, 1U);
+  EXPECT_EQ (chunks[0].offset, 2U);
+  EXPECT_EQ (chunks[0].total, 4U);
+  chunker.reset ();
+
+  buffer = assembler.finish ();
+  ASSERT_TRUE (buffer != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (buffer), 2U);
+  ASSERT_EQ (gst_buffer_get_size (buffer), 12U);
+
+  ASSERT_TRUE (gst_buffer_map (buffer, &map, GST_MAP_READ));
+  for (gsize i = 0; i < map.size; i++)
+    EXPECT_EQ (map.data[i], i);
+  gst_buffer_unmap (buffer, &map);
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Test the slice of the tensor chunk holds the memory without copy
+ */
+TEST (nnstreamerGrpc, chunkToSlice)
+{
+  GstTensorsInfo info;
+  grpc::TensorsChunker chunker;
+  std::vector<grpc::TensorChunk> chunks;
+  GstBuffer *buffer;
+  GstMapInfo map;
+
+  _set_chunk_test_info (&info);
+  buffer = _make_chunk_test_buffer (&info);
+
+  ASSERT_TRUE (chunker.setBuffer (gst_buffer_ref (buffer), &info));
+  EXPECT_FALSE (chunker.next (0, chunks));
+  ASSERT_EQ (chunks.size (), 2U);
+
+  grpc::Slice slice = grpc::tensor_chunk_to_slice (chunks[1]);
+
+  /* the slice is valid after the chunker releases the buffer */
+  chunker.reset ();
+  ASSERT_EQ (slice.size (), 4U);
+
+  ASSERT_TRUE (gst_buffer_map (buffer, &map, GST_MAP_READ));
+  EXPECT_EQ (slice.begin (), map.data + 8);
+  for (gsize i = 0; i < slice.size (); i++)
+    EXPECT_EQ (slice.begin ()[i], i + 8);
+  gst_buffer_unmap (buffer, &map);
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Test the chunker with the buffer smaller than the tensors info
+ */
+TEST (nnstreamerGrpc, chunkerInvalidBuffer_n)
+{
+  GstTensorsInfo info, small_info;
+  grpc::TensorsChunker chunker;
+
+  _set_chunk_test_info (&info);
+  _set_chunk_test_info (&small_info);
+  gst_tensor_parse_dimension ("2:1:1:1", small_info.info[1].dimension);
+
+  /* the second memory has 2 bytes for the tensor of 4 bytes */
+  EXPECT_FALSE (chunker.setBuffer (_make_chunk_test_buffer (&small_info), &info));
+  chunker.reset ();
+  EXPECT_TRUE (chunker.isEmpty ());
+}
+
+/**
+ * @brief Test the assembler with the chunk of bad offset
+ */
+TEST (nnstreamerGrpc, assemblerBadOffset_n)
+{
+  GstTensorsInfo info;
+  guint8 data[8] = { 0 };
+
+  _set_chunk_test_info (&info);
+  grpc::TensorsAssembler assembler (&info);
+
+  EXPECT_TRUE (assembler.append (data, 4, 0, 8));
+  /* the chunk [4:8] is skipped */
+  EXPECT_FALSE (assembler.append (data, 2, 6, 8));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the offset over the total */
+  EXPECT_TRUE (assembler.append (data, 4, 0, 8));
+  EXPECT_FALSE (assembler.append (data, 2, 10, 8));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the size over the total */
+  EXPECT_TRUE (assembler.append (data, 4, 0, 8));
+  EXPECT_FALSE (assembler.append (data, 6, 4, 8));
+  EXPECT_TRUE (assembler.finish () == NULL);
+}
+
+/**
+ * @brief Test the assembler with the chunks out of order
+ */
+TEST (nnstreamerGrpc, assemblerOutOfOrder_n)
+{
+  GstTensorsInfo info;
+  guint8 data[8] = { 0 };
+
+  _set_chunk_test_info (&info);
+  grpc::TensorsAssembler assembler (&info);
+
+  /* the first chunk is not received yet */
+  EXPECT_FALSE (assembler.append (data, 4, 4, 8));
+  EXPECT_TRUE (assembler.append (data, 4, 0, 8));
+  EXPECT_TRUE (assembler.append (data, 4, 4, 8));
+  EXPECT_TRUE (assembler.append (data, 4, 0, 4));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the chunk of the other total in the tensor */
+  EXPECT_TRUE (assembler.append (data, 4, 0, 8));
+  EXPECT_FALSE (assembler.append (data, 2, 4, 6));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the previous tensor is not completed */
+  EXPECT_TRUE (assembler.append (data, 4, 0, 8));
+  EXPECT_TRUE (assembler.append (data, 2, 0, 4));
+  EXPECT_TRUE (assembler.append (data + 2, 2, 2, 4));
+  EXPECT_TRUE (assembler.finish () == NULL);
+}
+
+/**
+ * @brief Test the assembler with the truncated frames
+ */
+TEST (nnstreamerGrpc, assemblerTruncated_n)
+{
+  GstTensorsInfo info;
+  guint8 data[8] = { 0 };
+  GstBuffer *buffer;
+
+  _set_chunk_test_info (&info);
+  grpc::TensorsAssembler assembler (&info);
+
+  /* the last chunk of the tensor is missing */
+  EXPECT_TRUE (assembler.append (data, 8, 0, 8));
+  EXPECT_TRUE (assembler.append (data, 2, 0, 4));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the second tensor is missing */
+  EXPECT_TRUE (assembler.append (data, 8, 0, 8));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the tensor without data */
+  EXPECT_TRUE (assembler.append (data, 8, 0, 8));
+  assembler.invalidate ();
+  EXPECT_TRUE (assembler.append (data, 4, 0, 4));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the assembler is reset after the frame is dropped */
+  EXPECT_TRUE (assembler.append (data, 8, 0, 8));
+  EXPECT_TRUE (assembler.append (data, 4, 0, 4));
+  buffer = assembler.finish ();
+  ASSERT_TRUE (buffer != NULL);
+  EXPECT_EQ (gst_buffer_get_size (buffer), 12U);
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Test the assembler with the total size over the negotiated one
+ */
+TEST (nnstreamerGrpc, assemblerOversize_n)
+{
+  GstTensorsInfo info;
+  guint8 data[16] = { 0 };
+  gpointer mem_data;
+
+  _set_chunk_test_info (&info);
+  grpc::TensorsAssembler assembler (&info);
+
+  /* do not allocate the size given by the peer */
+  EXPECT_FALSE (assembler.append (data, 4, 0, G_MAXSIZE));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  EXPECT_FALSE (assembler.append (data, 4, 0, 16));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the second tensor is 4 bytes */
+  EXPECT_TRUE (assembler.append (data, 8, 0, 8));
+  EXPECT_FALSE (assembler.append (data, 4, 0, 8));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* the complete tensor over the negotiated size */
+  mem_data = g_malloc0 (16);
+  EXPECT_FALSE (assembler.append (gst_memory_new_wrapped ((GstMemoryFlags) 0,
+      mem_data, 16, 0, 16, mem_data, g_free)));
+  EXPECT_TRUE (assembler.finish () == NULL);
+
+  /* too many tensors in a frame */
+  EXPECT_TRUE (assembler.append (data, 8, 0, 8));
+  EXPECT_TRUE (assembler.append (data, 4, 0, 4));
+  EXPECT_FALSE (assembler.append (data, 4, 0, 4));
+  EXPECT_TRUE (assembler.finish () == NULL);
+}
+
 /**
  * @brief gtest main
  */
@@ -17,10 +17,19 @@
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api_filter.h>
 #include <nnstreamer_subplugin.h>
+#include <nnstreamer_util.h>
 #include <string.h>
+#include <tensor_codec.h>
 #include <tensor_common.h>
+#include <tensor_filter_custom_easy.h>
 #include <tensor_meta.h>
 #include <unistd.h>
+#if defined(__linux__)
+#include <errno.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
 
 #include "../unittest_util.h"
 #include "../gst/nnstreamer/elements/gsttensor_sparseutil.h"
@@ -2139,6 +2148,327 @@ TEST (testTensorTransform, arithmeticFlexTensor)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_transform quant (quantize float32 to uint8)
+ */
+TEST (testTensorTransform, quantQuantize)
+{
+  const guint array_size = 5;
+  const float data[] = { -10.0f, 0.0f, 1.2f, 100.0f, 200.0f };
+  const uint8_t expected[] = { 0, 10, 12, 210, 255 };
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", GTT_QUANT, "option",
+      "quantize:uint8,scale:0.5,zero-point:10", NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("5", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  /* push buffer */
+  in_buf = gst_harness_create_buffer (h, sizeof (data));
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  memcpy (info.data, data, sizeof (data));
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), array_size);
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_EQ (((uint8_t *) info.data)[i], expected[i]);
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform quant (dequantize int8 to float32, per-channel)
+ */
+TEST (testTensorTransform, quantDequantizePerChannel)
+{
+  const guint array_size = 6;
+  const int8_t data[] = { 10, 10, -2, -2, 4, 4 };
+  /* channel (dim 0) 0 : scale 0.5, zp 0 / channel 1 : scale 2, zp -2 */
+  const float expected[] = { 5.0f, 24.0f, -1.0f, 0.0f, 2.0f, 12.0f };
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", GTT_QUANT, "option",
+      "dequantize:float32,scale:0.5:2,zero-point:0:-2,per-channel:true@0", NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_INT8;
+  gst_tensor_parse_dimension ("2:3", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  /* push buffer */
+  in_buf = gst_harness_create_buffer (h, sizeof (data));
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  memcpy (info.data, data, sizeof (data));
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), array_size * sizeof (float));
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ (((float *) info.data)[i], expected[i]);
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform quant (requantize uint8 to int8)
+ */
+TEST (testTensorTransform, quantRequantize)
+{
+  const guint array_size = 5;
+  const uint8_t data[] = { 0, 10, 12, 60, 200 };
+  /* (q - 10) * 0.5 / 0.25 + 0 */
+  const int8_t expected[] = { -20, 0, 4, 100, 127 };
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", GTT_QUANT, "option",
+      "requantize:int8,scale:0.5,zero-point:10,out-scale:0.25,out-zero-point:0",
+      NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("5", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  /* push buffer */
+  in_buf = gst_harness_create_buffer (h, sizeof (data));
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  memcpy (info.data, data, sizeof (data));
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), array_size);
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_EQ (((int8_t *) info.data)[i], expected[i]);
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for invalid option of tensor_transform quant
+ */
+TEST (testTensorTransform, quantProperties_n)
+{
+  GstHarness *h;
+  gchar *str = NULL;
+
+  h = gst_harness_new ("tensor_transform");
+  ASSERT_TRUE (NULL != h);
+
+  /* quantized type should be int8 or uint8 */
+  g_object_set (h->element, "mode", GTT_QUANT, "option",
+      "quantize:float32,scale:0.5,zero-point:0", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  /* scale should be positive */
+  g_object_set (h->element, "option", "quantize:int8,scale:0,zero-point:0", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  /* multiple parameters without per-channel */
+  g_object_set (h->element, "option",
+      "quantize:int8,scale:0.5:0.25,zero-point:0:0", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  /* zero point should be an integer */
+  g_object_set (h->element, "option", "quantize:int8,scale:0.5,zero-point:1.5", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  g_object_set (h->element, "option",
+      "requantize:uint8,scale:0.5,zero-point:3,out-scale:0.25,out-zero-point:2e1", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  /* zero point out of int32 range */
+  g_object_set (h->element, "option",
+      "quantize:int8,scale:0.5,zero-point:4294967296", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  /* each list should have one value or the same number of values */
+  g_object_set (h->element, "option",
+      "dequantize:float32,scale:0.5:2:4,zero-point:0:-2,per-channel:true@0", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  /* the same field given twice */
+  g_object_set (h->element, "option",
+      "quantize:int8,scale:0.5,zero-point:0,scale:0.25", NULL);
+  g_object_get (h->element, "option", &str, NULL);
+  EXPECT_TRUE (str == NULL);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform quant with a parameter for all channels
+ */
+TEST (testTensorTransform, quantDequantizeBroadcast)
+{
+  const guint array_size = 4;
+  const uint8_t data[] = { 10, 10, 20, 20 };
+  /* channel 0 : scale 0.5, zp 10 / channel 1 : scale 2, zp 10 */
+  const float expected[] = { 0.0f, 0.0f, 5.0f, 20.0f };
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", GTT_QUANT, "option",
+      "dequantize:float32,scale:0.5:2,zero-point:10,per-channel:true@0", NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("2:2", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, sizeof (data));
+  mem = gst_buffer_peek_memory (in_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+  memcpy (info.data, data, sizeof (data));
+  gst_memory_unmap (mem, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), array_size * sizeof (float));
+
+  mem = gst_buffer_peek_memory (out_buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+  for (i = 0; i < array_size; i++)
+    EXPECT_FLOAT_EQ (((float *) info.data)[i], expected[i]);
+
+  gst_memory_unmap (mem, &info);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform quant with unsupported input type (negative)
+ */
+TEST (testTensorTransform, quantInvalidInputType_n)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstTensorsConfig config;
+
+  h = gst_harness_new ("tensor_transform");
+
+  /* quantize requires float input */
+  g_object_set (h->element, "mode", GTT_QUANT, "option",
+      "quantize:uint8,scale:0.5,zero-point:10", NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 4);
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test data for tensor_aggregator (2 frames with dimension 3:4:2:2)
  */
@@ -4895,26 +5225,986 @@ error:
 #endif /* HAVE_ORC */
 
 /**
- * @brief Test to re-open tf-lite model file in tensor-filter.
+ * @brief Remove the directory and its contents (temporary test directory).
  */
-TEST_REQUIRE_TFLITE (testTensorFilter, reopenTFlite01)
+static void
+_remove_dir_recursive (const gchar *path)
 {
-  GstHarness *h;
-  GstBuffer *in_buf, *out_buf;
-  gsize in_size, out_size;
-  GstTensorsConfig config;
-  gchar *str_launch_line, *prop_string;
+  GDir *dir = g_dir_open (path, 0, NULL);
+  const gchar *name;
 
-  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
-  gchar *test_model;
+  if (dir) {
+    while ((name = g_dir_read_name (dir)) != NULL) {
+      gchar *child = g_build_filename (path, name, NULL);
 
-  /* supposed to run test in build directory */
-  if (root_path == NULL)
-    root_path = "..";
+      if (g_file_test (child, G_FILE_TEST_IS_DIR) && !g_file_test (child, G_FILE_TEST_IS_SYMLINK))
+        _remove_dir_recursive (child);
+      else
+        g_remove (child);
+      g_free (child);
+    }
+    g_dir_close (dir);
+  }
 
-  test_model = g_build_filename (root_path, "tests", "test_models", "models",
-      "mobilenet_v1_1.0_224_quant.tflite", NULL);
-  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+  g_rmdir (path);
+}
+
+/**
+ * @brief Custom-easy function to count the invokes.
+ */
+static int
+_count_invoke (void *data, const GstTensorFilterProperties *prop,
+    const GstTensorMemory *in, GstTensorMemory *out)
+{
+  guint *count = (guint *) data;
+
+  UNUSED (prop);
+  (*count)++;
+  memcpy (out[0].data, in[0].data, MIN (in[0].size, out[0].size));
+
+  return 0;
+}
+
+/**
+ * @brief Test warm-up invokes run before the first buffer.
+ */
+TEST (testTensorFilter, warmupCustomEasy)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  guint count = 0;
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:1:1:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  ASSERT_EQ (NNS_custom_easy_register ("count_warmup", _count_invoke, &count,
+                 &config.info, &config.info),
+      0);
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  gst_harness_add_parse (h, "tensor_filter framework=custom-easy model=count_warmup warmup=3");
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 4U);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  gst_buffer_unref (out_buf);
+
+  /* 3 warm-up invokes and 1 invoke for the buffer */
+  EXPECT_EQ (count, 4U);
+
+  /* warm-up is done once */
+  in_buf = gst_harness_create_buffer (h, 4U);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  gst_buffer_unref (out_buf);
+  EXPECT_EQ (count, 5U);
+
+  gst_harness_teardown (h);
+  EXPECT_EQ (NNS_custom_easy_unregister ("count_warmup"), 0);
+}
+
+/**
+ * @brief Test warm-up and cache directory of tensor-filter.
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, warmupCacheDirTFlite)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  gchar *str_launch_line, *prop_string, *cache_dir, *fw_cache_dir;
+  guint warmup;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  cache_dir = g_dir_make_tmp ("nns_filter_cache_XXXXXX", NULL);
+  ASSERT_TRUE (cache_dir != NULL);
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf (
+      "tensor_filter framework=tensorflow-lite model=%s warmup=2 cache-dir=%s",
+      test_model, cache_dir);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  /* get properties */
+  gst_harness_get (h, "tensor_filter", "warmup", &warmup, NULL);
+  EXPECT_EQ (warmup, 2U);
+
+  gst_harness_get (h, "tensor_filter", "cache-dir", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, cache_dir);
+  g_free (prop_string);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  /* push buffer (dummy input RGB 224x224, output 1001) */
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  /* sub-directory for the framework is created when opening the model */
+  fw_cache_dir = g_build_filename (cache_dir, "tensorflow-lite", NULL);
+  EXPECT_TRUE (g_file_test (fw_cache_dir, G_FILE_TEST_IS_DIR));
+
+  gst_harness_teardown (h);
+
+  _remove_dir_recursive (cache_dir);
+  EXPECT_FALSE (g_file_test (cache_dir, G_FILE_TEST_EXISTS));
+
+  g_free (fw_cache_dir);
+  g_free (cache_dir);
+  g_free (test_model);
+}
+
+/**
+ * @brief Test deadline-aware scheduling of tensor-filter.
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, scheduleDeadlineTFlite)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  gchar *str_launch_line, *prop_string;
+  guint priority, deadline;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf (
+      "tensor_filter framework=tensorflow-lite model=%s sched-priority=5 deadline=100",
+      test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  /* get properties */
+  gst_harness_get (h, "tensor_filter", "sched-priority", &priority, NULL);
+  EXPECT_EQ (priority, 5U);
+
+  gst_harness_get (h, "tensor_filter", "deadline", &deadline, NULL);
+  EXPECT_EQ (deadline, 100U);
+
+  gst_harness_get (h, "tensor_filter", "sched-stats", &prop_string, NULL);
+  EXPECT_STREQ (prop_string,
+      "invoked=0,deadline-drops=0,budget-drops=0,deadline-misses=0");
+  g_free (prop_string);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  EXPECT_TRUE (gst_harness_use_testclock (h));
+  EXPECT_TRUE (gst_harness_set_time (h, 0));
+
+  /* the frame on time is invoked */
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  GST_BUFFER_PTS (in_buf) = 0;
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  /* the frame 1 sec late is dropped before invoke */
+  EXPECT_TRUE (gst_harness_set_time (h, GST_SECOND));
+
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  GST_BUFFER_PTS (in_buf) = 33 * GST_MSECOND;
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+
+  gst_harness_get (h, "tensor_filter", "sched-stats", &prop_string, NULL);
+  EXPECT_TRUE (g_str_has_prefix (prop_string,
+      "invoked=1,deadline-drops=1,budget-drops=0,"));
+  g_free (prop_string);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
+}
+
+/**
+ * @brief Push a frame (mobilenet input) with the running time to the harness.
+ */
+static void
+_schedule_push_frame (GstHarness *h, GstClockTime pts)
+{
+  GstBuffer *in_buf;
+
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  GST_BUFFER_PTS (in_buf) = pts;
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+}
+
+/**
+ * @brief Test the budget of the process-wide scheduler, the instance of lower priority yields to the other instance missing its deadline.
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, scheduleBudgetTFlite)
+{
+  GstHarness *h_high, *h_low;
+  GstBuffer *out_buf;
+  GstTensorsConfig config;
+  gchar *str_launch_line, *prop_string;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  str_launch_line = g_strdup_printf (
+      "tensor_filter framework=tensorflow-lite model=%s sched-priority=10 deadline=100",
+      test_model);
+  h_high = gst_harness_new_parse (str_launch_line);
+  g_free (str_launch_line);
+  ASSERT_TRUE (h_high != NULL);
+
+  str_launch_line = g_strdup_printf (
+      "tensor_filter framework=tensorflow-lite model=%s sched-priority=1",
+      test_model);
+  h_low = gst_harness_new_parse (str_launch_line);
+  g_free (str_launch_line);
+  ASSERT_TRUE (h_low != NULL);
+
+  gst_harness_set_src_caps (h_high, gst_tensors_caps_from_config (&config));
+  gst_harness_set_src_caps (h_low, gst_tensors_caps_from_config (&config));
+  EXPECT_TRUE (gst_harness_use_testclock (h_high));
+  EXPECT_TRUE (gst_harness_set_time (h_high, 0));
+
+  /* both instances invoke the frames on time */
+  _schedule_push_frame (h_high, 0);
+  out_buf = gst_harness_pull (h_high);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  _schedule_push_frame (h_low, 0);
+  out_buf = gst_harness_pull (h_low);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  /* the instance of high priority misses its deadline */
+  EXPECT_TRUE (gst_harness_set_time (h_high, GST_SECOND));
+  _schedule_push_frame (h_high, 33 * GST_MSECOND);
+  EXPECT_EQ (gst_harness_buffers_received (h_high), 1U);
+
+  /* the instance of low priority uses more than its share (1/11), the frame is dropped */
+  _schedule_push_frame (h_low, 33 * GST_MSECOND);
+  EXPECT_EQ (gst_harness_buffers_received (h_low), 1U);
+
+  gst_harness_get (h_low, "tensor_filter", "sched-stats", &prop_string, NULL);
+  EXPECT_TRUE (g_str_has_prefix (prop_string,
+      "invoked=1,deadline-drops=0,budget-drops=1,"));
+  g_free (prop_string);
+
+  /* the instance missing the deadline is not throttled by its own miss */
+  _schedule_push_frame (h_high, GST_SECOND);
+  out_buf = gst_harness_pull (h_high);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_get (h_high, "tensor_filter", "sched-stats", &prop_string, NULL);
+  EXPECT_TRUE (g_str_has_prefix (prop_string,
+      "invoked=2,deadline-drops=1,budget-drops=0,"));
+  g_free (prop_string);
+
+  gst_harness_teardown (h_low);
+  gst_harness_teardown (h_high);
+  g_free (test_model);
+}
+
+/**
+ * @brief Test the properties for CPU placement of tensor-filter.
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, cpuPlacementPropsTFlite)
+{
+  GstHarness *h;
+  gchar *str_launch_line, *prop_string;
+  gint numa_node, thread_priority;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf (
+      "tensor_filter framework=tensorflow-lite model=%s", test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  /* default values */
+  gst_harness_get (h, "tensor_filter", "cpu-affinity", &prop_string,
+      "numa-node", &numa_node, "thread-priority", &thread_priority, NULL);
+  EXPECT_STREQ (prop_string, "");
+  EXPECT_EQ (numa_node, -1);
+  EXPECT_EQ (thread_priority, 0);
+  g_free (prop_string);
+
+  gst_harness_set (h, "tensor_filter", "cpu-affinity", "0-1,3",
+      "thread-priority", 5, NULL);
+  gst_harness_get (h, "tensor_filter", "cpu-affinity", &prop_string,
+      "thread-priority", &thread_priority, NULL);
+  EXPECT_STREQ (prop_string, "0-1,3");
+  EXPECT_EQ (thread_priority, 5);
+  g_free (prop_string);
+
+  gst_harness_set (h, "tensor_filter", "cpu-affinity", "big", NULL);
+  gst_harness_get (h, "tensor_filter", "cpu-affinity", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, "big");
+  g_free (prop_string);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
+}
+
+#if defined(__linux__)
+/**
+ * @brief Test the CPU placement of tensor-filter is restored after invoke.
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, cpuPlacementRestoreTFlite)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  gchar *str_launch_line;
+  cpu_set_t set_before, set_after;
+  int nice_before, nice_after;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  /* CPU 0 is always online, 4095 is out of range and ignored */
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+      "model=%s cpu-affinity=0,4095 numa-node=0 thread-priority=5", test_model);
+  h = gst_harness_new_parse (str_launch_line);
+  g_free (str_launch_line);
+  ASSERT_TRUE (h != NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  ASSERT_EQ (sched_getaffinity (0, sizeof (set_before), &set_before), 0);
+  errno = 0;
+  nice_before = getpriority (PRIO_PROCESS, (id_t) syscall (SYS_gettid));
+  ASSERT_EQ (errno, 0);
+
+  /* the harness invokes the model in the calling thread */
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  ASSERT_EQ (sched_getaffinity (0, sizeof (set_after), &set_after), 0);
+  EXPECT_TRUE (CPU_EQUAL (&set_before, &set_after));
+
+  nice_after = getpriority (PRIO_PROCESS, (id_t) syscall (SYS_gettid));
+  EXPECT_EQ (nice_before, nice_after);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
+}
+#endif
+
+/**
+ * @brief The number of opened instances of the custom framework for shape cache test.
+ */
+static gint shape_fw_opened = 0;
+
+/**
+ * @brief The callback to open the custom framework for shape cache test.
+ */
+static int
+test_shape_fw_open (const GstTensorFilterProperties *prop, void **private_data)
+{
+  *private_data = g_new0 (gint, 1);
+  shape_fw_opened++;
+  return 0;
+}
+
+/**
+ * @brief The callback to close the custom framework for shape cache test.
+ */
+static void
+test_shape_fw_close (const GstTensorFilterProperties *prop, void **private_data)
+{
+  g_free (*private_data);
+  *private_data = NULL;
+  shape_fw_opened--;
+}
+
+/**
+ * @brief The callback to invoke the custom framework for shape cache test (passthrough).
+ */
+static int
+test_shape_fw_invoke (const GstTensorFilterProperties *prop,
+    void **private_data, const GstTensorMemory *input, GstTensorMemory *output)
+{
+  guint i;
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    if (input[i].size != output[i].size)
+      return -1;
+    memcpy (output[i].data, input[i].data, input[i].size);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief The callback to set the input shape of the custom framework for shape cache test.
+ */
+static int
+test_shape_fw_setdim (const GstTensorFilterProperties *prop,
+    void **private_data, const GstTensorsInfo *in_info, GstTensorsInfo *out_info)
+{
+  gst_tensors_info_copy (out_info, in_info);
+  return 0;
+}
+
+/**
+ * @brief Register the custom framework for shape cache test.
+ */
+static GstTensorFilterFramework *
+_register_shape_fw (void)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V0;
+  fw->name = (char *) "custom-shape";
+  fw->run_without_model = TRUE;
+  fw->open = test_shape_fw_open;
+  fw->close = test_shape_fw_close;
+  fw->invoke_NN = test_shape_fw_invoke;
+  fw->setInputDimension = test_shape_fw_setdim;
+
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+  return fw;
+}
+
+/**
+ * @brief Push the flexible tensor (uint8, dimension d0:1:1:1) filled with given value.
+ */
+static GstFlowReturn
+_push_flex_tensor (GstHarness *h, guint d0, guint8 value)
+{
+  GstTensorInfo info;
+  GstTensorMetaInfo meta;
+  GstBuffer *buf;
+  GstMemory *mem;
+  guint8 *data;
+  gsize hsize, data_size;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_UINT8;
+  info.dimension[0] = d0;
+  info.dimension[1] = info.dimension[2] = info.dimension[3] = 1;
+
+  gst_tensor_info_convert_to_meta (&info, &meta);
+  hsize = gst_tensor_meta_info_get_header_size (&meta);
+  data_size = gst_tensor_meta_info_get_data_size (&meta);
+
+  data = (guint8 *) g_malloc (hsize + data_size);
+  gst_tensor_meta_info_update_header (&meta, data);
+  memset (data + hsize, value, data_size);
+
+  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, hsize + data_size,
+      0, hsize + data_size, data, g_free);
+  buf = gst_buffer_new ();
+  gst_buffer_append_memory (buf, mem);
+
+  return gst_harness_push (h, buf);
+}
+
+/**
+ * @brief Pull the flexible tensor and check the dimension and data.
+ */
+static void
+_check_flex_tensor (GstHarness *h, guint d0, guint valid, guint8 value)
+{
+  GstTensorMetaInfo meta;
+  GstBuffer *buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  gsize hsize;
+  guint i;
+
+  buf = gst_harness_pull (h);
+  ASSERT_TRUE (buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (buf), 1U);
+
+  mem = gst_buffer_peek_memory (buf, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+
+  gst_tensor_meta_info_parse_header (&meta, map.data);
+  hsize = gst_tensor_meta_info_get_header_size (&meta);
+  EXPECT_EQ (meta.dimension[0], d0);
+  EXPECT_EQ (map.size - hsize, (gsize) d0);
+
+  for (i = 0; i < d0; i++)
+    EXPECT_EQ (map.data[hsize + i], (i < valid) ? value : 0);
+
+  gst_memory_unmap (mem, &map);
+  gst_buffer_unref (buf);
+}
+
+/**
+ * @brief Test for the plan cache of flexible input shapes.
+ */
+TEST (testTensorFilter, shapeCacheFlexible)
+{
+  GstTensorFilterFramework *fw;
+  GstHarness *h;
+  gchar *prop_string;
+  guint cache_size;
+
+  fw = _register_shape_fw ();
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  gst_harness_add_parse (h, "tensor_filter framework=custom-shape "
+      "input=4:1:1:1 inputtype=uint8 shape-cache-size=2");
+  gst_harness_set_src_caps_str (h, "other/tensors,format=flexible,framerate=0/1");
+  gst_harness_set_sink_caps_str (h, "other/tensors,format=flexible");
+
+  gst_harness_get (h, "tensor_filter", "shape-cache-size", &cache_size, NULL);
+  EXPECT_EQ (cache_size, 2U);
+
+  /* the shape is changed : 4 -> 6 (miss) -> 4 (hit) -> 6 (hit) -> 8 (miss) */
+  EXPECT_EQ (_push_flex_tensor (h, 4U, 1U), GST_FLOW_OK);
+  EXPECT_EQ (_push_flex_tensor (h, 6U, 2U), GST_FLOW_OK);
+  EXPECT_EQ (_push_flex_tensor (h, 4U, 3U), GST_FLOW_OK);
+  EXPECT_EQ (_push_flex_tensor (h, 6U, 4U), GST_FLOW_OK);
+  EXPECT_EQ (_push_flex_tensor (h, 8U, 5U), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 5U);
+  _check_flex_tensor (h, 4U, 4U, 1U);
+  _check_flex_tensor (h, 6U, 6U, 2U);
+  _check_flex_tensor (h, 4U, 4U, 3U);
+  _check_flex_tensor (h, 6U, 6U, 4U);
+  _check_flex_tensor (h, 8U, 8U, 5U);
+
+  /* 2 instances are prepared, the least recently used one is re-planned. */
+  EXPECT_EQ (shape_fw_opened, 2);
+
+  gst_harness_get (h, "tensor_filter", "shape-cache-stats", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, "hits=2,misses=2,padded=0");
+  g_free (prop_string);
+
+  gst_harness_teardown (h);
+  EXPECT_EQ (shape_fw_opened, 0);
+
+  nnstreamer_filter_exit (fw->name);
+  g_free (fw);
+}
+
+/**
+ * @brief Test for the shape buckets to pad flexible input.
+ */
+TEST (testTensorFilter, shapeBucketsFlexible)
+{
+  GstTensorFilterFramework *fw;
+  GstHarness *h;
+  gchar *prop_string;
+
+  fw = _register_shape_fw ();
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  gst_harness_add_parse (h, "tensor_filter framework=custom-shape "
+      "input=4:1:1:1 inputtype=uint8 shape-buckets=\"8:1:1:1;4:1:1:1\"");
+  gst_harness_set_src_caps_str (h, "other/tensors,format=flexible,framerate=0/1");
+  gst_harness_set_sink_caps_str (h, "other/tensors,format=flexible");
+
+  gst_harness_get (h, "tensor_filter", "shape-buckets", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, "8:1:1:1;4:1:1:1");
+  g_free (prop_string);
+
+  /* 3 -> bucket 4 (no change), 7 -> bucket 8 (miss), 8 -> bucket 8 (no change) */
+  EXPECT_EQ (_push_flex_tensor (h, 3U, 1U), GST_FLOW_OK);
+  EXPECT_EQ (_push_flex_tensor (h, 7U, 2U), GST_FLOW_OK);
+  EXPECT_EQ (_push_flex_tensor (h, 8U, 3U), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 3U);
+  _check_flex_tensor (h, 4U, 3U, 1U);
+  _check_flex_tensor (h, 8U, 7U, 2U);
+  _check_flex_tensor (h, 8U, 8U, 3U);
+
+  gst_harness_get (h, "tensor_filter", "shape-cache-stats", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, "hits=0,misses=1,padded=2");
+  g_free (prop_string);
+
+  /* the input larger than all buckets cannot be padded, re-plan with its shape. */
+  EXPECT_EQ (_push_flex_tensor (h, 10U, 4U), GST_FLOW_OK);
+  _check_flex_tensor (h, 10U, 10U, 4U);
+
+  gst_harness_teardown (h);
+
+  nnstreamer_filter_exit (fw->name);
+  g_free (fw);
+}
+
+/**
+ * @brief Custom-easy function to invert uint8 data, which can be invoked in-place.
+ */
+static int
+_invert_in_place (void *data, const GstTensorFilterProperties *prop,
+    const GstTensorMemory *in, GstTensorMemory *out)
+{
+  guint *in_place_count = (guint *) data;
+  const guint8 *src = (const guint8 *) in[0].data;
+  guint8 *dest = (guint8 *) out[0].data;
+  gsize i;
+
+  UNUSED (prop);
+  if (src == dest)
+    (*in_place_count)++;
+
+  for (i = 0; i < out[0].size; i++)
+    dest[i] = 255U - src[i];
+
+  return 0;
+}
+
+/**
+ * @brief Prepare uint8 tensor info (4:1:1:1) for in-place custom-easy filter.
+ */
+static void
+_get_in_place_info (GstTensorsInfo *info)
+{
+  gst_tensors_info_init (info);
+  info->num_tensors = 1U;
+  info->info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:1:1:1", info->info[0].dimension);
+}
+
+/**
+ * @brief Test for in-place invoke with custom-easy filter.
+ */
+TEST (testTensorFilter, inPlaceCustomEasy)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo map;
+  guint8 *in_data;
+  guint in_place_count = 0;
+  guint i;
+
+  gst_tensors_config_init (&config);
+  _get_in_place_info (&config.info);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  ASSERT_EQ (NNS_custom_easy_register_in_place ("invert_in_place",
+                 _invert_in_place, &in_place_count, &config.info, &config.info),
+      0);
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  gst_harness_add_parse (h, "tensor_filter framework=custom-easy model=invert_in_place");
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  /* writable input, the result is written into the same memory */
+  in_buf = gst_harness_create_buffer (h, 4U);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  in_data = map.data;
+  for (i = 0; i < 4U; i++)
+    map.data[i] = i;
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, 4U);
+  EXPECT_TRUE (map.data == in_data);
+  for (i = 0; i < 4U; i++)
+    EXPECT_EQ (map.data[i], 255U - i);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+  EXPECT_EQ (in_place_count, 1U);
+
+  /* non-writable input, the input data should not be changed */
+  in_buf = gst_harness_create_buffer (h, 4U);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 4U; i++)
+    map.data[i] = i;
+  gst_buffer_unmap (in_buf, &map);
+
+  gst_buffer_ref (in_buf);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_TRUE (out_buf != in_buf);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  for (i = 0; i < 4U; i++)
+    EXPECT_EQ (map.data[i], 255U - i);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_READ));
+  for (i = 0; i < 4U; i++)
+    EXPECT_EQ (map.data[i], i);
+  gst_buffer_unmap (in_buf, &map);
+  gst_buffer_unref (in_buf);
+
+  gst_harness_teardown (h);
+  EXPECT_EQ (NNS_custom_easy_unregister ("invert_in_place"), 0);
+}
+
+/**
+ * @brief Test for custom-easy filter without in-place, output memory is newly allocated.
+ */
+TEST (testTensorFilter, inPlaceCustomEasyDisabled)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo map;
+  guint in_place_count = 0;
+  guint i;
+
+  gst_tensors_config_init (&config);
+  _get_in_place_info (&config.info);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  ASSERT_EQ (NNS_custom_easy_register ("invert_not_in_place", _invert_in_place,
+                 &in_place_count, &config.info, &config.info),
+      0);
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  gst_harness_add_parse (h, "tensor_filter framework=custom-easy model=invert_not_in_place");
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 4U);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 4U; i++)
+    map.data[i] = i;
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  for (i = 0; i < 4U; i++)
+    EXPECT_EQ (map.data[i], 255U - i);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+  EXPECT_EQ (in_place_count, 0U);
+
+  gst_harness_teardown (h);
+  EXPECT_EQ (NNS_custom_easy_unregister ("invert_not_in_place"), 0);
+}
+
+/**
+ * @brief Test to register in-place custom-easy filter with different tensor sizes (invalid).
+ */
+TEST (testTensorFilter, inPlaceCustomEasyInvalidSize_n)
+{
+  GstTensorsInfo in_info, out_info;
+
+  _get_in_place_info (&in_info);
+  _get_in_place_info (&out_info);
+  out_info.info[0].type = _NNS_FLOAT32;
+
+  EXPECT_NE (NNS_custom_easy_register_in_place ("invert_invalid",
+                 _invert_in_place, NULL, &in_info, &out_info),
+      0);
+}
+
+/**
+ * @brief Push a writable buffer to the custom pass-through filter (uint8 3:280:40:1) and check the output memory.
+ */
+static void
+_push_custom_passthrough (const gchar *library, gboolean in_place)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo map;
+  const gsize size = 3U * 280U * 40U;
+  gchar *model_file, *pipeline;
+  guint8 *in_data;
+  gsize i;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  if (root_path == NULL)
+    root_path = "..";
+
+  model_file = g_build_filename (root_path, "build", "tests",
+      "nnstreamer_example", library, NULL);
+  ASSERT_TRUE (g_file_test (model_file, G_FILE_TEST_EXISTS));
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:280:40:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  pipeline = g_strdup_printf ("tensor_filter framework=custom model=%s", model_file);
+  gst_harness_add_parse (h, pipeline);
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, size);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  in_data = map.data;
+  for (i = 0; i < size; i++)
+    map.data[i] = (guint8) i;
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, size);
+  EXPECT_EQ (map.data == in_data, in_place);
+  for (i = 0; i < size; i++)
+    EXPECT_EQ (map.data[i], (guint8) i);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+  g_free (pipeline);
+  g_free (model_file);
+}
+
+/**
+ * @brief Test for in-place invoke with custom filter exporting NNStreamer_custom_in_place.
+ */
+TEST (testTensorFilter, inPlaceCustomSymbol)
+{
+  _push_custom_passthrough (
+      "libnnstreamer_customfilter_passthrough_in_place.so", TRUE);
+}
+
+/**
+ * @brief Test for custom filter without NNStreamer_custom_in_place, output memory is newly allocated.
+ */
+TEST (testTensorFilter, inPlaceCustomSymbolAbsent)
+{
+  _push_custom_passthrough (
+      "libnnstreamer_customfilter_passthrough.so", FALSE);
+}
+
+/**
+ * @brief Test to re-open tf-lite model file in tensor-filter.
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, reopenTFlite01)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  gsize in_size, out_size;
+  GstTensorsConfig config;
+  gchar *str_launch_line, *prop_string;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
 
   h = gst_harness_new_empty ();
   ASSERT_TRUE (h != NULL);
@@ -4973,6 +6263,104 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reopenTFlite01)
   g_free (test_model);
 }
 
+/**
+ * @brief Test to map the model file and share the mapping in the process.
+ */
+TEST (testTensorFilter, modelMap)
+{
+  GstTensorFilterModelMap *map1, *map2;
+  const void *data1, *data2;
+  size_t size1 = 0, size2 = 0;
+  gchar *contents = NULL;
+  gsize len = 0;
+  gchar *test_model;
+
+  GET_MODEL_PATH ("mobilenet_v1_1.0_224_quant.tflite");
+  ASSERT_TRUE (g_file_get_contents (test_model, &contents, &len, NULL));
+
+  map1 = nnstreamer_filter_model_map (test_model, NNS_MODEL_MAP_DEFAULT);
+  ASSERT_TRUE (map1 != NULL);
+  map2 = nnstreamer_filter_model_map (test_model, NNS_MODEL_MAP_POPULATE);
+  ASSERT_TRUE (map2 != NULL);
+
+  data1 = nnstreamer_filter_model_map_get_data (map1, &size1);
+  data2 = nnstreamer_filter_model_map_get_data (map2, &size2);
+
+  /* the same file is mapped once */
+  EXPECT_TRUE (data1 == data2);
+  EXPECT_EQ (size1, len);
+  EXPECT_EQ (size2, len);
+  EXPECT_EQ (memcmp (data1, contents, len), 0);
+
+  nnstreamer_filter_model_unmap (map1);
+
+  /* still valid after releasing the other reference */
+  data2 = nnstreamer_filter_model_map_get_data (map2, &size2);
+  EXPECT_EQ (memcmp (data2, contents, len), 0);
+  nnstreamer_filter_model_unmap (map2);
+
+  g_free (contents);
+  g_free (test_model);
+}
+
+/**
+ * @brief Test to map the invalid model file.
+ */
+TEST (testTensorFilter, modelMapInvalidFile_n)
+{
+  gchar *test_model;
+
+  EXPECT_TRUE (nnstreamer_filter_model_map (NULL, NNS_MODEL_MAP_DEFAULT) == NULL);
+  EXPECT_TRUE (nnstreamer_filter_model_map ("temp.tflite", NNS_MODEL_MAP_DEFAULT) == NULL);
+  EXPECT_TRUE (nnstreamer_filter_model_map_get_data (NULL, NULL) == NULL);
+
+  /* directory */
+  GET_MODEL_PATH ("");
+  EXPECT_TRUE (nnstreamer_filter_model_map (test_model, NNS_MODEL_MAP_DEFAULT) == NULL);
+  g_free (test_model);
+}
+
+/**
+ * @brief Test to load tf-lite model with the hint to map the model file.
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, modelMapPopulateTFlite)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  gchar *str_launch_line;
+  gchar *test_model;
+
+  GET_MODEL_PATH ("mobilenet_v1_1.0_224_quant.tflite");
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf (
+      "tensor_filter framework=tensorflow-lite model=%s custom=ModelMap:Populate", test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 3 * 224 * 224);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 1001U);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
+}
+
 /**
  * @brief Test to re-open tf-lite model file directly with nnfw struct.
  */
@@ -5019,47 +6407,202 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reopenTFlite02)
   /* close tf-lite model */
   fw->close (prop, &private_data);
 
-  g_free (prop);
-  g_free (test_model);
+  g_free (prop);
+  g_free (test_model);
+}
+
+/**
+ * @brief Test to reload tf-lite model set_property of model/is-updatable
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  gsize in_size, out_size;
+  GstTensorsConfig config;
+  gboolean prop_updatable;
+  gchar *str_launch_line, *prop_string;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model, *test_model2;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  test_model2 = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v2_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model2, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+                                     "is-updatable=true model=%s",
+      test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  /* playing state */
+  wait_for_element_state (h->element, GST_STATE_PLAYING);
+
+  /* paused state */
+  wait_for_element_state (h->element, GST_STATE_PAUSED);
+
+  /* get properties */
+  gst_harness_get (h, "tensor_filter", "framework", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, "tensorflow-lite");
+  g_free (prop_string);
+
+  gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, test_model);
+  g_free (prop_string);
+
+  gst_harness_get (h, "tensor_filter", "is-updatable", &prop_updatable, NULL);
+  EXPECT_TRUE (prop_updatable);
+
+  /* playing state */
+  wait_for_element_state (h->element, GST_STATE_PLAYING);
+
+  /* push buffer (dummy input RGB 224x224, output 1001) */
+  in_size = 3 * 224 * 224;
+  out_size = 1001;
+
+  in_buf = gst_harness_create_buffer (h, in_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
+  gst_buffer_unref (out_buf);
+
+  /* set second model file */
+  gst_harness_set (h, "tensor_filter", "model", test_model2, NULL);
+
+  gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, test_model2);
+  g_free (prop_string);
+
+  /* push buffer again */
+  in_buf = gst_harness_create_buffer (h, in_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
+  g_free (test_model2);
+}
+
+/**
+ * @brief Get the number of reloads from the property 'reload-stats'.
+ */
+static gint64
+get_reload_count (GstHarness *h)
+{
+  gchar *stats = NULL;
+  gint64 count = -1;
+
+  gst_harness_get (h, "tensor_filter", "reload-stats", &stats, NULL);
+  if (stats && g_str_has_prefix (stats, "reloads="))
+    count = g_ascii_strtoll (stats + strlen ("reloads="), NULL, 10);
+  g_free (stats);
+
+  return count;
+}
+
+/**
+ * @brief Push a buffer filled with fixed pattern and pull the result of tflite async reload test.
+ */
+static GstBuffer *
+_push_reload_input (GstHarness *h, gsize in_size)
+{
+  GstBuffer *in_buf;
+  GstMapInfo map;
+  gsize i;
+
+  in_buf = gst_harness_create_buffer (h, in_size);
+  if (!gst_buffer_map (in_buf, &map, GST_MAP_WRITE)) {
+    gst_buffer_unref (in_buf);
+    return NULL;
+  }
+
+  for (i = 0; i < in_size; i++)
+    map.data[i] = (guint8) (i % 251);
+  gst_buffer_unmap (in_buf, &map);
+
+  if (gst_harness_push (h, in_buf) != GST_FLOW_OK)
+    return NULL;
+
+  return gst_harness_pull (h);
+}
+
+/**
+ * @brief Compare the output buffer with the expected data.
+ */
+static gboolean
+_is_same_output (GstBuffer *buf, const guint8 *expected, gsize size)
+{
+  GstMapInfo map;
+  gboolean same;
+
+  if (gst_buffer_get_size (buf) != size || !gst_buffer_map (buf, &map, GST_MAP_READ))
+    return FALSE;
+
+  same = (memcmp (map.data, expected, size) == 0);
+  gst_buffer_unmap (buf, &map);
+
+  return same;
 }
 
 /**
- * @brief Test to reload tf-lite model set_property of model/is-updatable
+ * @brief Test to reload tf-lite model in background while the stream is running.
  */
-TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
+TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteAsync)
 {
   GstHarness *h;
-  GstBuffer *in_buf, *out_buf;
+  GstBuffer *out_buf;
   gsize in_size, out_size;
   GstTensorsConfig config;
-  gboolean prop_updatable;
   gchar *str_launch_line, *prop_string;
-
-  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gint64 reloads, timeout;
   gchar *test_model, *test_model2;
+  guint8 *old_output, *new_output;
+  guint num_pending, num_old, num_new;
+  GstMapInfo map;
 
-  /* supposed to run test in build directory */
-  if (root_path == NULL)
-    root_path = "..";
-
-  test_model = g_build_filename (root_path, "tests", "test_models", "models",
-      "mobilenet_v1_1.0_224_quant.tflite", NULL);
-  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
-
-  test_model2 = g_build_filename (root_path, "tests", "test_models", "models",
-      "mobilenet_v2_1.0_224_quant.tflite", NULL);
-  ASSERT_TRUE (g_file_test (test_model2, G_FILE_TEST_EXISTS));
+  GET_MODEL_PATH ("mobilenet_v2_1.0_224_quant.tflite");
+  test_model2 = test_model;
+  GET_MODEL_PATH ("mobilenet_v1_1.0_224_quant.tflite");
 
   h = gst_harness_new_empty ();
   ASSERT_TRUE (h != NULL);
 
   str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
-                                     "is-updatable=true model=%s",
+                                     "is-updatable=true custom=AsyncReload:true model=%s",
       test_model);
   gst_harness_add_parse (h, str_launch_line);
   g_free (str_launch_line);
 
-  /* input tensor info */
   gst_tensors_config_init (&config);
   config.info.num_tensors = 1U;
   config.info.info[0].type = _NNS_UINT8;
@@ -5069,58 +6612,86 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
 
   gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
 
-  /* playing state */
-  wait_for_element_state (h->element, GST_STATE_PLAYING);
-
-  /* paused state */
-  wait_for_element_state (h->element, GST_STATE_PAUSED);
-
-  /* get properties */
-  gst_harness_get (h, "tensor_filter", "framework", &prop_string, NULL);
-  EXPECT_STREQ (prop_string, "tensorflow-lite");
-  g_free (prop_string);
-
-  gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
-  EXPECT_STREQ (prop_string, test_model);
-  g_free (prop_string);
-
-  gst_harness_get (h, "tensor_filter", "is-updatable", &prop_updatable, NULL);
-  EXPECT_TRUE (prop_updatable);
-
-  /* playing state */
-  wait_for_element_state (h->element, GST_STATE_PLAYING);
-
-  /* push buffer (dummy input RGB 224x224, output 1001) */
   in_size = 3 * 224 * 224;
   out_size = 1001;
 
-  in_buf = gst_harness_create_buffer (h, in_size);
-  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
-
-  /* get output buffer */
-  out_buf = gst_harness_pull (h);
-  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
-  EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
+  /* the output of the first model */
+  out_buf = _push_reload_input (h, in_size);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), out_size);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  old_output = (guint8 *) _g_memdup (map.data, out_size);
+  gst_buffer_unmap (out_buf, &map);
   gst_buffer_unref (out_buf);
 
-  /* set second model file */
+  reloads = get_reload_count (h);
+  EXPECT_GE (reloads, 0);
+
+  /* the model is loaded in background, the stream is not blocked */
   gst_harness_set (h, "tensor_filter", "model", test_model2, NULL);
 
   gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
   EXPECT_STREQ (prop_string, test_model2);
   g_free (prop_string);
 
-  /* push buffer again */
-  in_buf = gst_harness_create_buffer (h, in_size);
-  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  /* the reload is counted when it is requested */
+  EXPECT_EQ (get_reload_count (h), reloads + 1);
 
-  /* get output buffer */
-  out_buf = gst_harness_pull (h);
-  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
-  EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
+  /**
+   * Keep the buffers flowing until the output is changed by the new model (max 10 sec).
+   * The invokes should not be blocked while the new model is loaded.
+   */
+  num_pending = 0;
+  new_output = NULL;
+  timeout = g_get_monotonic_time () + 10 * G_TIME_SPAN_SECOND;
+  while (g_get_monotonic_time () < timeout) {
+    out_buf = _push_reload_input (h, in_size);
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), out_size);
+
+    if (!_is_same_output (out_buf, old_output, out_size)) {
+      ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+      new_output = (guint8 *) _g_memdup (map.data, out_size);
+      gst_buffer_unmap (out_buf, &map);
+      gst_buffer_unref (out_buf);
+      break;
+    }
+
+    gst_buffer_unref (out_buf);
+    num_pending++;
+  }
+  ASSERT_TRUE (new_output != NULL);
+  EXPECT_GT (num_pending, 0U);
+
+  /* reload the first model again and check each output is made by either model, not a mixed one */
+  reloads = get_reload_count (h);
+  gst_harness_set (h, "tensor_filter", "model", test_model, NULL);
+  EXPECT_EQ (get_reload_count (h), reloads + 1);
+
+  num_old = num_new = 0;
+  timeout = g_get_monotonic_time () + 10 * G_TIME_SPAN_SECOND;
+  while (num_old == 0 && g_get_monotonic_time () < timeout) {
+    out_buf = _push_reload_input (h, in_size);
+    ASSERT_TRUE (out_buf != NULL);
+    if (_is_same_output (out_buf, new_output, out_size))
+      num_new++;
+    else if (_is_same_output (out_buf, old_output, out_size))
+      num_old++;
+    else
+      ADD_FAILURE () << "The output is made by neither model.";
+    gst_buffer_unref (out_buf);
+  }
+  EXPECT_GT (num_old, 0U);
+
+  /* no more reload is pending, the first model is kept */
+  out_buf = _push_reload_input (h, in_size);
+  ASSERT_TRUE (out_buf != NULL);
+  EXPECT_TRUE (_is_same_output (out_buf, old_output, out_size));
   gst_buffer_unref (out_buf);
 
   gst_harness_teardown (h);
+  g_free (old_output);
+  g_free (new_output);
   g_free (test_model);
   g_free (test_model2);
 }
@@ -7450,6 +9021,522 @@ TEST (testTensorCrop, infoDelayed_n)
   _crop_test_free (&crop_test);
 }
 
+/**
+ * @brief Data for tensor_merge test with two sink pads.
+ */
+typedef struct
+{
+  GstHarness *merge;
+  GstHarness *in0;
+  GstHarness *in1;
+  GstHarness *in0_q;
+  GstHarness *in1_q;
+} merge_test_data_s;
+
+/**
+ * @brief Initialize tensor_merge test data (2 static uint8 tensors 4:1:1:1).
+ */
+static void
+_merge_test_init (merge_test_data_s * merge_test, const gchar * sync_mode)
+{
+  GstPad *sink0, *sink1, *src0, *src1;
+  const gchar caps_str[] =
+      "other/tensors,num_tensors=1,types=uint8,dimensions=4:1:1:1,format=static,framerate=0/1";
+
+  merge_test->merge = gst_harness_new_with_padnames ("tensor_merge", NULL, "src");
+  g_object_set (merge_test->merge->element, "mode", "linear", "option", "0",
+      "sync-mode", sync_mode, NULL);
+
+  merge_test->in0 = gst_harness_new_with_element (merge_test->merge->element, "sink_0", NULL);
+  merge_test->in1 = gst_harness_new_with_element (merge_test->merge->element, "sink_1", NULL);
+  merge_test->in0_q = gst_harness_new ("queue");
+  merge_test->in1_q = gst_harness_new ("queue");
+
+  sink0 = GST_PAD_PEER (merge_test->in0->srcpad);
+  sink1 = GST_PAD_PEER (merge_test->in1->srcpad);
+  src0 = GST_PAD_PEER (merge_test->in0_q->sinkpad);
+  src1 = GST_PAD_PEER (merge_test->in1_q->sinkpad);
+
+  gst_pad_unlink (merge_test->in0->srcpad, sink0);
+  gst_pad_unlink (merge_test->in1->srcpad, sink1);
+  gst_pad_unlink (src0, merge_test->in0_q->sinkpad);
+  gst_pad_unlink (src1, merge_test->in1_q->sinkpad);
+  gst_pad_link (src0, sink0);
+  gst_pad_link (src1, sink1);
+
+  gst_harness_set_src_caps_str (merge_test->in0_q, caps_str);
+  gst_harness_set_src_caps_str (merge_test->in1_q, caps_str);
+}
+
+/**
+ * @brief Free tensor_merge test data.
+ */
+static void
+_merge_test_free (merge_test_data_s * merge_test)
+{
+  gst_harness_teardown (merge_test->in0);
+  gst_harness_teardown (merge_test->in1);
+  gst_harness_teardown (merge_test->in0_q);
+  gst_harness_teardown (merge_test->in1_q);
+  gst_harness_teardown (merge_test->merge);
+}
+
+/**
+ * @brief Push two halves of the parent memory to tensor_merge and check the merged output.
+ * @return TRUE if the output memory points to the parent memory (no copy).
+ */
+static gboolean
+_merge_test_push_halves (merge_test_data_s * merge_test, GstMemory * parent,
+    gsize offset0, gsize offset1)
+{
+  GstBuffer *in0, *in1, *out;
+  GstMemory *mem;
+  GstMapInfo pmap, omap;
+  gboolean shared = FALSE;
+  guint i;
+
+  in0 = gst_buffer_new ();
+  gst_buffer_append_memory (in0, gst_memory_share (parent, offset0, 4));
+  GST_BUFFER_PTS (in0) = 0;
+  in1 = gst_buffer_new ();
+  gst_buffer_append_memory (in1, gst_memory_share (parent, offset1, 4));
+  GST_BUFFER_PTS (in1) = 0;
+
+  EXPECT_EQ (gst_harness_push (merge_test->in0_q, in0), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_push (merge_test->in1_q, in1), GST_FLOW_OK);
+
+  EXPECT_EQ (_harness_wait_for_output_buffer (merge_test->merge, 1U), 1U);
+  out = gst_harness_pull (merge_test->merge);
+  if (out == NULL)
+    return FALSE;
+
+  EXPECT_EQ (gst_buffer_n_memory (out), 1U);
+  mem = gst_buffer_peek_memory (out, 0);
+  EXPECT_TRUE (gst_memory_map (parent, &pmap, GST_MAP_READ));
+  EXPECT_TRUE (gst_memory_map (mem, &omap, GST_MAP_READ));
+  EXPECT_EQ (omap.size, 8U);
+
+  /* merged data should be the concatenation of the two inputs */
+  for (i = 0; i < 4U && omap.size == 8U; i++) {
+    EXPECT_EQ (omap.data[i], pmap.data[offset0 + i]);
+    EXPECT_EQ (omap.data[4U + i], pmap.data[offset1 + i]);
+  }
+
+  shared = (omap.data == pmap.data);
+
+  gst_memory_unmap (mem, &omap);
+  gst_memory_unmap (parent, &pmap);
+  gst_buffer_unref (out);
+
+  return shared;
+}
+
+/**
+ * @brief Test for tensor_merge, contiguous input memories are merged without copy.
+ */
+TEST (testTensorMerge, zeroCopySpan)
+{
+  merge_test_data_s merge_test;
+  GstMemory *parent;
+  GstMapInfo map;
+  guint i;
+
+  parent = gst_allocator_alloc (NULL, 8, NULL);
+  ASSERT_TRUE (gst_memory_map (parent, &map, GST_MAP_WRITE));
+  for (i = 0; i < 8U; i++)
+    map.data[i] = (guint8) i;
+  gst_memory_unmap (parent, &map);
+
+  _merge_test_init (&merge_test, "nosync");
+
+  /* sink_0 gets [0..3] and sink_1 gets [4..7] of the same parent memory */
+  EXPECT_TRUE (_merge_test_push_halves (&merge_test, parent, 0, 4));
+
+  _merge_test_free (&merge_test);
+  gst_memory_unref (parent);
+}
+
+/**
+ * @brief Test for tensor_merge, non-contiguous input memories are copied.
+ */
+TEST (testTensorMerge, zeroCopyNotSpan_n)
+{
+  merge_test_data_s merge_test;
+  GstMemory *parent;
+  GstMapInfo map;
+  guint i;
+
+  parent = gst_allocator_alloc (NULL, 8, NULL);
+  ASSERT_TRUE (gst_memory_map (parent, &map, GST_MAP_WRITE));
+  for (i = 0; i < 8U; i++)
+    map.data[i] = (guint8) i;
+  gst_memory_unmap (parent, &map);
+
+  _merge_test_init (&merge_test, "nosync");
+
+  /* halves in reversed order, merged tensor should be copied (data 4..7, 0..3) */
+  EXPECT_FALSE (_merge_test_push_halves (&merge_test, parent, 4, 0));
+
+  _merge_test_free (&merge_test);
+  gst_memory_unref (parent);
+}
+
+/**
+ * @brief Callback to check the input buffer is released.
+ */
+static void
+_merge_test_buffer_released (gpointer data, GstMiniObject * obj)
+{
+  gboolean *released = (gboolean *) data;
+  UNUSED (obj);
+
+  *released = TRUE;
+}
+
+/**
+ * @brief Test for tensor_merge, the buffer held on the collect pad is released with the pad.
+ */
+TEST (testTensorMerge, releasePadBuffer)
+{
+  merge_test_data_s merge_test;
+  GstBuffer *in0, *in1;
+  gboolean released = FALSE;
+
+  _merge_test_init (&merge_test, "refresh");
+
+  in0 = gst_harness_create_buffer (merge_test.in0_q, 4);
+  GST_BUFFER_PTS (in0) = 0;
+  in1 = gst_harness_create_buffer (merge_test.in1_q, 4);
+  GST_BUFFER_PTS (in1) = 0;
+
+  /* refresh mode keeps the last buffer of each pad */
+  gst_mini_object_weak_ref (GST_MINI_OBJECT_CAST (in1),
+      _merge_test_buffer_released, &released);
+
+  EXPECT_EQ (gst_harness_push (merge_test.in0_q, in0), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_push (merge_test.in1_q, in1), GST_FLOW_OK);
+  EXPECT_GE (_harness_wait_for_output_buffer (merge_test.merge, 1U), 1U);
+
+  _merge_test_free (&merge_test);
+  EXPECT_TRUE (released);
+}
+
+/**
+ * @brief Query the allocation to tensor_merge through the queue, and get the proposed allocator.
+ */
+static GstAllocator *
+_merge_test_query_allocator (GstHarness * h_q)
+{
+  GstAllocator *allocator = NULL;
+  GstQuery *query;
+  GstCaps *caps;
+
+  caps = gst_pad_get_current_caps (h_q->srcpad);
+  query = gst_query_new_allocation (caps, TRUE);
+
+  if (gst_pad_peer_query (h_q->srcpad, query)
+      && gst_query_get_n_allocation_params (query) > 0)
+    gst_query_parse_nth_allocation_param (query, 0, &allocator, NULL);
+
+  gst_query_unref (query);
+  if (caps)
+    gst_caps_unref (caps);
+
+  return allocator;
+}
+
+/**
+ * @brief Test for tensor_merge, upstream writes the tensors into the slices proposed by the allocation query.
+ */
+TEST (testTensorMerge, proposeSlices)
+{
+  merge_test_data_s merge_test;
+  GstAllocator *alloc0, *alloc1;
+  GstMemory *mem0, *mem1, *mem;
+  GstBuffer *in0, *in1, *out;
+  GstMapInfo map0, map1, omap;
+  guint8 *data0;
+  guint i;
+
+  _merge_test_init (&merge_test, "nosync");
+
+  /* sink_0 may query before sink_1 is negotiated, query again after sink_1 */
+  alloc0 = _merge_test_query_allocator (merge_test.in0_q);
+  if (alloc0)
+    gst_object_unref (alloc0);
+  alloc1 = _merge_test_query_allocator (merge_test.in1_q);
+  alloc0 = _merge_test_query_allocator (merge_test.in0_q);
+  ASSERT_TRUE (alloc0 != NULL);
+  ASSERT_TRUE (alloc1 != NULL);
+  EXPECT_TRUE (alloc0 != alloc1);
+
+  mem0 = gst_allocator_alloc (alloc0, 4, NULL);
+  mem1 = gst_allocator_alloc (alloc1, 4, NULL);
+  ASSERT_TRUE (gst_memory_map (mem0, &map0, GST_MAP_WRITE));
+  ASSERT_TRUE (gst_memory_map (mem1, &map1, GST_MAP_WRITE));
+
+  /* two slices of the same merged tensor */
+  EXPECT_EQ (map1.data, map0.data + 4);
+  for (i = 0; i < 4U; i++) {
+    map0.data[i] = (guint8) i;
+    map1.data[i] = (guint8) (10U + i);
+  }
+  data0 = map0.data;
+
+  gst_memory_unmap (mem0, &map0);
+  gst_memory_unmap (mem1, &map1);
+
+  in0 = gst_buffer_new ();
+  gst_buffer_append_memory (in0, mem0);
+  GST_BUFFER_PTS (in0) = 0;
+  in1 = gst_buffer_new ();
+  gst_buffer_append_memory (in1, mem1);
+  GST_BUFFER_PTS (in1) = 0;
+
+  EXPECT_EQ (gst_harness_push (merge_test.in0_q, in0), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_push (merge_test.in1_q, in1), GST_FLOW_OK);
+
+  EXPECT_EQ (_harness_wait_for_output_buffer (merge_test.merge, 1U), 1U);
+  out = gst_harness_pull (merge_test.merge);
+  ASSERT_TRUE (out != NULL);
+
+  EXPECT_EQ (gst_buffer_n_memory (out), 1U);
+  mem = gst_buffer_peek_memory (out, 0);
+  ASSERT_TRUE (gst_memory_map (mem, &omap, GST_MAP_READ));
+  EXPECT_EQ (omap.size, 8U);
+
+  /* merged without copy */
+  EXPECT_EQ (omap.data, data0);
+  for (i = 0; i < 4U && omap.size == 8U; i++) {
+    EXPECT_EQ (omap.data[i], i);
+    EXPECT_EQ (omap.data[4U + i], 10U + i);
+  }
+
+  gst_memory_unmap (mem, &omap);
+  gst_buffer_unref (out);
+
+  gst_object_unref (alloc0);
+  gst_object_unref (alloc1);
+  _merge_test_free (&merge_test);
+}
+
+/**
+ * @brief Encode and decode the tensor data, and check the decoded size.
+ */
+static guint8 *
+_codec_round_trip (tensor_codec_e codec, tensor_type type, const guint8 * data,
+    gsize size)
+{
+  guint8 *encoded, *decoded;
+  gsize enc_size = 0, dec_size = 0;
+
+  encoded = (guint8 *) gst_tensor_codec_encode (codec, type, data, size, NULL, &enc_size);
+  if (encoded == NULL)
+    return NULL;
+
+  EXPECT_LT (enc_size, size);
+  decoded = (guint8 *) gst_tensor_codec_decode (encoded, enc_size, size, &dec_size);
+  EXPECT_EQ (dec_size, size);
+  g_free (encoded);
+
+  return decoded;
+}
+
+/**
+ * @brief Test for tensor codec, lossless encoding of multiple chunks.
+ */
+TEST (testTensorCodec, roundTripLossless)
+{
+  const gsize num = 1024 * 1024; /* 4MB, multiple chunks */
+  gint32 *data;
+  guint8 *decoded;
+  gsize i;
+
+  data = g_new (gint32, num);
+  for (i = 0; i < num; i++)
+    data[i] = (gint32) ((i / 16) % 100);
+
+  decoded = _codec_round_trip (TENSOR_CODEC_LOSSLESS, _NNS_INT32,
+      (const guint8 *) data, num * sizeof (gint32));
+  ASSERT_TRUE (decoded != NULL);
+  EXPECT_EQ (memcmp (decoded, data, num * sizeof (gint32)), 0);
+
+  g_free (decoded);
+  g_free (data);
+}
+
+/**
+ * @brief Test for tensor codec, float16 conversion of the values representable in float16.
+ */
+TEST (testTensorCodec, roundTripFp16)
+{
+  const gsize num = 4096;
+  gfloat *data, *decoded;
+  gsize i;
+
+  data = g_new (gfloat, num);
+  for (i = 0; i < num; i++)
+    data[i] = ((gfloat) (i % 64) - 32.0f) * 0.25f;
+
+  decoded = (gfloat *) _codec_round_trip (TENSOR_CODEC_FP16, _NNS_FLOAT32,
+      (const guint8 *) data, num * sizeof (gfloat));
+  ASSERT_TRUE (decoded != NULL);
+  for (i = 0; i < num; i++)
+    EXPECT_FLOAT_EQ (decoded[i], data[i]);
+
+  g_free (decoded);
+  g_free (data);
+}
+
+/**
+ * @brief Test for tensor codec, int8 quantization with scale.
+ */
+TEST (testTensorCodec, roundTripInt8)
+{
+  const gsize num = 4096;
+  gfloat *data, *decoded;
+  gfloat scale = 10.0f / 127.0f;
+  gsize i;
+
+  data = g_new (gfloat, num);
+  for (i = 0; i < num; i++)
+    data[i] = ((gfloat) (i % 201) - 100.0f) * 0.1f;
+
+  decoded = (gfloat *) _codec_round_trip (TENSOR_CODEC_INT8, _NNS_FLOAT32,
+      (const guint8 *) data, num * sizeof (gfloat));
+  ASSERT_TRUE (decoded != NULL);
+  for (i = 0; i < num; i++)
+    EXPECT_NEAR (decoded[i], data[i], scale / 2.0f + 1e-5f);
+
+  g_free (decoded);
+  g_free (data);
+}
+
+/**
+ * @brief Test for tensor codec, decode the data at unaligned address.
+ */
+TEST (testTensorCodec, decodeUnaligned)
+{
+  const gsize size = 4096;
+  guint8 *data, *encoded, *unaligned, *decoded;
+  gsize i, enc_size = 0, dec_size = 0;
+
+  data = (guint8 *) g_malloc (size);
+  for (i = 0; i < size; i++)
+    data[i] = (guint8) (i / 64);
+
+  encoded = (guint8 *) gst_tensor_codec_encode (TENSOR_CODEC_LOSSLESS,
+      _NNS_UINT8, data, size, NULL, &enc_size);
+  ASSERT_TRUE (encoded != NULL);
+
+  unaligned = (guint8 *) g_malloc (enc_size + 1);
+  memcpy (unaligned + 1, encoded, enc_size);
+
+  decoded = (guint8 *) gst_tensor_codec_decode (unaligned + 1, enc_size, size, &dec_size);
+  ASSERT_TRUE (decoded != NULL);
+  EXPECT_EQ (dec_size, size);
+  EXPECT_EQ (memcmp (decoded, data, size), 0);
+
+  g_free (decoded);
+  g_free (unaligned);
+  g_free (encoded);
+  g_free (data);
+}
+
+/**
+ * @brief Test for tensor codec, incompressible data is not encoded.
+ */
+TEST (testTensorCodec, encodeIncompressible)
+{
+  const gsize size = 4096;
+  GstTensorCodecState state = { 0 };
+  guint8 *data;
+  gsize i, enc_size = 0;
+
+  data = (guint8 *) g_malloc (size);
+  for (i = 0; i < size; i++)
+    data[i] = (guint8) g_random_int ();
+
+  EXPECT_TRUE (gst_tensor_codec_encode (TENSOR_CODEC_LOSSLESS, _NNS_UINT8,
+                   data, size, &state, &enc_size) == NULL);
+  /* skip lossless encoding for next frames */
+  EXPECT_GT (state.skip, 0U);
+
+  g_free (data);
+}
+
+/**
+ * @brief Test for tensor codec, decode the truncated data.
+ */
+TEST (testTensorCodec, decodeTruncated_n)
+{
+  const gsize size = 4096;
+  guint8 *data, *encoded;
+  gsize i, enc_size = 0, dec_size = 0;
+
+  data = (guint8 *) g_malloc (size);
+  for (i = 0; i < size; i++)
+    data[i] = (guint8) (i / 64);
+
+  encoded = (guint8 *) gst_tensor_codec_encode (TENSOR_CODEC_LOSSLESS,
+      _NNS_UINT8, data, size, NULL, &enc_size);
+  ASSERT_TRUE (encoded != NULL);
+
+  /* header only */
+  EXPECT_TRUE (gst_tensor_codec_decode (encoded, 8, size, &dec_size) == NULL);
+  /* payload is truncated */
+  EXPECT_TRUE (gst_tensor_codec_decode (encoded, enc_size - 1, size, &dec_size) == NULL);
+  /* trailing garbage */
+  encoded = (guint8 *) g_realloc (encoded, enc_size + 1);
+  EXPECT_TRUE (gst_tensor_codec_decode (encoded, enc_size + 1, size, &dec_size) == NULL);
+
+  g_free (encoded);
+  g_free (data);
+}
+
+/**
+ * @brief Test for tensor codec, decode the corrupted data.
+ */
+TEST (testTensorCodec, decodeCorrupt_n)
+{
+  const gsize size = 4096;
+  guint8 *data, *encoded, *corrupt;
+  gsize i, enc_size = 0, dec_size = 0;
+  guint64 orig_size;
+
+  data = (guint8 *) g_malloc (size);
+  for (i = 0; i < size; i++)
+    data[i] = (guint8) (i / 64);
+
+  encoded = (guint8 *) gst_tensor_codec_encode (TENSOR_CODEC_LOSSLESS,
+      _NNS_UINT8, data, size, NULL, &enc_size);
+  ASSERT_TRUE (encoded != NULL);
+  corrupt = (guint8 *) g_malloc (enc_size);
+
+  /* larger than the negotiated tensor */
+  EXPECT_TRUE (gst_tensor_codec_decode (encoded, enc_size, size - 1, &dec_size) == NULL);
+
+  /* invalid magic */
+  memcpy (corrupt, encoded, enc_size);
+  corrupt[0] ^= 0xff;
+  EXPECT_TRUE (gst_tensor_codec_decode (corrupt, enc_size, size, &dec_size) == NULL);
+
+  /* huge original size (offset 16 in the header) */
+  memcpy (corrupt, encoded, enc_size);
+  orig_size = G_MAXUINT64 / 2;
+  memcpy (corrupt + 16, &orig_size, sizeof (orig_size));
+  EXPECT_TRUE (gst_tensor_codec_decode (corrupt, enc_size, 0, &dec_size) == NULL);
+
+  /* run-length control byte in the payload is broken */
+  memcpy (corrupt, encoded, enc_size);
+  corrupt[enc_size - 2] = 0x7f;
+  EXPECT_TRUE (gst_tensor_codec_decode (corrupt, enc_size, size, &dec_size) == NULL);
+
+  g_free (corrupt);
+  g_free (encoded);
+  g_free (data);
+}
+
 /**
  * @brief Macro to test sparse tensor conversion for each data type.
  */
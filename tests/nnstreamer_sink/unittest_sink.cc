@@ -370,6 +370,24 @@ _eos_cb (GstElement *element, gpointer user_data)
   _print_log ("eos callback");
 }
 
+/**
+ * @brief Callback for signal new-data-batch.
+ */
+static void
+_new_data_batch_cb (GstElement *element, GstBufferList *list, gpointer user_data)
+{
+  guint *batches = (guint *) user_data;
+
+  if (!GST_IS_BUFFER_LIST (list) || gst_buffer_list_length (list) == 0) {
+    _print_log ("received invalid buffer list");
+    g_test_data.test_failed = TRUE;
+    return;
+  }
+
+  batches[0]++;
+  batches[1] += gst_buffer_list_length (list);
+}
+
 /**
  * @brief Calculate buffer size from test data if test is flexible tensor stream.
  */
@@ -1392,6 +1410,201 @@ TEST (tensorSinkTest, signalRate)
   _free_test_data (option);
 }
 
+/**
+ * @brief Test for tensor sink properties for pull mode.
+ */
+TEST (tensorSinkTest, propertiesPullMode)
+{
+  guint max_buffers, batch_size;
+  gboolean drop;
+  gint fd;
+  TestOption option = { 1, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  /** default max-buffers is 0 */
+  g_object_get (g_test_data.sink, "max-buffers", &max_buffers, NULL);
+  EXPECT_EQ (max_buffers, 0U);
+
+  g_object_set (g_test_data.sink, "max-buffers", 10U, NULL);
+  g_object_get (g_test_data.sink, "max-buffers", &max_buffers, NULL);
+  EXPECT_EQ (max_buffers, 10U);
+
+  /** default drop is FALSE */
+  g_object_get (g_test_data.sink, "drop", &drop, NULL);
+  EXPECT_FALSE (drop);
+
+  g_object_set (g_test_data.sink, "drop", TRUE, NULL);
+  g_object_get (g_test_data.sink, "drop", &drop, NULL);
+  EXPECT_TRUE (drop);
+
+  /** default batch-size is 1 */
+  g_object_get (g_test_data.sink, "batch-size", &batch_size, NULL);
+  EXPECT_EQ (batch_size, 1U);
+
+  g_object_set (g_test_data.sink, "batch-size", 4U, NULL);
+  g_object_get (g_test_data.sink, "batch-size", &batch_size, NULL);
+  EXPECT_EQ (batch_size, 4U);
+
+#ifdef G_OS_UNIX
+  /** wakeup-fd is not changed once created */
+  g_object_get (g_test_data.sink, "wakeup-fd", &fd, NULL);
+  EXPECT_GE (fd, 0);
+
+  {
+    gint res_fd;
+
+    g_object_get (g_test_data.sink, "wakeup-fd", &res_fd, NULL);
+    EXPECT_EQ (res_fd, fd);
+  }
+#else
+  g_object_get (g_test_data.sink, "wakeup-fd", &fd, NULL);
+  EXPECT_EQ (fd, -1);
+#endif
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink pull mode.
+ */
+TEST (tensorSinkTest, pullBuffer)
+{
+  const guint num_buffers = 5;
+  GstBuffer *buffer;
+  guint pulled = 0;
+  gint fd;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  /** keep all buffers in the queue, without new-data signal */
+  g_object_set (g_test_data.sink, "emit-signal", (gboolean) FALSE, NULL);
+  g_object_set (g_test_data.sink, "max-buffers", num_buffers, NULL);
+  g_object_get (g_test_data.sink, "wakeup-fd", &fd, NULL);
+
+  /** nothing to pull before starting the pipeline */
+  g_signal_emit_by_name (g_test_data.sink, "try-pull-buffer", (GstClockTime) 0, &buffer);
+  EXPECT_TRUE (buffer == NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+  EXPECT_EQ (g_test_data.received, 0U);
+
+#ifdef G_OS_UNIX
+  {
+    GPollFD pfd = { fd, G_IO_IN, 0 };
+
+    /** wakeup-fd is readable while the buffers are queued */
+    EXPECT_EQ (g_poll (&pfd, 1, 0), 1);
+  }
+#endif
+
+  while (TRUE) {
+    g_signal_emit_by_name (g_test_data.sink, "try-pull-buffer", (GstClockTime) (10 * GST_MSECOND), &buffer);
+    if (buffer == NULL)
+      break;
+
+    EXPECT_EQ (gst_buffer_get_size (buffer), 160U * 120U * 3U);
+    gst_buffer_unref (buffer);
+    pulled++;
+  }
+
+  EXPECT_EQ (pulled, num_buffers);
+
+  /** returns NULL without blocking after eos */
+  g_signal_emit_by_name (g_test_data.sink, "pull-buffer", &buffer);
+  EXPECT_TRUE (buffer == NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink pull mode (drop the oldest buffers).
+ */
+TEST (tensorSinkTest, pullBufferDrop)
+{
+  const guint num_buffers = 6;
+  const guint max_buffers = 2;
+  GstBuffer *buffer;
+  GstClockTime pts = 0;
+  guint pulled = 0;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  g_object_set (g_test_data.sink, "emit-signal", (gboolean) FALSE, NULL);
+  g_object_set (g_test_data.sink, "max-buffers", max_buffers, NULL);
+  g_object_set (g_test_data.sink, "drop", TRUE, NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** the latest buffers remain in the queue */
+  while (TRUE) {
+    g_signal_emit_by_name (g_test_data.sink, "try-pull-buffer", (GstClockTime) 0, &buffer);
+    if (buffer == NULL)
+      break;
+
+    EXPECT_TRUE (pulled == 0 || GST_BUFFER_PTS (buffer) > pts);
+    pts = GST_BUFFER_PTS (buffer);
+    gst_buffer_unref (buffer);
+    pulled++;
+  }
+
+  EXPECT_EQ (pulled, max_buffers);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor sink batched signal.
+ */
+TEST (tensorSinkTest, newDataBatch)
+{
+  const guint num_buffers = 5;
+  guint batches[2] = { 0, 0 };
+  gulong handle_id;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  g_object_set (g_test_data.sink, "batch-size", 2U, NULL);
+
+  handle_id = g_signal_connect (g_test_data.sink, "new-data-batch",
+      (GCallback) _new_data_batch_cb, batches);
+  EXPECT_TRUE (handle_id > 0);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+  g_usleep (jitter);
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** new-data is not emitted, the remaining buffer is delivered at eos */
+  EXPECT_EQ (g_test_data.received, 0U);
+  EXPECT_EQ (batches[0], 3U);
+  EXPECT_EQ (batches[1], num_buffers);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
 /**
  * @brief Test for caps negotiation failed.
  */